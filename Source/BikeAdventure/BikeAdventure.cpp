@@ -1,5 +1,6 @@
 #include "BikeAdventure.h"
 #include "Modules/ModuleManager.h"
+#include "Systems/BikeTelemetry.h"
 
 #if WITH_EDITOR
 #include "ToolMenus.h"
@@ -33,6 +34,12 @@ IMPLEMENT_PRIMARY_GAME_MODULE(FBikeAdventureModule, BikeAdventure, "BikeAdventur
 
 void FBikeAdventureModule::StartupModule()
 {
+       // Hot-path telemetry is opt-in: -BikeTelemetry on the command line or bike.Telemetry=1 in config.
+       if (FBikeTelemetry::IsRequested())
+       {
+               FBikeTelemetry::Get().Startup();
+       }
+
 #if WITH_EDITOR
        // Delay menu registration until the editor ToolMenus system is ready.
        ToolMenusStartupHandle = UToolMenus::RegisterStartupCallback(
@@ -42,6 +49,8 @@ void FBikeAdventureModule::StartupModule()
 
 void FBikeAdventureModule::ShutdownModule()
 {
+       FBikeTelemetry::Get().Shutdown();
+
 #if WITH_EDITOR
        UToolMenus::UnRegisterStartupCallback(ToolMenusStartupHandle);
 #endif // WITH_EDITOR
@@ -6,6 +6,7 @@
 
 class UIntersectionManager;
 class UBiomeGenerator;
+class UDiscoverySystem;
 
 /**
  * Main Game Mode for BikeAdventure
@@ -33,7 +34,7 @@ protected:
 
 	/** Discovery system for tracking encounters */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Core Systems")
-	TObjectPtr<class UDiscoverySystem> DiscoverySystem;
+	TObjectPtr<UDiscoverySystem> DiscoverySystem;
 
 	/** Default forward speed for all bikes in cm/s */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gameplay Settings")
@@ -52,6 +53,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Core Systems")
 	UBiomeGenerator* GetBiomeGenerator() const { return BiomeGenerator; }
 
+	/** Get the discovery system instance */
+	UFUNCTION(BlueprintCallable, Category = "Core Systems")
+	UDiscoverySystem* GetDiscoverySystem() const { return DiscoverySystem; }
+
 	/** Get default bike speed */
 	UFUNCTION(BlueprintCallable, Category = "Gameplay Settings")
 	float GetDefaultBikeSpeed() const { return DefaultBikeSpeed; }
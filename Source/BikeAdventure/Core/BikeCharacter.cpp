@@ -1,10 +1,14 @@
 #include "BikeCharacter.h"
 #include "Systems/BikeMovementComponent.h"
+#include "Systems/BikeTelemetry.h"
+#include "Systems/DiscoverySystem.h"
+#include "Core/BikeAdventureGameMode.h"
 #include "Gameplay/Intersection.h"
 #include "Components/InputComponent.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
 
 ABikeCharacter::ABikeCharacter()
 {
@@ -71,22 +75,88 @@ void ABikeCharacter::BeginPlay()
 	{
 		BikeMovement->UpdatedComponent = RootComponent;
 		BikeMovement->SetUpdatedComponent(RootComponent);
+
+		// Movement is simulated at a fixed rate; the mesh and the camera boom render between
+		// simulation steps, so the view moves as smoothly as the bike does
+		BikeMovement->AddInterpolatedComponent(BikeMesh);
+		BikeMovement->AddInterpolatedComponent(SpringArm);
 	}
 
+	// Located discoveries are found by riding past them
+	if (const ABikeAdventureGameMode* GameMode = Cast<ABikeAdventureGameMode>(GetWorld()->GetAuthGameMode()))
+	{
+		DiscoverySystem = GameMode->GetDiscoverySystem();
+	}
+
+	// Transforms written by the end of actor ticking are what the frame presents
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ABikeCharacter::OnWorldPostActorTick);
+
 	UE_LOG(LogTemp, Warning, TEXT("Bike Character spawned and initialized"));
 }
 
+void ABikeCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ABikeCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-        // Update movement component
-        if (BikeMovement && RootComponent)
-        {
-                BikeMovement->SetSteering(SteeringInput);
-               BikeMovement->SetThrottle(ThrottleInput);
-                BikeMovement->UpdateMovement(DeltaTime);
-        }
+	// The player controller processes input before its pawn ticks, so this applies it the same frame
+	ApplyInputAndMove(DeltaTime);
+}
+
+void ABikeCharacter::ApplyInputAndMove(float DeltaTime)
+{
+	// Update movement component
+	if (BikeMovement && RootComponent)
+	{
+		BikeMovement->SetSteering(SteeringInput);
+		BikeMovement->SetThrottle(ThrottleInput);
+
+		// Input only reaches the pose once a fixed simulation step has consumed it
+		const int32 PreviousStepCount = BikeMovement->GetMovementState().StepCount;
+		BikeMovement->UpdateMovement(DeltaTime);
+
+		if (bTrackInputLatency && BikeMovement->GetMovementState().StepCount != PreviousStepCount
+			&& SteeringLatency.MarkMovementUpdate(FPlatformTime::Seconds()))
+		{
+			SteeringLatencyStep = BikeMovement->GetMovementState().StepCount;
+		}
+	}
+
+	// Only does work when the bike crosses into another proximity cell
+	if (UDiscoverySystem* Discovery = DiscoverySystem.Get())
+	{
+		Discovery->UpdateRiderLocation(GetActorLocation());
+	}
+}
+
+void ABikeCharacter::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || !bTrackInputLatency)
+	{
+		return;
+	}
+
+	// Interpolated visuals render one step behind the simulation, so the step that consumed the
+	// input is only fully on screen once the following step has run
+	if (BikeMovement && BikeMovement->bInterpolateVisuals && BikeMovement->GetSimulationStepCount() <= SteeringLatencyStep)
+	{
+		return;
+	}
+
+	if (SteeringLatency.MarkPresented(FPlatformTime::Seconds(), GFrameCounter))
+	{
+		const FInputLatencySample& Sample = *SteeringLatency.GetLastSample();
+		FBikeTelemetry::Get().Record(EBikeTelemetryEvent::InputLatency, FIntVector::ZeroValue,
+			static_cast<uint8>(FMath::Clamp(Sample.GetFrameDelay(), 0, 255)), 0,
+			FMath::RoundToInt(Sample.GetInputToUpdateMs() * 1000.0), static_cast<float>(Sample.GetInputToPresentMs()));
+	}
 }
 
 void ABikeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -103,6 +173,11 @@ void ABikeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompo
 void ABikeCharacter::HandleTurnInput(float Value)
 {
         SteeringInput = FMath::Clamp(Value, -1.0f, 1.0f);
+
+        if (bTrackInputLatency)
+        {
+                SteeringLatency.MarkInput(SteeringInput, FPlatformTime::Seconds(), GFrameCounter);
+        }
 }
 
 void ABikeCharacter::HandleThrottleInput(float Value)
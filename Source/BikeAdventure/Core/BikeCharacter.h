@@ -6,10 +6,12 @@
 #include "Components/CapsuleComponent.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "Systems/InputLatencyTracker.h"
 #include "BikeCharacter.generated.h"
 
 class UBikeMovementComponent;
 class AIntersection;
+class UDiscoverySystem;
 
 /**
  * Physics-based bike character for meditative exploration
@@ -27,6 +29,9 @@ protected:
 	/** Called when the game starts or when spawned */
 	virtual void BeginPlay() override;
 
+	/** Called when the bike is removed from the world */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Called every frame */
 	virtual void Tick(float DeltaTime) override;
 
@@ -111,6 +116,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gameplay")
 	AIntersection* GetCurrentIntersection() const { return CurrentIntersection; }
 
+	/** Average time from a steering change to the frame that presented its effect, in milliseconds */
+	UFUNCTION(BlueprintCallable, Category = "Input|Latency")
+	float GetAverageSteeringLatencyMs() const { return static_cast<float>(SteeringLatency.GetAverageInputToPresentMs()); }
+
+	/** Steering input-to-motion measurements */
+	const FInputLatencyTracker& GetSteeringLatency() const { return SteeringLatency; }
+
+	/** Timestamp steering changes through the movement update to the presented transform */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input|Latency")
+	bool bTrackInputLatency = true;
+
 protected:
         /** Current intersection the bike is at (null if not at intersection) */
         UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Gameplay")
@@ -128,6 +144,21 @@ private:
 	/** Set up default component values and relationships */
 	void SetupComponents();
 
+	/** Push cached input into the movement component and step it, timestamping the first step after a steering change */
+	void ApplyInputAndMove(float DeltaTime);
+
+	/** End of actor ticking for the frame; transforms now go to rendering */
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	FInputLatencyTracker SteeringLatency;
+
+	/** Simulation step that consumed the open steering measurement's input */
+	int32 SteeringLatencyStep = INDEX_NONE;
+	FDelegateHandle PostActorTickHandle;
+
+	/** Game mode's discovery system, fed the bike position after every move */
+	TWeakObjectPtr<UDiscoverySystem> DiscoverySystem;
+
 	/** Handle intersection overlap events */
 	UFUNCTION()
 	void OnCapsuleBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
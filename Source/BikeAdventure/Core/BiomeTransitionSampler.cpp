@@ -0,0 +1,200 @@
+#include "BiomeTransitionSampler.h"
+
+FBiomeHistorySignature FBiomeHistorySignature::FromHistory(EBiomeType CurrentBiome, const TArray<EBiomeType>& RecentBiomes)
+{
+    FBiomeHistorySignature Signature;
+    if (RecentBiomes.Num() > 0)
+    {
+        Signature.PreviousBiome = RecentBiomes.Last();
+        for (int32 i = RecentBiomes.Num() - 1; i >= 0 && RecentBiomes[i] == CurrentBiome; i--)
+        {
+            Signature.ConsecutiveCount++;
+        }
+    }
+    return Signature;
+}
+
+FBiomeTransitionSampler::FAliasTableCache::FAliasTableCache()
+{
+    for (int32 BiomeIndex = 0; BiomeIndex < BiomeTables::NumBiomes; ++BiomeIndex)
+    {
+        for (int32 Mask = 0; Mask < NumMasks; ++Mask)
+        {
+            BuildAliasTable(static_cast<EBiomeType>(BiomeIndex), static_cast<uint8>(Mask), Tables[BiomeIndex][Mask]);
+        }
+    }
+}
+
+const FBiomeTransitionSampler::FAliasTableCache& FBiomeTransitionSampler::GetCache()
+{
+    static const FAliasTableCache Cache;
+    return Cache;
+}
+
+void FBiomeTransitionSampler::BuildAliasTable(EBiomeType CurrentBiome, uint8 ExcludedMask, FAliasTable& OutTable)
+{
+    const int32 BiomeIndex = static_cast<int32>(CurrentBiome);
+    const EBiomeType* Transitions = BiomeTables::Transitions[BiomeIndex];
+    const int32 NumTransitions = BiomeTables::TransitionCounts[BiomeIndex];
+
+    OutTable.NumOutcomes = 0;
+    for (int32 i = 0; i < NumTransitions; ++i)
+    {
+        if ((BiomeTables::BiomeBit(Transitions[i]) & ExcludedMask) == 0)
+        {
+            OutTable.Outcome[OutTable.NumOutcomes++] = Transitions[i];
+        }
+    }
+
+    if (OutTable.NumOutcomes == 0)
+    {
+        // Fallback to any valid transition if no options remain
+        for (int32 i = 0; i < NumTransitions; ++i)
+        {
+            OutTable.Outcome[OutTable.NumOutcomes++] = Transitions[i];
+        }
+    }
+
+    // Vose's alias method over the candidate weights. Distribution version 1 weights
+    // every candidate equally, which yields Probability = 1 and Alias = self for every
+    // column; the general construction is kept so weighted versions only change Weights.
+    const int32 N = OutTable.NumOutcomes;
+    float Scaled[BiomeTables::MaxTransitionsPerBiome];
+    int32 Small[BiomeTables::MaxTransitionsPerBiome];
+    int32 Large[BiomeTables::MaxTransitionsPerBiome];
+    int32 NumSmall = 0;
+    int32 NumLarge = 0;
+
+    float Weights[BiomeTables::MaxTransitionsPerBiome];
+    float TotalWeight = 0.0f;
+    for (int32 i = 0; i < N; ++i)
+    {
+        Weights[i] = 1.0f;
+        TotalWeight += Weights[i];
+    }
+
+    for (int32 i = 0; i < N; ++i)
+    {
+        Scaled[i] = Weights[i] * N / TotalWeight;
+        OutTable.Alias[i] = static_cast<uint8>(i);
+        if (Scaled[i] < 1.0f)
+        {
+            Small[NumSmall++] = i;
+        }
+        else
+        {
+            Large[NumLarge++] = i;
+        }
+    }
+
+    while (NumSmall > 0 && NumLarge > 0)
+    {
+        const int32 Less = Small[--NumSmall];
+        const int32 More = Large[--NumLarge];
+
+        OutTable.Probability[Less] = Scaled[Less];
+        OutTable.Alias[Less] = static_cast<uint8>(More);
+
+        Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0f;
+        if (Scaled[More] < 1.0f)
+        {
+            Small[NumSmall++] = More;
+        }
+        else
+        {
+            Large[NumLarge++] = More;
+        }
+    }
+
+    while (NumLarge > 0)
+    {
+        OutTable.Probability[Large[--NumLarge]] = 1.0f;
+    }
+
+    while (NumSmall > 0)
+    {
+        OutTable.Probability[Small[--NumSmall]] = 1.0f;
+    }
+}
+
+uint8 FBiomeTransitionSampler::GetExcludedMask(EBiomeType CurrentBiome, const FBiomeHistorySignature& History)
+{
+    const FBiomeTransitionRules& Rules = UBiomeUtilities::GetDefaultTransitionRulesRef(CurrentBiome);
+
+    // An empty history has PreviousBiome None (no bit) and a zero run, so it excludes nothing
+    uint8 ExcludedMask = 0;
+    if (!Rules.bAllowImmediateReturn)
+    {
+        ExcludedMask |= BiomeTables::BiomeBit(History.PreviousBiome);
+    }
+
+    if (History.ConsecutiveCount >= Rules.MaxConsecutiveSameBiome)
+    {
+        ExcludedMask |= BiomeTables::BiomeBit(CurrentBiome);
+    }
+
+    return ExcludedMask;
+}
+
+EBiomeType FBiomeTransitionSampler::Sample(EBiomeType CurrentBiome, const FBiomeHistorySignature& History, float UniformSample)
+{
+    if (!BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        // Ultimate fallback
+        return EBiomeType::Countryside;
+    }
+
+    const FAliasTable& Table = GetCache().Tables[static_cast<int32>(CurrentBiome)][GetExcludedMask(CurrentBiome, History)];
+
+    // Same column selection as FMath::RandRange(0, N - 1) for the same uniform draw
+    const float ScaledSample = UniformSample * static_cast<float>(Table.NumOutcomes);
+    const int32 Column = FMath::Min(FMath::TruncToInt(ScaledSample), Table.NumOutcomes - 1);
+    const float Fraction = ScaledSample - static_cast<float>(Column);
+
+    return Fraction < Table.Probability[Column] ? Table.Outcome[Column] : Table.Outcome[Table.Alias[Column]];
+}
+
+EBiomeType FBiomeTransitionSampler::Sample(EBiomeType CurrentBiome, const FBiomeHistorySignature& History)
+{
+    if (!BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        return EBiomeType::Countryside;
+    }
+
+    return Sample(CurrentBiome, History, FMath::FRand());
+}
+
+EBiomeType FBiomeTransitionSampler::Sample(EBiomeType CurrentBiome, const FBiomeHistorySignature& History, FRandomStream& Stream)
+{
+    if (!BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        return EBiomeType::Countryside;
+    }
+
+    return Sample(CurrentBiome, History, Stream.GetFraction());
+}
+
+float FBiomeTransitionSampler::GetSampleProbability(EBiomeType CurrentBiome, EBiomeType TargetBiome, const FBiomeHistorySignature& History)
+{
+    if (!BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        return TargetBiome == EBiomeType::Countryside ? 1.0f : 0.0f;
+    }
+
+    const FAliasTable& Table = GetCache().Tables[static_cast<int32>(CurrentBiome)][GetExcludedMask(CurrentBiome, History)];
+
+    float Probability = 0.0f;
+    for (int32 Column = 0; Column < Table.NumOutcomes; ++Column)
+    {
+        if (Table.Outcome[Column] == TargetBiome)
+        {
+            Probability += Table.Probability[Column];
+        }
+        if (Table.Outcome[Table.Alias[Column]] == TargetBiome)
+        {
+            Probability += 1.0f - Table.Probability[Column];
+        }
+    }
+
+    return Probability / static_cast<float>(Table.NumOutcomes);
+}
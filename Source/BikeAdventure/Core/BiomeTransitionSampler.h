@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BiomeTypes.h"
+
+/**
+ * Compact summary of recent biome history.
+ * The transition rules only look at the previous biome and the length of the
+ * trailing run of the current biome, so this is all a sampler needs.
+ */
+struct BIKEADVENTURE_API FBiomeHistorySignature
+{
+    /** Most recent biome in the history, None when the history is empty */
+    EBiomeType PreviousBiome = EBiomeType::None;
+
+    /** Number of trailing history entries equal to the current biome */
+    int32 ConsecutiveCount = 0;
+
+    FBiomeHistorySignature() = default;
+
+    FBiomeHistorySignature(EBiomeType InPreviousBiome, int32 InConsecutiveCount)
+        : PreviousBiome(InPreviousBiome)
+        , ConsecutiveCount(InConsecutiveCount)
+    {
+    }
+
+    /** Summarise a full history array relative to CurrentBiome */
+    static FBiomeHistorySignature FromHistory(EBiomeType CurrentBiome, const TArray<EBiomeType>& RecentBiomes);
+
+    /** Signature of a single-entry history, avoiding a temporary TArray */
+    static FBiomeHistorySignature FromSingle(EBiomeType CurrentBiome, EBiomeType PreviousBiome)
+    {
+        return FBiomeHistorySignature(PreviousBiome, PreviousBiome == CurrentBiome ? 1 : 0);
+    }
+};
+
+/**
+ * Allocation-free biome transition sampler.
+ * One alias table is precomputed for every (current biome, excluded-candidate mask)
+ * pair the transition rules can produce, so sampling is a table lookup plus one
+ * uniform draw. Under the same uniform value it selects exactly the candidate the
+ * previous candidate-array implementation selected via FMath::RandRange.
+ */
+class BIKEADVENTURE_API FBiomeTransitionSampler
+{
+public:
+    /**
+     * Version of the sampled distribution. 1 = uniform over rule-filtered candidates,
+     * in BiomeTables::Transitions order. Bump whenever weights or ordering change,
+     * since seeded worlds will no longer reproduce.
+     */
+    static constexpr int32 DistributionVersion = 1;
+
+    /**
+     * Sample the next biome using a caller-supplied uniform value in [0, 1)
+     * @return Next biome, or Countryside when CurrentBiome has no transitions
+     */
+    static EBiomeType Sample(EBiomeType CurrentBiome, const FBiomeHistorySignature& History, float UniformSample);
+
+    /** Sample using the global FMath random stream */
+    static EBiomeType Sample(EBiomeType CurrentBiome, const FBiomeHistorySignature& History);
+
+    /** Sample using a deterministic stream */
+    static EBiomeType Sample(EBiomeType CurrentBiome, const FBiomeHistorySignature& History, FRandomStream& Stream);
+
+    /** Candidates excluded by the transition rules for this history, as a BiomeTables::BiomeBit mask */
+    static uint8 GetExcludedMask(EBiomeType CurrentBiome, const FBiomeHistorySignature& History);
+
+    /** Probability that Sample returns TargetBiome for this history */
+    static float GetSampleProbability(EBiomeType CurrentBiome, EBiomeType TargetBiome, const FBiomeHistorySignature& History);
+
+private:
+    struct FAliasTable
+    {
+        float Probability[BiomeTables::MaxTransitionsPerBiome];
+        uint8 Alias[BiomeTables::MaxTransitionsPerBiome];
+        EBiomeType Outcome[BiomeTables::MaxTransitionsPerBiome];
+        int32 NumOutcomes;
+    };
+
+    static constexpr int32 NumMasks = 1 << BiomeTables::NumBiomes;
+
+    /** Tables for every biome and exclusion mask, built once on first use */
+    struct FAliasTableCache
+    {
+        FAliasTable Tables[BiomeTables::NumBiomes][NumMasks];
+
+        FAliasTableCache();
+    };
+
+    static const FAliasTableCache& GetCache();
+
+    static void BuildAliasTable(EBiomeType CurrentBiome, uint8 ExcludedMask, FAliasTable& OutTable);
+};
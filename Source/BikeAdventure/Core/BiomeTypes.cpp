@@ -1,268 +1,92 @@
 #include "BiomeTypes.h"
+#include "BiomeTransitionSampler.h"
 #include "Engine/Engine.h"
 
-FString UBiomeUtilities::GetBiomeName(EBiomeType BiomeType)
+namespace
 {
-    switch(BiomeType)
+    // Index NumBiomes holds the fallback entry used for EBiomeType::None
+    FORCEINLINE int32 TableIndex(EBiomeType BiomeType)
+    {
+        return BiomeTables::IsValidBiome(BiomeType) ? static_cast<int32>(BiomeType) : BiomeTables::NumBiomes;
+    }
+
+    struct FBiomeDefaultsCache
+    {
+        FString Names[BiomeTables::NumBiomes + 1];
+        FBiomeGenerationParams Params[BiomeTables::NumBiomes + 1];
+        FBiomeTransitionRules Rules[BiomeTables::NumBiomes + 1];
+
+        FBiomeDefaultsCache()
+        {
+            for (int32 Index = 0; Index <= BiomeTables::NumBiomes; ++Index)
+            {
+                Names[Index] = BiomeTables::Names[Index];
+            }
+
+            for (int32 Index = 0; Index < BiomeTables::NumBiomes; ++Index)
+            {
+                const BiomeTables::FParamsRow& Row = BiomeTables::DefaultParams[Index];
+                FBiomeGenerationParams& BiomeParams = Params[Index];
+                BiomeParams.VegetationDensity = Row.VegetationDensity;
+                BiomeParams.RockDensity = Row.RockDensity;
+                BiomeParams.PathWindiness = Row.PathWindiness;
+                BiomeParams.PathWidth = Row.PathWidth;
+                BiomeParams.DetailObjectDensity = Row.DetailObjectDensity;
+                BiomeParams.WildlifeSpawnRate = Row.WildlifeSpawnRate;
+                BiomeParams.WeatherEventProbability = Row.WeatherEventProbability;
+
+                FBiomeTransitionRules& BiomeRules = Rules[Index];
+                BiomeRules.ValidTransitions.Append(BiomeTables::Transitions[Index], BiomeTables::TransitionCounts[Index]);
+                BiomeRules.PreferredIntersectionTypes.Append(BiomeTables::PreferredIntersections[Index], BiomeTables::PreferredIntersectionCounts[Index]);
+            }
+        }
+    };
+
+    const FBiomeDefaultsCache& GetBiomeDefaults()
     {
-        case EBiomeType::Forest:
-            return TEXT("Forest");
-        case EBiomeType::Beach:
-            return TEXT("Beach");
-        case EBiomeType::Desert:
-            return TEXT("Desert");
-        case EBiomeType::Urban:
-            return TEXT("Urban");
-        case EBiomeType::Countryside:
-            return TEXT("Countryside");
-        case EBiomeType::Mountains:
-            return TEXT("Mountains");
-        case EBiomeType::Wetlands:
-            return TEXT("Wetlands");
-        default:
-            return TEXT("Unknown");
+        static const FBiomeDefaultsCache Cache;
+        return Cache;
     }
 }
 
+FString UBiomeUtilities::GetBiomeName(EBiomeType BiomeType)
+{
+    return GetBiomeNameRef(BiomeType);
+}
+
 FBiomeGenerationParams UBiomeUtilities::GetDefaultBiomeParams(EBiomeType BiomeType)
 {
-    FBiomeGenerationParams Params;
-    
-    switch(BiomeType)
-    {
-        case EBiomeType::Forest:
-            Params.VegetationDensity = 0.85f;
-            Params.RockDensity = 0.2f;
-            Params.PathWindiness = 0.75f;
-            Params.PathWidth = 350.0f;
-            Params.DetailObjectDensity = 0.8f;
-            Params.WildlifeSpawnRate = 0.4f;
-            Params.WeatherEventProbability = 0.2f;
-            break;
-            
-        case EBiomeType::Beach:
-            Params.VegetationDensity = 0.2f;
-            Params.RockDensity = 0.4f;
-            Params.PathWindiness = 0.3f;
-            Params.PathWidth = 450.0f;
-            Params.DetailObjectDensity = 0.3f;
-            Params.WildlifeSpawnRate = 0.25f;
-            Params.WeatherEventProbability = 0.35f;
-            break;
-            
-        case EBiomeType::Desert:
-            Params.VegetationDensity = 0.15f;
-            Params.RockDensity = 0.6f;
-            Params.PathWindiness = 0.2f;
-            Params.PathWidth = 500.0f;
-            Params.DetailObjectDensity = 0.2f;
-            Params.WildlifeSpawnRate = 0.1f;
-            Params.WeatherEventProbability = 0.1f;
-            break;
-            
-        case EBiomeType::Urban:
-            Params.VegetationDensity = 0.4f;
-            Params.RockDensity = 0.1f;
-            Params.PathWindiness = 0.1f;
-            Params.PathWidth = 600.0f;
-            Params.DetailObjectDensity = 0.9f;
-            Params.WildlifeSpawnRate = 0.05f;
-            Params.WeatherEventProbability = 0.05f;
-            break;
-            
-        case EBiomeType::Countryside:
-            Params.VegetationDensity = 0.6f;
-            Params.RockDensity = 0.2f;
-            Params.PathWindiness = 0.4f;
-            Params.PathWidth = 400.0f;
-            Params.DetailObjectDensity = 0.5f;
-            Params.WildlifeSpawnRate = 0.3f;
-            Params.WeatherEventProbability = 0.15f;
-            break;
-            
-        case EBiomeType::Mountains:
-            Params.VegetationDensity = 0.3f;
-            Params.RockDensity = 0.8f;
-            Params.PathWindiness = 0.6f;
-            Params.PathWidth = 300.0f;
-            Params.DetailObjectDensity = 0.4f;
-            Params.WildlifeSpawnRate = 0.2f;
-            Params.WeatherEventProbability = 0.4f;
-            break;
-            
-        case EBiomeType::Wetlands:
-            Params.VegetationDensity = 0.7f;
-            Params.RockDensity = 0.1f;
-            Params.PathWindiness = 0.8f;
-            Params.PathWidth = 320.0f;
-            Params.DetailObjectDensity = 0.6f;
-            Params.WildlifeSpawnRate = 0.5f;
-            Params.WeatherEventProbability = 0.3f;
-            break;
-            
-        default:
-            // Default parameters already set in constructor
-            break;
-    }
-    
-    return Params;
+    return GetDefaultBiomeParamsRef(BiomeType);
 }
 
 FBiomeTransitionRules UBiomeUtilities::GetDefaultTransitionRules(EBiomeType BiomeType)
 {
-    FBiomeTransitionRules Rules;
-    
-    switch(BiomeType)
-    {
-        case EBiomeType::Forest:
-            Rules.ValidTransitions = {
-                EBiomeType::Mountains, 
-                EBiomeType::Countryside, 
-                EBiomeType::Wetlands
-            };
-            Rules.PreferredIntersectionTypes = {
-                EIntersectionType::YFork, 
-                EIntersectionType::CaveEntrance
-            };
-            break;
-            
-        case EBiomeType::Beach:
-            Rules.ValidTransitions = {
-                EBiomeType::Urban, 
-                EBiomeType::Countryside, 
-                EBiomeType::Wetlands
-            };
-            Rules.PreferredIntersectionTypes = {
-                EIntersectionType::Boardwalk, 
-                EIntersectionType::Bridge
-            };
-            break;
-            
-        case EBiomeType::Desert:
-            Rules.ValidTransitions = {
-                EBiomeType::Mountains, 
-                EBiomeType::Urban, 
-                EBiomeType::Countryside
-            };
-            Rules.PreferredIntersectionTypes = {
-                EIntersectionType::RockPass, 
-                EIntersectionType::YFork
-            };
-            break;
-            
-        case EBiomeType::Urban:
-            Rules.ValidTransitions = {
-                EBiomeType::Beach, 
-                EBiomeType::Desert, 
-                EBiomeType::Countryside
-            };
-            Rules.PreferredIntersectionTypes = {
-                EIntersectionType::Roundabout, 
-                EIntersectionType::TJunction
-            };
-            break;
-            
-        case EBiomeType::Countryside:
-            Rules.ValidTransitions = {
-                EBiomeType::Forest, 
-                EBiomeType::Beach, 
-                EBiomeType::Desert, 
-                EBiomeType::Urban, 
-                EBiomeType::Mountains
-            };
-            Rules.PreferredIntersectionTypes = {
-                EIntersectionType::TJunction, 
-                EIntersectionType::YFork, 
-                EIntersectionType::Bridge
-            };
-            break;
-            
-        case EBiomeType::Mountains:
-            Rules.ValidTransitions = {
-                EBiomeType::Forest, 
-                EBiomeType::Desert, 
-                EBiomeType::Countryside
-            };
-            Rules.PreferredIntersectionTypes = {
-                EIntersectionType::RockPass, 
-                EIntersectionType::Bridge, 
-                EIntersectionType::CaveEntrance
-            };
-            break;
-            
-        case EBiomeType::Wetlands:
-            Rules.ValidTransitions = {
-                EBiomeType::Forest, 
-                EBiomeType::Beach, 
-                EBiomeType::Countryside
-            };
-            Rules.PreferredIntersectionTypes = {
-                EIntersectionType::RiverCrossing, 
-                EIntersectionType::Bridge, 
-                EIntersectionType::Boardwalk
-            };
-            break;
-            
-        default:
-            // No valid transitions for unknown biomes
-            break;
-    }
-    
-    return Rules;
+    return GetDefaultTransitionRulesRef(BiomeType);
+}
+
+const FString& UBiomeUtilities::GetBiomeNameRef(EBiomeType BiomeType)
+{
+    return GetBiomeDefaults().Names[TableIndex(BiomeType)];
+}
+
+const FBiomeGenerationParams& UBiomeUtilities::GetDefaultBiomeParamsRef(EBiomeType BiomeType)
+{
+    return GetBiomeDefaults().Params[TableIndex(BiomeType)];
+}
+
+const FBiomeTransitionRules& UBiomeUtilities::GetDefaultTransitionRulesRef(EBiomeType BiomeType)
+{
+    return GetBiomeDefaults().Rules[TableIndex(BiomeType)];
 }
 
 bool UBiomeUtilities::CanBiomesTransition(EBiomeType FromBiome, EBiomeType ToBiome)
 {
-    if(FromBiome == EBiomeType::None || ToBiome == EBiomeType::None)
-    {
-        return false;
-    }
-    
-    FBiomeTransitionRules Rules = GetDefaultTransitionRules(FromBiome);
-    return Rules.ValidTransitions.Contains(ToBiome);
+    return BiomeTables::CanTransition(FromBiome, ToBiome);
 }
 
 EBiomeType UBiomeUtilities::GetRandomValidTransition(EBiomeType CurrentBiome, const TArray<EBiomeType>& RecentBiomes)
 {
-    FBiomeTransitionRules Rules = GetDefaultTransitionRules(CurrentBiome);
-    TArray<EBiomeType> ValidOptions = Rules.ValidTransitions;
-    
-    // Remove recently visited biomes to avoid repetition
-    if(RecentBiomes.Num() > 0)
-    {
-        EBiomeType PreviousBiome = RecentBiomes.Last();
-        if(!Rules.bAllowImmediateReturn)
-        {
-            ValidOptions.Remove(PreviousBiome);
-        }
-        
-        // Apply consecutive biome penalty
-        int32 ConsecutiveCount = 0;
-        for(int32 i = RecentBiomes.Num() - 1; i >= 0 && RecentBiomes[i] == CurrentBiome; i--)
-        {
-            ConsecutiveCount++;
-        }
-        
-        if(ConsecutiveCount >= Rules.MaxConsecutiveSameBiome)
-        {
-            ValidOptions.Remove(CurrentBiome);
-        }
-    }
-    
-    if(ValidOptions.Num() == 0)
-    {
-        // Fallback to any valid transition if no options remain
-        ValidOptions = Rules.ValidTransitions;
-    }
-    
-    if(ValidOptions.Num() == 0)
-    {
-        // Ultimate fallback
-        return EBiomeType::Countryside;
-    }
-    
-    int32 RandomIndex = FMath::RandRange(0, ValidOptions.Num() - 1);
-    return ValidOptions[RandomIndex];
+    return FBiomeTransitionSampler::Sample(CurrentBiome, FBiomeHistorySignature::FromHistory(CurrentBiome, RecentBiomes));
 }
 
 float UBiomeUtilities::CalculateTransitionProbability(EBiomeType CurrentBiome, EBiomeType TargetBiome, const TArray<EBiomeType>& RecentBiomes)
@@ -272,22 +96,16 @@ float UBiomeUtilities::CalculateTransitionProbability(EBiomeType CurrentBiome, E
         return 0.0f;
     }
     
-    FBiomeTransitionRules Rules = GetDefaultTransitionRules(CurrentBiome);
+    const FBiomeTransitionRules& Rules = GetDefaultTransitionRulesRef(CurrentBiome);
+    const FBiomeHistorySignature History = FBiomeHistorySignature::FromHistory(CurrentBiome, RecentBiomes);
     float Probability = Rules.BaseTransitionProbability;
     
-    // Calculate consecutive biome penalty
-    int32 ConsecutiveCount = 0;
-    for(int32 i = RecentBiomes.Num() - 1; i >= 0 && RecentBiomes[i] == CurrentBiome; i--)
-    {
-        ConsecutiveCount++;
-    }
-    
     if(TargetBiome == CurrentBiome)
     {
         // Penalize staying in the same biome
-        Probability *= FMath::Pow(Rules.ConsecutiveBiomePenalty, ConsecutiveCount);
+        Probability *= FMath::Pow(Rules.ConsecutiveBiomePenalty, History.ConsecutiveCount);
     }
-    else if(RecentBiomes.Num() > 0 && TargetBiome == RecentBiomes.Last() && !Rules.bAllowImmediateReturn)
+    else if(RecentBiomes.Num() > 0 && TargetBiome == History.PreviousBiome && !Rules.bAllowImmediateReturn)
     {
         // Penalize immediate return to previous biome
         Probability *= 0.1f;
@@ -213,6 +213,111 @@ struct BIKEADVENTURE_API FPathHints
     TArray<TSoftObjectPtr<class AActor>> RightPathVisualHints;
 };
 
+/**
+ * Compile-time biome lookup tables indexed by EBiomeType.
+ * UBiomeUtilities builds its struct-returning helpers from these once; hot paths
+ * should prefer the const-reference accessors or the raw tables directly.
+ */
+namespace BiomeTables
+{
+    constexpr int32 NumBiomes = static_cast<int32>(EBiomeType::None);
+    constexpr int32 MaxTransitionsPerBiome = 5;
+    constexpr int32 MaxIntersectionsPerBiome = 3;
+
+    constexpr bool IsValidBiome(EBiomeType Biome)
+    {
+        return static_cast<uint8>(Biome) < NumBiomes;
+    }
+
+    constexpr uint8 BiomeBit(EBiomeType Biome)
+    {
+        return IsValidBiome(Biome) ? static_cast<uint8>(1u << static_cast<uint8>(Biome)) : 0;
+    }
+
+    /** Ordered transition targets per biome; order is significant for seeded selection */
+    constexpr EBiomeType Transitions[NumBiomes][MaxTransitionsPerBiome] =
+    {
+        /* Forest */      { EBiomeType::Mountains, EBiomeType::Countryside, EBiomeType::Wetlands },
+        /* Beach */       { EBiomeType::Urban, EBiomeType::Countryside, EBiomeType::Wetlands },
+        /* Desert */      { EBiomeType::Mountains, EBiomeType::Urban, EBiomeType::Countryside },
+        /* Urban */       { EBiomeType::Beach, EBiomeType::Desert, EBiomeType::Countryside },
+        /* Countryside */ { EBiomeType::Forest, EBiomeType::Beach, EBiomeType::Desert, EBiomeType::Urban, EBiomeType::Mountains },
+        /* Mountains */   { EBiomeType::Forest, EBiomeType::Desert, EBiomeType::Countryside },
+        /* Wetlands */    { EBiomeType::Forest, EBiomeType::Beach, EBiomeType::Countryside }
+    };
+
+    constexpr int32 TransitionCounts[NumBiomes] = { 3, 3, 3, 3, 5, 3, 3 };
+
+    constexpr uint8 BuildTransitionMask(int32 BiomeIndex)
+    {
+        uint8 Mask = 0;
+        for (int32 i = 0; i < TransitionCounts[BiomeIndex]; ++i)
+        {
+            Mask |= BiomeBit(Transitions[BiomeIndex][i]);
+        }
+        return Mask;
+    }
+
+    /** Adjacency bitmask: bit N set when the biome can transition to EBiomeType(N) */
+    constexpr uint8 TransitionMasks[NumBiomes] =
+    {
+        BuildTransitionMask(0), BuildTransitionMask(1), BuildTransitionMask(2), BuildTransitionMask(3),
+        BuildTransitionMask(4), BuildTransitionMask(5), BuildTransitionMask(6)
+    };
+
+    constexpr EIntersectionType PreferredIntersections[NumBiomes][MaxIntersectionsPerBiome] =
+    {
+        /* Forest */      { EIntersectionType::YFork, EIntersectionType::CaveEntrance },
+        /* Beach */       { EIntersectionType::Boardwalk, EIntersectionType::Bridge },
+        /* Desert */      { EIntersectionType::RockPass, EIntersectionType::YFork },
+        /* Urban */       { EIntersectionType::Roundabout, EIntersectionType::TJunction },
+        /* Countryside */ { EIntersectionType::TJunction, EIntersectionType::YFork, EIntersectionType::Bridge },
+        /* Mountains */   { EIntersectionType::RockPass, EIntersectionType::Bridge, EIntersectionType::CaveEntrance },
+        /* Wetlands */    { EIntersectionType::RiverCrossing, EIntersectionType::Bridge, EIntersectionType::Boardwalk }
+    };
+
+    constexpr int32 PreferredIntersectionCounts[NumBiomes] = { 2, 2, 2, 2, 3, 3, 3 };
+
+    /** Scalar generation parameters; asset lists stay on FBiomeGenerationParams */
+    struct FParamsRow
+    {
+        float VegetationDensity;
+        float RockDensity;
+        float PathWindiness;
+        float PathWidth;
+        float DetailObjectDensity;
+        float WildlifeSpawnRate;
+        float WeatherEventProbability;
+    };
+
+    constexpr FParamsRow DefaultParams[NumBiomes] =
+    {
+        /* Forest */      { 0.85f, 0.2f, 0.75f, 350.0f, 0.8f, 0.4f, 0.2f },
+        /* Beach */       { 0.2f, 0.4f, 0.3f, 450.0f, 0.3f, 0.25f, 0.35f },
+        /* Desert */      { 0.15f, 0.6f, 0.2f, 500.0f, 0.2f, 0.1f, 0.1f },
+        /* Urban */       { 0.4f, 0.1f, 0.1f, 600.0f, 0.9f, 0.05f, 0.05f },
+        /* Countryside */ { 0.6f, 0.2f, 0.4f, 400.0f, 0.5f, 0.3f, 0.15f },
+        /* Mountains */   { 0.3f, 0.8f, 0.6f, 300.0f, 0.4f, 0.2f, 0.4f },
+        /* Wetlands */    { 0.7f, 0.1f, 0.8f, 320.0f, 0.6f, 0.5f, 0.3f }
+    };
+
+    constexpr const TCHAR* Names[NumBiomes + 1] =
+    {
+        TEXT("Forest"), TEXT("Beach"), TEXT("Desert"), TEXT("Urban"), TEXT("Countryside"), TEXT("Mountains"), TEXT("Wetlands"),
+        TEXT("Unknown")
+    };
+
+    /** Single bit test against the adjacency mask */
+    constexpr bool CanTransition(EBiomeType FromBiome, EBiomeType ToBiome)
+    {
+        return IsValidBiome(FromBiome) && (TransitionMasks[static_cast<uint8>(FromBiome)] & BiomeBit(ToBiome)) != 0;
+    }
+
+    static_assert(CanTransition(EBiomeType::Forest, EBiomeType::Wetlands), "Forest should lead to Wetlands");
+    static_assert(!CanTransition(EBiomeType::Forest, EBiomeType::Urban), "Forest should not lead to Urban");
+    static_assert(!CanTransition(EBiomeType::None, EBiomeType::Forest), "None has no transitions");
+}
+
 /**
  * Utility class for biome-related functionality
  */
@@ -257,4 +362,15 @@ public:
      */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Biome Utilities")
     static float CalculateTransitionProbability(EBiomeType CurrentBiome, EBiomeType TargetBiome, const TArray<EBiomeType>& RecentBiomes);
+
+    // Allocation-free accessors for C++ hot paths. Results are built once from BiomeTables and shared.
+
+    /** Interned biome name, "Unknown" for None */
+    static const FString& GetBiomeNameRef(EBiomeType BiomeType);
+
+    /** Shared default generation parameters; None returns the constructor defaults */
+    static const FBiomeGenerationParams& GetDefaultBiomeParamsRef(EBiomeType BiomeType);
+
+    /** Shared default transition rules; None returns rules with no transitions */
+    static const FBiomeTransitionRules& GetDefaultTransitionRulesRef(EBiomeType BiomeType);
 };
\ No newline at end of file
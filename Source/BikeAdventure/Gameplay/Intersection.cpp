@@ -7,14 +7,22 @@
 #include "NiagaraSystem.h"
 #include "Sound/SoundCue.h"
 #include "Materials/MaterialInterface.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
 #include "Engine/StaticMesh.h"
 #include "Core/BikeAdventureGameMode.h"
+#include "Systems/BikeSaveSubsystem.h"
 #include "Systems/DiscoverySystem.h"
+#include "Systems/IntersectionAssetPrefetcher.h"
+#include "Systems/IntersectionManager.h"
+#include "Systems/PathHintMaterialCache.h"
 
 AIntersection::AIntersection()
 {
+    // Idle intersections cost nothing per frame; ticking is enabled only while the player is inside
     PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 
     // Create root scene component
     RootSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootSceneComponent"));
@@ -46,6 +54,7 @@ AIntersection::AIntersection()
     // Create environmental effect component
     EnvironmentalEffect = CreateDefaultSubobject<UNiagaraComponent>(TEXT("EnvironmentalEffect"));
     EnvironmentalEffect->SetupAttachment(RootComponent);
+    EnvironmentalEffect->bAutoActivate = false; // Activated while the player is inside
 
     // Create ambient audio component
     AmbientAudio = CreateDefaultSubobject<UAudioComponent>(TEXT("AmbientAudio"));
@@ -58,6 +67,10 @@ AIntersection::AIntersection()
     RightPathBiome = EBiomeType::Countryside;
     bPlayerPresent = false;
     bChoiceMade = false;
+    PlaceholderIntersectionMesh = nullptr;
+    bApplyingLoadedAssets = false;
+    LeftHintMaterial = nullptr;
+    RightHintMaterial = nullptr;
 
     // Set default path directions (45-degree angles)
     LeftPathDirection = FVector(0.707f, -0.707f, 0.0f);  // Left-forward
@@ -76,16 +89,63 @@ void AIntersection::BeginPlay()
     UpdateVisualAppearance();
     UpdatePathHints();
     CalculatePathDirections();
+
+    if (UIntersectionManager* Manager = GetIntersectionManager())
+    {
+        Manager->RegisterIntersection(this);
+    }
+}
+
+UIntersectionManager* AIntersection::GetIntersectionManager() const
+{
+    UWorld* World = GetWorld();
+    ABikeAdventureGameMode* GameMode = World ? Cast<ABikeAdventureGameMode>(World->GetAuthGameMode()) : nullptr;
+    return GameMode ? GameMode->GetIntersectionManager() : nullptr;
+}
+
+void AIntersection::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    for (TSharedPtr<FStreamableHandle>& Handle : PendingAssetHandles)
+    {
+        if (Handle.IsValid())
+        {
+            Handle->CancelHandle();
+        }
+    }
+    PendingAssetHandles.Empty();
+
+    ReleasePathHintMaterials();
+
+    if (UIntersectionManager* Manager = GetIntersectionManager())
+    {
+        Manager->UnregisterIntersection(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AIntersection::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    // Update any dynamic visual effects here if needed
-    if (bPlayerPresent && !bChoiceMade)
+    // Hint pulsing runs in the indicator material off material time (see SetHintPulseActive),
+    // so only per-visit logic belongs here
+}
+
+void AIntersection::SetHintPulseActive(bool bActive)
+{
+    // Indicator materials scale their time-driven pulse by this custom primitive data slot,
+    // which keeps shared hint materials shared and needs no per-frame update
+    const float PulseScale = bActive ? 1.0f : 0.0f;
+
+    if (LeftPathIndicator)
+    {
+        LeftPathIndicator->SetCustomPrimitiveDataFloat(HintPulseDataIndex, PulseScale);
+    }
+
+    if (RightPathIndicator)
     {
-        // Could add pulsing effects or other dynamic elements
+        RightPathIndicator->SetCustomPrimitiveDataFloat(HintPulseDataIndex, PulseScale);
     }
 }
 
@@ -95,6 +155,7 @@ void AIntersection::SetIntersectionType(EIntersectionType NewType)
     {
         IntersectionType = NewType;
         UpdateVisualAppearance();
+        ApplyPathHintMaterials();
         CalculatePathDirections();
     }
 }
@@ -104,8 +165,13 @@ void AIntersection::SetPathBiomes(EBiomeType LeftBiome, EBiomeType RightBiome)
     LeftPathBiome = LeftBiome;
     RightPathBiome = RightBiome;
     
-    ApplyBiomeVisuals(LeftBiome, LeftPathIndicator, true);
-    ApplyBiomeVisuals(RightBiome, RightPathIndicator, false);
+    TArray<FSoftObjectPath> MissingAssets;
+    ApplyBiomeVisuals(LeftBiome, LeftPathIndicator, true, MissingAssets);
+    ApplyBiomeVisuals(RightBiome, RightPathIndicator, false, MissingAssets);
+    RequestMissingAssets(MissingAssets);
+
+    // Hint materials are keyed on the path biome, so swap to the new biomes' instances and release the old ones
+    ApplyPathHintMaterials();
 }
 
 void AIntersection::SetPathHints(const FPathHints& NewHints)
@@ -119,6 +185,8 @@ void AIntersection::OnPlayerEnterIntersection(UPrimitiveComponent* OverlappedCom
     if (OtherActor && OtherActor->IsA<APawn>())
     {
         bPlayerPresent = true;
+        SetActorTickEnabled(!bChoiceMade);
+        SetHintPulseActive(!bChoiceMade);
         
         UE_LOG(LogTemp, Log, TEXT("Player entered intersection: %s -> Left: %s, Right: %s"), 
                *GetName(), 
@@ -141,6 +209,8 @@ void AIntersection::OnPlayerExitIntersection(UPrimitiveComponent* OverlappedComp
     if (OtherActor && OtherActor->IsA<APawn>())
     {
         bPlayerPresent = false;
+        SetActorTickEnabled(false);
+        SetHintPulseActive(false);
         
         UE_LOG(LogTemp, Log, TEXT("Player exited intersection: %s"), *GetName());
 
@@ -163,6 +233,9 @@ void AIntersection::OnPlayerChoiceMade(bool bChoseLeftPath)
     }
 
     bChoiceMade = true;
+    SetActorTickEnabled(false);
+    SetHintPulseActive(false);
+
     EBiomeType ChosenBiome = bChoseLeftPath ? LeftPathBiome : RightPathBiome;
     
     UE_LOG(LogTemp, Log, TEXT("Player chose %s path at intersection %s, leading to %s biome"), 
@@ -173,12 +246,21 @@ void AIntersection::OnPlayerChoiceMade(bool bChoseLeftPath)
     // Broadcast choice event
     OnPlayerChoiceMadeEvent.Broadcast(this, bChoseLeftPath, ChosenBiome);
 
-    // Trigger possible discoveries in the new biome
     if (UWorld* World = GetWorld())
     {
+        // Record the choice for the save file
+        if (UGameInstance* GameInstance = World->GetGameInstance())
+        {
+            if (UBikeSaveSubsystem* SaveSubsystem = GameInstance->GetSubsystem<UBikeSaveSubsystem>())
+            {
+                SaveSubsystem->RecordChoice(bChoseLeftPath, ChosenBiome, bChoseLeftPath ? PathHints.LeftPathPersonality : PathHints.RightPathPersonality);
+            }
+        }
+
+        // Trigger possible discoveries in the new biome
         if (class ABikeAdventureGameMode* GameMode = Cast<class ABikeAdventureGameMode>(World->GetAuthGameMode()))
         {
-            if (class UDiscoverySystem* DiscoverySys = GameMode->DiscoverySystem)
+            if (class UDiscoverySystem* DiscoverySys = GameMode->GetDiscoverySystem())
             {
                 DiscoverySys->HandleBiomeEntered(ChosenBiome);
             }
@@ -196,16 +278,32 @@ void AIntersection::OnPlayerChoiceMade(bool bChoseLeftPath)
 
 void AIntersection::UpdateVisualAppearance()
 {
+    TArray<FSoftObjectPath> MissingAssets;
+
     // Update intersection mesh based on type
     TSoftObjectPtr<UStaticMesh>* MeshPtr = IntersectionMeshMap.Find(IntersectionType);
-    if (MeshPtr && MeshPtr->IsValid())
+    if (MeshPtr && !MeshPtr->IsNull())
     {
-        IntersectionMesh->SetStaticMesh(MeshPtr->LoadSynchronous());
+        if (UStaticMesh* Mesh = MeshPtr->Get())
+        {
+            IntersectionMesh->SetStaticMesh(Mesh);
+        }
+        else
+        {
+            // Not prefetched in time - show the placeholder until the async load lands
+            if (PlaceholderIntersectionMesh)
+            {
+                IntersectionMesh->SetStaticMesh(PlaceholderIntersectionMesh);
+            }
+            MissingAssets.Add(MeshPtr->ToSoftObjectPath());
+        }
     }
 
     // Update materials and effects based on current biome context
-    ApplyBiomeVisuals(LeftPathBiome, LeftPathIndicator, true);
-    ApplyBiomeVisuals(RightPathBiome, RightPathIndicator, false);
+    ApplyBiomeVisuals(LeftPathBiome, LeftPathIndicator, true, MissingAssets);
+    ApplyBiomeVisuals(RightPathBiome, RightPathIndicator, false, MissingAssets);
+
+    RequestMissingAssets(MissingAssets);
 }
 
 void AIntersection::UpdatePathHints()
@@ -221,68 +319,228 @@ void AIntersection::UpdatePathHints()
         }
 
         TSoftObjectPtr<UNiagaraSystem>* HintEffectPtr = PathHintEffects.Find(PathHints.LeftPathPersonality);
-        if (HintEffectPtr && HintEffectPtr->IsValid() && EnvironmentalEffect)
+        if (HintEffectPtr && !HintEffectPtr->IsNull() && EnvironmentalEffect)
         {
-            EnvironmentalEffect->SetAsset(HintEffectPtr->LoadSynchronous());
+            if (UNiagaraSystem* HintEffect = HintEffectPtr->Get())
+            {
+                EnvironmentalEffect->SetAsset(HintEffect);
+            }
+            else
+            {
+                RequestMissingAssets({ HintEffectPtr->ToSoftObjectPath() });
+            }
         }
     }
 
-    // Apply hint subtlety by adjusting opacity/intensity
-    float HintIntensity = 1.0f - PathHints.HintSubtlety;
-    
-    if (LeftPathIndicator)
+    ApplyPathHintMaterials();
+}
+
+void AIntersection::ApplyPathHintMaterials()
+{
+    // Hint subtlety and personality factors come from materials shared with every intersection in the same hint state
+    ApplyPathHintMaterial(LeftPathIndicator, LeftHintMaterial, PathHints.LeftPathPersonality, LeftPathBiome, true, PathHints.LeftPathChallengeFactor);
+    ApplyPathHintMaterial(RightPathIndicator, RightHintMaterial, PathHints.RightPathPersonality, RightPathBiome, false, PathHints.RightPathSceneryFactor);
+}
+
+void AIntersection::ApplyPathHintMaterial(UStaticMeshComponent* TargetMesh, UMaterialInstanceDynamic*& HeldMaterial, EPathPersonality Personality, EBiomeType BiomeType, bool bIsLeftPath, float PathFactor)
+{
+    if (!TargetMesh)
     {
-        // Adjust material parameters for hint intensity
-        UMaterialInstanceDynamic* LeftDynamicMaterial = LeftPathIndicator->CreateAndSetMaterialInstanceDynamic(0);
-        if (LeftDynamicMaterial)
-        {
-            LeftDynamicMaterial->SetScalarParameterValue(TEXT("Opacity"), HintIntensity);
-            LeftDynamicMaterial->SetScalarParameterValue(TEXT("Challenge"), PathHints.LeftPathChallengeFactor);
-        }
+        return;
     }
 
-    if (RightPathIndicator)
+    UWorld* World = GetWorld();
+    UPathHintMaterialCache* MaterialCache = World ? World->GetSubsystem<UPathHintMaterialCache>() : nullptr;
+    if (!MaterialCache)
     {
-        UMaterialInstanceDynamic* RightDynamicMaterial = RightPathIndicator->CreateAndSetMaterialInstanceDynamic(0);
-        if (RightDynamicMaterial)
+        // No world subsystem (e.g. editor preview), fall back to a private instance
+        UMaterialInstanceDynamic* DynamicMaterial = TargetMesh->CreateAndSetMaterialInstanceDynamic(0);
+        if (DynamicMaterial)
         {
-            RightDynamicMaterial->SetScalarParameterValue(TEXT("Opacity"), HintIntensity);
-            RightDynamicMaterial->SetScalarParameterValue(TEXT("Scenery"), PathHints.RightPathSceneryFactor);
+            DynamicMaterial->SetScalarParameterValue(TEXT("Opacity"), 1.0f - PathHints.HintSubtlety);
+            DynamicMaterial->SetScalarParameterValue(bIsLeftPath ? TEXT("Challenge") : TEXT("Scenery"), PathFactor);
         }
+        return;
     }
+
+    // Acquire before releasing so an unchanged state keeps its instance alive
+    UMaterialInstanceDynamic* SharedMaterial = MaterialCache->AcquireInstance(TargetMesh->GetMaterial(0), Personality, BiomeType, bIsLeftPath, PathHints.HintSubtlety, PathFactor);
+    MaterialCache->ReleaseInstance(HeldMaterial);
+    HeldMaterial = SharedMaterial;
+
+    if (SharedMaterial)
+    {
+        TargetMesh->SetMaterial(0, SharedMaterial);
+    }
+}
+
+void AIntersection::ReleasePathHintMaterials()
+{
+    UWorld* World = GetWorld();
+    if (UPathHintMaterialCache* MaterialCache = World ? World->GetSubsystem<UPathHintMaterialCache>() : nullptr)
+    {
+        MaterialCache->ReleaseInstance(LeftHintMaterial);
+        MaterialCache->ReleaseInstance(RightHintMaterial);
+    }
+
+    LeftHintMaterial = nullptr;
+    RightHintMaterial = nullptr;
 }
 
-void AIntersection::ApplyBiomeVisuals(EBiomeType BiomeType, UStaticMeshComponent* TargetMesh, bool bIsLeftPath)
+void AIntersection::ApplyBiomeVisuals(EBiomeType BiomeType, UStaticMeshComponent* TargetMesh, bool bIsLeftPath, TArray<FSoftObjectPath>& OutMissingAssets)
 {
     if (!TargetMesh)
     {
         return;
     }
 
-    // Apply biome-specific material
+    // Apply biome-specific material; the mesh keeps its default material until it is loaded
     TSoftObjectPtr<UMaterialInterface>* MaterialPtr = BiomeMaterials.Find(BiomeType);
-    if (MaterialPtr && MaterialPtr->IsValid())
+    if (MaterialPtr && !MaterialPtr->IsNull())
     {
-        TargetMesh->SetMaterial(0, MaterialPtr->LoadSynchronous());
+        if (UMaterialInterface* Material = MaterialPtr->Get())
+        {
+            TargetMesh->SetMaterial(0, Material);
+        }
+        else
+        {
+            OutMissingAssets.Add(MaterialPtr->ToSoftObjectPath());
+        }
     }
 
     // Set up biome-specific particle effect
     TSoftObjectPtr<UNiagaraSystem>* EffectPtr = BiomeEffects.Find(BiomeType);
-    if (EffectPtr && EffectPtr->IsValid() && EnvironmentalEffect)
+    if (EffectPtr && !EffectPtr->IsNull() && EnvironmentalEffect && !EnvironmentalEffect->GetAsset())
     {
         // For now, use the effect for the intersection as a whole
         // In a more complex implementation, each path could have its own effect component
-        if (!EnvironmentalEffect->GetAsset())
+        if (UNiagaraSystem* Effect = EffectPtr->Get())
         {
-            EnvironmentalEffect->SetAsset(EffectPtr->LoadSynchronous());
+            EnvironmentalEffect->SetAsset(Effect);
+        }
+        else
+        {
+            OutMissingAssets.Add(EffectPtr->ToSoftObjectPath());
         }
     }
 
     // Set up biome-specific ambient audio
     TSoftObjectPtr<USoundCue>* AudioPtr = BiomeAmbientSounds.Find(BiomeType);
-    if (AudioPtr && AudioPtr->IsValid() && AmbientAudio && !AmbientAudio->GetSound())
+    if (AudioPtr && !AudioPtr->IsNull() && AmbientAudio && !AmbientAudio->GetSound())
+    {
+        if (USoundCue* Sound = AudioPtr->Get())
+        {
+            AmbientAudio->SetSound(Sound);
+        }
+        else
+        {
+            OutMissingAssets.Add(AudioPtr->ToSoftObjectPath());
+        }
+    }
+}
+
+void AIntersection::RequestMissingAssets(const TArray<FSoftObjectPath>& MissingAssets)
+{
+    // A load that completed without producing the asset keeps the placeholder rather than retrying forever
+    if (MissingAssets.Num() == 0 || bApplyingLoadedAssets)
+    {
+        return;
+    }
+
+    TSharedPtr<FStreamableHandle> Handle = UIntersectionAssetPrefetcher::GetStreamableManager().RequestAsyncLoad(
+        MissingAssets,
+        FStreamableDelegate::CreateUObject(this, &AIntersection::OnMissingAssetsLoaded),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    if (Handle.IsValid())
+    {
+        PendingAssetHandles.Add(Handle);
+    }
+}
+
+void AIntersection::OnMissingAssetsLoaded()
+{
+    PendingAssetHandles.RemoveAll([](const TSharedPtr<FStreamableHandle>& Handle)
+    {
+        return !Handle.IsValid() || !Handle->IsLoadingInProgress();
+    });
+
+    // Everything that was missing is resident now, so this only swaps placeholders for real assets
+    bApplyingLoadedAssets = true;
+    UpdateVisualAppearance();
+
+    // Late biome materials replaced slot 0, so put the hint materials back on top of them
+    ApplyPathHintMaterials();
+
+    TSoftObjectPtr<UNiagaraSystem>* HintEffectPtr = PathHints.LeftPathPersonality != EPathPersonality::None ? PathHintEffects.Find(PathHints.LeftPathPersonality) : nullptr;
+    if (HintEffectPtr && EnvironmentalEffect)
+    {
+        if (UNiagaraSystem* HintEffect = HintEffectPtr->Get())
+        {
+            EnvironmentalEffect->SetAsset(HintEffect);
+        }
+    }
+    bApplyingLoadedAssets = false;
+}
+
+void AIntersection::GatherAssetPaths(TArrayView<const EIntersectionType> Types, TArrayView<const EBiomeType> Biomes, bool bIncludePathHints, TArray<FSoftObjectPath>& OutPaths) const
+{
+    for (EIntersectionType Type : Types)
+    {
+        if (const TSoftObjectPtr<UStaticMesh>* MeshPtr = IntersectionMeshMap.Find(Type))
+        {
+            if (!MeshPtr->IsNull())
+            {
+                OutPaths.Add(MeshPtr->ToSoftObjectPath());
+            }
+        }
+    }
+
+    for (EBiomeType Biome : Biomes)
     {
-        AmbientAudio->SetSound(AudioPtr->LoadSynchronous());
+        if (const TSoftObjectPtr<UMaterialInterface>* MaterialPtr = BiomeMaterials.Find(Biome))
+        {
+            if (!MaterialPtr->IsNull())
+            {
+                OutPaths.Add(MaterialPtr->ToSoftObjectPath());
+            }
+        }
+
+        if (const TSoftObjectPtr<UNiagaraSystem>* EffectPtr = BiomeEffects.Find(Biome))
+        {
+            if (!EffectPtr->IsNull())
+            {
+                OutPaths.Add(EffectPtr->ToSoftObjectPath());
+            }
+        }
+
+        if (const TSoftObjectPtr<USoundCue>* AudioPtr = BiomeAmbientSounds.Find(Biome))
+        {
+            if (!AudioPtr->IsNull())
+            {
+                OutPaths.Add(AudioPtr->ToSoftObjectPath());
+            }
+        }
+    }
+
+    if (bIncludePathHints)
+    {
+        // Personalities are only decided at spawn time, so hints for all of them are needed
+        for (const auto& HintPair : PathHintMeshes)
+        {
+            if (!HintPair.Value.IsNull())
+            {
+                OutPaths.Add(HintPair.Value.ToSoftObjectPath());
+            }
+        }
+
+        for (const auto& HintPair : PathHintEffects)
+        {
+            if (!HintPair.Value.IsNull())
+            {
+                OutPaths.Add(HintPair.Value.ToSoftObjectPath());
+            }
+        }
     }
 }
 
@@ -5,12 +5,14 @@
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SceneComponent.h"
+#include "Engine/StreamableManager.h"
 #include "../Core/BiomeTypes.h"
 #include "Intersection.generated.h"
 
 class UBoxComponent;
 class UStaticMeshComponent;
 class UNiagaraComponent;
+class UMaterialInstanceDynamic;
 
 /**
  * Intersection actor representing decision points in the bike adventure
@@ -26,6 +28,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     virtual void Tick(float DeltaTime) override;
@@ -84,6 +87,12 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Intersection")
     FVector GetRightPathDirection() const { return RightPathDirection; }
 
+    /**
+     * Indicator meshes showing each path's biome and hint material
+     */
+    UStaticMeshComponent* GetLeftPathIndicator() const { return LeftPathIndicator; }
+    UStaticMeshComponent* GetRightPathIndicator() const { return RightPathIndicator; }
+
     /**
      * Handle player entering the intersection trigger
      */
@@ -102,6 +111,18 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Intersection")
     void OnPlayerChoiceMade(bool bChoseLeftPath);
 
+    /**
+     * Collect the soft asset paths an intersection of these types between these biomes would use.
+     * Used by UIntersectionAssetPrefetcher on the class defaults to preload visuals ahead of spawning.
+     */
+    void GatherAssetPaths(TArrayView<const EIntersectionType> Types, TArrayView<const EBiomeType> Biomes, bool bIncludePathHints, TArray<FSoftObjectPath>& OutPaths) const;
+
+    /**
+     * Whether any visual asset is still being loaded asynchronously
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Intersection")
+    bool HasPendingAssets() const { return PendingAssetHandles.Num() > 0; }
+
 protected:
     // Root scene component
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
@@ -187,6 +208,10 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hint Settings")
     TMap<EPathPersonality, TSoftObjectPtr<UNiagaraSystem>> PathHintEffects;
 
+    // Mesh shown while the intersection mesh for the current type is still loading
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visual Settings")
+    UStaticMesh* PlaceholderIntersectionMesh;
+
 private:
     /**
      * Update visual appearance based on intersection type
@@ -198,10 +223,63 @@ private:
      */
     void UpdatePathHints();
 
+    /**
+     * Swap an indicator onto the shared material for its hint state, releasing the previous one
+     */
+    void ApplyPathHintMaterial(UStaticMeshComponent* TargetMesh, UMaterialInstanceDynamic*& HeldMaterial, EPathPersonality Personality, EBiomeType BiomeType, bool bIsLeftPath, float PathFactor);
+
+    /**
+     * Re-key both indicators' shared hint materials on their current biomes and base materials.
+     * Needed whenever ApplyBiomeVisuals has replaced material slot 0.
+     */
+    void ApplyPathHintMaterials();
+
+    /**
+     * Return both indicator materials to the shared cache
+     */
+    void ReleasePathHintMaterials();
+
+    /**
+     * Start or stop the material-driven pulse on both path indicators
+     */
+    void SetHintPulseActive(bool bActive);
+
+    // Custom primitive data slot the indicator material reads as its pulse scale
+    static constexpr int32 HintPulseDataIndex = 0;
+
+    /**
+     * Intersection manager of the current game mode, used for spatial registration
+     */
+    class UIntersectionManager* GetIntersectionManager() const;
+
+    // Shared hint materials currently referenced by the indicators
+    UPROPERTY(Transient)
+    UMaterialInstanceDynamic* LeftHintMaterial;
+
+    UPROPERTY(Transient)
+    UMaterialInstanceDynamic* RightHintMaterial;
+
     /**
      * Apply biome-specific materials and effects
+     * Assets that are not resident yet are appended to OutMissingAssets instead of being loaded
      */
-    void ApplyBiomeVisuals(EBiomeType BiomeType, UStaticMeshComponent* TargetMesh, bool bIsLeftPath);
+    void ApplyBiomeVisuals(EBiomeType BiomeType, UStaticMeshComponent* TargetMesh, bool bIsLeftPath, TArray<FSoftObjectPath>& OutMissingAssets);
+
+    /**
+     * Asynchronously load assets that were missing when visuals were applied
+     */
+    void RequestMissingAssets(const TArray<FSoftObjectPath>& MissingAssets);
+
+    /**
+     * Re-apply visuals once a deferred asset request completes
+     */
+    void OnMissingAssetsLoaded();
+
+    // Outstanding async loads for assets that were not prefetched in time
+    TArray<TSharedPtr<FStreamableHandle>> PendingAssetHandles;
+
+    // Set while re-applying loaded assets so failed loads are not requested again
+    bool bApplyingLoadedAssets;
 
     /**
      * Initialize default assets
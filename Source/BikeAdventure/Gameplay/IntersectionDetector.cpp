@@ -1,7 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "IntersectionDetector.h"
+#include "Intersection.h"
 #include "GameFramework/Actor.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Systems/WorldStreamingManager.h"
+#include "Systems/PathSpline.h"
 
 UIntersectionDetector::UIntersectionDetector()
 {
@@ -15,55 +20,162 @@ void UIntersectionDetector::BeginPlay()
 	// Initialize available choices
 	AvailableChoices.Add(TEXT("Turn Left"));
 	AvailableChoices.Add(TEXT("Turn Right"));
+
+	// Streamed intersections drive detection when the streaming manager is running
+	UWorld* World = GetWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	StreamingManager = GameInstance ? GameInstance->GetSubsystem<UWorldStreamingManager>() : nullptr;
+
+	if (UWorldStreamingManager* Manager = StreamingManager.Get())
+	{
+		Manager->OnSectionLoadedEvent.AddUniqueDynamic(this, &UIntersectionDetector::OnSectionStreamed);
+		Manager->OnSectionUnloadedEvent.AddUniqueDynamic(this, &UIntersectionDetector::OnSectionStreamed);
+	}
+
+	bTargetScheduled = false;
+}
+
+void UIntersectionDetector::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorldStreamingManager* Manager = StreamingManager.Get())
+	{
+		Manager->OnSectionLoadedEvent.RemoveDynamic(this, &UIntersectionDetector::OnSectionStreamed);
+		Manager->OnSectionUnloadedEvent.RemoveDynamic(this, &UIntersectionDetector::OnSectionStreamed);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UIntersectionDetector::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	
-	CheckForIntersection();
+	CheckForIntersection(DeltaTime);
 }
 
-void UIntersectionDetector::CheckForIntersection()
+void UIntersectionDetector::CheckForIntersection(float DeltaTime)
 {
-	if (!GetOwner())
+	if (!GetOwner() || bAtIntersection)
 	{
 		return;
 	}
 
 	FVector CurrentLocation = GetOwner()->GetActorLocation();
-	
-	// Simple intersection detection based on distance traveled
-	float DistanceFromLastIntersectionSquared = FVector::DistSquared(CurrentLocation, LastIntersectionLocation);
-	
-	if (DistanceFromLastIntersectionSquared >= (MinimumIntersectionDistance * MinimumIntersectionDistance))
+
+	// Only query the streaming manager when the world around the rider changed or the rider changed section path
+	const bool bPathChanged = UpdateRiderPath(CurrentLocation, DeltaTime);
+	if (!bTargetScheduled || bPathChanged || TargetIntersection.IsStale())
 	{
-		// Probability-based intersection detection (10% chance per check when eligible)
-		if (FMath::RandRange(0.0f, 1.0f) <= 0.1f)
+		ScheduleNextIntersection(CurrentLocation);
+	}
+
+	if (AIntersection* Target = TargetIntersection.Get())
+	{
+		// Trigger once the rider is within DetectionRadius of the intersection along the path
+		DistanceToTrigger = TargetPathDistance - RiderPathDistance - DetectionRadius;
+
+		if (DistanceToTrigger <= 0.0f)
+		{
+			CurrentIntersection = Target;
+			ReachIntersection(Target->GetActorLocation());
+			return;
+		}
+	}
+	else
+	{
+		// No streamed intersection ahead, space intersections evenly from the last one
+		const FVector FromLastIntersection = CurrentLocation - LastIntersectionLocation;
+		DistanceToTrigger = MinimumIntersectionDistance - FromLastIntersection.Size();
+
+		if (DistanceToTrigger <= 0.0f)
 		{
-			if (!bAtIntersection)
-			{
-				bAtIntersection = true;
-				LastIntersectionLocation = CurrentLocation;
-				GenerateChoices();
-				
-				// Broadcast event
-				OnIntersectionReached.Broadcast();
-			}
+			// Snap to the exact spacing so the trigger point does not depend on frame rate
+			CurrentIntersection.Reset();
+			ReachIntersection(LastIntersectionLocation + FromLastIntersection.GetSafeNormal() * MinimumIntersectionDistance);
+			return;
 		}
 	}
+
+	UpdateTickInterval();
+}
+
+bool UIntersectionDetector::UpdateRiderPath(const FVector& CurrentLocation, float DeltaTime)
+{
+	UWorldStreamingManager* Manager = StreamingManager.Get();
+	TSharedPtr<const FPathSpline> Path = Manager ? Manager->FindPathSplineAt(CurrentLocation) : nullptr;
+	const bool bPathChanged = Path != RiderPath;
+
+	if (Path.IsValid())
+	{
+		// On the same spline, only search as far as the rider could have ridden since the last check
+		const float Moved = FMath::Max(MaxRiderSpeed * DeltaTime, FVector::Dist2D(CurrentLocation, LastCheckLocation));
+		const float HintDistance = bPathChanged ? -1.0f : Path->ToLocalDistance(RiderPathDistance);
+		RiderPathDistance = Path->ToPathDistance(Path->FindNearestDistance(CurrentLocation, HintDistance, Moved + Path->GetSampleSpacing()));
+	}
+
+	RiderPath = Path;
+	LastCheckLocation = CurrentLocation;
+	return bPathChanged;
+}
+
+void UIntersectionDetector::ScheduleNextIntersection(const FVector& CurrentLocation)
+{
+	AIntersection* NextIntersection = nullptr;
+	UWorldStreamingManager* Manager = StreamingManager.Get();
+
+	if (Manager && Manager->FindNextIntersectionAhead(CurrentLocation, CurrentIntersection.Get(), NextIntersection, TargetPathDistance))
+	{
+		TargetIntersection = NextIntersection;
+	}
+	else
+	{
+		TargetIntersection.Reset();
+	}
+
+	bTargetScheduled = true;
+}
+
+void UIntersectionDetector::ReachIntersection(const FVector& TriggerLocation)
+{
+	bAtIntersection = true;
+	LastIntersectionLocation = TriggerLocation;
+	DistanceToTrigger = 0.0f;
+	TargetIntersection.Reset();
+	bTargetScheduled = false;
+	GenerateChoices();
+
+	// Nothing to detect until a path is selected
+	SetComponentTickEnabled(false);
+
+	// Broadcast event
+	OnIntersectionReached.Broadcast();
+}
+
+void UIntersectionDetector::UpdateTickInterval()
+{
+	const float SleepDistance = DistanceToTrigger - WakeDistance;
+	SetComponentTickInterval((SleepDistance > 0.0f && MaxRiderSpeed > 0.0f) ? SleepDistance / MaxRiderSpeed : 0.0f);
+}
+
+void UIntersectionDetector::OnSectionStreamed(const FIntVector& SectionCoordinates, EBiomeType BiomeType)
+{
+	bTargetScheduled = false;
+
+	if (!bAtIntersection)
+	{
+		SetComponentTickInterval(0.0f);
+	}
 }
 
 void UIntersectionDetector::GenerateChoices()
 {
-	// For now, always provide left/right choices
-	// In a full implementation, this could be more sophisticated
 	AvailableChoices.Empty();
 	AvailableChoices.Add(TEXT("Turn Left"));
 	AvailableChoices.Add(TEXT("Turn Right"));
 	
-	// Occasionally add a straight option
-	if (FMath::RandRange(0.0f, 1.0f) <= 0.3f)
+	// Roundabouts also allow carrying straight on
+	const AIntersection* Intersection = CurrentIntersection.Get();
+	if (Intersection && Intersection->GetIntersectionType() == EIntersectionType::Roundabout)
 	{
 		AvailableChoices.Add(TEXT("Continue Straight"));
 	}
@@ -75,8 +187,12 @@ void UIntersectionDetector::SelectPath(const FString& Choice)
 	{
 		// Mark intersection as resolved
 		bAtIntersection = false;
+
+		// Resume detection for the next intersection along the chosen path
+		SetComponentTickInterval(0.0f);
+		SetComponentTickEnabled(true);
 		
 		// In a full implementation, this would trigger world generation
 		// for the selected path
 	}
-}
\ No newline at end of file
+}
@@ -5,8 +5,13 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Components/BoxComponent.h"
+#include "../Core/BiomeTypes.h"
 #include "IntersectionDetector.generated.h"
 
+class AIntersection;
+class UWorldStreamingManager;
+struct FPathSpline;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnIntersectionReached);
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
@@ -19,6 +24,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -35,6 +41,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Intersection")
 	void SelectPath(const FString& Choice);
 
+	// Intersection the rider is currently at, or null when detection fell back to spacing
+	UFUNCTION(BlueprintCallable, Category = "Intersection")
+	AIntersection* GetCurrentIntersection() const { return CurrentIntersection.Get(); }
+
+	// Remaining path distance to the next trigger point, as of the last check
+	UFUNCTION(BlueprintCallable, Category = "Intersection")
+	float GetDistanceToNextIntersection() const { return DistanceToTrigger; }
+
 	// Events
 	UPROPERTY(BlueprintAssignable, Category = "Intersection")
 	FOnIntersectionReached OnIntersectionReached;
@@ -45,13 +59,50 @@ protected:
 	float DetectionRadius = 100.0f;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Detection")
-	float MinimumIntersectionDistance = 500.0f; // Minimum distance between intersections
+	float MinimumIntersectionDistance = 500.0f; // Spacing used when no streamed intersection is ahead
+
+	// Distance before the trigger point at which ticking resumes every frame
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Detection")
+	float WakeDistance = 500.0f;
+
+	// Upper bound on rider speed (cm/s) used to size the tick sleep so the trigger is never overshot
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Detection")
+	float MaxRiderSpeed = 2000.0f;
 
 private:
 	bool bAtIntersection = false;
 	TArray<FString> AvailableChoices;
 	FVector LastIntersectionLocation = FVector::ZeroVector;
 
-	void CheckForIntersection();
+	// Next streamed intersection ahead; when unset, intersections are spaced MinimumIntersectionDistance apart
+	TWeakObjectPtr<AIntersection> TargetIntersection;
+	TWeakObjectPtr<AIntersection> CurrentIntersection;
+	TWeakObjectPtr<UWorldStreamingManager> StreamingManager;
+	bool bTargetScheduled = false;
+	float DistanceToTrigger = 0.0f;
+
+	// Section path the rider is on and the rider's and target's positions in the shared distance-along-path coordinate
+	TSharedPtr<const FPathSpline> RiderPath;
+	float RiderPathDistance = 0.0f;
+	float TargetPathDistance = 0.0f;
+	FVector LastCheckLocation = FVector::ZeroVector;
+
+	void CheckForIntersection(float DeltaTime);
 	void GenerateChoices();
+
+	// Find the section path under the rider and the rider's distance along it; returns whether the path changed
+	bool UpdateRiderPath(const FVector& CurrentLocation, float DeltaTime);
+
+	// Ask the streaming manager for the next intersection along the path ahead
+	void ScheduleNextIntersection(const FVector& CurrentLocation);
+
+	// Mark the rider as arrived at the scheduled trigger point
+	void ReachIntersection(const FVector& TriggerLocation);
+
+	// Sleep the tick for as long as the rider cannot reach the wake distance
+	void UpdateTickInterval();
+
+	// A newly streamed section may hold a nearer intersection
+	UFUNCTION()
+	void OnSectionStreamed(const FIntVector& SectionCoordinates, EBiomeType BiomeType);
 };
\ No newline at end of file
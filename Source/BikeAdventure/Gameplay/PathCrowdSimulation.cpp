@@ -0,0 +1,200 @@
+#include "PathCrowdSimulation.h"
+#include "Components/SplineComponent.h"
+#include "Async/ParallelFor.h"
+
+void FPathCrowdSimulation::BuildTrack(const USplineComponent& Spline, float SampleSpacing)
+{
+    TrackLength = Spline.GetSplineLength();
+    bClosedLoop = Spline.IsClosedLoop();
+
+    const int32 NumSamples = FMath::Max(2, FMath::CeilToInt(TrackLength / FMath::Max(SampleSpacing, 1.0f)) + 1);
+    const float Spacing = TrackLength / (NumSamples - 1);
+    InvSampleSpacing = Spacing > UE_SMALL_NUMBER ? 1.0f / Spacing : 0.0f;
+
+    TrackX.SetNumUninitialized(NumSamples);
+    TrackY.SetNumUninitialized(NumSamples);
+    TrackZ.SetNumUninitialized(NumSamples);
+    TrackRightX.SetNumUninitialized(NumSamples);
+    TrackRightY.SetNumUninitialized(NumSamples);
+    TrackYaw.SetNumUninitialized(NumSamples);
+
+    float PreviousYaw = 0.0f;
+    for (int32 Sample = 0; Sample < NumSamples; Sample++)
+    {
+        const float Distance = Sample * Spacing;
+        const FVector Location = Spline.GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+        const FVector Direction = Spline.GetDirectionAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+
+        // Yaw is unwound so neighbouring samples interpolate without a wrap check
+        float Yaw = static_cast<float>(FMath::Atan2(Direction.Y, Direction.X));
+        if (Sample > 0)
+        {
+            Yaw = PreviousYaw + FMath::FindDeltaAngleRadians(PreviousYaw, Yaw);
+        }
+        PreviousYaw = Yaw;
+
+        float SinYaw;
+        float CosYaw;
+        FMath::SinCos(&SinYaw, &CosYaw, Yaw);
+
+        TrackX[Sample] = static_cast<float>(Location.X);
+        TrackY[Sample] = static_cast<float>(Location.Y);
+        TrackZ[Sample] = static_cast<float>(Location.Z);
+        TrackRightX[Sample] = -SinYaw;
+        TrackRightY[Sample] = CosYaw;
+        TrackYaw[Sample] = Yaw;
+    }
+
+    // Agents placed on an earlier track are re-evaluated on this one
+    StepRange(0, Num(), 0.0f);
+}
+
+int32 FPathCrowdSimulation::AddAgent(float Distance, float DesiredSpeed, float LaneOffset, float SwayPhase)
+{
+    const int32 Agent = Distances.AddUninitialized();
+    Speeds.AddUninitialized();
+    DesiredSpeeds.AddUninitialized();
+    LaneOffsets.AddUninitialized();
+    SwayPhases.AddUninitialized();
+    Visible.AddUninitialized();
+    Active.AddUninitialized();
+    Transforms.Add(FTransform::Identity);
+
+    SetAgent(Agent, Distance, DesiredSpeed, LaneOffset, SwayPhase);
+    return Agent;
+}
+
+void FPathCrowdSimulation::SetAgent(int32 Agent, float Distance, float DesiredSpeed, float LaneOffset, float SwayPhase)
+{
+    Distances[Agent] = FMath::Clamp(Distance, 0.0f, TrackLength);
+    Speeds[Agent] = DesiredSpeed;
+    DesiredSpeeds[Agent] = DesiredSpeed;
+    LaneOffsets[Agent] = LaneOffset;
+    SwayPhases[Agent] = FMath::Fmod(SwayPhase, UE_TWO_PI);
+    Visible[Agent] = 1;
+    Active[Agent] = 1;
+    StepRange(Agent, Agent + 1, 0.0f);
+}
+
+void FPathCrowdSimulation::DeactivateAgent(int32 Agent)
+{
+    Active[Agent] = 0;
+    Transforms[Agent].SetScale3D(FVector::ZeroVector);
+}
+
+void FPathCrowdSimulation::SetAgentVisible(int32 Agent, bool bVisible)
+{
+    Visible[Agent] = bVisible ? 1 : 0;
+    Transforms[Agent].SetScale3D(bVisible ? FVector::OneVector : FVector::ZeroVector);
+}
+
+void FPathCrowdSimulation::Reset()
+{
+    Distances.Reset();
+    Speeds.Reset();
+    DesiredSpeeds.Reset();
+    LaneOffsets.Reset();
+    SwayPhases.Reset();
+    Visible.Reset();
+    Active.Reset();
+    Transforms.Reset();
+}
+
+void FPathCrowdSimulation::Step(float DeltaTime)
+{
+    const int32 NumAgents = Num();
+    const int32 NumChunks = FMath::DivideAndRoundUp(NumAgents, ChunkSize);
+    ParallelFor(NumChunks, [this, NumAgents, DeltaTime](int32 Chunk)
+    {
+        const int32 Begin = Chunk * ChunkSize;
+        StepRange(Begin, FMath::Min(Begin + ChunkSize, NumAgents), DeltaTime);
+    });
+}
+
+void FPathCrowdSimulation::StepRange(int32 Begin, int32 End, float DeltaTime)
+{
+    if (TrackYaw.Num() < 2)
+    {
+        return;
+    }
+
+    const float SpeedAlpha = FMath::Min(SpeedResponse * DeltaTime, 1.0f);
+    const float SwayStep = SwayRate * DeltaTime;
+    const float Length = TrackLength;
+    const int32 LastSegment = TrackYaw.Num() - 2;
+
+    float* RESTRICT Distance = Distances.GetData();
+    float* RESTRICT Speed = Speeds.GetData();
+    float* RESTRICT DesiredSpeed = DesiredSpeeds.GetData();
+    float* RESTRICT SwayPhase = SwayPhases.GetData();
+    const uint8* RESTRICT bActive = Active.GetData();
+
+    // Motion: speed, distance and sway, turning round at the ends of an open path
+    for (int32 Agent = Begin; Agent < End; Agent++)
+    {
+        if (!bActive[Agent])
+        {
+            continue;
+        }
+
+        Speed[Agent] += (DesiredSpeed[Agent] - Speed[Agent]) * SpeedAlpha;
+        float NewDistance = Distance[Agent] + Speed[Agent] * DeltaTime;
+        if (bClosedLoop && Length > 0.0f)
+        {
+            NewDistance -= Length * FMath::FloorToFloat(NewDistance / Length);
+        }
+        else if (NewDistance < 0.0f || NewDistance > Length)
+        {
+            NewDistance = NewDistance < 0.0f ? -NewDistance : 2.0f * Length - NewDistance;
+            Speed[Agent] = -Speed[Agent];
+            DesiredSpeed[Agent] = -DesiredSpeed[Agent];
+        }
+        Distance[Agent] = FMath::Clamp(NewDistance, 0.0f, Length);
+
+        float Phase = SwayPhase[Agent] + SwayStep;
+        SwayPhase[Agent] = Phase >= UE_TWO_PI ? Phase - UE_TWO_PI : Phase;
+    }
+
+    // Placement: interpolate the baked track and write the transforms
+    const float* RESTRICT X = TrackX.GetData();
+    const float* RESTRICT Y = TrackY.GetData();
+    const float* RESTRICT Z = TrackZ.GetData();
+    const float* RESTRICT RightX = TrackRightX.GetData();
+    const float* RESTRICT RightY = TrackRightY.GetData();
+    const float* RESTRICT Yaw = TrackYaw.GetData();
+    const float* RESTRICT Lane = LaneOffsets.GetData();
+    const uint8* RESTRICT bVisible = Visible.GetData();
+    FTransform* RESTRICT Out = Transforms.GetData();
+
+    for (int32 Agent = Begin; Agent < End; Agent++)
+    {
+        if (!bActive[Agent])
+        {
+            continue;
+        }
+
+        const float Sample = Distance[Agent] * InvSampleSpacing;
+        const int32 Segment = FMath::Min(static_cast<int32>(Sample), LastSegment);
+        const float Alpha = Sample - Segment;
+        const int32 Next = Segment + 1;
+
+        const float Lateral = Lane[Agent] + SwayDistance * FMath::Sin(SwayPhase[Agent]);
+        const float PathX = FMath::Lerp(X[Segment], X[Next], Alpha);
+        const float PathY = FMath::Lerp(Y[Segment], Y[Next], Alpha);
+        const float PathZ = FMath::Lerp(Z[Segment], Z[Next], Alpha);
+        const float SideX = FMath::Lerp(RightX[Segment], RightX[Next], Alpha);
+        const float SideY = FMath::Lerp(RightY[Segment], RightY[Next], Alpha);
+
+        // Agents walking back toward the start face the other way
+        const float Heading = FMath::Lerp(Yaw[Segment], Yaw[Next], Alpha) + (Speed[Agent] < 0.0f ? UE_PI : 0.0f);
+        float HalfSin;
+        float HalfCos;
+        FMath::SinCos(&HalfSin, &HalfCos, Heading * 0.5f);
+
+        const float Scale = bVisible[Agent] ? 1.0f : 0.0f;
+        Out[Agent] = FTransform(
+            FQuat(0.0f, 0.0f, HalfSin, HalfCos),
+            FVector(PathX + SideX * Lateral, PathY + SideY * Lateral, PathZ),
+            FVector(Scale));
+    }
+}
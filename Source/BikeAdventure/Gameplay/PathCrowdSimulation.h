@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/**
+ * Batched locomotion for NPCs walking along a path spline.
+ *
+ * The spline is baked once into evenly spaced samples (location, right vector and unwound yaw),
+ * so moving an agent never evaluates the spline itself. Agent state is held as parallel arrays
+ * (distance along the path, signed speed, target speed, lane offset and sway phase) and advanced
+ * in fixed-size chunks on worker threads. Each chunk writes its agents' world transforms in the
+ * same pass, ready for a single instance transform upload. Deactivated agents keep their index
+ * for reuse but are skipped by every step.
+ */
+class BIKEADVENTURE_API FPathCrowdSimulation
+{
+public:
+    /** Agents advanced per parallel task */
+    static constexpr int32 ChunkSize = 512;
+
+    /** Bake the spline's world-space path, one sample every SampleSpacing cm */
+    void BuildTrack(const USplineComponent& Spline, float SampleSpacing = 100.0f);
+
+    /** Length of the baked path */
+    float GetTrackLength() const { return TrackLength; }
+
+    /**
+     * Add an agent
+     * @param DesiredSpeed - Walking speed in cm/s; negative walks toward the start of the path
+     * @param LaneOffset - Sideways offset from the path centre, positive to the right
+     * @return Agent index; agents are never reordered
+     */
+    int32 AddAgent(float Distance, float DesiredSpeed, float LaneOffset, float SwayPhase);
+
+    /** Reinitialise an existing agent, as AddAgent; a deactivated agent becomes active again */
+    void SetAgent(int32 Agent, float Distance, float DesiredSpeed, float LaneOffset, float SwayPhase);
+
+    /** Stop simulating an agent until SetAgent reuses it; its transform is left scaled to zero */
+    void DeactivateAgent(int32 Agent);
+
+    /** Hidden agents keep moving but write a zero-scale transform */
+    void SetAgentVisible(int32 Agent, bool bVisible);
+
+    float GetAgentDistance(int32 Agent) const { return Distances[Agent]; }
+
+    int32 Num() const { return Distances.Num(); }
+    void Reset();
+
+    /** Advance every agent by DeltaTime and rewrite all transforms */
+    void Step(float DeltaTime);
+
+    /** World transform of every agent as of the last step, indexed by agent */
+    const TArray<FTransform>& GetTransforms() const { return Transforms; }
+
+    /** How quickly speed follows the desired speed, per second */
+    float SpeedResponse = 2.0f;
+
+    /** Amplitude of the sideways sway around the lane */
+    float SwayDistance = 20.0f;
+
+    /** Angular rate of the sway, in radians per second */
+    float SwayRate = 1.5f;
+
+private:
+    void StepRange(int32 Begin, int32 End, float DeltaTime);
+
+    // Baked track
+    TArray<float> TrackX;
+    TArray<float> TrackY;
+    TArray<float> TrackZ;
+    TArray<float> TrackRightX;
+    TArray<float> TrackRightY;
+    TArray<float> TrackYaw;
+    float TrackLength = 0.0f;
+    float InvSampleSpacing = 0.0f;
+    bool bClosedLoop = false;
+
+    // Agents
+    TArray<float> Distances;
+    TArray<float> Speeds;
+    TArray<float> DesiredSpeeds;
+    TArray<float> LaneOffsets;
+    TArray<float> SwayPhases;
+    TArray<uint8> Visible;
+    TArray<uint8> Active;
+    TArray<FTransform> Transforms;
+};
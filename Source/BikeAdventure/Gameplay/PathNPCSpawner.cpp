@@ -1,23 +1,148 @@
 #include "PathNPCSpawner.h"
 #include "Components/SplineComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
 
 APathNPCSpawner::APathNPCSpawner()
 {
-    PrimaryActorTick.bCanEverTick = false;
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 
     PathSpline = CreateDefaultSubobject<USplineComponent>(TEXT("PathSpline"));
     RootComponent = PathSpline;
 
+    CrowdInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("CrowdInstances"));
+    CrowdInstances->SetupAttachment(PathSpline);
+    CrowdInstances->SetMobility(EComponentMobility::Movable);
+    CrowdInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    CrowdInstances->SetCastShadow(false);
+
     NPCCount = 5;
     RandomSeed = 12345;
+
+    bCrowdMode = false;
+    SpawnBatchSize = 16;
+    SpawnDistanceAhead = 10000.0f;
+    DespawnDistanceBehind = 2000.0f;
+
+    bInstancedCrowd = false;
+    CrowdMesh = nullptr;
+    MaxFullActors = 8;
+    SignificanceDistance = 3000.0f;
+    BehindViewWeight = 0.25f;
+    PromoteSignificance = 0.6f;
+    DemoteSignificance = 0.45f;
+    CrowdWalkSpeed = 100.0f;
+    CrowdWalkSpeedVariance = 0.3f;
+    CrowdLaneHalfWidth = 150.0f;
 }
 
 void APathNPCSpawner::BeginPlay()
 {
     Super::BeginPlay();
 
-    SpawnNPCsAlongPath();
+    if (bCrowdMode)
+    {
+        StartCrowdSpawning();
+    }
+    else
+    {
+        SpawnNPCsAlongPath();
+    }
+}
+
+void APathNPCSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // The crowd belongs to the spawner; the world takes care of its actors on level teardown
+    if (EndPlayReason == EEndPlayReason::Destroyed)
+    {
+        for (AActor* NPC : CrowdNPCs)
+        {
+            if (IsValid(NPC))
+            {
+                NPC->Destroy();
+            }
+        }
+        for (AActor* NPC : SlotActors)
+        {
+            if (IsValid(NPC))
+            {
+                NPC->Destroy();
+            }
+        }
+        for (AActor* NPC : NPCPool)
+        {
+            if (IsValid(NPC))
+            {
+                NPC->Destroy();
+            }
+        }
+    }
+    CrowdNPCs.Empty();
+    SlotActors.Empty();
+    NPCPool.Empty();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void APathNPCSpawner::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    UpdateCrowd(GetRiderDistance());
+
+    if (bInstancedCrowd)
+    {
+        FVector ViewLocation;
+        FVector ViewDirection;
+        if (GetSignificanceView(ViewLocation, ViewDirection))
+        {
+            UpdateSignificance(ViewLocation, ViewDirection);
+        }
+        UpdateCrowdInstances(DeltaTime);
+    }
+}
+
+void APathNPCSpawner::BuildPlacements()
+{
+    PlacementDistances.Reset(NPCCount);
+    PlacementTransforms.Reset(NPCCount);
+
+    FRandomStream Random(RandomSeed);
+    const float SplineLength = PathSpline->GetSplineLength();
+    for (int32 i = 0; i < NPCCount; i++)
+    {
+        PlacementDistances.Add(Random.FRandRange(0.0f, SplineLength));
+    }
+    PlacementDistances.Sort();
+
+    // Distance maps to input key through the linear reparam table; with sorted distances a cursor
+    // walks it forward once instead of searching it for every NPC
+    const TArray<FInterpCurvePoint<float>>& Reparam = PathSpline->SplineCurves.ReparamTable.Points;
+    int32 Segment = 0;
+    for (const float Distance : PlacementDistances)
+    {
+        float InputKey = 0.0f;
+        if (Reparam.Num() >= 2)
+        {
+            while (Segment + 2 < Reparam.Num() && Reparam[Segment + 1].InVal <= Distance)
+            {
+                Segment++;
+            }
+            const FInterpCurvePoint<float>& Start = Reparam[Segment];
+            const FInterpCurvePoint<float>& End = Reparam[Segment + 1];
+            const float Span = End.InVal - Start.InVal;
+            const float Alpha = Span > UE_SMALL_NUMBER ? FMath::Clamp((Distance - Start.InVal) / Span, 0.0f, 1.0f) : 0.0f;
+            InputKey = FMath::Lerp(Start.OutVal, End.OutVal, Alpha);
+        }
+
+        PlacementTransforms.Emplace(
+            PathSpline->GetRotationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World),
+            PathSpline->GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World));
+    }
 }
 
 void APathNPCSpawner::SpawnNPCsAlongPath()
@@ -29,19 +154,347 @@ void APathNPCSpawner::SpawnNPCsAlongPath()
 
     SpawnedNPCs.Empty(NPCCount);
 
-    FRandomStream Random(RandomSeed);
-    float SplineLength = PathSpline->GetSplineLength();
+    BuildPlacements();
 
-    for (int32 i = 0; i < NPCCount; i++)
+    for (const FTransform& Transform : PlacementTransforms)
     {
-        float Distance = Random.FRandRange(0.0f, SplineLength);
-        FVector Location = PathSpline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
-        FRotator Rotation = PathSpline->GetRotationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
-
-        if (AActor* Spawned = GetWorld()->SpawnActor<AActor>(NPCClass, Location, Rotation))
+        if (AActor* Spawned = GetWorld()->SpawnActor<AActor>(NPCClass, Transform))
         {
             SpawnedNPCs.Add(Spawned);
         }
     }
 }
 
+void APathNPCSpawner::StartCrowdSpawning()
+{
+    if (!PathSpline || !NPCClass)
+    {
+        return;
+    }
+
+    // Any crowd from a previous run goes back to the pool
+    for (AActor* NPC : CrowdNPCs)
+    {
+        ReleaseNPC(NPC);
+    }
+    for (AActor* NPC : SlotActors)
+    {
+        ReleaseNPC(NPC);
+    }
+
+    BuildPlacements();
+
+    CrowdNPCs.Reset();
+    CrowdNPCs.SetNumZeroed(PlacementDistances.Num());
+    PlacementSlots.Init(INDEX_NONE, PlacementDistances.Num());
+    FirstActivePlacement = 0;
+    NextPlacement = 0;
+    NumActiveCrowdNPCs = 0;
+
+    CrowdSimulation.Reset();
+    CrowdSimulation.BuildTrack(*PathSpline);
+    SlotPlacements.Reset();
+    SlotSignificance.Reset();
+    SlotActors.Reset();
+    FreeSlots.Reset();
+    PromotedSlots.Reset();
+
+    CrowdInstances->ClearInstances();
+    if (bInstancedCrowd && CrowdMesh)
+    {
+        CrowdInstances->SetStaticMesh(CrowdMesh);
+    }
+
+    SetActorTickEnabled(PlacementDistances.Num() > 0);
+}
+
+void APathNPCSpawner::UpdateCrowd(float RiderDistance)
+{
+    // Without a rider the whole path is in range and the crowd fills in batches
+    const float WindowStart = RiderDistance >= 0.0f ? RiderDistance - DespawnDistanceBehind : -UE_BIG_NUMBER;
+    const float WindowEnd = RiderDistance >= 0.0f ? RiderDistance + SpawnDistanceAhead : UE_BIG_NUMBER;
+
+    if (bInstancedCrowd)
+    {
+        // Instanced NPCs walk, so they may have fallen behind well before or after their placement
+        for (int32 Slot = 0; Slot < SlotPlacements.Num(); Slot++)
+        {
+            if (SlotPlacements[Slot] != INDEX_NONE && CrowdSimulation.GetAgentDistance(Slot) < WindowStart)
+            {
+                DeactivatePlacement(SlotPlacements[Slot]);
+            }
+        }
+        while (FirstActivePlacement < NextPlacement && PlacementSlots[FirstActivePlacement] == INDEX_NONE)
+        {
+            FirstActivePlacement++;
+        }
+    }
+    else
+    {
+        while (FirstActivePlacement < NextPlacement && PlacementDistances[FirstActivePlacement] < WindowStart)
+        {
+            DeactivatePlacement(FirstActivePlacement);
+            FirstActivePlacement++;
+        }
+    }
+
+    // Placements the rider passed before they were spawned are skipped outright
+    if (FirstActivePlacement == NextPlacement)
+    {
+        while (NextPlacement < PlacementDistances.Num() && PlacementDistances[NextPlacement] < WindowStart)
+        {
+            NextPlacement++;
+        }
+        FirstActivePlacement = NextPlacement;
+    }
+
+    for (int32 Spawned = 0; Spawned < SpawnBatchSize && NextPlacement < PlacementDistances.Num() && PlacementDistances[NextPlacement] <= WindowEnd; Spawned++)
+    {
+        ActivatePlacement(NextPlacement);
+        NextPlacement++;
+    }
+
+    if (FirstActivePlacement >= PlacementDistances.Num())
+    {
+        SetActorTickEnabled(false);
+    }
+}
+
+void APathNPCSpawner::ActivatePlacement(int32 Placement)
+{
+    if (bInstancedCrowd)
+    {
+        PlacementSlots[Placement] = AllocateSlot(Placement);
+        NumActiveCrowdNPCs++;
+    }
+    else if (AActor* NPC = AcquireNPC(PlacementTransforms[Placement]))
+    {
+        CrowdNPCs[Placement] = NPC;
+        NumActiveCrowdNPCs++;
+    }
+}
+
+void APathNPCSpawner::DeactivatePlacement(int32 Placement)
+{
+    if (PlacementSlots[Placement] != INDEX_NONE)
+    {
+        FreeSlot(PlacementSlots[Placement]);
+        PlacementSlots[Placement] = INDEX_NONE;
+        NumActiveCrowdNPCs--;
+    }
+    else if (CrowdNPCs[Placement])
+    {
+        ReleaseNPC(CrowdNPCs[Placement]);
+        CrowdNPCs[Placement] = nullptr;
+        NumActiveCrowdNPCs--;
+    }
+}
+
+AActor* APathNPCSpawner::AcquireNPC(const FTransform& Transform)
+{
+    AActor* NPC = nullptr;
+    while (!NPC && NPCPool.Num() > 0)
+    {
+        NPC = NPCPool.Pop(false);
+        NPC = IsValid(NPC) ? NPC : nullptr;
+    }
+
+    if (NPC)
+    {
+        NPC->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+        NPC->SetActorHiddenInGame(false);
+        NPC->SetActorEnableCollision(true);
+        NPC->SetActorTickEnabled(true);
+    }
+    else
+    {
+        NPC = GetWorld()->SpawnActor<AActor>(NPCClass, Transform);
+        NumCrowdActorsCreated += NPC ? 1 : 0;
+    }
+
+    return NPC;
+}
+
+void APathNPCSpawner::ReleaseNPC(AActor* NPC)
+{
+    if (!IsValid(NPC))
+    {
+        return;
+    }
+
+    NPC->SetActorHiddenInGame(true);
+    NPC->SetActorEnableCollision(false);
+    NPC->SetActorTickEnabled(false);
+    NPCPool.Add(NPC);
+}
+
+int32 APathNPCSpawner::AllocateSlot(int32 Placement)
+{
+    // Each placement always walks the same way at the same pace
+    FRandomStream Random(HashCombine(GetTypeHash(RandomSeed), GetTypeHash(Placement)));
+    const float Speed = CrowdWalkSpeed * Random.FRandRange(1.0f - CrowdWalkSpeedVariance, 1.0f + CrowdWalkSpeedVariance) * (Random.GetFraction() < 0.5f ? -1.0f : 1.0f);
+    const float Lane = Random.FRandRange(-CrowdLaneHalfWidth, CrowdLaneHalfWidth);
+    const float Phase = Random.FRandRange(0.0f, UE_TWO_PI);
+
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(false);
+        CrowdSimulation.SetAgent(Slot, PlacementDistances[Placement], Speed, Lane, Phase);
+    }
+    else
+    {
+        Slot = CrowdSimulation.AddAgent(PlacementDistances[Placement], Speed, Lane, Phase);
+        SlotPlacements.AddUninitialized();
+        SlotSignificance.AddUninitialized();
+        SlotActors.AddZeroed();
+        CrowdInstances->AddInstance(CrowdSimulation.GetTransforms()[Slot], true);
+    }
+
+    SlotPlacements[Slot] = Placement;
+    SlotSignificance[Slot] = 0.0f;
+    return Slot;
+}
+
+void APathNPCSpawner::FreeSlot(int32 Slot)
+{
+    if (SlotActors[Slot])
+    {
+        ReleaseNPC(SlotActors[Slot]);
+        SlotActors[Slot] = nullptr;
+        PromotedSlots.RemoveSingleSwap(Slot, false);
+    }
+    SlotPlacements[Slot] = INDEX_NONE;
+    CrowdSimulation.DeactivateAgent(Slot);
+    FreeSlots.Add(Slot);
+}
+
+void APathNPCSpawner::PromoteSlot(int32 Slot)
+{
+    if (AActor* NPC = AcquireNPC(CrowdSimulation.GetTransforms()[Slot]))
+    {
+        SlotActors[Slot] = NPC;
+        CrowdSimulation.SetAgentVisible(Slot, false);
+        PromotedSlots.Add(Slot);
+    }
+}
+
+void APathNPCSpawner::DemoteSlot(int32 Slot)
+{
+    // The agent kept walking under the actor, so the instance carries on from where the actor got to
+    ReleaseNPC(SlotActors[Slot]);
+    SlotActors[Slot] = nullptr;
+    CrowdSimulation.SetAgentVisible(Slot, true);
+    PromotedSlots.RemoveSingleSwap(Slot, false);
+}
+
+void APathNPCSpawner::UpdateCrowdInstances(float DeltaTime)
+{
+    if (CrowdSimulation.Num() == 0)
+    {
+        return;
+    }
+
+    CrowdSimulation.Step(DeltaTime);
+    const TArray<FTransform>& Transforms = CrowdSimulation.GetTransforms();
+    CrowdInstances->BatchUpdateInstancesTransforms(0, Transforms, true, true, false);
+
+    // Promoted actors follow their hidden agents; the agent transform is scaled away, so only place them
+    for (const int32 Slot : PromotedSlots)
+    {
+        AActor* NPC = SlotActors[Slot];
+        if (IsValid(NPC))
+        {
+            NPC->SetActorLocationAndRotation(Transforms[Slot].GetLocation(), Transforms[Slot].GetRotation());
+        }
+    }
+}
+
+void APathNPCSpawner::UpdateSignificance(const FVector& ViewLocation, const FVector& ViewDirection)
+{
+    const FVector Forward = ViewDirection.GetSafeNormal();
+    const float InvDistance = 1.0f / FMath::Max(SignificanceDistance, 1.0f);
+
+    PromotionCandidates.Reset();
+    for (int32 Slot = 0; Slot < SlotPlacements.Num(); Slot++)
+    {
+        if (SlotPlacements[Slot] == INDEX_NONE)
+        {
+            continue;
+        }
+
+        // A promoted actor destroyed behind our back is simply dropped from the actor tier
+        AActor* NPC = SlotActors[Slot];
+        if (NPC && !IsValid(NPC))
+        {
+            DemoteSlot(Slot);
+            NPC = nullptr;
+        }
+
+        const FVector ToNPC = (NPC ? NPC->GetActorLocation() : CrowdSimulation.GetTransforms()[Slot].GetLocation()) - ViewLocation;
+        const float Distance = ToNPC.Size();
+        const float DistanceScore = FMath::Clamp(1.0f - Distance * InvDistance, 0.0f, 1.0f);
+        const float Facing = Distance > UE_KINDA_SMALL_NUMBER ? FVector::DotProduct(ToNPC / Distance, Forward) : 1.0f;
+        const float Significance = DistanceScore * FMath::Lerp(BehindViewWeight, 1.0f, (Facing + 1.0f) * 0.5f);
+        SlotSignificance[Slot] = Significance;
+
+        if (NPC)
+        {
+            if (Significance < DemoteSignificance)
+            {
+                DemoteSlot(Slot);
+            }
+        }
+        else if (Significance >= PromoteSignificance)
+        {
+            PromotionCandidates.Add(Slot);
+        }
+    }
+
+    if (PromotionCandidates.Num() > 0 && PromotedSlots.Num() < MaxFullActors)
+    {
+        PromotionCandidates.Sort([this](int32 A, int32 B) { return SlotSignificance[A] > SlotSignificance[B]; });
+        for (int32 Index = 0; Index < PromotionCandidates.Num() && PromotedSlots.Num() < MaxFullActors; Index++)
+        {
+            PromoteSlot(PromotionCandidates[Index]);
+        }
+    }
+}
+
+bool APathNPCSpawner::GetSignificanceView(FVector& OutLocation, FVector& OutDirection) const
+{
+    if (const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr)
+    {
+        FRotator ViewRotation;
+        PC->GetPlayerViewPoint(OutLocation, ViewRotation);
+        OutDirection = ViewRotation.Vector();
+        return true;
+    }
+
+    if (const AActor* Rider = TrackedRider.Get())
+    {
+        OutLocation = Rider->GetActorLocation();
+        OutDirection = Rider->GetActorForwardVector();
+        return true;
+    }
+
+    return false;
+}
+
+float APathNPCSpawner::GetRiderDistance() const
+{
+    const AActor* Rider = TrackedRider.Get();
+    if (!Rider)
+    {
+        const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+        Rider = PC ? PC->GetPawn() : nullptr;
+    }
+
+    if (!Rider || !PathSpline)
+    {
+        return -1.0f;
+    }
+
+    const float InputKey = PathSpline->FindInputKeyClosestToWorldLocation(Rider->GetActorLocation());
+    return PathSpline->GetDistanceAlongSplineAtSplineInputKey(InputKey);
+}
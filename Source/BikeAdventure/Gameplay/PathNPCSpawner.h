@@ -2,12 +2,25 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "PathCrowdSimulation.h"
 #include "PathNPCSpawner.generated.h"
 
 class USplineComponent;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
 
 /**
- * Spawns NPCs along a spline path using procedural placement
+ * Spawns NPCs along a spline path using procedural placement.
+ *
+ * Placements are sampled once, sorted by distance along the path and evaluated in a single
+ * forward walk of the spline. By default every NPC is spawned in BeginPlay. Crowd mode instead
+ * keeps only the NPCs within a window around the rider: placements entering the window are
+ * spawned a batch per frame from a pool, and NPCs that fall behind the rider go back to it.
+ *
+ * With an instanced crowd, NPCs in the window are instances of CrowdMesh walking the path,
+ * moved together by FPathCrowdSimulation and uploaded in one batch. Each frame a significance score from distance and
+ * view direction promotes the few most significant NPCs to pooled NPCClass actors and demotes
+ * them again once they lose significance.
  */
 UCLASS()
 class BIKEADVENTURE_API APathNPCSpawner : public AActor
@@ -17,6 +30,8 @@ class BIKEADVENTURE_API APathNPCSpawner : public AActor
 public:
     APathNPCSpawner();
 
+    virtual void Tick(float DeltaTime) override;
+
     /** Path spline along which NPCs are spawned */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner")
     USplineComponent* PathSpline;
@@ -26,7 +41,7 @@ public:
     TSubclassOf<AActor> NPCClass;
 
     /** Number of NPCs to spawn */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner", meta=(ClampMin="0", ClampMax="100"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner", meta=(ClampMin="0", ClampMax="2000", UIMax="100"))
     int32 NPCCount;
 
     /** Seed for procedural placement */
@@ -37,11 +52,174 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="NPC Spawner")
     TArray<AActor*> SpawnedNPCs;
 
+    /** Stream NPCs in around the rider instead of spawning them all in BeginPlay */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Crowd")
+    bool bCrowdMode;
+
+    /** Most NPCs spawned or taken from the pool in one frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Crowd", meta=(ClampMin="1"))
+    int32 SpawnBatchSize;
+
+    /** Path distance ahead of the rider within which NPCs are present */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Crowd", meta=(ClampMin="0"))
+    float SpawnDistanceAhead;
+
+    /** Path distance behind the rider after which NPCs are returned to the pool */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Crowd", meta=(ClampMin="0"))
+    float DespawnDistanceBehind;
+
+    /** Represent crowd NPCs as mesh instances, promoting only significant ones to actors */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd")
+    bool bInstancedCrowd;
+
+    /** Mesh drawn for NPCs that are not promoted */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd")
+    UStaticMesh* CrowdMesh;
+
+    /** Instances of CrowdMesh, one per crowd slot; free and promoted slots are scaled to zero */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="NPC Spawner|Instanced Crowd")
+    UInstancedStaticMeshComponent* CrowdInstances;
+
+    /** Most NPCs promoted to full actors at once */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd", meta=(ClampMin="0"))
+    int32 MaxFullActors;
+
+    /** Distance from the viewer at which significance falls to zero */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd", meta=(ClampMin="1"))
+    float SignificanceDistance;
+
+    /** Significance weight of an NPC straight behind the viewer, relative to one straight ahead */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd", meta=(ClampMin="0", ClampMax="1"))
+    float BehindViewWeight;
+
+    /** Significance at which an instance is promoted to an actor */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd", meta=(ClampMin="0", ClampMax="1"))
+    float PromoteSignificance;
+
+    /** Significance below which an actor is demoted back to an instance; lower than PromoteSignificance */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd", meta=(ClampMin="0", ClampMax="1"))
+    float DemoteSignificance;
+
+    /** Average walking speed of instanced NPCs, in cm/s; each walks one way or the other along the path */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd", meta=(ClampMin="0"))
+    float CrowdWalkSpeed;
+
+    /** Fraction by which an NPC's walking speed may differ from the average */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd", meta=(ClampMin="0", ClampMax="1"))
+    float CrowdWalkSpeedVariance;
+
+    /** Farthest an NPC's lane sits from the path centre */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NPC Spawner|Instanced Crowd", meta=(ClampMin="0"))
+    float CrowdLaneHalfWidth;
+
     /** Generate NPCs along the path */
     UFUNCTION(BlueprintCallable, Category="NPC Spawner")
     void SpawnNPCsAlongPath();
 
+    /** Build the crowd placements and start streaming NPCs in around the rider */
+    UFUNCTION(BlueprintCallable, Category="NPC Spawner|Crowd")
+    void StartCrowdSpawning();
+
+    /**
+     * Advance the crowd window to the rider's distance along the path: release NPCs that fell
+     * behind, then spawn up to SpawnBatchSize of the placements that came into range. Instanced
+     * NPCs are released by where they have walked to, the rest by where they were placed.
+     * Called every tick in crowd mode; the rider is assumed to only move forward.
+     */
+    UFUNCTION(BlueprintCallable, Category="NPC Spawner|Crowd")
+    void UpdateCrowd(float RiderDistance);
+
+    /** Walk every instanced NPC on by DeltaTime, push all instance transforms in one batch and move promoted actors with their NPCs */
+    UFUNCTION(BlueprintCallable, Category="NPC Spawner|Instanced Crowd")
+    void UpdateCrowdInstances(float DeltaTime);
+
+    /** Score instanced NPCs against the view, then demote and promote across the actor tier */
+    UFUNCTION(BlueprintCallable, Category="NPC Spawner|Instanced Crowd")
+    void UpdateSignificance(const FVector& ViewLocation, const FVector& ViewDirection);
+
+    /** Actor whose distance along the path drives the crowd window; defaults to the player pawn */
+    UFUNCTION(BlueprintCallable, Category="NPC Spawner|Crowd")
+    void SetTrackedRider(AActor* Rider) { TrackedRider = Rider; }
+
+    /** Placement distances along the path, ascending */
+    const TArray<float>& GetPlacementDistances() const { return PlacementDistances; }
+
+    /** World transforms of the placements, in the same order */
+    const TArray<FTransform>& GetPlacementTransforms() const { return PlacementTransforms; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="NPC Spawner|Crowd")
+    int32 GetNumActiveCrowdNPCs() const { return NumActiveCrowdNPCs; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="NPC Spawner|Crowd")
+    int32 GetNumPooledNPCs() const { return NPCPool.Num(); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="NPC Spawner|Instanced Crowd")
+    int32 GetNumPromotedNPCs() const { return PromotedSlots.Num(); }
+
+    /** Crowd slots allocated, in use or free; matches the instance count of CrowdInstances */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="NPC Spawner|Instanced Crowd")
+    int32 GetNumCrowdSlots() const { return SlotPlacements.Num(); }
+
+    /** Actors created by the crowd, active or pooled; stays near the window size thanks to the pool */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="NPC Spawner|Crowd")
+    int32 GetNumCrowdActorsCreated() const { return NumCrowdActorsCreated; }
+
 protected:
     virtual void BeginPlay() override;
-};
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    /** Sample NPCCount distances, sort them and evaluate their transforms in one forward walk */
+    void BuildPlacements();
+
+    void ActivatePlacement(int32 Placement);
+    void DeactivatePlacement(int32 Placement);
+
+    AActor* AcquireNPC(const FTransform& Transform);
+    void ReleaseNPC(AActor* NPC);
+
+    int32 AllocateSlot(int32 Placement);
+    void FreeSlot(int32 Slot);
+    void PromoteSlot(int32 Slot);
+    void DemoteSlot(int32 Slot);
 
+    /** View used for significance: the player camera, else the rider's facing */
+    bool GetSignificanceView(FVector& OutLocation, FVector& OutDirection) const;
+
+    /** Rider distance along the path, or a negative value when there is no rider */
+    float GetRiderDistance() const;
+
+    TArray<float> PlacementDistances;
+    TArray<FTransform> PlacementTransforms;
+
+    /** Crowd NPC per placement, null outside the window or in an instanced crowd */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AActor>> CrowdNPCs;
+
+    /** Crowd slot per placement in an instanced crowd, INDEX_NONE outside the window */
+    TArray<int32> PlacementSlots;
+
+    /** Instanced crowd slots, slot i being simulation agent i and drawing instance i; SlotPlacements is INDEX_NONE for free slots */
+    FPathCrowdSimulation CrowdSimulation;
+    TArray<int32> SlotPlacements;
+    TArray<float> SlotSignificance;
+    TArray<int32> FreeSlots;
+    TArray<int32> PromotedSlots;
+    TArray<int32> PromotionCandidates;
+
+    /** Actor standing in for each promoted slot */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AActor>> SlotActors;
+
+    /** Hidden, collision-free NPCs ready for reuse */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AActor>> NPCPool;
+
+    /** Crowd window over the sorted placements: [FirstActivePlacement, NextPlacement) may be live */
+    int32 FirstActivePlacement = 0;
+    int32 NextPlacement = 0;
+    int32 NumActiveCrowdNPCs = 0;
+    int32 NumCrowdActorsCreated = 0;
+
+    TWeakObjectPtr<AActor> TrackedRider;
+};
@@ -4,6 +4,10 @@
 #include "Elements/PCGPointData.h"
 #include "Engine/Engine.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/StreamableManager.h"
+#include "IntersectionAssetPrefetcher.h"
+#include "BiomeAssetPrefetcher.h"
+#include "Algo/StableSort.h"
 
 // Beach PCG Settings
 UBeachPCGSettings::UBeachPCGSettings()
@@ -1171,18 +1175,15 @@ void FAdvancedBiomeGenerationElement::ScatterObjects(FRandomStream& Random, TArr
 }
 
 // Biome Preset Manager Implementation
-void UBiomePresetManager::LoadBiomePresets()
+void UBiomePresetManager::LoadBiomePresets(EBiomeType CurrentBiome)
 {
     FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
     
     TArray<FAssetData> PresetAssets;
     AssetRegistryModule.Get().GetAssetsByClass(UBiomeGenerationPreset::StaticClass()->GetFName(), PresetAssets);
     
-    // Clear existing data
-    BiomePresets.Empty();
-    DefaultPresets.Empty();
-    LoadedBiomePresets.Empty();
-    LoadedDefaultPresets.Empty();
+    // Clear existing data; callers still waiting are answered once the fresh loads finish
+    ResetBiomeLoads();
 
     for (const FAssetData& AssetData : PresetAssets)
     {
@@ -1233,59 +1234,369 @@ void UBiomePresetManager::LoadBiomePresets()
     }
     
     UE_LOG(LogTemp, Log, TEXT("Discovered %d biome presets via Asset Registry"), PresetAssets.Num());
+
+    WarmBiomes(CurrentBiome);
 }
 
-UBiomeGenerationPreset* UBiomePresetManager::GetPresetForBiome(EBiomeType BiomeType)
+void UBiomePresetManager::LoadBiomePresetsFromPaths(const TMap<EBiomeType, TArray<FSoftObjectPath>>& PresetPaths, EBiomeType CurrentBiome)
 {
-    // Check cache first
-    if (UBiomeGenerationPreset** CachedDefault = LoadedDefaultPresets.Find(BiomeType))
+    ResetBiomeLoads();
+
+    for (const TPair<EBiomeType, TArray<FSoftObjectPath>>& Pair : PresetPaths)
     {
-        return *CachedDefault;
+        if (!BiomeTables::IsValidBiome(Pair.Key) || Pair.Value.Num() == 0)
+        {
+            continue;
+        }
+
+        TArray<TSoftObjectPtr<UBiomeGenerationPreset>>& Presets = BiomePresets.FindOrAdd(Pair.Key);
+        for (const FSoftObjectPath& Path : Pair.Value)
+        {
+            Presets.Add(TSoftObjectPtr<UBiomeGenerationPreset>(Path));
+        }
+        DefaultPresets.Add(Pair.Key, Presets[0]);
     }
 
-    TSoftObjectPtr<UBiomeGenerationPreset>* DefaultPreset = DefaultPresets.Find(BiomeType);
-    if (DefaultPreset)
+    WarmBiomes(CurrentBiome);
+}
+
+void UBiomePresetManager::ResetBiomeLoads()
+{
+    BiomePresets.Empty();
+    DefaultPresets.Empty();
+    LoadedBiomePresets.Empty();
+    LoadedDefaultPresets.Empty();
+    for (FBiomeLoadState& State : LoadStates)
     {
-        UBiomeGenerationPreset* LoadedPreset = DefaultPreset->LoadSynchronous();
-        if (LoadedPreset)
+        if (State.PresetHandle.IsValid())
         {
-            LoadedDefaultPresets.Add(BiomeType, LoadedPreset);
-            return LoadedPreset;
+            State.PresetHandle->CancelHandle();
         }
+        if (State.AssetHandle.IsValid())
+        {
+            State.AssetHandle->CancelHandle();
+        }
+        State.PresetHandle.Reset();
+        State.AssetHandle.Reset();
+        State.Presets.Reset();
+        State.DefaultPreset = nullptr;
+        State.bRequested = false;
+        State.bReady = false;
+    }
+}
+
+void UBiomePresetManager::WarmBiomes(EBiomeType CurrentBiome)
+{
+    if (BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        UpdateForBiome(CurrentBiome);
+        return;
     }
 
-    return nullptr;
+    // No rider yet: warm every biome in the background, the likeliest destinations at the highest priority
+    TArray<EBiomeType> Order;
+    GetPredictedBiomeOrder(CurrentBiome, Order);
+    for (int32 Rank = 0; Rank < Order.Num(); Rank++)
+    {
+        StartBiomeLoad(Order[Rank], FStreamableManager::DefaultAsyncLoadPriority + Order.Num() - Rank);
+    }
 }
 
-TArray<UBiomeGenerationPreset*> UBiomePresetManager::GetPresetsForBiome(EBiomeType BiomeType)
+void UBiomePresetManager::UpdateForBiome(EBiomeType CurrentBiome)
 {
-    // Check cache first
-    if (TArray<UBiomeGenerationPreset*>* CachedPresets = LoadedBiomePresets.Find(BiomeType))
+    if (!BiomeTables::IsValidBiome(CurrentBiome))
     {
-        return *CachedPresets;
+        return;
+    }
+
+    int32 Distances[BiomeTables::NumBiomes];
+    UBiomeAssetPrefetcher::GetTransitionDistances(CurrentBiome, Distances);
+
+    TArray<EBiomeType> Order;
+    GetPredictedBiomeOrder(CurrentBiome, Order);
+    for (int32 Rank = 0; Rank < Order.Num(); Rank++)
+    {
+        const int32 Index = static_cast<int32>(Order[Rank]);
+        if (Distances[Index] != INDEX_NONE && Distances[Index] <= RetainDepth)
+        {
+            StartBiomeLoad(Order[Rank], FStreamableManager::DefaultAsyncLoadPriority + Order.Num() - Rank);
+        }
+        else if (LoadStates[Index].Waiters.Num() == 0)
+        {
+            ReleaseBiome(Order[Rank]);
+        }
     }
+}
 
-    TArray<UBiomeGenerationPreset*> Results;
-    TArray<TSoftObjectPtr<UBiomeGenerationPreset>>* Presets = BiomePresets.Find(BiomeType);
+void UBiomePresetManager::GetPredictedBiomeOrder(EBiomeType CurrentBiome, TArray<EBiomeType>& OutOrder)
+{
+    OutOrder.Reset(BiomeTables::NumBiomes);
 
-    if (Presets)
+    bool bQueued[BiomeTables::NumBiomes] = {};
+    if (BiomeTables::IsValidBiome(CurrentBiome))
     {
-        for (TSoftObjectPtr<UBiomeGenerationPreset>& PresetPtr : *Presets)
+        OutOrder.Add(CurrentBiome);
+        bQueued[static_cast<int32>(CurrentBiome)] = true;
+
+        // Breadth first, so biomes one transition away come before those two away
+        for (int32 Head = 0; Head < OutOrder.Num(); Head++)
         {
-            if (UBiomeGenerationPreset* LoadedPreset = PresetPtr.LoadSynchronous())
+            for (EBiomeType Next : UBiomeUtilities::GetDefaultTransitionRulesRef(OutOrder[Head]).ValidTransitions)
             {
-                Results.Add(LoadedPreset);
+                if (BiomeTables::IsValidBiome(Next) && !bQueued[static_cast<int32>(Next)])
+                {
+                    OutOrder.Add(Next);
+                    bQueued[static_cast<int32>(Next)] = true;
+                }
             }
         }
+    }
 
-        // Cache the results
-        if (Results.Num() > 0)
+    // Unreachable biomes, or every biome with no current one, by how many biomes lead into them
+    int32 InDegree[BiomeTables::NumBiomes] = {};
+    for (int32 Index = 0; Index < BiomeTables::NumBiomes; Index++)
+    {
+        for (EBiomeType Next : UBiomeUtilities::GetDefaultTransitionRulesRef(static_cast<EBiomeType>(Index)).ValidTransitions)
+        {
+            if (BiomeTables::IsValidBiome(Next))
+            {
+                InDegree[static_cast<int32>(Next)]++;
+            }
+        }
+    }
+
+    const int32 FirstUnreached = OutOrder.Num();
+    for (int32 Index = 0; Index < BiomeTables::NumBiomes; Index++)
+    {
+        if (!bQueued[Index])
+        {
+            OutOrder.Add(static_cast<EBiomeType>(Index));
+        }
+    }
+    Algo::StableSort(MakeArrayView(OutOrder).RightChop(FirstUnreached), [&InDegree](EBiomeType A, EBiomeType B)
+    {
+        return InDegree[static_cast<int32>(A)] > InDegree[static_cast<int32>(B)];
+    });
+}
+
+void UBiomePresetManager::StartBiomeLoad(EBiomeType BiomeType, int32 Priority)
+{
+    if (!BiomeTables::IsValidBiome(BiomeType))
+    {
+        return;
+    }
+
+    FBiomeLoadState& State = LoadStates[static_cast<int32>(BiomeType)];
+    if (State.bRequested || State.bReady)
+    {
+        return;
+    }
+    State.bRequested = true;
+    State.Priority = Priority;
+
+    TArray<FSoftObjectPath> PresetPaths;
+    if (const TArray<TSoftObjectPtr<UBiomeGenerationPreset>>* Presets = BiomePresets.Find(BiomeType))
+    {
+        for (const TSoftObjectPtr<UBiomeGenerationPreset>& PresetPtr : *Presets)
+        {
+            PresetPaths.Add(PresetPtr.ToSoftObjectPath());
+        }
+    }
+
+    if (PresetPaths.Num() == 0)
+    {
+        MarkBiomeReady(BiomeType);
+        return;
+    }
+
+    // The delegate may run inside this call when everything is already resident
+    State.PresetHandle = UIntersectionAssetPrefetcher::GetStreamableManager().RequestAsyncLoad(
+        PresetPaths,
+        FStreamableDelegate::CreateUObject(this, &UBiomePresetManager::OnBiomePresetsLoaded, BiomeType),
+        Priority);
+}
+
+void UBiomePresetManager::OnBiomePresetsLoaded(EBiomeType BiomeType)
+{
+    FBiomeLoadState& State = LoadStates[static_cast<int32>(BiomeType)];
+    TArray<UBiomeGenerationPreset*>& Loaded = State.Presets;
+    Loaded.Reset();
+    if (const TArray<TSoftObjectPtr<UBiomeGenerationPreset>>* Presets = BiomePresets.Find(BiomeType))
+    {
+        for (const TSoftObjectPtr<UBiomeGenerationPreset>& PresetPtr : *Presets)
+        {
+            if (UBiomeGenerationPreset* Preset = PresetPtr.Get())
+            {
+                Loaded.Add(Preset);
+            }
+        }
+    }
+    const TSoftObjectPtr<UBiomeGenerationPreset>* DefaultPreset = DefaultPresets.Find(BiomeType);
+    State.DefaultPreset = DefaultPreset ? DefaultPreset->Get() : nullptr;
+
+    // Second stage: what generation will spawn and play in the biome
+    TArray<FSoftObjectPath> AssetPaths;
+    for (const UBiomeGenerationPreset* Preset : Loaded)
+    {
+        for (const TSoftObjectPtr<UStaticMesh>& Mesh : Preset->PrimaryMeshes)
+        {
+            AssetPaths.AddUnique(Mesh.ToSoftObjectPath());
+        }
+        for (const TSoftObjectPtr<UStaticMesh>& Mesh : Preset->SecondaryMeshes)
+        {
+            AssetPaths.AddUnique(Mesh.ToSoftObjectPath());
+        }
+        for (const TSoftObjectPtr<UMaterialInterface>& Material : Preset->Materials)
+        {
+            AssetPaths.AddUnique(Material.ToSoftObjectPath());
+        }
+        for (const TSoftObjectPtr<UNiagaraSystem>& Effect : Preset->ParticleEffects)
+        {
+            AssetPaths.AddUnique(Effect.ToSoftObjectPath());
+        }
+        for (const TSoftObjectPtr<USoundCue>& Sound : Preset->AmbientSounds)
         {
-            LoadedBiomePresets.Add(BiomeType, Results);
+            AssetPaths.AddUnique(Sound.ToSoftObjectPath());
         }
     }
+    AssetPaths.Remove(FSoftObjectPath());
+
+    if (AssetPaths.Num() == 0)
+    {
+        MarkBiomeReady(BiomeType);
+        return;
+    }
+
+    State.AssetHandle = UIntersectionAssetPrefetcher::GetStreamableManager().RequestAsyncLoad(
+        AssetPaths,
+        FStreamableDelegate::CreateUObject(this, &UBiomePresetManager::MarkBiomeReady, BiomeType),
+        State.Priority);
+}
+
+void UBiomePresetManager::MarkBiomeReady(EBiomeType BiomeType)
+{
+    FBiomeLoadState& State = LoadStates[static_cast<int32>(BiomeType)];
+    if (State.bReady)
+    {
+        return;
+    }
+    State.bReady = true;
+
+    // Presets are handed out only now, so callers never see one whose assets are still loading
+    if (State.Presets.Num() > 0)
+    {
+        LoadedBiomePresets.Add(BiomeType, MoveTemp(State.Presets));
+    }
+    if (State.DefaultPreset)
+    {
+        LoadedDefaultPresets.Add(BiomeType, State.DefaultPreset);
+    }
+    State.Presets.Reset();
+    State.DefaultPreset = nullptr;
+
+    UE_LOG(LogTemp, Verbose, TEXT("Biome presets ready: %s"), *UBiomeUtilities::GetBiomeNameRef(BiomeType));
+
+    // Waiters may queue more work on this manager, so run them from a detached list
+    TArray<TUniqueFunction<void()>> Waiters = MoveTemp(State.Waiters);
+    for (TUniqueFunction<void()>& Waiter : Waiters)
+    {
+        Waiter();
+    }
+
+    OnBiomePresetsReady.Broadcast(BiomeType);
+}
+
+void UBiomePresetManager::ReleaseBiome(EBiomeType BiomeType)
+{
+    FBiomeLoadState& State = LoadStates[static_cast<int32>(BiomeType)];
+    if (!State.bRequested && !State.bReady)
+    {
+        return;
+    }
+
+    if (State.PresetHandle.IsValid())
+    {
+        State.PresetHandle->CancelHandle();
+    }
+    if (State.AssetHandle.IsValid())
+    {
+        State.AssetHandle->CancelHandle();
+    }
+    State.PresetHandle.Reset();
+    State.AssetHandle.Reset();
+    State.Presets.Reset();
+    State.DefaultPreset = nullptr;
+    State.bRequested = false;
+    State.bReady = false;
+
+    // Dropping the hard references lets the presets be collected along with their assets
+    LoadedBiomePresets.Remove(BiomeType);
+    LoadedDefaultPresets.Remove(BiomeType);
+
+    UE_LOG(LogTemp, Verbose, TEXT("Biome presets released: %s"), *UBiomeUtilities::GetBiomeNameRef(BiomeType));
+}
+
+bool UBiomePresetManager::IsBiomeReady(EBiomeType BiomeType) const
+{
+    return BiomeTables::IsValidBiome(BiomeType) && LoadStates[static_cast<int32>(BiomeType)].bReady;
+}
+
+void UBiomePresetManager::WhenBiomeReady(EBiomeType BiomeType, TUniqueFunction<void()>&& Callback)
+{
+    if (!BiomeTables::IsValidBiome(BiomeType) || IsBiomeReady(BiomeType))
+    {
+        Callback();
+        return;
+    }
+
+    LoadStates[static_cast<int32>(BiomeType)].Waiters.Add(MoveTemp(Callback));
+    StartBiomeLoad(BiomeType, FStreamableManager::AsyncLoadHighPriority);
+}
+
+void UBiomePresetManager::RequestPresetForBiome(EBiomeType BiomeType, FOnBiomePresetLoaded OnLoaded)
+{
+    WhenBiomeReady(BiomeType, [WeakThis = TWeakObjectPtr<UBiomePresetManager>(this), BiomeType, OnLoaded]()
+    {
+        UBiomePresetManager* This = WeakThis.Get();
+        OnLoaded.ExecuteIfBound(This ? This->LoadedDefaultPresets.FindRef(BiomeType) : nullptr);
+    });
+}
+
+TFuture<UBiomeGenerationPreset*> UBiomePresetManager::GetPresetForBiomeAsync(EBiomeType BiomeType)
+{
+    TSharedRef<TPromise<UBiomeGenerationPreset*>> Promise = MakeShared<TPromise<UBiomeGenerationPreset*>>();
+    TFuture<UBiomeGenerationPreset*> Future = Promise->GetFuture();
+
+    WhenBiomeReady(BiomeType, [WeakThis = TWeakObjectPtr<UBiomePresetManager>(this), BiomeType, Promise]()
+    {
+        UBiomePresetManager* This = WeakThis.Get();
+        Promise->SetValue(This ? This->LoadedDefaultPresets.FindRef(BiomeType) : nullptr);
+    });
 
-    return Results;
+    return Future;
+}
+
+UBiomeGenerationPreset* UBiomePresetManager::GetPresetForBiome(EBiomeType BiomeType)
+{
+    if (UBiomeGenerationPreset** CachedDefault = LoadedDefaultPresets.Find(BiomeType))
+    {
+        return *CachedDefault;
+    }
+
+    // Not warmed yet: request it rather than loading it here
+    StartBiomeLoad(BiomeType, FStreamableManager::AsyncLoadHighPriority);
+    return nullptr;
+}
+
+TArray<UBiomeGenerationPreset*> UBiomePresetManager::GetPresetsForBiome(EBiomeType BiomeType)
+{
+    if (TArray<UBiomeGenerationPreset*>* CachedPresets = LoadedBiomePresets.Find(BiomeType))
+    {
+        return *CachedPresets;
+    }
+
+    StartBiomeLoad(BiomeType, FStreamableManager::AsyncLoadHighPriority);
+    return TArray<UBiomeGenerationPreset*>();
 }
 
 UBiomePCGSettings* UBiomePresetManager::CreatePCGSettingsFromPreset(UBiomeGenerationPreset* Preset)
@@ -1296,41 +1607,36 @@ UBiomePCGSettings* UBiomePresetManager::CreatePCGSettingsFromPreset(UBiomeGenera
     }
     
     // Create appropriate PCG settings class based on biome type
-    UBiomePCGSettings* Settings = nullptr;
+    UBiomePCGSettings* Settings = NewObject<UBiomePCGSettings>(GetTransientPackage(), GetPCGSettingsClass(Preset->TargetBiome));
     
-    switch (Preset->TargetBiome)
+    if (Settings)
+    {
+        Settings->BiomeType = Preset->TargetBiome;
+        Settings->GenerationParams = Preset->GenerationParams;
+    }
+    
+    return Settings;
+}
+
+TSubclassOf<UBiomePCGSettings> UBiomePresetManager::GetPCGSettingsClass(EBiomeType BiomeType)
+{
+    switch (BiomeType)
     {
         case EBiomeType::Urban:
-            Settings = NewObject<UUrbanPCGSettings>();
-            break;
+            return UUrbanPCGSettings::StaticClass();
         case EBiomeType::Countryside:
-            Settings = NewObject<UCountrysidePCGSettings>();
-            break;
+            return UCountrysidePCGSettings::StaticClass();
         case EBiomeType::Mountains:
-            Settings = NewObject<UMountainPCGSettings>();
-            break;
+            return UMountainPCGSettings::StaticClass();
         case EBiomeType::Wetlands:
-            Settings = NewObject<UWetlandsPCGSettings>();
-            break;
+            return UWetlandsPCGSettings::StaticClass();
         case EBiomeType::Forest:
-            Settings = NewObject<UForestPCGSettings>();
-            break;
+            return UForestPCGSettings::StaticClass();
         case EBiomeType::Desert:
-            Settings = NewObject<UDesertPCGSettings>();
-            break;
+            return UDesertPCGSettings::StaticClass();
         case EBiomeType::Beach:
-            Settings = NewObject<UBeachPCGSettings>();
-            break;
+            return UBeachPCGSettings::StaticClass();
         default:
-            Settings = NewObject<UBiomePCGSettings>();
-            break;
+            return UBiomePCGSettings::StaticClass();
     }
-    
-    if (Settings)
-    {
-        Settings->BiomeType = Preset->TargetBiome;
-        Settings->GenerationParams = Preset->GenerationParams;
-    }
-    
-    return Settings;
-}
\ No newline at end of file
+}
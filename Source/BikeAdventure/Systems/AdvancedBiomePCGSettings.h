@@ -4,8 +4,11 @@
 #include "BiomeGenerator.h"
 #include "PCGSettings.h"
 #include "PCGElement.h"
+#include "Async/Future.h"
 #include "AdvancedBiomePCGSettings.generated.h"
 
+struct FStreamableHandle;
+
 /**
  * Beach-specific PCG settings with palm trees and sandcastles
  */
@@ -565,8 +568,16 @@ public:
     TArray<TSoftObjectPtr<USoundCue>> AmbientSounds;
 };
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBiomePresetsReady, EBiomeType, BiomeType);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnBiomePresetLoaded, UBiomeGenerationPreset*, Preset);
+
 /**
- * Manager class for biome generation presets
+ * Manager class for biome generation presets.
+ * Presets are discovered through the asset registry and warmed in the background: each biome's
+ * presets are loaded asynchronously, then the meshes, materials, effects and sounds they
+ * reference. Biomes are requested in the order the rider is likely to reach them, so nothing
+ * is ever loaded synchronously on first entry into a biome. Once the rider's biome is known, only
+ * biomes within RetainDepth transitions are kept resident and farther ones are released.
  */
 UCLASS(BlueprintType, Blueprintable)
 class BIKEADVENTURE_API UBiomePresetManager : public UObject
@@ -575,29 +586,87 @@ class BIKEADVENTURE_API UBiomePresetManager : public UObject
 
 public:
     /**
-     * Load all available biome presets
+     * Discover all available biome presets and start warming them in the background
+     * @param CurrentBiome - Biome the rider is in; biomes reachable in fewer transitions are loaded first
+     */
+    UFUNCTION(BlueprintCallable, Category = "Biome Presets")
+    void LoadBiomePresets(EBiomeType CurrentBiome = EBiomeType::None);
+
+    /**
+     * Warm the given presets instead of those the asset registry knows about, as LoadBiomePresets
+     * @param PresetPaths - Presets of each biome; the first one is the biome's default
+     */
+    void LoadBiomePresetsFromPaths(const TMap<EBiomeType, TArray<FSoftObjectPath>>& PresetPaths, EBiomeType CurrentBiome = EBiomeType::None);
+
+    /**
+     * The rider is now in CurrentBiome: warm every biome within RetainDepth transitions of it,
+     * nearest first, and release the presets and assets of farther biomes nobody is waiting for
      */
     UFUNCTION(BlueprintCallable, Category = "Biome Presets")
-    void LoadBiomePresets();
+    void UpdateForBiome(EBiomeType CurrentBiome);
 
     /**
      * Get preset for a specific biome type
+     * Never blocks: returns null until the biome is ready, requesting it at high priority if it has not been requested
      */
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Biome Presets")
+    UFUNCTION(BlueprintCallable, Category = "Biome Presets")
     UBiomeGenerationPreset* GetPresetForBiome(EBiomeType BiomeType);
 
     /**
      * Get all available presets for a biome type
+     * Never blocks: returns an empty array until the biome is ready, requesting it at high priority if it has not been requested
      */
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Biome Presets")
+    UFUNCTION(BlueprintCallable, Category = "Biome Presets")
     TArray<UBiomeGenerationPreset*> GetPresetsForBiome(EBiomeType BiomeType);
 
+    /**
+     * Whether a biome's presets and the assets they reference are resident
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Biome Presets")
+    bool IsBiomeReady(EBiomeType BiomeType) const;
+
+    /**
+     * Call back with the biome's default preset once it is ready; immediately if it already is
+     */
+    UFUNCTION(BlueprintCallable, Category = "Biome Presets")
+    void RequestPresetForBiome(EBiomeType BiomeType, FOnBiomePresetLoaded OnLoaded);
+
+    /**
+     * Future fulfilled on the game thread with the biome's default preset once it is ready
+     */
+    TFuture<UBiomeGenerationPreset*> GetPresetForBiomeAsync(EBiomeType BiomeType);
+
+    /**
+     * Run Callback on the game thread once the biome is ready; immediately if it already is
+     */
+    void WhenBiomeReady(EBiomeType BiomeType, TUniqueFunction<void()>&& Callback);
+
     /**
      * Create PCG settings from preset
      */
     UFUNCTION(BlueprintCallable, Category = "Biome Presets")
     UBiomePCGSettings* CreatePCGSettingsFromPreset(UBiomeGenerationPreset* Preset);
 
+    /**
+     * Biomes in the order the rider is predicted to reach them: breadth first over the default
+     * transition rules from CurrentBiome, then any unreachable biomes. With no current biome,
+     * biomes that more biomes lead into come first.
+     */
+    static void GetPredictedBiomeOrder(EBiomeType CurrentBiome, TArray<EBiomeType>& OutOrder);
+
+    /**
+     * PCG settings class generating the given biome; the base class for None
+     */
+    static TSubclassOf<UBiomePCGSettings> GetPCGSettingsClass(EBiomeType BiomeType);
+
+    // Broadcast when a biome's presets and their assets become resident
+    UPROPERTY(BlueprintAssignable, Category = "Biome Presets")
+    FOnBiomePresetsReady OnBiomePresetsReady;
+
+    // Transitions from the rider's biome within which presets and their assets stay resident
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome Presets", meta = (ClampMin = "0", ClampMax = "6"))
+    int32 RetainDepth = 2;
+
 protected:
     // Discovered biome presets mapped by biome type (not yet loaded)
     UPROPERTY()
@@ -607,11 +676,41 @@ protected:
     UPROPERTY()
     TMap<EBiomeType, TSoftObjectPtr<UBiomeGenerationPreset>> DefaultPresets;
 
-    // Cache of loaded presets to prevent repeated synchronous loading
+    // Presets of every ready biome
     UPROPERTY()
     TMap<EBiomeType, TArray<UBiomeGenerationPreset*>> LoadedBiomePresets;
 
-    // Cache of loaded default presets
+    // Default preset of every ready biome
     UPROPERTY()
     TMap<EBiomeType, UBiomeGenerationPreset*> LoadedDefaultPresets;
+
+private:
+    /** Background load progress of one biome: presets first, then the assets they reference */
+    struct FBiomeLoadState
+    {
+        TSharedPtr<FStreamableHandle> PresetHandle;
+        TSharedPtr<FStreamableHandle> AssetHandle;
+        TArray<TUniqueFunction<void()>> Waiters;
+
+        // Resolved presets, kept alive by PresetHandle and published to the loaded maps only once the biome is ready
+        TArray<UBiomeGenerationPreset*> Presets;
+        UBiomeGenerationPreset* DefaultPreset = nullptr;
+
+        int32 Priority = 0;
+        bool bRequested = false;
+        bool bReady = false;
+    };
+
+    /** Cancel every load and forget discovered presets; waiters are kept for the next loads */
+    void ResetBiomeLoads();
+
+    /** Warm discovered presets: around CurrentBiome, or every biome in predicted order without one */
+    void WarmBiomes(EBiomeType CurrentBiome);
+
+    void StartBiomeLoad(EBiomeType BiomeType, int32 Priority);
+    void OnBiomePresetsLoaded(EBiomeType BiomeType);
+    void MarkBiomeReady(EBiomeType BiomeType);
+    void ReleaseBiome(EBiomeType BiomeType);
+
+    FBiomeLoadState LoadStates[BiomeTables::NumBiomes];
 };
\ No newline at end of file
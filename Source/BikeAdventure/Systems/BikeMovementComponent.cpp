@@ -1,14 +1,25 @@
 #include "BikeMovementComponent.h"
+#include "WorldStreamingManager.h"
 #include "GameFramework/Pawn.h"
+#include "Engine/GameInstance.h"
 #include "Components/PrimitiveComponent.h"
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
 
+// Console variable for debug drawing (declare in header if needed elsewhere)
+#if WITH_EDITOR
+TAutoConsoleVariable<bool> CVarDebugBikeMovement(
+	TEXT("bike.DebugMovement"),
+	false,
+	TEXT("Enable debug drawing for bike movement"),
+	ECVF_Cheat
+);
+#endif
+
 UBikeMovementComponent::UBikeMovementComponent()
 {
-	// Set this component to be ticked every frame
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	// ABikeCharacter drives UpdateMovement from its own tick, so the component needs no tick function
+	PrimaryComponentTick.bCanEverTick = false;
 
 	// Initialize default values optimized for meditative bike experience
 	ForwardSpeed = 1200.0f;        // 12 m/s - comfortable exploration speed
@@ -24,12 +35,7 @@ UBikeMovementComponent::UBikeMovementComponent()
 	GroundTraceDistance = 150.0f;   // 1.5 meter ground detection
 
 	// Initialize state
-	CurrentForwardSpeed = 0.0f;
-	SteeringValue = 0.0f;
-	CurrentTurnRate = 0.0f;
-	CurrentTiltAngle = 0.0f;
-	bIntersectionMode = false;
-	bOnGround = true;
+	State = FBikeMovementState();
 }
 
 void UBikeMovementComponent::BeginPlay()
@@ -37,7 +43,7 @@ void UBikeMovementComponent::BeginPlay()
 	Super::BeginPlay();
 	
 	// Start with initial forward speed
-	CurrentForwardSpeed = GetTargetForwardSpeed();
+	State.Speed = GetTargetForwardSpeed();
 }
 
 void UBikeMovementComponent::UpdateMovement(float DeltaTime)
@@ -47,65 +53,236 @@ void UBikeMovementComponent::UpdateMovement(float DeltaTime)
 		return;
 	}
 
+	State.TimeAccumulator += FMath::Max(DeltaTime, 0.0f);
+
+	// Consume whole steps only, so the trajectory depends on elapsed time rather than frame rate
+	int32 Substeps = 0;
+	while (State.TimeAccumulator >= FixedTimeStep && Substeps < MaxSubstepsPerFrame)
+	{
+		StepSimulation();
+		State.TimeAccumulator -= FixedTimeStep;
+		Substeps++;
+	}
+
+	// Drop time a hitch could not simulate rather than letting it snowball into later frames
+	if (State.TimeAccumulator >= FixedTimeStep)
+	{
+		State.TimeAccumulator = FMath::Fmod(State.TimeAccumulator, FixedTimeStep);
+	}
+
+	UpdateInterpolatedComponents();
+}
+
+void UBikeMovementComponent::StepSimulation()
+{
+	if (!UpdatedComponent || !PawnOwner)
+	{
+		return;
+	}
+
+	const FTransform StepStartTransform = UpdatedComponent->GetComponentTransform();
+	const float StepTime = FixedTimeStep;
+
 	// Check ground contact
-	bOnGround = CheckGroundContact();
+	State.bOnGround = CheckGroundContact();
 
 	// Only apply movement if we're on the ground
-	if (bOnGround)
+	if (State.bOnGround)
 	{
 		// Update different aspects of movement
-		UpdateForwardMovement(DeltaTime);
-		UpdateSteering(DeltaTime);
-		UpdateVisualEffects(DeltaTime);
+		UpdateForwardMovement(StepTime);
+
+		if (IsFollowingPath())
+		{
+			UpdateVisualEffects(StepTime);
+			UpdatePathFollowing(StepTime);
+		}
+		else
+		{
+			UpdateSteering(StepTime);
+			UpdateVisualEffects(StepTime);
+
+			// Calculate and apply final movement vector
+			FVector ForwardVector = UpdatedComponent->GetForwardVector();
+			FVector MovementVector = ForwardVector * State.Speed * StepTime;
+
+			ApplyMovement(MovementVector, StepTime);
+		}
+	}
 
-		// Calculate and apply final movement vector
-		FVector ForwardVector = UpdatedComponent->GetForwardVector();
-		FVector MovementVector = ForwardVector * CurrentForwardSpeed * DeltaTime;
+	Velocity = State.bOnGround ? UpdatedComponent->GetForwardVector() * State.Speed : FVector::ZeroVector;
+	UpdateComponentVelocity();
+
+	PreviousSimTransform = StepStartTransform;
+	CurrentSimTransform = UpdatedComponent->GetComponentTransform();
+	bSimTransformsValid = true;
+	State.StepCount++;
+}
 
-		ApplyMovement(MovementVector, DeltaTime);
+void UBikeMovementComponent::AddInterpolatedComponent(USceneComponent* Component)
+{
+	if (Component && Component != UpdatedComponent && !InterpolatedComponents.Contains(Component))
+	{
+		InterpolatedComponents.Add(Component);
+		InterpolatedBaseTransforms.Add(Component->GetRelativeTransform());
+	}
+}
+
+void UBikeMovementComponent::ResetInterpolation()
+{
+	bSimTransformsValid = false;
+	State.TimeAccumulator = 0.0f;
+	UpdateInterpolatedComponents();
+}
+
+void UBikeMovementComponent::UpdateInterpolatedComponents()
+{
+	if (!UpdatedComponent || InterpolatedComponents.Num() == 0)
+	{
+		return;
+	}
+
+	// The updated component sits at the current simulated transform; offset the visuals back
+	// towards the previous one so they render at (alpha) between the two
+	const FTransform CurrentTransform = UpdatedComponent->GetComponentTransform();
+	FTransform RenderTransform = CurrentTransform;
+	if (bInterpolateVisuals && bSimTransformsValid && CurrentTransform.Equals(CurrentSimTransform))
+	{
+		RenderTransform.Blend(PreviousSimTransform, CurrentSimTransform, FMath::Clamp(GetInterpolationAlpha(), 0.0f, 1.0f));
+	}
+
+	const FTransform RenderOffset = RenderTransform.GetRelativeTransform(CurrentTransform);
+	for (int32 i = 0; i < InterpolatedComponents.Num(); i++)
+	{
+		if (USceneComponent* Component = InterpolatedComponents[i])
+		{
+			Component->SetRelativeTransform(InterpolatedBaseTransforms[i] * RenderOffset);
+		}
 	}
 }
 
 void UBikeMovementComponent::SetSteering(float SteeringInput)
 {
-        SteeringValue = FMath::Clamp(SteeringInput, -1.0f, 1.0f);
+	State.Steering = FMath::Clamp(SteeringInput, -1.0f, 1.0f);
 }
 
 void UBikeMovementComponent::SetThrottle(float ThrottleInput)
 {
-       ThrottleValue = FMath::Clamp(ThrottleInput, 0.0f, 1.0f);
+	State.Throttle = FMath::Clamp(ThrottleInput, 0.0f, 1.0f);
 }
 
 void UBikeMovementComponent::SetIntersectionMode(bool bEnabled)
 {
-	bIntersectionMode = bEnabled;
+	State.bIntersectionMode = bEnabled;
 	UE_LOG(LogTemp, Log, TEXT("Intersection mode %s"), bEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
 }
 
+void UBikeMovementComponent::FollowPath(TSharedPtr<const FPathSpline> Path, float LocalDistance)
+{
+	if (!Path.IsValid() || !Path->IsValid())
+	{
+		StopFollowingPath();
+		return;
+	}
+
+	if (LocalDistance < 0.0f)
+	{
+		LocalDistance = UpdatedComponent ? Path->FindNearestDistance(UpdatedComponent->GetComponentLocation()) : 0.0f;
+	}
+
+	FollowedPath = Path;
+	FollowedPathDistance = FMath::Clamp(LocalDistance, 0.0f, Path->GetLength());
+	State.TurnRate = 0.0f;
+}
+
+void UBikeMovementComponent::StopFollowingPath()
+{
+	FollowedPath.Reset();
+	FollowedPathDistance = 0.0f;
+}
+
+void UBikeMovementComponent::UpdatePathFollowing(float DeltaTime)
+{
+	const float Advance = State.Speed * DeltaTime;
+	float TargetDistance = FollowedPathDistance + Advance;
+
+	// Hand over to the next section's spline once this one runs out, carrying the overshoot;
+	// linked splines share their crossing point, so the next one picks up at its start
+	if (TargetDistance > FollowedPath->GetLength())
+	{
+		if (TSharedPtr<const FPathSpline> NextPath = FindContinuingPath())
+		{
+			TargetDistance = FMath::Min(TargetDistance - FollowedPath->GetLength(), NextPath->GetLength());
+			FollowedPath = NextPath;
+		}
+	}
+	TargetDistance = FMath::Min(TargetDistance, FollowedPath->GetLength());
+
+	const FVector TargetLocation = FollowedPath->GetLocationAtDistance(TargetDistance);
+	const FVector PathDirection = FollowedPath->GetDirectionAtDistance(TargetDistance);
+	const FVector CurrentLocation = UpdatedComponent->GetComponentLocation();
+
+	// The spline places the bike in the ground plane; height stays with ground contact and collision
+	FRotator NewRotation = UpdatedComponent->GetComponentRotation();
+	NewRotation.Yaw = PathDirection.Rotation().Yaw;
+	UpdatedComponent->SetWorldRotation(NewRotation);
+
+	const FVector RequestedMove(TargetLocation.X - CurrentLocation.X, TargetLocation.Y - CurrentLocation.Y, 0.0f);
+	ApplyMovement(RequestedMove, DeltaTime);
+
+	// Advance only as far as the bike actually got, so a blocked bike does not run ahead along the path
+	const FVector ActualMove = UpdatedComponent->GetComponentLocation() - CurrentLocation;
+	const float RequestedSizeSquared = RequestedMove.SizeSquared();
+	const float MovedFraction = RequestedSizeSquared > KINDA_SMALL_NUMBER
+		? FMath::Clamp(FVector::DotProduct(FVector(ActualMove.X, ActualMove.Y, 0.0f), RequestedMove) / RequestedSizeSquared, 0.0f, 1.0f)
+		: 1.0f;
+	FollowedPathDistance = FMath::Max(TargetDistance - Advance * (1.0f - MovedFraction), 0.0f);
+
+	// Nothing loaded past the end of the path: carry on steering freely from its final heading
+	if (FollowedPathDistance >= FollowedPath->GetLength())
+	{
+		StopFollowingPath();
+	}
+}
+
+TSharedPtr<const FPathSpline> UBikeMovementComponent::FindContinuingPath() const
+{
+	UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	UWorldStreamingManager* StreamingManager = GameInstance ? GameInstance->GetSubsystem<UWorldStreamingManager>() : nullptr;
+	if (!StreamingManager)
+	{
+		return nullptr;
+	}
+
+	// Follow the ride graph rather than probing space, so the bike stays on its own chain of sections
+	TSharedPtr<const FPathSpline> NextPath = StreamingManager->FindNextPathSpline(*FollowedPath);
+	return NextPath.IsValid() && NextPath->IsValid() ? NextPath : nullptr;
+}
+
 void UBikeMovementComponent::UpdateForwardMovement(float DeltaTime)
 {
-        float TargetSpeed = GetTargetForwardSpeed();
+	float TargetSpeed = GetTargetForwardSpeed();
 
-        // Smooth acceleration/deceleration to target speed
-        float AccelerationRate = (CurrentForwardSpeed < TargetSpeed) ? 800.0f : 1200.0f; // Faster deceleration
-        CurrentForwardSpeed = SmoothInterp(CurrentForwardSpeed, TargetSpeed, AccelerationRate, DeltaTime);
+	// Smooth acceleration/deceleration to target speed
+	float AccelerationRate = (State.Speed < TargetSpeed) ? 800.0f : 1200.0f; // Faster deceleration
+	State.Speed = SmoothInterp(State.Speed, TargetSpeed, AccelerationRate, DeltaTime);
 
-        // Apply air resistance (subtle effect)
-        CurrentForwardSpeed *= (1.0f - AirResistance * DeltaTime);
+	// Apply air resistance (subtle effect)
+	State.Speed *= (1.0f - AirResistance * DeltaTime);
 }
 
 void UBikeMovementComponent::UpdateSteering(float DeltaTime)
 {
 	// Calculate target turn rate based on steering input
-	float TargetTurnRate = SteeringValue * MaxTurnRate;
+	float TargetTurnRate = State.Steering * MaxTurnRate;
 	
 	// Smooth steering interpolation for natural feel
-	CurrentTurnRate = SmoothInterp(CurrentTurnRate, TargetTurnRate, SteeringResponsiveness * MaxTurnRate, DeltaTime);
+	State.TurnRate = SmoothInterp(State.TurnRate, TargetTurnRate, SteeringResponsiveness * MaxTurnRate, DeltaTime);
 
 	// Apply rotation if we have turn rate
-	if (FMath::Abs(CurrentTurnRate) > 0.1f)
+	if (FMath::Abs(State.TurnRate) > 0.1f)
 	{
-		float RotationAmount = CurrentTurnRate * DeltaTime;
+		float RotationAmount = State.TurnRate * DeltaTime;
 		FRotator DeltaRotation(0.0f, RotationAmount, 0.0f);
 		UpdatedComponent->AddWorldRotation(DeltaRotation);
 	}
@@ -114,18 +291,18 @@ void UBikeMovementComponent::UpdateSteering(float DeltaTime)
 void UBikeMovementComponent::UpdateVisualEffects(float DeltaTime)
 {
 	// Calculate target tilt based on steering and speed
-	float SpeedFactor = FMath::Clamp(CurrentForwardSpeed / ForwardSpeed, 0.0f, 1.0f);
-	float TargetTilt = SteeringValue * TiltAngle * SpeedFactor;
+	float SpeedFactor = FMath::Clamp(State.Speed / ForwardSpeed, 0.0f, 1.0f);
+	float TargetTilt = State.Steering * TiltAngle * SpeedFactor;
 
 	// Smooth tilt interpolation
-	CurrentTiltAngle = SmoothInterp(CurrentTiltAngle, TargetTilt, TiltSpeed * TiltAngle, DeltaTime);
+	State.TiltAngle = SmoothInterp(State.TiltAngle, TargetTilt, TiltSpeed * TiltAngle, DeltaTime);
 
 	// Apply tilt rotation (roll)
-	if (FMath::Abs(CurrentTiltAngle) > 0.1f)
+	if (FMath::Abs(State.TiltAngle) > 0.1f)
 	{
 		FRotator CurrentRotation = UpdatedComponent->GetComponentRotation();
 		FRotator NewRotation = CurrentRotation;
-		NewRotation.Roll = CurrentTiltAngle;
+		NewRotation.Roll = State.TiltAngle;
 		UpdatedComponent->SetWorldRotation(NewRotation);
 	}
 }
@@ -137,32 +314,163 @@ bool UBikeMovementComponent::CheckGroundContact()
 		return false;
 	}
 
-	FVector StartLocation = UpdatedComponent->GetComponentLocation();
-	FVector EndLocation = StartLocation - FVector(0.0f, 0.0f, GroundTraceDistance);
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FVector TraceEnd = Location - FVector(0.0f, 0.0f, GroundTraceDistance);
+	float GroundZ = 0.0f;
+
+	if (!bUseGroundProbeCache)
+	{
+		return TraceGround(Location, TraceEnd, GroundZ);
+	}
+
+	bool bGrounded = false;
+	if (QueryGroundProbe(Location, bGrounded))
+	{
+		GroundProbeCacheHits++;
+		return bGrounded;
+	}
+
+	// Miss: sample this cell and the ones the bike is about to ride over in one go
+	ProbeGroundAhead(Location, UpdatedComponent->GetForwardVector());
+	if (QueryGroundProbe(Location, bGrounded))
+	{
+		return bGrounded;
+	}
+
+	// Something overhangs the bike inside its cell (bridge deck, canopy), so trace from the bike itself
+	return TraceGround(Location, TraceEnd, GroundZ);
+}
+
+bool UBikeMovementComponent::QueryGroundProbe(const FVector& Location, bool& bOutOnGround) const
+{
+	const FGroundProbe* Probe = GroundProbes.Find(GetGroundProbeCell(Location));
+	if (!Probe || State.StepCount - Probe->Step > GroundProbeLifetimeSteps)
+	{
+		return false;
+	}
+
+	// The probe must cover the whole range the direct trace would have tested
+	const float TraceBottomZ = Location.Z - GroundTraceDistance;
+	if (Location.Z > Probe->TopZ || TraceBottomZ < Probe->BottomZ)
+	{
+		return false;
+	}
+
+	// The probe only saw the highest surface, which says nothing about what lies below a surface above the bike
+	if (Probe->bHit && Probe->GroundZ > Location.Z)
+	{
+		return false;
+	}
+
+	bOutOnGround = Probe->bHit && Probe->GroundZ >= TraceBottomZ;
+	return true;
+}
+
+void UBikeMovementComponent::ProbeGroundAhead(const FVector& Location, const FVector& Heading)
+{
+	const FVector2D Direction = FVector2D(Heading.X, Heading.Y).GetSafeNormal();
+	const float TopZ = Location.Z + GroundProbeHeightMargin;
+	const float BottomZ = Location.Z - GroundTraceDistance - GroundProbeHeightMargin;
+
+	// Half-cell spacing so diagonal headings do not skip the cells they clip
+	const float SampleSpacing = GroundProbeCellSize * 0.5f;
+	const int32 MaxSamples = Direction.IsNearlyZero() ? 1 : GroundProbeBatchSize * 2;
+
+	int32 ProbesIssued = 0;
+	FIntPoint PreviousCell(MAX_int32, MAX_int32);
 
+	for (int32 SampleIndex = 0; SampleIndex < MaxSamples && ProbesIssued < GroundProbeBatchSize; SampleIndex++)
+	{
+		const FVector2D Sample = FVector2D(Location.X, Location.Y) + Direction * (SampleIndex * SampleSpacing);
+		const FVector SampleLocation(Sample.X, Sample.Y, Location.Z);
+		const FIntPoint Cell = GetGroundProbeCell(SampleLocation);
+
+		if (Cell == PreviousCell)
+		{
+			continue;
+		}
+		PreviousCell = Cell;
+
+		// The bike's own cell is always re-probed; cells ahead keep a probe that still answers
+		bool bUnused = false;
+		if (SampleIndex > 0 && QueryGroundProbe(SampleLocation, bUnused))
+		{
+			continue;
+		}
+
+		FGroundProbe Probe;
+		Probe.TopZ = TopZ;
+		Probe.BottomZ = BottomZ;
+		Probe.bHit = TraceGround(FVector(Sample.X, Sample.Y, TopZ), FVector(Sample.X, Sample.Y, BottomZ), Probe.GroundZ);
+		Probe.Step = State.StepCount;
+		ProbesIssued++;
+
+		if (FGroundProbe* Existing = GroundProbes.Find(Cell))
+		{
+			*Existing = Probe;
+			continue;
+		}
+
+		// Evict the oldest cell once full; the bike never looks far behind itself
+		if (GroundProbeOrder.Num() < MaxGroundProbes)
+		{
+			GroundProbeOrder.Add(Cell);
+		}
+		else
+		{
+			GroundProbes.Remove(GroundProbeOrder[GroundProbeOrderHead]);
+			GroundProbeOrder[GroundProbeOrderHead] = Cell;
+			GroundProbeOrderHead = (GroundProbeOrderHead + 1) % MaxGroundProbes;
+		}
+		GroundProbes.Add(Cell, Probe);
+	}
+}
+
+bool UBikeMovementComponent::TraceGround(const FVector& Start, const FVector& End, float& OutGroundZ)
+{
 	FHitResult HitResult;
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(PawnOwner);
 
 	bool bHit = GetWorld()->LineTraceSingleByChannel(
 		HitResult,
-		StartLocation,
-		EndLocation,
+		Start,
+		End,
 		ECC_WorldStatic,
 		QueryParams
 	);
+	GroundTraceCount++;
+	OutGroundZ = bHit ? HitResult.ImpactPoint.Z : 0.0f;
 
 	// Optional: Draw debug line in development builds
 	#if WITH_EDITOR
 	if (CVarDebugBikeMovement.GetValueOnGameThread())
 	{
-		DrawDebugLine(GetWorld(), StartLocation, EndLocation, bHit ? FColor::Green : FColor::Red, false, 0.0f, 0, 1.0f);
+		DrawDebugLine(GetWorld(), Start, End, bHit ? FColor::Green : FColor::Red, false, 0.0f, 0, 1.0f);
 	}
 	#endif
 
 	return bHit;
 }
 
+FIntPoint UBikeMovementComponent::GetGroundProbeCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / GroundProbeCellSize), FMath::FloorToInt(Location.Y / GroundProbeCellSize));
+}
+
+void UBikeMovementComponent::InvalidateGroundProbeCache()
+{
+	GroundProbes.Reset();
+	GroundProbeOrder.Reset();
+	GroundProbeOrderHead = 0;
+}
+
+float UBikeMovementComponent::GetGroundTracesPerSecond() const
+{
+	const float SimulatedTime = State.StepCount * FixedTimeStep;
+	return SimulatedTime > 0.0f ? GroundTraceCount / SimulatedTime : 0.0f;
+}
+
 void UBikeMovementComponent::ApplyMovement(const FVector& MovementVector, float DeltaTime)
 {
 	if (!UpdatedComponent)
@@ -184,8 +492,7 @@ void UBikeMovementComponent::ApplyMovement(const FVector& MovementVector, float
 
 float UBikeMovementComponent::GetTargetForwardSpeed() const
 {
-       float MaxSpeed = bIntersectionMode ? IntersectionSpeed : ForwardSpeed;
-       return ThrottleValue * MaxSpeed;
+	return State.Throttle * GetMaxSpeed();
 }
 
 float UBikeMovementComponent::SmoothInterp(float Current, float Target, float Speed, float DeltaTime) const
@@ -197,13 +504,3 @@ float UBikeMovementComponent::SmoothInterp(float Current, float Target, float Sp
 	
 	return FMath::FInterpTo(Current, Target, DeltaTime, Speed);
 }
-
-// Console variable for debug drawing (declare in header if needed elsewhere)
-#if WITH_EDITOR
-TAutoConsoleVariable<bool> CVarDebugBikeMovement(
-	TEXT("bike.DebugMovement"),
-	false,
-	TEXT("Enable debug drawing for bike movement"),
-	ECVF_Cheat
-);
-#endif
\ No newline at end of file
@@ -3,11 +3,64 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PawnMovementComponent.h"
 #include "Engine/Engine.h"
+#include "PathSpline.h"
 #include "BikeMovementComponent.generated.h"
 
 /**
- * Custom movement component for physics-based bike movement
- * Handles player-controlled forward movement with smooth turning mechanics
+ * Per-step simulation state, kept in one small block so a movement update touches a single cache line
+ */
+USTRUCT(BlueprintType)
+struct BIKEADVENTURE_API FBikeMovementState
+{
+	GENERATED_BODY()
+
+	FBikeMovementState()
+		: bOnGround(true)
+		, bIntersectionMode(false)
+	{
+	}
+
+	/** Current forward speed in cm/s */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	float Speed = 0.0f;
+
+	/** Current steering input (-1 to 1) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	float Steering = 0.0f;
+
+	/** Current throttle input (0 to 1) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	float Throttle = 0.0f;
+
+	/** Turn rate being applied in degrees per second */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	float TurnRate = 0.0f;
+
+	/** Tilt angle for visual feedback */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	float TiltAngle = 0.0f;
+
+	/** Frame time not yet consumed by a simulation step */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	float TimeAccumulator = 0.0f;
+
+	/** Fixed steps simulated so far */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	int32 StepCount = 0;
+
+	/** Whether the last step found ground under the bike */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	uint8 bOnGround : 1;
+
+	/** Whether intersection mode (slower movement) is active */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
+	uint8 bIntersectionMode : 1;
+};
+
+/**
+ * Movement component for physics-based bike movement
+ * Handles player-controlled forward movement with smooth turning mechanics, intersection slow-down
+ * and tilt visuals, simulated at a fixed step on the owning pawn's root component
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class BIKEADVENTURE_API UBikeMovementComponent : public UPawnMovementComponent
@@ -21,21 +74,83 @@ protected:
 	virtual void BeginPlay() override;
 
 public:
-        /** Called every frame to update movement */
-        virtual void UpdateMovement(float DeltaTime);
+	/**
+	 * Called every frame to update movement
+	 * Frame time is accumulated and consumed in FixedTimeStep simulation steps, then the
+	 * interpolated components are placed between the last two simulated transforms
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Bike Movement")
+	virtual void UpdateMovement(float DeltaTime);
+
+	/** Advance exactly one fixed simulation step, bypassing the accumulator (replays, headless rides) */
+	void StepSimulation();
 
-        /** Set steering input (-1.0 to 1.0) */
-        void SetSteering(float SteeringInput);
+	/** Render this component at the interpolated transform instead of the last simulated one */
+	void AddInterpolatedComponent(USceneComponent* Component);
 
-       /** Set throttle input (0.0 to 1.0) */
-       void SetThrottle(float ThrottleInput);
+	/** Snap interpolation to the current transform, e.g. after a teleport */
+	void ResetInterpolation();
+
+	/** Number of fixed simulation steps taken so far */
+	int32 GetSimulationStepCount() const { return State.StepCount; }
+
+	/** Fraction of a step between the last simulated transform and the next one */
+	float GetInterpolationAlpha() const { return FixedTimeStep > 0.0f ? State.TimeAccumulator / FixedTimeStep : 0.0f; }
+
+	/** Set steering input (-1.0 to 1.0) */
+	UFUNCTION(BlueprintCallable, Category = "Bike Movement")
+	void SetSteering(float SteeringInput);
+
+	/** Set throttle input (0.0 to 1.0) */
+	UFUNCTION(BlueprintCallable, Category = "Bike Movement")
+	void SetThrottle(float ThrottleInput);
 
 	/** Get current forward speed */
-	float GetCurrentSpeed() const { return CurrentForwardSpeed; }
+	UFUNCTION(BlueprintPure, Category = "Bike Movement")
+	float GetCurrentSpeed() const { return State.Speed; }
+
+	/** Current velocity of the bike in world space */
+	UFUNCTION(BlueprintPure, Category = "Bike Movement")
+	FVector GetVelocity() const { return Velocity; }
+
+	/** Current angular velocity; only yaw is simulated */
+	UFUNCTION(BlueprintPure, Category = "Bike Movement")
+	FVector GetAngularVelocity() const { return FVector(0.0f, 0.0f, State.TurnRate); }
+
+	/** Target speed for the current mode at full throttle */
+	virtual float GetMaxSpeed() const override { return State.bIntersectionMode ? IntersectionSpeed : ForwardSpeed; }
+
+	/** Whether the last simulation step found ground under the bike */
+	bool IsOnGround() const { return State.bOnGround; }
+
+	/** Whether intersection mode is active */
+	bool IsInIntersectionMode() const { return State.bIntersectionMode; }
+
+	/** Hot simulation state, for debugging and tests */
+	const FBikeMovementState& GetMovementState() const { return State; }
 
 	/** Enable/disable intersection mode (slower movement) */
+	UFUNCTION(BlueprintCallable, Category = "Bike Movement")
 	void SetIntersectionMode(bool bEnabled);
 
+	/**
+	 * Ride along a path spline by distance instead of steering freely
+	 * Steering input is ignored while following; the spline sets the heading
+	 * @param LocalDistance - Where to join the spline, or negative to join at the point nearest the bike
+	 */
+	void FollowPath(TSharedPtr<const FPathSpline> Path, float LocalDistance = -1.0f);
+
+	/** Return to free steering from the current heading */
+	void StopFollowingPath();
+
+	bool IsFollowingPath() const { return FollowedPath.IsValid(); }
+
+	/** Spline currently being followed, if any */
+	TSharedPtr<const FPathSpline> GetFollowedPath() const { return FollowedPath; }
+
+	/** Position in the shared distance-along-path coordinate while following a path */
+	float GetPathDistance() const { return FollowedPath.IsValid() ? FollowedPath->ToPathDistance(FollowedPathDistance) : 0.0f; }
+
 	//~ Movement Parameters
 
 	/** Base forward speed in cm/s */
@@ -76,36 +191,73 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Physics")
 	float GroundTraceDistance = 150.0f;
 
-protected:
-        /** Current forward velocity */
-        UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
-        float CurrentForwardSpeed = 0.0f;
+	//~ Simulation Parameters
 
-        /** Current steering input value */
-        UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
-        float SteeringValue = 0.0f;
+	/** Fixed simulation step in seconds, so movement does not depend on frame rate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Simulation", meta = (ClampMin = "0.002", ClampMax = "0.05"))
+	float FixedTimeStep = 1.0f / 60.0f;
 
-       /** Current throttle input value */
-       UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
-       float ThrottleValue = 0.0f;
+	/** Maximum simulation steps per frame; longer hitches drop the excess time instead of stalling */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Simulation", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 MaxSubstepsPerFrame = 8;
 
-	/** Current turn rate being applied */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
-	float CurrentTurnRate = 0.0f;
+	/** Whether interpolated components are smoothed between simulation steps */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Simulation")
+	bool bInterpolateVisuals = true;
 
-	/** Current tilt angle for visual feedback */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
-	float CurrentTiltAngle = 0.0f;
+	//~ Ground Probe Parameters
 
-	/** Whether we're currently in intersection mode */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
-	bool bIntersectionMode = false;
+	/** Answer ground checks from probes sampled ahead along the heading instead of tracing every step */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Ground Probe")
+	bool bUseGroundProbeCache = true;
+
+	/** Edge length of the ground cells a single probe answers for */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Ground Probe", meta = (ClampMin = "10.0"))
+	float GroundProbeCellSize = 200.0f;
+
+	/** Cells sampled ahead of the bike when the current one misses */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Ground Probe", meta = (ClampMin = "1", ClampMax = "32"))
+	int32 GroundProbeBatchSize = 8;
+
+	/** Vertical slack above and below the trace range so probes stay valid over gentle slopes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Ground Probe")
+	float GroundProbeHeightMargin = 100.0f;
+
+	/** Simulation steps a probe stays valid, so streamed-in geometry is picked up */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Ground Probe", meta = (ClampMin = "1"))
+	int32 GroundProbeLifetimeSteps = 600;
+
+	/** Forget every cached ground probe, e.g. after a teleport or a level streaming change */
+	void InvalidateGroundProbeCache();
+
+	/** Ground traces issued so far */
+	int32 GetGroundTraceCount() const { return GroundTraceCount; }
 
-	/** Whether we're currently on the ground */
+	/** Ground checks answered from the probe cache so far */
+	int32 GetGroundProbeCacheHits() const { return GroundProbeCacheHits; }
+
+	/** Ground traces per second of simulated time */
+	float GetGroundTracesPerSecond() const;
+
+protected:
+	/** Hot simulation state */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|State")
-	bool bOnGround = true;
+	FBikeMovementState State;
 
 private:
+	/** Place interpolated components between the previous and current simulated transforms */
+	void UpdateInterpolatedComponents();
+
+	/** Updated component transform before and after the latest simulation step */
+	FTransform PreviousSimTransform;
+	FTransform CurrentSimTransform;
+	bool bSimTransformsValid = false;
+
+	/** Components rendered at the interpolated transform, with their authored relative transforms */
+	UPROPERTY(Transient)
+	TArray<USceneComponent*> InterpolatedComponents;
+	TArray<FTransform> InterpolatedBaseTransforms;
+
 	/** Update forward movement with physics */
 	void UpdateForwardMovement(float DeltaTime);
 
@@ -118,6 +270,46 @@ private:
 	/** Check if bike is on the ground */
 	bool CheckGroundContact();
 
+	/** Highest blocking ground surface over a probed vertical range of one cell */
+	struct FGroundProbe
+	{
+		float TopZ = 0.0f;
+		float BottomZ = 0.0f;
+		float GroundZ = 0.0f;
+		bool bHit = false;
+		int32 Step = 0;
+	};
+
+	/** Answer a ground check from the cache; false if no valid probe covers the trace range */
+	bool QueryGroundProbe(const FVector& Location, bool& bOutOnGround) const;
+
+	/** Probe the current cell and the cells ahead along the heading in one batch */
+	void ProbeGroundAhead(const FVector& Location, const FVector& Heading);
+
+	/** Single ground trace, counted and optionally drawn */
+	bool TraceGround(const FVector& Start, const FVector& End, float& OutGroundZ);
+
+	FIntPoint GetGroundProbeCell(const FVector& Location) const;
+
+	/** Cached probes by cell, evicted oldest first once the cache is full */
+	TMap<FIntPoint, FGroundProbe> GroundProbes;
+	TArray<FIntPoint> GroundProbeOrder;
+	int32 GroundProbeOrderHead = 0;
+	static constexpr int32 MaxGroundProbes = 256;
+
+	int32 GroundTraceCount = 0;
+	int32 GroundProbeCacheHits = 0;
+
+	/** Advance along the followed path by the distance covered this step */
+	void UpdatePathFollowing(float DeltaTime);
+
+	/** Spline linked after the followed one in the streaming manager's ride graph, if loaded */
+	TSharedPtr<const FPathSpline> FindContinuingPath() const;
+
+	/** Path being followed and the local distance along it */
+	TSharedPtr<const FPathSpline> FollowedPath;
+	float FollowedPathDistance = 0.0f;
+
 	/** Apply movement to the pawn */
 	void ApplyMovement(const FVector& MovementVector, float DeltaTime);
 
@@ -0,0 +1,453 @@
+#include "BikeSaveFormat.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+    constexpr uint32 ChoiceMask = (1u << FBikeChoiceLog::BitsPerChoice) - 1;
+
+    uint32 ReadPackedValue(const uint8* Src, int32 NumBytes, int64 BitPos)
+    {
+        const int32 ByteIndex = static_cast<int32>(BitPos >> 3);
+        uint32 Word = Src[ByteIndex];
+        if (ByteIndex + 1 < NumBytes)
+        {
+            Word |= static_cast<uint32>(Src[ByteIndex + 1]) << 8;
+        }
+        return (Word >> (BitPos & 7)) & ChoiceMask;
+    }
+
+    void WritePackedValue(uint8* Dest, int32 NumBytes, int64 BitPos, uint32 Value)
+    {
+        const int32 ByteIndex = static_cast<int32>(BitPos >> 3);
+        const uint32 Shifted = Value << (BitPos & 7);
+        Dest[ByteIndex] |= static_cast<uint8>(Shifted);
+        if ((Shifted >> 8) != 0 && ByteIndex + 1 < NumBytes)
+        {
+            Dest[ByteIndex + 1] |= static_cast<uint8>(Shifted >> 8);
+        }
+    }
+
+    /** Clear the bits past the last choice so packed ranges compare and compress cleanly */
+    void MaskTail(TArray<uint8>& Bytes, int32 Count)
+    {
+        const int32 UsedBits = static_cast<int32>((static_cast<int64>(Count) * FBikeChoiceLog::BitsPerChoice) & 7);
+        if (UsedBits != 0 && Bytes.Num() > 0)
+        {
+            Bytes.Last() &= static_cast<uint8>((1u << UsedBits) - 1);
+        }
+    }
+
+    void AppendChunk(BikeSaveFormat::EChunk Type, const TArray<uint8>& Payload, TArray<uint8>& Out)
+    {
+        FMemoryWriter Writer(Out, true);
+        Writer.Seek(Out.Num());
+
+        uint8 TypeValue = static_cast<uint8>(Type);
+        uint32 Size = Payload.Num();
+        uint32 Crc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+        Writer << TypeValue;
+        Writer.SerializeIntPacked(Size);
+        Writer.Serialize(const_cast<uint8*>(Payload.GetData()), Payload.Num());
+        Writer << Crc;
+    }
+}
+
+void FBikeChoiceLog::Add(bool bChoseLeft, EBiomeType Biome, EPathPersonality Personality)
+{
+    const uint32 Value = (bChoseLeft ? 1u : 0u)
+        | ((static_cast<uint32>(Biome) & 0x7) << 1)
+        | ((static_cast<uint32>(Personality) & 0x7) << 4);
+
+    const int32 NeededBytes = GetNumBytes(NumChoices + 1);
+    if (Bits.Num() < NeededBytes)
+    {
+        Bits.AddZeroed(NeededBytes - Bits.Num());
+    }
+
+    WritePackedValue(Bits.GetData(), Bits.Num(), static_cast<int64>(NumChoices) * BitsPerChoice, Value);
+    NumChoices++;
+}
+
+FBikeChoiceLog::FChoice FBikeChoiceLog::Get(int32 Index) const
+{
+    check(Index >= 0 && Index < NumChoices);
+    const uint32 Value = ReadPackedValue(Bits.GetData(), Bits.Num(), static_cast<int64>(Index) * BitsPerChoice);
+
+    FChoice Choice;
+    Choice.bChoseLeft = (Value & 0x1) != 0;
+    Choice.Biome = static_cast<EBiomeType>((Value >> 1) & 0x7);
+    Choice.Personality = static_cast<EPathPersonality>((Value >> 4) & 0x7);
+    return Choice;
+}
+
+void FBikeChoiceLog::Reset()
+{
+    Bits.Reset();
+    NumChoices = 0;
+}
+
+void FBikeChoiceLog::CopyRange(int32 First, int32 Count, TArray<uint8>& OutBits) const
+{
+    check(First >= 0 && Count >= 0 && First + Count <= NumChoices);
+    OutBits.Reset();
+    OutBits.AddZeroed(GetNumBytes(Count));
+
+    const int64 FirstBit = static_cast<int64>(First) * BitsPerChoice;
+    if ((FirstBit & 7) == 0)
+    {
+        // Byte aligned, which every full save is
+        FMemory::Memcpy(OutBits.GetData(), Bits.GetData() + (FirstBit >> 3), OutBits.Num());
+        MaskTail(OutBits, Count);
+        return;
+    }
+
+    for (int32 i = 0; i < Count; i++)
+    {
+        const uint32 Value = ReadPackedValue(Bits.GetData(), Bits.Num(), FirstBit + static_cast<int64>(i) * BitsPerChoice);
+        WritePackedValue(OutBits.GetData(), OutBits.Num(), static_cast<int64>(i) * BitsPerChoice, Value);
+    }
+}
+
+void FBikeChoiceLog::AppendPacked(const uint8* Src, int32 Count)
+{
+    const int32 SrcBytes = GetNumBytes(Count);
+    const int64 FirstBit = static_cast<int64>(NumChoices) * BitsPerChoice;
+    Bits.AddZeroed(GetNumBytes(NumChoices + Count) - Bits.Num());
+
+    if ((FirstBit & 7) == 0)
+    {
+        FMemory::Memcpy(Bits.GetData() + (FirstBit >> 3), Src, SrcBytes);
+        NumChoices += Count;
+        MaskTail(Bits, NumChoices);
+        return;
+    }
+
+    for (int32 i = 0; i < Count; i++)
+    {
+        const uint32 Value = ReadPackedValue(Src, SrcBytes, static_cast<int64>(i) * BitsPerChoice);
+        WritePackedValue(Bits.GetData(), Bits.Num(), FirstBit + static_cast<int64>(i) * BitsPerChoice, Value);
+    }
+    NumChoices += Count;
+}
+
+namespace BikeSaveFormat
+{
+    void WriteFileHeader(TArray<uint8>& Out)
+    {
+        FMemoryWriter Writer(Out, true);
+        Writer.Seek(Out.Num());
+
+        uint32 Magic = FileMagic;
+        uint16 Version = FileVersion;
+        uint16 Reserved = 0;
+        Writer << Magic << Version << Reserved;
+    }
+
+    void WriteCounters(const FBikeSaveCounters& Counters, TArray<uint8>& Out)
+    {
+        TArray<uint8> Payload;
+        FMemoryWriter Writer(Payload);
+
+        uint32 TotalChoices = Counters.TotalChoices;
+        uint32 LeftChoices = Counters.LeftChoices;
+        uint32 RightChoices = Counters.RightChoices;
+        uint32 DiscoveriesFound = Counters.DiscoveriesFound;
+        uint8 Preferred = static_cast<uint8>(Counters.PreferredPersonality);
+        float AdaptiveWeight = Counters.AdaptiveWeight;
+        uint8 NumPreferences = static_cast<uint8>(FMath::Min(Counters.PersonalityPreferences.Num(), 255));
+
+        Writer.SerializeIntPacked(TotalChoices);
+        Writer.SerializeIntPacked(LeftChoices);
+        Writer.SerializeIntPacked(RightChoices);
+        Writer.SerializeIntPacked(DiscoveriesFound);
+        Writer << Preferred << AdaptiveWeight << NumPreferences;
+        for (int32 i = 0; i < NumPreferences; i++)
+        {
+            float Preference = Counters.PersonalityPreferences[i];
+            Writer << Preference;
+        }
+
+        AppendChunk(EChunk::Counters, Payload, Out);
+    }
+
+    void WriteDiscoveries(const FDiscoverySaveState& Discoveries, TArray<uint8>& Out)
+    {
+        TArray<uint8> Payload;
+        FMemoryWriter Writer(Payload);
+
+        uint32 TableHash = Discoveries.TableHash;
+        uint32 NumBits = Discoveries.BiomeWideFound.Num();
+        Writer << TableHash;
+        Writer.SerializeIntPacked(NumBits);
+        for (uint32 Base = 0; Base < NumBits; Base += 8)
+        {
+            uint8 Byte = 0;
+            for (uint32 Bit = 0; Bit < 8 && Base + Bit < NumBits; Bit++)
+            {
+                Byte |= Discoveries.BiomeWideFound[Base + Bit] ? (1 << Bit) : 0;
+            }
+            Writer << Byte;
+        }
+
+        // Located discoveries are instances of a few table names, so write each name string once
+        TMap<FName, uint32> StringIndex;
+        TArray<FName, TInlineAllocator<64>> Strings;
+        TArray<TPair<uint32, uint32>> Entries;
+        Entries.Reserve(Discoveries.FoundNames.Num());
+        for (const FName Name : Discoveries.FoundNames)
+        {
+            const FName Plain(Name, NAME_NO_NUMBER_INTERNAL);
+            uint32* Index = StringIndex.Find(Plain);
+            if (!Index)
+            {
+                Index = &StringIndex.Add(Plain, Strings.Add(Plain));
+            }
+            Entries.Emplace(*Index, static_cast<uint32>(Name.GetNumber()));
+        }
+
+        uint32 NumStrings = Strings.Num();
+        Writer.SerializeIntPacked(NumStrings);
+        for (const FName String : Strings)
+        {
+            FTCHARToUTF8 Utf8(*String.ToString());
+            uint32 Length = Utf8.Length();
+            Writer.SerializeIntPacked(Length);
+            Writer.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Length);
+        }
+
+        uint32 NumEntries = Entries.Num();
+        Writer.SerializeIntPacked(NumEntries);
+        for (TPair<uint32, uint32>& Entry : Entries)
+        {
+            Writer.SerializeIntPacked(Entry.Key);
+            Writer.SerializeIntPacked(Entry.Value);
+        }
+
+        AppendChunk(EChunk::Discoveries, Payload, Out);
+    }
+
+    void WriteChoices(int32 FirstChoice, int32 NumChoices, TConstArrayView<uint8> PackedBits, TArray<uint8>& Out)
+    {
+        check(PackedBits.Num() >= FBikeChoiceLog::GetNumBytes(NumChoices));
+
+        TArray<uint8> Payload;
+        Payload.Reserve(PackedBits.Num() + 10);
+        FMemoryWriter Writer(Payload);
+
+        uint32 First = FirstChoice;
+        uint32 Count = NumChoices;
+        Writer.SerializeIntPacked(First);
+        Writer.SerializeIntPacked(Count);
+        Writer.Serialize(const_cast<uint8*>(PackedBits.GetData()), FBikeChoiceLog::GetNumBytes(NumChoices));
+
+        AppendChunk(EChunk::Choices, Payload, Out);
+    }
+
+    static bool ReadCounters(FArchive& Reader, FBikeSaveCounters& Out)
+    {
+        uint8 Preferred = 0;
+        uint8 NumPreferences = 0;
+        Reader.SerializeIntPacked(Out.TotalChoices);
+        Reader.SerializeIntPacked(Out.LeftChoices);
+        Reader.SerializeIntPacked(Out.RightChoices);
+        Reader.SerializeIntPacked(Out.DiscoveriesFound);
+        Reader << Preferred << Out.AdaptiveWeight << NumPreferences;
+        Out.PreferredPersonality = static_cast<EPathPersonality>(Preferred);
+
+        Out.PersonalityPreferences.SetNumZeroed(NumPreferences);
+        for (float& Preference : Out.PersonalityPreferences)
+        {
+            Reader << Preference;
+        }
+        return !Reader.IsError();
+    }
+
+    static bool ReadDiscoveries(FArchive& Reader, FDiscoverySaveState& Out)
+    {
+        uint32 NumBits = 0;
+        Reader << Out.TableHash;
+        Reader.SerializeIntPacked(NumBits);
+        if (Reader.IsError() || NumBits > static_cast<uint32>(Reader.TotalSize()) * 8)
+        {
+            return false;
+        }
+
+        Out.BiomeWideFound.Init(false, NumBits);
+        for (uint32 Base = 0; Base < NumBits; Base += 8)
+        {
+            uint8 Byte = 0;
+            Reader << Byte;
+            for (uint32 Bit = 0; Bit < 8 && Base + Bit < NumBits; Bit++)
+            {
+                Out.BiomeWideFound[Base + Bit] = (Byte & (1 << Bit)) != 0;
+            }
+        }
+
+        uint32 NumStrings = 0;
+        Reader.SerializeIntPacked(NumStrings);
+        if (Reader.IsError() || NumStrings > static_cast<uint32>(Reader.TotalSize()))
+        {
+            return false;
+        }
+
+        TArray<FName> Strings;
+        Strings.Reserve(NumStrings);
+        TArray<ANSICHAR> Utf8;
+        for (uint32 i = 0; i < NumStrings && !Reader.IsError(); i++)
+        {
+            uint32 Length = 0;
+            Reader.SerializeIntPacked(Length);
+            if (Length > static_cast<uint32>(Reader.TotalSize() - Reader.Tell()))
+            {
+                return false;
+            }
+            Utf8.SetNumUninitialized(Length);
+            Reader.Serialize(Utf8.GetData(), Length);
+
+            FUTF8ToTCHAR Converted(Utf8.GetData(), Length);
+            Strings.Add(FName(Converted.Length(), Converted.Get()));
+        }
+
+        uint32 NumEntries = 0;
+        Reader.SerializeIntPacked(NumEntries);
+        if (Reader.IsError() || NumEntries > static_cast<uint32>(Reader.TotalSize()))
+        {
+            return false;
+        }
+
+        Out.FoundNames.Reset(NumEntries);
+        for (uint32 i = 0; i < NumEntries; i++)
+        {
+            uint32 StringIndex = 0;
+            uint32 Number = 0;
+            Reader.SerializeIntPacked(StringIndex);
+            Reader.SerializeIntPacked(Number);
+            if (Reader.IsError() || !Strings.IsValidIndex(StringIndex))
+            {
+                return false;
+            }
+            Out.FoundNames.Add(FName(Strings[StringIndex], static_cast<int32>(Number)));
+        }
+        return !Reader.IsError();
+    }
+
+    static bool ReadChoices(FArchive& Reader, FBikeChoiceLog& Out)
+    {
+        uint32 First = 0;
+        uint32 Count = 0;
+        Reader.SerializeIntPacked(First);
+        Reader.SerializeIntPacked(Count);
+        if (Reader.IsError() || First != static_cast<uint32>(Out.Num()) || Count > MAX_int32 / FBikeChoiceLog::BitsPerChoice)
+        {
+            return false;
+        }
+
+        const int32 NumBytes = FBikeChoiceLog::GetNumBytes(Count);
+        if (Reader.TotalSize() - Reader.Tell() < NumBytes)
+        {
+            return false;
+        }
+
+        TArray<uint8> Packed;
+        Packed.SetNumUninitialized(NumBytes);
+        Reader.Serialize(Packed.GetData(), NumBytes);
+        Out.AppendPacked(Packed.GetData(), Count);
+        return !Reader.IsError();
+    }
+
+    bool Read(TConstArrayView<uint8> Bytes, FBikeSaveSnapshot& OutSnapshot, int32* OutNumChunks)
+    {
+        OutSnapshot = FBikeSaveSnapshot();
+        if (OutNumChunks)
+        {
+            *OutNumChunks = 0;
+        }
+
+        FMemoryReaderView Reader(Bytes, true);
+        uint32 Magic = 0;
+        uint16 Version = 0;
+        uint16 Reserved = 0;
+        Reader << Magic << Version << Reserved;
+        if (Reader.IsError() || Magic != FileMagic || Version < MinFileVersion || Version > FileVersion)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Save file has an unsupported header (version %d)"), Version);
+            return false;
+        }
+
+        while (Reader.Tell() < Reader.TotalSize())
+        {
+            uint8 Type = 0;
+            uint32 Size = 0;
+            Reader << Type;
+            Reader.SerializeIntPacked(Size);
+
+            const int64 PayloadStart = Reader.Tell();
+            if (Reader.IsError() || PayloadStart + Size + sizeof(uint32) > static_cast<uint64>(Reader.TotalSize()))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Save file ends in a partial chunk, ignoring it"));
+                break;
+            }
+
+            TConstArrayView<uint8> Payload = Bytes.Slice(static_cast<int32>(PayloadStart), static_cast<int32>(Size));
+            Reader.Seek(PayloadStart + Size);
+            uint32 Crc = 0;
+            Reader << Crc;
+            if (Crc != FCrc::MemCrc32(Payload.GetData(), Payload.Num()))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Save file chunk failed its checksum, ignoring the rest of the file"));
+                break;
+            }
+
+            // Read into a copy so a bad chunk leaves the snapshot as it was
+            FMemoryReaderView PayloadReader(Payload, true);
+            bool bChunkValid = true;
+            switch (static_cast<EChunk>(Type))
+            {
+            case EChunk::Counters:
+            {
+                FBikeSaveCounters Counters;
+                bChunkValid = ReadCounters(PayloadReader, Counters);
+                if (bChunkValid)
+                {
+                    OutSnapshot.Counters = MoveTemp(Counters);
+                }
+                break;
+            }
+            case EChunk::Discoveries:
+            {
+                if (Version < 2)
+                {
+                    break;
+                }
+                FDiscoverySaveState Discoveries;
+                bChunkValid = ReadDiscoveries(PayloadReader, Discoveries);
+                if (bChunkValid)
+                {
+                    OutSnapshot.Discoveries = MoveTemp(Discoveries);
+                }
+                break;
+            }
+            case EChunk::Choices:
+                bChunkValid = ReadChoices(PayloadReader, OutSnapshot.Choices);
+                break;
+            default:
+                // Chunks from newer builds of the same version are skipped
+                break;
+            }
+
+            if (!bChunkValid)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Save file chunk %d could not be decoded, ignoring the rest of the file"), Type);
+                break;
+            }
+            if (OutNumChunks && Version == FileVersion)
+            {
+                (*OutNumChunks)++;
+            }
+        }
+
+        return true;
+    }
+}
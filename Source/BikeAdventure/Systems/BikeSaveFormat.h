@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+#include "../Core/BiomeTypes.h"
+
+/**
+ * Every intersection choice of a run, packed into BitsPerChoice bits:
+ * bit 0 = left path, bits 1-3 = biome, bits 4-6 = personality.
+ * The in-memory form is the saved form, so saving a range is a bit copy.
+ */
+class BIKEADVENTURE_API FBikeChoiceLog
+{
+public:
+    static constexpr int32 BitsPerChoice = 7;
+
+    struct FChoice
+    {
+        bool bChoseLeft;
+        EBiomeType Biome;
+        EPathPersonality Personality;
+    };
+
+    void Add(bool bChoseLeft, EBiomeType Biome, EPathPersonality Personality);
+    FChoice Get(int32 Index) const;
+
+    int32 Num() const { return NumChoices; }
+    void Reset();
+    void Reserve(int32 Count) { Bits.Reserve(GetNumBytes(Count)); }
+
+    /** Pack Count choices starting at First into OutBits, starting at bit 0 */
+    void CopyRange(int32 First, int32 Count, TArray<uint8>& OutBits) const;
+
+    /** Append Count choices packed from bit 0 of Src */
+    void AppendPacked(const uint8* Src, int32 Count);
+
+    static int32 GetNumBytes(int32 Count) { return static_cast<int32>((static_cast<int64>(Count) * BitsPerChoice + 7) / 8); }
+
+private:
+    TArray<uint8> Bits;
+    int32 NumChoices = 0;
+};
+
+/**
+ * Running choice statistics, mirroring the totals and profile of FPlayerChoiceHistory
+ */
+struct FBikeSaveCounters
+{
+    uint32 TotalChoices = 0;
+    uint32 LeftChoices = 0;
+    uint32 RightChoices = 0;
+    uint32 DiscoveriesFound = 0;
+    EPathPersonality PreferredPersonality = EPathPersonality::None;
+    float AdaptiveWeight = 0.5f;
+    TArray<float, TInlineAllocator<8>> PersonalityPreferences;
+};
+
+/**
+ * Found discoveries: one bit per biome-wide discovery table record, and the names of every
+ * other found discovery (located ones and biome-wide ones that did not come from the table)
+ */
+struct FDiscoverySaveState
+{
+    /** FDiscoveryTable::GetBiomeWideHash of the table the bits index; they are dropped when it no longer matches */
+    uint32 TableHash = 0;
+    TBitArray<> BiomeWideFound;
+    TArray<FName> FoundNames;
+};
+
+/**
+ * Everything a save file holds once loaded
+ */
+struct FBikeSaveSnapshot
+{
+    FBikeSaveCounters Counters;
+    FDiscoverySaveState Discoveries;
+    FBikeChoiceLog Choices;
+};
+
+/**
+ * Versioned save file made of self-checking chunks, so saves can be appended incrementally:
+ *
+ *   uint32 Magic | uint16 Version | uint16 Reserved
+ *   { uint8 Type | packed uint32 Size | Payload[Size] | uint32 Crc } ...
+ *
+ * Counters and Discoveries chunks are small snapshots, the last one in the file wins.
+ * Choices chunks carry only the choices recorded since the previous save and must follow on
+ * from each other. Counts are written as packed integers (7 bits per byte). A torn or corrupt
+ * chunk ends the read, keeping everything before it.
+ */
+namespace BikeSaveFormat
+{
+    constexpr uint32 FileMagic = 0x56534B42; // "BKSV"
+    constexpr uint16 FileVersion = 2;
+
+    /** Oldest version still read; version 1 keyed discovery bits by catalogue position, so its discoveries are skipped */
+    constexpr uint16 MinFileVersion = 1;
+    constexpr int32 FileHeaderSize = 8;
+
+    enum class EChunk : uint8
+    {
+        Counters = 1,
+        Discoveries = 2,
+        Choices = 3
+    };
+
+    BIKEADVENTURE_API void WriteFileHeader(TArray<uint8>& Out);
+    BIKEADVENTURE_API void WriteCounters(const FBikeSaveCounters& Counters, TArray<uint8>& Out);
+    BIKEADVENTURE_API void WriteDiscoveries(const FDiscoverySaveState& Discoveries, TArray<uint8>& Out);
+
+    /** Append a choices chunk from bits packed by FBikeChoiceLog::CopyRange */
+    BIKEADVENTURE_API void WriteChoices(int32 FirstChoice, int32 NumChoices, TConstArrayView<uint8> PackedBits, TArray<uint8>& Out);
+
+    /**
+     * Decode a whole file
+     * @param OutNumChunks - Chunks read, used to decide when appending should give way to a rewrite;
+     *                       0 for files of an older version, so they are rewritten rather than appended to
+     * @return False if the header is missing or from an unknown version
+     */
+    BIKEADVENTURE_API bool Read(TConstArrayView<uint8> Bytes, FBikeSaveSnapshot& OutSnapshot, int32* OutNumChunks = nullptr);
+}
@@ -0,0 +1,295 @@
+#include "BikeSaveSubsystem.h"
+#include "DiscoverySystem.h"
+#include "../Core/BikeAdventureGameMode.h"
+#include "Async/Async.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+void UBikeSaveSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    PathPersonality = NewObject<UPathPersonalitySystem>(this);
+    PathPersonality->Initialize();
+}
+
+void UBikeSaveSubsystem::Deinitialize()
+{
+    // Never drop a save that was asked for
+    WaitForPendingIO();
+    if (bSaveQueued)
+    {
+        SaveGame();
+        WaitForPendingIO();
+    }
+
+    Super::Deinitialize();
+}
+
+FString UBikeSaveSubsystem::GetSavePath() const
+{
+    return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SaveFileName;
+}
+
+void UBikeSaveSubsystem::RecordChoice(bool bChoseLeftPath, EBiomeType BiomeChosen, EPathPersonality PersonalityChosen)
+{
+    ChoiceLog.Add(bChoseLeftPath, BiomeChosen, PersonalityChosen);
+    if (PathPersonality)
+    {
+        PathPersonality->UpdatePlayerChoiceHistory(ChoiceHistory, bChoseLeftPath, BiomeChosen, PersonalityChosen);
+    }
+}
+
+UDiscoverySystem* UBikeSaveSubsystem::ResolveDiscoverySystem() const
+{
+    if (DiscoverySystem.IsValid())
+    {
+        return DiscoverySystem.Get();
+    }
+
+    const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+    const ABikeAdventureGameMode* GameMode = World ? Cast<ABikeAdventureGameMode>(World->GetAuthGameMode()) : nullptr;
+    return GameMode ? GameMode->GetDiscoverySystem() : nullptr;
+}
+
+void UBikeSaveSubsystem::CaptureCounters(FBikeSaveCounters& Out) const
+{
+    Out.TotalChoices = ChoiceHistory.TotalChoices;
+    Out.LeftChoices = ChoiceHistory.LeftChoices;
+    Out.RightChoices = ChoiceHistory.RightChoices;
+    Out.PreferredPersonality = ChoiceHistory.PreferredPersonality;
+    Out.AdaptiveWeight = ChoiceHistory.AdaptiveWeight;
+    Out.PersonalityPreferences.SetNumUninitialized(PathPersonalityTables::NumPersonalities);
+    for (int32 Index = 0; Index < PathPersonalityTables::NumPersonalities; Index++)
+    {
+        Out.PersonalityPreferences[Index] = ChoiceHistory.PersonalityPreferences[Index];
+    }
+
+    const UDiscoverySystem* Discovery = ResolveDiscoverySystem();
+    Out.DiscoveriesFound = Discovery ? Discovery->GetTotalDiscoveriesFound() : 0;
+}
+
+void UBikeSaveSubsystem::CaptureDiscoveries(FDiscoverySaveState& Out) const
+{
+    if (const UDiscoverySystem* Discovery = ResolveDiscoverySystem())
+    {
+        Discovery->CaptureSaveState(Out);
+    }
+}
+
+bool UBikeSaveSubsystem::SaveGame()
+{
+    if (IsBusy())
+    {
+        bSaveQueued = true;
+        return false;
+    }
+
+    // Small snapshots and a bit copy of the new choices are all the game thread pays for
+    FBikeSaveCounters Counters;
+    CaptureCounters(Counters);
+    FDiscoverySaveState Discoveries;
+    CaptureDiscoveries(Discoveries);
+
+    const bool bRewrite = SavedChunks == 0 || SavedChunks + 3 > MaxChunksBeforeRewrite;
+    const int32 FirstChoice = bRewrite ? 0 : SavedChoices;
+    const int32 NumChoices = ChoiceLog.Num() - FirstChoice;
+    TArray<uint8> PackedChoices;
+    ChoiceLog.CopyRange(FirstChoice, NumChoices, PackedChoices);
+
+    const int32 PreviousChunks = bRewrite ? 0 : SavedChunks;
+    PendingIO = Async(EAsyncExecution::ThreadPool,
+        [Path = GetSavePath(), bRewrite, PreviousChunks, FirstChoice, NumChoices, Counters = MoveTemp(Counters),
+         Discoveries = MoveTemp(Discoveries), PackedChoices = MoveTemp(PackedChoices)]()
+        {
+            TArray<uint8> Bytes;
+            Bytes.Reserve(PackedChoices.Num() + 256);
+            if (bRewrite)
+            {
+                BikeSaveFormat::WriteFileHeader(Bytes);
+            }
+            BikeSaveFormat::WriteCounters(Counters, Bytes);
+            BikeSaveFormat::WriteDiscoveries(Discoveries, Bytes);
+            int32 NumChunks = 2;
+            if (bRewrite || NumChoices > 0)
+            {
+                BikeSaveFormat::WriteChoices(FirstChoice, NumChoices, PackedChoices, Bytes);
+                NumChunks++;
+            }
+
+            FIOResult Result;
+            if (bRewrite)
+            {
+                // Write beside the old save and swap, so a crash mid-write keeps the previous one
+                const FString TempPath = Path + TEXT(".tmp");
+                Result.bSuccess = FFileHelper::SaveArrayToFile(Bytes, *TempPath) && IFileManager::Get().Move(*Path, *TempPath, true);
+            }
+            else
+            {
+                Result.bSuccess = FFileHelper::SaveArrayToFile(Bytes, *Path, &IFileManager::Get(), FILEWRITE_Append);
+            }
+            Result.NumChunks = PreviousChunks + NumChunks;
+            Result.SavedChoices = FirstChoice + NumChoices;
+            return Result;
+        },
+        [WeakThis = TWeakObjectPtr<UBikeSaveSubsystem>(this)]()
+        {
+            AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+            {
+                if (UBikeSaveSubsystem* This = WeakThis.Get())
+                {
+                    This->FinishIO();
+                }
+            });
+        });
+
+    return true;
+}
+
+bool UBikeSaveSubsystem::LoadGame()
+{
+    if (IsBusy())
+    {
+        return false;
+    }
+
+    ChoicesAtLoadStart = ChoiceLog.Num();
+    PendingIO = Async(EAsyncExecution::ThreadPool,
+        [Path = GetSavePath()]()
+        {
+            FIOResult Result;
+            Result.bIsLoad = true;
+
+            TArray<uint8> Bytes;
+            if (FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+            {
+                Result.Snapshot = MakeUnique<FBikeSaveSnapshot>();
+                Result.bSuccess = BikeSaveFormat::Read(Bytes, *Result.Snapshot, &Result.NumChunks);
+            }
+            return Result;
+        },
+        [WeakThis = TWeakObjectPtr<UBikeSaveSubsystem>(this)]()
+        {
+            AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+            {
+                if (UBikeSaveSubsystem* This = WeakThis.Get())
+                {
+                    This->FinishIO();
+                }
+            });
+        });
+
+    return true;
+}
+
+void UBikeSaveSubsystem::WaitForPendingIO()
+{
+    if (PendingIO.IsValid())
+    {
+        PendingIO.Wait();
+        FinishIO();
+    }
+}
+
+void UBikeSaveSubsystem::FinishIO()
+{
+    // The completion task of an earlier request can arrive after WaitForPendingIO handled it
+    if (!PendingIO.IsValid() || !PendingIO.IsReady())
+    {
+        return;
+    }
+
+    FIOResult Result = PendingIO.Consume();
+    if (Result.bIsLoad)
+    {
+        if (Result.bSuccess)
+        {
+            const int32 LoadedChoices = Result.Snapshot->Choices.Num();
+            ApplySnapshot(*Result.Snapshot);
+            SavedChoices = LoadedChoices;
+            SavedChunks = Result.NumChunks;
+        }
+        UE_LOG(LogTemp, Log, TEXT("Save loaded: %s (%d choices)"), Result.bSuccess ? TEXT("ok") : TEXT("failed"), ChoiceLog.Num());
+        OnLoadCompleted.Broadcast(Result.bSuccess);
+    }
+    else
+    {
+        if (Result.bSuccess)
+        {
+            SavedChoices = Result.SavedChoices;
+            SavedChunks = Result.NumChunks;
+        }
+        else
+        {
+            // The file may hold a partial append, start over with a clean file
+            SavedChunks = 0;
+            UE_LOG(LogTemp, Warning, TEXT("Failed to write save file %s"), *GetSavePath());
+        }
+        OnSaveCompleted.Broadcast(Result.bSuccess);
+    }
+
+    if (bSaveQueued && !IsBusy())
+    {
+        bSaveQueued = false;
+        SaveGame();
+    }
+}
+
+void UBikeSaveSubsystem::ApplySnapshot(FBikeSaveSnapshot& Snapshot)
+{
+    // Choices made while the file was being read happened after the loaded run
+    FBikeChoiceLog RecordedDuringLoad;
+    const int32 NumRecordedDuringLoad = FMath::Max(ChoiceLog.Num() - ChoicesAtLoadStart, 0);
+    if (NumRecordedDuringLoad > 0)
+    {
+        TArray<uint8> Packed;
+        ChoiceLog.CopyRange(ChoiceLog.Num() - NumRecordedDuringLoad, NumRecordedDuringLoad, Packed);
+        RecordedDuringLoad.AppendPacked(Packed.GetData(), NumRecordedDuringLoad);
+    }
+
+    ChoiceLog = MoveTemp(Snapshot.Choices);
+
+    const FBikeSaveCounters& Counters = Snapshot.Counters;
+    ChoiceHistory = FPlayerChoiceHistory();
+    ChoiceHistory.TotalChoices = Counters.TotalChoices;
+    ChoiceHistory.LeftChoices = Counters.LeftChoices;
+    ChoiceHistory.RightChoices = Counters.RightChoices;
+    ChoiceHistory.PreferredPersonality = Counters.PreferredPersonality;
+    ChoiceHistory.AdaptiveWeight = Counters.AdaptiveWeight;
+    for (int32 Index = 0; Index < FMath::Min(Counters.PersonalityPreferences.Num(), PathPersonalityTables::NumPersonalities); Index++)
+    {
+        ChoiceHistory.PersonalityPreferences[Index] = Counters.PersonalityPreferences[Index];
+    }
+
+    // The recent window and streak are rebuilt by replaying the tail of the log, reaching back
+    // to where the current streak started when that is further than the window
+    int32 FirstReplayed = ChoiceLog.Num() - 1;
+    if (FirstReplayed > 0)
+    {
+        const bool bLastLeft = ChoiceLog.Get(FirstReplayed).bChoseLeft;
+        while (FirstReplayed > 0 && ChoiceLog.Get(FirstReplayed - 1).bChoseLeft == bLastLeft)
+        {
+            FirstReplayed--;
+        }
+    }
+    FirstReplayed = FMath::Max(FMath::Min(FirstReplayed, ChoiceLog.Num() - FPlayerChoiceHistory::RecentCapacity), 0);
+    for (int32 Index = FirstReplayed; Index < ChoiceLog.Num(); Index++)
+    {
+        const FBikeChoiceLog::FChoice Choice = ChoiceLog.Get(Index);
+        ChoiceHistory.PushRecent(Choice.bChoseLeft, Choice.Biome, Choice.Personality);
+    }
+
+    for (int32 Index = 0; Index < RecordedDuringLoad.Num(); Index++)
+    {
+        const FBikeChoiceLog::FChoice Choice = RecordedDuringLoad.Get(Index);
+        RecordChoice(Choice.bChoseLeft, Choice.Biome, Choice.Personality);
+    }
+
+    if (UDiscoverySystem* Discovery = ResolveDiscoverySystem())
+    {
+        Discovery->RestoreSaveState(Snapshot.Discoveries);
+    }
+}
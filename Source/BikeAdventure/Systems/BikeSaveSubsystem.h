@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Async/Future.h"
+#include "BikeSaveFormat.h"
+#include "PathPersonalitySystem.h"
+#include "BikeSaveSubsystem.generated.h"
+
+class UDiscoverySystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBikeSaveCompleted, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBikeLoadCompleted, bool, bSuccess);
+
+/**
+ * Persists the run: every intersection choice, choice statistics and found discoveries.
+ * State is captured on the game thread (a bit copy of the packed choice log and two small
+ * snapshots) and written on a worker thread. Saves append only what changed since the last
+ * save to the same file, and the file is rewritten whole once it has collected too many chunks.
+ */
+UCLASS()
+class BIKEADVENTURE_API UBikeSaveSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // USubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Record an intersection choice into the log and choice history */
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    void RecordChoice(bool bChoseLeftPath, EBiomeType BiomeChosen, EPathPersonality PersonalityChosen);
+
+    /**
+     * Start saving in the background
+     * @return False if a save is already running; the request is then run once it finishes
+     */
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    bool SaveGame();
+
+    /**
+     * Start loading in the background; state is replaced on the game thread when it completes,
+     * keeping choices recorded while the load was running on top of the loaded run
+     * @return False if a save or load is already running
+     */
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    bool LoadGame();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Save")
+    bool IsBusy() const { return PendingIO.IsValid(); }
+
+    /** Block until background I/O finishes and apply its result; for shutdown and tests */
+    void WaitForPendingIO();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Save")
+    const FPlayerChoiceHistory& GetChoiceHistory() const { return ChoiceHistory; }
+
+    const FBikeChoiceLog& GetChoiceLog() const { return ChoiceLog; }
+
+    /** Discovery system whose state is saved; defaults to the game mode's */
+    void SetDiscoverySystem(UDiscoverySystem* InDiscoverySystem) { DiscoverySystem = InDiscoverySystem; }
+
+    /** Full path of the save file */
+    FString GetSavePath() const;
+
+    /** Save file name inside Saved/SaveGames */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Save")
+    FString SaveFileName = TEXT("BikeAdventure.bsav");
+
+    /** Chunks the file may collect from incremental saves before it is rewritten whole */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Save", meta = (ClampMin = "4"))
+    int32 MaxChunksBeforeRewrite = 64;
+
+    UPROPERTY(BlueprintAssignable, Category = "Save")
+    FOnBikeSaveCompleted OnSaveCompleted;
+
+    UPROPERTY(BlueprintAssignable, Category = "Save")
+    FOnBikeLoadCompleted OnLoadCompleted;
+
+private:
+    /** Result of background I/O, applied on the game thread */
+    struct FIOResult
+    {
+        bool bIsLoad = false;
+        bool bSuccess = false;
+        int32 NumChunks = 0;
+        int32 SavedChoices = 0;
+        TUniquePtr<FBikeSaveSnapshot> Snapshot;
+    };
+
+    void CaptureCounters(FBikeSaveCounters& Out) const;
+    void CaptureDiscoveries(FDiscoverySaveState& Out) const;
+    void ApplySnapshot(FBikeSaveSnapshot& Snapshot);
+    void FinishIO();
+    UDiscoverySystem* ResolveDiscoverySystem() const;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UPathPersonalitySystem> PathPersonality;
+
+    TWeakObjectPtr<UDiscoverySystem> DiscoverySystem;
+
+    FPlayerChoiceHistory ChoiceHistory;
+    FBikeChoiceLog ChoiceLog;
+
+    /** Choices already in the save file, and chunks it holds; a rewrite is forced while SavedChunks is 0 */
+    int32 SavedChoices = 0;
+    int32 SavedChunks = 0;
+
+    /** Choices in the log when the running load started; later ones are replayed onto the loaded log */
+    int32 ChoicesAtLoadStart = 0;
+
+    TFuture<FIOResult> PendingIO;
+    bool bSaveQueued = false;
+};
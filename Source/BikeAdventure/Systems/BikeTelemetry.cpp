@@ -0,0 +1,254 @@
+#include "BikeTelemetry.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/Paths.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/DateTime.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+    bool bTelemetryRequested = false;
+
+    void OnTelemetryRequestChanged(IConsoleVariable* Variable)
+    {
+        if (bTelemetryRequested)
+        {
+            FBikeTelemetry::Get().Startup();
+        }
+        else
+        {
+            FBikeTelemetry::Get().Shutdown();
+        }
+    }
+
+    FAutoConsoleVariableRef CVarBikeTelemetry(
+        TEXT("bike.Telemetry"),
+        bTelemetryRequested,
+        TEXT("Record hot-path telemetry to Saved/Telemetry (off by default; -BikeTelemetry also enables it)"),
+        FConsoleVariableDelegate::CreateStatic(&OnTelemetryRequestChanged),
+        ECVF_Default);
+}
+
+FBikeTelemetry& FBikeTelemetry::Get()
+{
+    static FBikeTelemetry Instance;
+    return Instance;
+}
+
+bool FBikeTelemetry::IsRequested()
+{
+    return bTelemetryRequested || FParse::Param(FCommandLine::Get(), TEXT("BikeTelemetry"));
+}
+
+FBikeTelemetry::FBikeTelemetry()
+    : EnqueuePosition(0)
+    , DequeuePosition(0)
+    , DroppedCount(0)
+    , bEnabled(false)
+    , bStopRequested(false)
+    , Thread(nullptr)
+    , WakeEvent(nullptr)
+{
+    for (uint32 Index = 0; Index < RingCapacity; ++Index)
+    {
+        Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+    }
+}
+
+FBikeTelemetry::~FBikeTelemetry()
+{
+    Shutdown();
+
+    // Kept alive between Shutdown/Startup cycles since late producers may still poke it
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+}
+
+bool FBikeTelemetry::Startup(const FString& OutputPath)
+{
+    FScopeLock Lock(&FlushLock);
+
+    if (FileHandle.IsValid())
+    {
+        return bEnabled.load(std::memory_order_relaxed);
+    }
+
+    OutputFilePath = OutputPath;
+    if (OutputFilePath.IsEmpty())
+    {
+        OutputFilePath = FPaths::ProjectSavedDir() / TEXT("Telemetry") /
+            FString::Printf(TEXT("BikeTelemetry_%s.bin"), *FDateTime::Now().ToString());
+    }
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(OutputFilePath));
+
+    FileHandle.Reset(PlatformFile.OpenWrite(*OutputFilePath));
+    if (!FileHandle.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to open telemetry file %s"), *OutputFilePath);
+        return false;
+    }
+
+    FBikeTelemetryFileHeader Header;
+    Header.Magic = FBikeTelemetryFileHeader::FileMagic;
+    Header.Version = FBikeTelemetryFileHeader::FileVersion;
+    Header.RecordSize = sizeof(FBikeTelemetryRecord);
+    Header.SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+    Header.StartCycles = FPlatformTime::Cycles64();
+    FileHandle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+    FlushBuffer.Reserve(RingCapacity);
+    DroppedCount.store(0, std::memory_order_relaxed);
+    bStopRequested.store(false, std::memory_order_relaxed);
+    bEnabled.store(true, std::memory_order_release);
+
+    if (FPlatformProcess::SupportsMultithreading())
+    {
+        if (!WakeEvent)
+        {
+            WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+        }
+        Thread = FRunnableThread::Create(this, TEXT("BikeTelemetryFlush"), 0, TPri_BelowNormal);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Telemetry recording to %s"), *OutputFilePath);
+    return true;
+}
+
+void FBikeTelemetry::Shutdown()
+{
+    bEnabled.store(false, std::memory_order_release);
+
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    Flush();
+
+    FScopeLock Lock(&FlushLock);
+    if (FileHandle.IsValid())
+    {
+        const uint64 Dropped = GetDroppedCount();
+        if (Dropped > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Telemetry ring dropped %llu records"), Dropped);
+        }
+        FileHandle.Reset();
+    }
+}
+
+void FBikeTelemetry::Record(EBikeTelemetryEvent Event, const FIntVector& Coordinates, uint8 ValueA, uint8 ValueB, int32 IntValue, float FloatValue, uint8 Flags)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    // Bounded MPMC ring: each slot carries a sequence number telling producers
+    // whether it is free for position Pos (Sequence == Pos) or still unconsumed.
+    uint64 Pos = EnqueuePosition.load(std::memory_order_relaxed);
+    FSlot* Slot = nullptr;
+    for (;;)
+    {
+        Slot = &Slots[Pos & RingMask];
+        const uint64 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+        const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Pos);
+
+        if (Difference == 0)
+        {
+            if (EnqueuePosition.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (Difference < 0)
+        {
+            // Ring is full - drop rather than stall the caller
+            DroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            Pos = EnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    FBikeTelemetryRecord& Data = Slot->Data;
+    Data.TimestampCycles = FPlatformTime::Cycles64();
+    Data.EventType = static_cast<uint8>(Event);
+    Data.BiomeA = ValueA;
+    Data.BiomeB = ValueB;
+    Data.Flags = Flags;
+    Data.X = Coordinates.X;
+    Data.Y = Coordinates.Y;
+    Data.Z = Coordinates.Z;
+    Data.IntValue = IntValue;
+    Data.FloatValue = FloatValue;
+
+    Slot->Sequence.store(Pos + 1, std::memory_order_release);
+
+    // Wake the flush thread early once half the ring has been used since the last wake
+    if (WakeEvent && (Pos & (RingCapacity / 2 - 1)) == 0)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+int32 FBikeTelemetry::Flush()
+{
+    FScopeLock Lock(&FlushLock);
+
+    FlushBuffer.Reset();
+    for (;;)
+    {
+        FSlot& Slot = Slots[DequeuePosition & RingMask];
+        if (Slot.Sequence.load(std::memory_order_acquire) != DequeuePosition + 1)
+        {
+            break;
+        }
+
+        FlushBuffer.Add(Slot.Data);
+        Slot.Sequence.store(DequeuePosition + RingCapacity, std::memory_order_release);
+        ++DequeuePosition;
+    }
+
+    if (FlushBuffer.Num() > 0 && FileHandle.IsValid())
+    {
+        FileHandle->Write(reinterpret_cast<const uint8*>(FlushBuffer.GetData()), FlushBuffer.Num() * sizeof(FBikeTelemetryRecord));
+        FileHandle->Flush();
+    }
+
+    return FlushBuffer.Num();
+}
+
+uint32 FBikeTelemetry::Run()
+{
+    while (!bStopRequested.load(std::memory_order_acquire))
+    {
+        WakeEvent->Wait(FlushIntervalMs);
+        Flush();
+    }
+
+    return 0;
+}
+
+void FBikeTelemetry::Stop()
+{
+    bStopRequested.store(true, std::memory_order_release);
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "../Core/BiomeTypes.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+class IFileHandle;
+
+/**
+ * Event identifiers written into the telemetry stream.
+ * Values are part of the file format - append only, never renumber.
+ */
+enum class EBikeTelemetryEvent : uint8
+{
+    None = 0,
+    SectionStreamIn = 1,        // X/Y/Z = section, BiomeA = biome
+    SectionLoaded = 2,          // X/Y/Z = section, BiomeA = biome, IntValue = memory KB, FloatValue = load ms, Flags bit0 = has intersection
+    SectionUnloaded = 3,        // X/Y/Z = section, BiomeA = biome, FloatValue = unload ms
+    PathSegmentGenerated = 4,   // X/Y/Z = location (cm), BiomeA = biome, IntValue = actors spawned, FloatValue = generation ms, Flags = quality level
+    BiomeTransition = 5,        // BiomeA = from, BiomeB = to, Flags bit0 = left path
+    PathHintsGenerated = 6,     // BiomeA = left personality, BiomeB = right personality, FloatValue = hint subtlety
+    PathHintsBatchGenerated = 7, // X/Y/Z = first section, IntValue = intersections, FloatValue = batch ms
+    InputLatency = 8            // BiomeA = frames to present, IntValue = input to movement update us, FloatValue = input to present ms
+};
+
+/**
+ * Fixed-size telemetry record. Layout is part of the on-disk format,
+ * see scripts/automation/decode-telemetry.py for the matching decoder.
+ */
+struct FBikeTelemetryRecord
+{
+    uint64 TimestampCycles;
+    uint8 EventType;
+    uint8 BiomeA;
+    uint8 BiomeB;
+    uint8 Flags;
+    int32 X;
+    int32 Y;
+    int32 Z;
+    int32 IntValue;
+    float FloatValue;
+};
+
+static_assert(sizeof(FBikeTelemetryRecord) == 32, "FBikeTelemetryRecord layout is part of the telemetry file format");
+
+/**
+ * Header written once at the start of every telemetry file
+ */
+struct FBikeTelemetryFileHeader
+{
+    static constexpr uint32 FileMagic = 0x4C544B42; // "BKTL"
+    static constexpr uint16 FileVersion = 1;
+
+    uint32 Magic;
+    uint16 Version;
+    uint16 RecordSize;
+    double SecondsPerCycle;
+    uint64 StartCycles;
+};
+
+static_assert(sizeof(FBikeTelemetryFileHeader) == 24, "FBikeTelemetryFileHeader layout is part of the telemetry file format");
+
+/**
+ * Structured binary telemetry channel for hot paths.
+ * Producers claim a slot in a bounded lock-free ring and copy one fixed-size record;
+ * a background thread drains the ring to a compact file. No string formatting or
+ * allocation happens on the producer side, and records are dropped (and counted)
+ * rather than blocking when the ring is full.
+ * Recording is opt-in: pass -BikeTelemetry or set bike.Telemetry 1, which also starts and stops it at runtime.
+ */
+class BIKEADVENTURE_API FBikeTelemetry : public FRunnable
+{
+public:
+    /** Number of records the ring can hold before producers start dropping */
+    static constexpr uint32 RingCapacity = 8192;
+
+    static FBikeTelemetry& Get();
+
+    /**
+     * Whether recording was asked for, via -BikeTelemetry or bike.Telemetry=1.
+     * Telemetry is off by default so editor sessions and automation runs write no files.
+     */
+    static bool IsRequested();
+
+    /**
+     * Open the output file and start the flush thread
+     * @param OutputPath - Destination file, defaults to Saved/Telemetry/BikeTelemetry_<timestamp>.bin
+     * @return True if the channel is now recording
+     */
+    bool Startup(const FString& OutputPath = FString());
+
+    /** Stop the flush thread, drain any pending records and close the file */
+    void Shutdown();
+
+    /** Whether records are currently being accepted */
+    FORCEINLINE bool IsEnabled() const
+    {
+        return bEnabled.load(std::memory_order_relaxed);
+    }
+
+    /** Append a record to the ring. Safe to call from any thread */
+    void Record(EBikeTelemetryEvent Event, const FIntVector& Coordinates, uint8 ValueA, uint8 ValueB, int32 IntValue = 0, float FloatValue = 0.0f, uint8 Flags = 0);
+
+    FORCEINLINE void Record(EBikeTelemetryEvent Event, const FIntVector& Coordinates, EBiomeType BiomeA, EBiomeType BiomeB = EBiomeType::None, int32 IntValue = 0, float FloatValue = 0.0f, uint8 Flags = 0)
+    {
+        Record(Event, Coordinates, static_cast<uint8>(BiomeA), static_cast<uint8>(BiomeB), IntValue, FloatValue, Flags);
+    }
+
+    /** Drain the ring to disk on the calling thread. Returns the number of records written */
+    int32 Flush();
+
+    /** Number of records dropped because the ring was full */
+    uint64 GetDroppedCount() const { return DroppedCount.load(std::memory_order_relaxed); }
+
+    /** Path of the file currently being written */
+    const FString& GetOutputPath() const { return OutputFilePath; }
+
+    // FRunnable interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    FBikeTelemetry();
+    virtual ~FBikeTelemetry();
+
+    struct FSlot
+    {
+        std::atomic<uint64> Sequence;
+        FBikeTelemetryRecord Data;
+    };
+
+    static constexpr uint32 RingMask = RingCapacity - 1;
+    static_assert((RingCapacity & RingMask) == 0, "RingCapacity must be a power of two");
+
+    /** Interval between background flushes */
+    static constexpr uint32 FlushIntervalMs = 250;
+
+    FSlot Slots[RingCapacity];
+
+    alignas(64) std::atomic<uint64> EnqueuePosition;
+    alignas(64) uint64 DequeuePosition;
+
+    std::atomic<uint64> DroppedCount;
+    std::atomic<bool> bEnabled;
+    std::atomic<bool> bStopRequested;
+
+    /** Serialises consumers (flush thread, explicit Flush and Shutdown) */
+    FCriticalSection FlushLock;
+
+    /** Scratch buffer reused between flushes */
+    TArray<FBikeTelemetryRecord> FlushBuffer;
+
+    TUniquePtr<IFileHandle> FileHandle;
+    FString OutputFilePath;
+
+    FRunnableThread* Thread;
+    FEvent* WakeEvent;
+};
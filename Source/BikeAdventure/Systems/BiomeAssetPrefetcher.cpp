@@ -0,0 +1,296 @@
+#include "BiomeAssetPrefetcher.h"
+#include "AdvancedBiomePCGSettings.h"
+#include "IntersectionAssetPrefetcher.h"
+#include "Engine/StaticMesh.h"
+#include "UObject/UnrealType.h"
+
+UBiomeAssetPrefetcher::UBiomeAssetPrefetcher()
+{
+    PrefetchDepth = 2;
+    MemoryBudgetMB = 512;
+    PendingMeshEstimateKB = 2048;
+    RiderBiome = EBiomeType::None;
+}
+
+void UBiomeAssetPrefetcher::GatherBiomeMeshPaths(EBiomeType BiomeType, TArray<FSoftObjectPath>& OutPaths)
+{
+    const UClass* SettingsClass = UBiomePresetManager::GetPCGSettingsClass(BiomeType);
+    const UObject* Defaults = SettingsClass ? SettingsClass->GetDefaultObject() : nullptr;
+    if (!Defaults)
+    {
+        return;
+    }
+
+    // Every soft static mesh the settings can place, whether held singly or in an array
+    for (TFieldIterator<FProperty> It(SettingsClass); It; ++It)
+    {
+        if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(*It))
+        {
+            const FSoftObjectProperty* Inner = CastField<FSoftObjectProperty>(ArrayProperty->Inner);
+            if (!Inner || !Inner->PropertyClass || !Inner->PropertyClass->IsChildOf(UStaticMesh::StaticClass()))
+            {
+                continue;
+            }
+
+            FScriptArrayHelper Array(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(Defaults));
+            for (int32 Index = 0; Index < Array.Num(); Index++)
+            {
+                const FSoftObjectPath Path = Inner->GetPropertyValue(Array.GetRawPtr(Index)).ToSoftObjectPath();
+                if (!Path.IsNull())
+                {
+                    OutPaths.AddUnique(Path);
+                }
+            }
+        }
+        else if (const FSoftObjectProperty* SoftProperty = CastField<FSoftObjectProperty>(*It))
+        {
+            if (SoftProperty->PropertyClass && SoftProperty->PropertyClass->IsChildOf(UStaticMesh::StaticClass()))
+            {
+                const FSoftObjectPath Path = SoftProperty->GetPropertyValue_InContainer(Defaults).ToSoftObjectPath();
+                if (!Path.IsNull())
+                {
+                    OutPaths.AddUnique(Path);
+                }
+            }
+        }
+    }
+}
+
+void UBiomeAssetPrefetcher::GetTransitionDistances(EBiomeType CurrentBiome, int32 (&OutDistances)[BiomeTables::NumBiomes])
+{
+    for (int32& Distance : OutDistances)
+    {
+        Distance = INDEX_NONE;
+    }
+
+    if (!BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        return;
+    }
+
+    // Breadth first; the graph is tiny, so the queue lives on the stack
+    EBiomeType Queue[BiomeTables::NumBiomes];
+    int32 QueueEnd = 0;
+    Queue[QueueEnd++] = CurrentBiome;
+    OutDistances[static_cast<int32>(CurrentBiome)] = 0;
+
+    for (int32 Head = 0; Head < QueueEnd; Head++)
+    {
+        const int32 NextDistance = OutDistances[static_cast<int32>(Queue[Head])] + 1;
+        for (EBiomeType Next : UBiomeUtilities::GetDefaultTransitionRulesRef(Queue[Head]).ValidTransitions)
+        {
+            if (BiomeTables::IsValidBiome(Next) && OutDistances[static_cast<int32>(Next)] == INDEX_NONE)
+            {
+                OutDistances[static_cast<int32>(Next)] = NextDistance;
+                Queue[QueueEnd++] = Next;
+            }
+        }
+    }
+}
+
+void UBiomeAssetPrefetcher::UpdateForBiome(EBiomeType CurrentBiome)
+{
+    if (!BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        return;
+    }
+
+    RiderBiome = CurrentBiome;
+
+    int32 Distances[BiomeTables::NumBiomes];
+    GetTransitionDistances(CurrentBiome, Distances);
+
+    // Nearest biomes first, so they are queued ahead at a higher priority
+    for (int32 Depth = 0; Depth <= PrefetchDepth; Depth++)
+    {
+        for (int32 Index = 0; Index < BiomeTables::NumBiomes; Index++)
+        {
+            if (Distances[Index] == Depth)
+            {
+                RetainBiome(static_cast<EBiomeType>(Index), FStreamableManager::AsyncLoadHighPriority - Depth);
+            }
+        }
+    }
+
+    EvictOverBudget(Distances, EBiomeType::None);
+}
+
+void UBiomeAssetPrefetcher::PrefetchBiome(EBiomeType BiomeType)
+{
+    RetainBiome(BiomeType, FStreamableManager::AsyncLoadHighPriority);
+}
+
+void UBiomeAssetPrefetcher::RetainBiome(EBiomeType BiomeType, int32 Priority)
+{
+    if (!BiomeTables::IsValidBiome(BiomeType))
+    {
+        return;
+    }
+
+    FBiomeMeshState& State = MeshStates[static_cast<int32>(BiomeType)];
+    if (State.Handle.IsValid() || State.bLoaded)
+    {
+        return;
+    }
+
+    ScratchPaths.Reset();
+    GatherBiomeMeshPaths(BiomeType, ScratchPaths);
+    State.NumMeshes = ScratchPaths.Num();
+    State.ResidentBytes = 0;
+
+    if (ScratchPaths.Num() == 0)
+    {
+        State.bLoaded = true;
+        return;
+    }
+
+    // The delegate may run inside this call when every mesh is already resident
+    State.Handle = UIntersectionAssetPrefetcher::GetStreamableManager().RequestAsyncLoad(
+        ScratchPaths,
+        FStreamableDelegate::CreateUObject(this, &UBiomeAssetPrefetcher::OnBiomeMeshesLoaded, BiomeType),
+        Priority);
+
+    // A delegate that already ran could not see the handle, so measure what loaded now
+    if (State.bLoaded)
+    {
+        OnBiomeMeshesLoaded(BiomeType);
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Prefetching %d meshes for %s"), ScratchPaths.Num(), *UBiomeUtilities::GetBiomeNameRef(BiomeType));
+}
+
+void UBiomeAssetPrefetcher::OnBiomeMeshesLoaded(EBiomeType BiomeType)
+{
+    FBiomeMeshState& State = MeshStates[static_cast<int32>(BiomeType)];
+    State.bLoaded = true;
+    State.ResidentBytes = 0;
+
+    if (!State.Handle.IsValid())
+    {
+        return;
+    }
+
+    // Replace the pending estimate with what actually loaded; missing meshes cost nothing
+    TArray<UObject*> LoadedAssets;
+    State.Handle->GetLoadedAssets(LoadedAssets);
+    for (const UObject* Asset : LoadedAssets)
+    {
+        if (const UStaticMesh* Mesh = Cast<UStaticMesh>(Asset))
+        {
+            State.ResidentBytes += Mesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+        }
+    }
+
+    // The real size may exceed the pending estimate; until the rider's biome is known every biome is equally near
+    if (BiomeTables::IsValidBiome(RiderBiome))
+    {
+        int32 Distances[BiomeTables::NumBiomes];
+        GetTransitionDistances(RiderBiome, Distances);
+        EvictOverBudget(Distances, BiomeType);
+    }
+}
+
+void UBiomeAssetPrefetcher::ReleaseBiome(EBiomeType BiomeType)
+{
+    FBiomeMeshState& State = MeshStates[static_cast<int32>(BiomeType)];
+    if (State.Handle.IsValid())
+    {
+        if (State.Handle->IsLoadingInProgress())
+        {
+            State.Handle->CancelHandle();
+        }
+        else
+        {
+            State.Handle->ReleaseHandle();
+        }
+    }
+
+    State = FBiomeMeshState();
+}
+
+void UBiomeAssetPrefetcher::EvictOverBudget(const int32 (&Distances)[BiomeTables::NumBiomes], EBiomeType KeepBiome)
+{
+    const int64 BudgetBytes = static_cast<int64>(MemoryBudgetMB) * 1024 * 1024;
+    int64 RetainedBytes = GetEstimatedRetainedBytes();
+
+    while (RetainedBytes > BudgetBytes)
+    {
+        // Farthest unreachable biome first; biomes within PrefetchDepth are never evicted
+        int32 Victim = INDEX_NONE;
+        int32 VictimDistance = PrefetchDepth;
+        for (int32 Index = 0; Index < BiomeTables::NumBiomes; Index++)
+        {
+            if (!MeshStates[Index].Handle.IsValid() || Index == static_cast<int32>(KeepBiome))
+            {
+                continue;
+            }
+
+            const int32 Distance = Distances[Index] == INDEX_NONE ? MAX_int32 : Distances[Index];
+            if (Distance > VictimDistance)
+            {
+                Victim = Index;
+                VictimDistance = Distance;
+            }
+        }
+
+        if (Victim == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Biomes within %d transitions need %lld KB of meshes, over the %d MB budget"),
+                PrefetchDepth, RetainedBytes / 1024, MemoryBudgetMB);
+            return;
+        }
+
+        RetainedBytes -= GetEstimatedBytes(MeshStates[Victim]);
+        ReleaseBiome(static_cast<EBiomeType>(Victim));
+    }
+}
+
+int64 UBiomeAssetPrefetcher::GetEstimatedBytes(const FBiomeMeshState& State) const
+{
+    if (!State.Handle.IsValid())
+    {
+        return 0;
+    }
+
+    return State.bLoaded ? State.ResidentBytes : static_cast<int64>(State.NumMeshes) * PendingMeshEstimateKB * 1024;
+}
+
+bool UBiomeAssetPrefetcher::IsBiomeRetained(EBiomeType BiomeType) const
+{
+    return BiomeTables::IsValidBiome(BiomeType) && MeshStates[static_cast<int32>(BiomeType)].Handle.IsValid();
+}
+
+bool UBiomeAssetPrefetcher::IsBiomeReady(EBiomeType BiomeType) const
+{
+    return BiomeTables::IsValidBiome(BiomeType) && MeshStates[static_cast<int32>(BiomeType)].bLoaded;
+}
+
+int32 UBiomeAssetPrefetcher::GetRetainedBiomeCount() const
+{
+    int32 Count = 0;
+    for (const FBiomeMeshState& State : MeshStates)
+    {
+        Count += State.Handle.IsValid() ? 1 : 0;
+    }
+
+    return Count;
+}
+
+int64 UBiomeAssetPrefetcher::GetEstimatedRetainedBytes() const
+{
+    int64 Bytes = 0;
+    for (const FBiomeMeshState& State : MeshStates)
+    {
+        Bytes += GetEstimatedBytes(State);
+    }
+
+    return Bytes;
+}
+
+void UBiomeAssetPrefetcher::ReleaseAll()
+{
+    for (int32 Index = 0; Index < BiomeTables::NumBiomes; Index++)
+    {
+        ReleaseBiome(static_cast<EBiomeType>(Index));
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Engine/StreamableManager.h"
+#include "../Core/BiomeTypes.h"
+#include "BiomeAssetPrefetcher.generated.h"
+
+/**
+ * Keeps the meshes of every biome the rider can reach soon resident.
+ * Whenever the rider's biome changes, the default transition graph is walked breadth first to
+ * PrefetchDepth transitions, and the static meshes referenced by each reachable biome's PCG
+ * settings are requested through the shared streamable manager, nearest biomes first. Biomes
+ * that fall out of reach stay cached until the estimated resident size exceeds the memory
+ * budget, then the farthest are released first; the budget is checked again whenever a load
+ * finishes and its real size replaces the estimate. Since every biome one transition away is
+ * already loading before its intersection is reached, the first section of a new biome
+ * finds its meshes in memory.
+ */
+UCLASS(BlueprintType)
+class BIKEADVENTURE_API UBiomeAssetPrefetcher : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UBiomeAssetPrefetcher();
+
+    /**
+     * The rider is now in CurrentBiome: retain every biome within PrefetchDepth transitions of it,
+     * then evict unreachable biomes while over the memory budget
+     */
+    UFUNCTION(BlueprintCallable, Category = "Asset Prefetch")
+    void UpdateForBiome(EBiomeType CurrentBiome);
+
+    /**
+     * Retain a single biome, e.g. one just chosen for an upcoming section, at high priority
+     */
+    UFUNCTION(BlueprintCallable, Category = "Asset Prefetch")
+    void PrefetchBiome(EBiomeType BiomeType);
+
+    /**
+     * Whether the biome's meshes have been requested and are kept resident
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Asset Prefetch")
+    bool IsBiomeRetained(EBiomeType BiomeType) const;
+
+    /**
+     * Whether the biome's meshes have finished loading
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Asset Prefetch")
+    bool IsBiomeReady(EBiomeType BiomeType) const;
+
+    /**
+     * Number of biomes whose meshes are currently retained
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Asset Prefetch")
+    int32 GetRetainedBiomeCount() const;
+
+    /**
+     * Estimated size of every retained biome's meshes; loads still in flight are counted at
+     * PendingMeshEstimateKB per mesh
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Asset Prefetch")
+    int64 GetEstimatedRetainedBytes() const;
+
+    /**
+     * Release every retained biome
+     */
+    UFUNCTION(BlueprintCallable, Category = "Asset Prefetch")
+    void ReleaseAll();
+
+    /**
+     * Static meshes referenced by the biome's PCG settings class defaults
+     */
+    static void GatherBiomeMeshPaths(EBiomeType BiomeType, TArray<FSoftObjectPath>& OutPaths);
+
+    /**
+     * Fewest transitions from CurrentBiome to each biome over the default transition rules,
+     * indexed by biome; INDEX_NONE for biomes that cannot be reached
+     */
+    static void GetTransitionDistances(EBiomeType CurrentBiome, int32 (&OutDistances)[BiomeTables::NumBiomes]);
+
+    // Transitions ahead of the current biome whose meshes are kept resident
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Prefetch", meta = (ClampMin = "1", ClampMax = "6"))
+    int32 PrefetchDepth;
+
+    // Estimated mesh memory above which unreachable biomes are released
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Prefetch", meta = (ClampMin = "0"))
+    int32 MemoryBudgetMB;
+
+    // Size assumed for a mesh whose load has not completed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Prefetch", meta = (ClampMin = "0"))
+    int32 PendingMeshEstimateKB;
+
+private:
+    /** Retained meshes of one biome */
+    struct FBiomeMeshState
+    {
+        TSharedPtr<FStreamableHandle> Handle;
+        int64 ResidentBytes = 0;
+        int32 NumMeshes = 0;
+        bool bLoaded = false;
+    };
+
+    void RetainBiome(EBiomeType BiomeType, int32 Priority);
+    void ReleaseBiome(EBiomeType BiomeType);
+    void OnBiomeMeshesLoaded(EBiomeType BiomeType);
+    /** Release the farthest biomes beyond PrefetchDepth while over budget, never KeepBiome */
+    void EvictOverBudget(const int32 (&Distances)[BiomeTables::NumBiomes], EBiomeType KeepBiome);
+    int64 GetEstimatedBytes(const FBiomeMeshState& State) const;
+
+    FBiomeMeshState MeshStates[BiomeTables::NumBiomes];
+
+    // Biome passed to the last UpdateForBiome; distances for eviction are measured from it
+    EBiomeType RiderBiome;
+
+    // Scratch buffer reused between requests
+    TArray<FSoftObjectPath> ScratchPaths;
+};
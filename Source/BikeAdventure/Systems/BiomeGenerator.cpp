@@ -7,6 +7,9 @@
 #include "../Gameplay/Intersection.h"
 #include "AdvancedBiomePCGSettings.h"
 #include "PerformanceOptimizationSystem.h"
+#include "BikeTelemetry.h"
+#include "IntersectionAssetPrefetcher.h"
+#include "BiomeAssetPrefetcher.h"
 #include "HAL/PlatformTime.h"
 #include "DrawDebugHelpers.h"
 
@@ -125,12 +128,15 @@ void UBiomeGenerator::GenerateBiome(const FVector& Location, int32 BiomeType)
 
 EBiomeType UBiomeGenerator::GenerateNextBiome(EBiomeType CurrentBiome, bool bChooseLeftPath, const TArray<EBiomeType>& BiomeHistory)
 {
-        EBiomeType NextBiome = UBiomeUtilities::GetRandomValidTransition(CurrentBiome, BiomeHistory);
+        return GenerateNextBiomeWithHistory(CurrentBiome, bChooseLeftPath, FBiomeHistorySignature::FromHistory(CurrentBiome, BiomeHistory));
+}
+
+EBiomeType UBiomeGenerator::GenerateNextBiomeWithHistory(EBiomeType CurrentBiome, bool bChooseLeftPath, const FBiomeHistorySignature& History)
+{
+        EBiomeType NextBiome = FBiomeTransitionSampler::Sample(CurrentBiome, History);
 
-        UE_LOG(LogTemp, Log, TEXT("Transitioning from %s to %s via %s path"),
-               *UBiomeUtilities::GetBiomeName(CurrentBiome),
-               *UBiomeUtilities::GetBiomeName(NextBiome),
-               bChooseLeftPath ? TEXT("left") : TEXT("right"));
+        FBikeTelemetry::Get().Record(EBikeTelemetryEvent::BiomeTransition, FIntVector::ZeroValue, CurrentBiome, NextBiome,
+                                     0, 0.0f, bChooseLeftPath ? 1 : 0);
 
         return NextBiome;
 }
@@ -211,10 +217,6 @@ TArray<APCGActor*> UBiomeGenerator::GeneratePathSegment(const FVector& Location,
                 }
         }
 
-        UE_LOG(LogTemp, Log, TEXT("Generated path segment for %s biome at %s with %d/%d PCG actors (Quality: %d)"),
-               *UBiomeUtilities::GetBiomeName(BiomeType), *Location.ToString(),
-               SpawnedActors.Num(), NumActors, static_cast<int32>(CurrentQualityLevel));
-
         // Draw debug visualization if enabled
         if (bShowDebugVisualization)
         {
@@ -225,9 +227,47 @@ TArray<APCGActor*> UBiomeGenerator::GeneratePathSegment(const FVector& Location,
         float GenerationTimeMs = (EndTime - StartTime) * 1000.0f;
         RecordPathGeneration(GenerationTimeMs, SpawnedActors.Num());
 
+        FBikeTelemetry::Get().Record(EBikeTelemetryEvent::PathSegmentGenerated,
+                                     FIntVector(FMath::RoundToInt(Location.X), FMath::RoundToInt(Location.Y), FMath::RoundToInt(Location.Z)),
+                                     BiomeType, EBiomeType::None, SpawnedActors.Num(), GenerationTimeMs,
+                                     static_cast<uint8>(CurrentQualityLevel));
+
         return SpawnedActors;
 }
 
+FPathSpline UBiomeGenerator::GeneratePathSpline(const FVector& Location, const FVector& Entry, const FVector& Exit, EBiomeType BiomeType, float StartDistance)
+{
+        // Same lateral spread as GeneratePathSegment, with defaults when the biome has no settings
+        UBiomePCGSettings* Settings = GetBiomePCGSettings(BiomeType);
+        const FBiomeGenerationParams Params = Settings ? Settings->GenerationParams : FBiomeGenerationParams();
+        const float ControlPointSpacing = FMath::Max(Params.PathWidth * 5.0f, 100.0f);
+
+        // Dedicated stream so building a spline never shifts the shared stream PCG placement draws from
+        const FIntVector GridLocation(FMath::RoundToInt(Location.X), FMath::RoundToInt(Location.Y), FMath::RoundToInt(Location.Z));
+        FRandomStream PathStream(HashCombine(GetTypeHash(RandomStream.GetInitialSeed()), GetTypeHash(GridLocation)));
+
+        // Entry, centre and exit stay pinned so neighbouring splines join and intersections sit on the path
+        const FVector Legs[] = { Entry, Location, Exit };
+        TArray<FVector> ControlPoints;
+        ControlPoints.Add(Entry);
+        for (int32 Leg = 0; Leg < 2; Leg++)
+        {
+                const FVector LegVector = Legs[Leg + 1] - Legs[Leg];
+                const FVector Perpendicular = FVector::CrossProduct(LegVector.GetSafeNormal2D(), FVector::UpVector);
+                const int32 NumSpans = FMath::Max(1, FMath::RoundToInt(LegVector.Size2D() / ControlPointSpacing));
+                for (int32 i = 1; i <= NumSpans; i++)
+                {
+                        const float Jitter = i == NumSpans ? 0.0f : PathStream.FRandRange(-Params.PathWidth * 0.5f, Params.PathWidth * 0.5f);
+                        ControlPoints.Add(Legs[Leg] + LegVector * (static_cast<float>(i) / NumSpans) + Perpendicular * Jitter);
+                }
+        }
+
+        FPathSpline PathSpline;
+        PathSpline.Build(ControlPoints);
+        PathSpline.StartDistance = StartDistance;
+        return PathSpline;
+}
+
 AIntersection* UBiomeGenerator::GenerateIntersection(const FVector& Location, EBiomeType CurrentBiome, EBiomeType LeftBiome, EBiomeType RightBiome)
 {
         if (!GetWorld())
@@ -235,7 +275,7 @@ AIntersection* UBiomeGenerator::GenerateIntersection(const FVector& Location, EB
                 return nullptr;
         }
 
-        FBiomeTransitionRules Rules = UBiomeUtilities::GetDefaultTransitionRules(CurrentBiome);
+        const FBiomeTransitionRules& Rules = UBiomeUtilities::GetDefaultTransitionRulesRef(CurrentBiome);
         EIntersectionType Type = EIntersectionType::YFork;
         if (Rules.PreferredIntersectionTypes.Num() > 0)
         {
@@ -243,6 +283,9 @@ AIntersection* UBiomeGenerator::GenerateIntersection(const FVector& Location, EB
                 Type = Rules.PreferredIntersectionTypes[Index];
         }
 
+        // Usually already requested when the section biome was determined; this covers the exact pair
+        GetAssetPrefetcher()->PrefetchForIntersection(CurrentBiome, LeftBiome, RightBiome);
+
         FActorSpawnParameters Params;
         Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
@@ -263,6 +306,26 @@ AIntersection* UBiomeGenerator::GenerateIntersection(const FVector& Location, EB
         return Intersection;
 }
 
+UIntersectionAssetPrefetcher* UBiomeGenerator::GetAssetPrefetcher()
+{
+        if (!AssetPrefetcher)
+        {
+                AssetPrefetcher = NewObject<UIntersectionAssetPrefetcher>(this);
+        }
+
+        return AssetPrefetcher;
+}
+
+UBiomeAssetPrefetcher* UBiomeGenerator::GetBiomeAssetPrefetcher()
+{
+        if (!BiomeAssetPrefetcher)
+        {
+                BiomeAssetPrefetcher = NewObject<UBiomeAssetPrefetcher>(this);
+        }
+
+        return BiomeAssetPrefetcher;
+}
+
 void UBiomeGenerator::SetGenerationSeed(int32 Seed)
 {
         BiomeSeed = Seed;
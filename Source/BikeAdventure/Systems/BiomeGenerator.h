@@ -6,10 +6,14 @@
 #include "PCGSettings.h"
 #include "PCGElement.h"
 #include "../Core/BiomeTypes.h"
+#include "../Core/BiomeTransitionSampler.h"
+#include "PathSpline.h"
 #include "BiomeGenerator.generated.h"
 
 class APCGActor;
 class AIntersection;
+class UIntersectionAssetPrefetcher;
+class UBiomeAssetPrefetcher;
 class UPerformanceOptimizationSystem;
 
 /**
@@ -181,18 +185,45 @@ public:
         UFUNCTION(BlueprintCallable, Category = "Biome Generator")
         EBiomeType GenerateNextBiome(EBiomeType CurrentBiome, bool bChooseLeftPath, const TArray<EBiomeType>& BiomeHistory);
 
+        /**
+         * Allocation-free variant of GenerateNextBiome for callers that already know the history summary
+         */
+        EBiomeType GenerateNextBiomeWithHistory(EBiomeType CurrentBiome, bool bChooseLeftPath, const FBiomeHistorySignature& History);
+
         /**
          * Generate the path segment for the specified biome
          */
         UFUNCTION(BlueprintCallable, Category = "Biome Generator")
         TArray<APCGActor*> GeneratePathSegment(const FVector& Location, EBiomeType BiomeType, const FVector& Direction);
 
+        /**
+         * Build the rideable path spline across a section, from where it enters to where it leaves
+         * Jitter comes from a stream seeded by the generation seed and location, so PCG placement is unaffected
+         * @param Location - Section centre; the spline passes through it so intersections placed there sit on the path
+         * @param Entry - Crossing point shared with the previous section's spline, where this one starts
+         * @param Exit - Crossing point shared with the next section's spline, where this one ends
+         * @param StartDistance - Where the spline begins in the shared distance-along-path coordinate
+         */
+        FPathSpline GeneratePathSpline(const FVector& Location, const FVector& Entry, const FVector& Exit, EBiomeType BiomeType, float StartDistance = 0.0f);
+
         /**
          * Spawn an intersection connecting to left and right biomes
          */
         UFUNCTION(BlueprintCallable, Category = "Biome Generator")
         AIntersection* GenerateIntersection(const FVector& Location, EBiomeType CurrentBiome, EBiomeType LeftBiome, EBiomeType RightBiome);
 
+        /**
+         * Get the prefetcher that preloads intersection visuals ahead of spawning
+         */
+        UFUNCTION(BlueprintCallable, Category = "Biome Generator")
+        UIntersectionAssetPrefetcher* GetAssetPrefetcher();
+
+        /**
+         * Get the prefetcher that keeps the meshes of biomes reachable from the rider's biome resident
+         */
+        UFUNCTION(BlueprintCallable, Category = "Biome Generator")
+        UBiomeAssetPrefetcher* GetBiomeAssetPrefetcher();
+
         /**
          * Set the random seed for deterministic biome generation
          */
@@ -293,6 +324,14 @@ protected:
 	UPROPERTY()
 	TMap<EBiomeType, UBiomePCGSettings*> BiomePCGSettingsMap;
 
+	/** Async preloader for intersection meshes, materials, effects and sounds */
+	UPROPERTY()
+	UIntersectionAssetPrefetcher* AssetPrefetcher = nullptr;
+
+	/** Async preloader for the meshes of biomes ahead on the transition graph */
+	UPROPERTY()
+	UBiomeAssetPrefetcher* BiomeAssetPrefetcher = nullptr;
+
 	/** Current generation quality level */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Generation")
 	EBiomeGenerationQuality CurrentQualityLevel = EBiomeGenerationQuality::High;
@@ -1,7 +1,22 @@
 #include "DiscoverySystem.h"
+#include "DiscoveryTable.h"
+#include "BikeSaveFormat.h"
+#include "WorldStreamingManager.h"
 #include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "Misc/Paths.h"
 #include "../Core/BikeCharacter.h"
 #include "GameFramework/PlayerController.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+	/** Row-major order of proximity cells */
+	bool IsCellBefore(const FIntPoint& A, const FIntPoint& B)
+	{
+		return A.Y != B.Y ? A.Y < B.Y : A.X < B.X;
+	}
+}
 
 UDiscoverySystem::UDiscoverySystem()
 {
@@ -15,8 +30,191 @@ void UDiscoverySystem::BeginPlay()
 
 void UDiscoverySystem::Initialize()
 {
+	if (!Table.IsValid() && !DiscoveryTablePath.IsEmpty())
+	{
+		TSharedRef<FDiscoveryTable> LoadedTable = MakeShared<FDiscoveryTable>();
+		if (LoadedTable->OpenFile(FPaths::ProjectContentDir() / DiscoveryTablePath))
+		{
+			Table = LoadedTable;
+		}
+	}
+
+	// Biome-wide entries stay resident; located ones arrive with their sections
+	if (Table.IsValid() && AvailableDiscoveries.Num() == 0)
+	{
+		TConstArrayView<FDiscoveryTableRecord> BiomeWide = Table->GetBiomeWideRecords();
+		AvailableDiscoveries.Reserve(BiomeWide.Num());
+		for (const FDiscoveryTableRecord& Record : BiomeWide)
+		{
+			FDiscoveryData& Data = AvailableDiscoveries.AddDefaulted_GetRef();
+			Data.Name = Table->GetName(Record);
+			Data.RequiredBiome = static_cast<EBiomeType>(Record.Biome);
+		}
+	}
+
 	LoadDefaultDiscoveries();
-	UE_LOG(LogTemp, Log, TEXT("Discovery System Initialized with %d items"), AvailableDiscoveries.Num());
+	RebuildIndex();
+
+	// Descriptions of table entries load lazily, so remember where each came from
+	if (Table.IsValid())
+	{
+		for (const FDiscoveryTableRecord& Record : Table->GetBiomeWideRecords())
+		{
+			if (const int32* Index = NameIndex.Find(Table->GetName(Record)))
+			{
+				SlotTableRecord[*Index] = Table->GetRecordIndex(Record);
+			}
+		}
+	}
+
+	BindToWorldStreaming();
+
+	UE_LOG(LogTemp, Log, TEXT("Discovery System Initialized with %d items (%d in discovery table)"), AvailableDiscoveries.Num(), Table.IsValid() ? Table->Num() : 0);
+}
+
+void UDiscoverySystem::BindToWorldStreaming()
+{
+	UWorld* World = GetWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	UWorldStreamingManager* StreamingManager = GameInstance ? GameInstance->GetSubsystem<UWorldStreamingManager>() : nullptr;
+	if (StreamingManager)
+	{
+		StreamingManager->OnSectionLoadedEvent.AddUniqueDynamic(this, &UDiscoverySystem::HandleSectionLoaded);
+		StreamingManager->OnSectionUnloadedEvent.AddUniqueDynamic(this, &UDiscoverySystem::HandleSectionUnloaded);
+	}
+}
+
+void UDiscoverySystem::HandleSectionLoaded(const FIntVector& SectionCoordinates, EBiomeType BiomeType)
+{
+	UWorld* World = GetWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	UWorldStreamingManager* StreamingManager = GameInstance ? GameInstance->GetSubsystem<UWorldStreamingManager>() : nullptr;
+	if (const FWorldSection* Section = StreamingManager ? StreamingManager->FindSection(SectionCoordinates) : nullptr)
+	{
+		LoadSectionDiscoveries(SectionCoordinates, BiomeType, Section->WorldBounds);
+	}
+}
+
+void UDiscoverySystem::HandleSectionUnloaded(const FIntVector& SectionCoordinates, EBiomeType BiomeType)
+{
+	UnloadSectionDiscoveries(SectionCoordinates);
+}
+
+int32 UDiscoverySystem::LoadSectionDiscoveries(const FIntVector& SectionCoordinates, EBiomeType BiomeType, const FBox& SectionBounds)
+{
+	if (!Table.IsValid() || SectionGrids.Contains(SectionCoordinates))
+	{
+		return 0;
+	}
+
+	TConstArrayView<FDiscoveryTableRecord> Records = Table->GetSectionRecords(BiomeType, SectionCoordinates);
+	if (Records.Num() == 0)
+	{
+		return 0;
+	}
+
+	// Sections sharing a hash bucket reuse its records, so each section gets its own instance of every name
+	// and its own deterministic placement of every point
+	const uint32 SectionHash = GetTypeHash(SectionCoordinates);
+	const int32 SectionInstance = static_cast<int32>(SectionHash & 0x3FFFFFFF) + 1;
+	FRandomStream Placement(static_cast<int32>(HashCombine(SectionHash, ::GetTypeHash(SystemSeed))));
+	const FVector SectionSize = SectionBounds.GetSize();
+
+	TArray<TPair<FIntPoint, int32>, TInlineAllocator<32>> Points;
+
+	for (const FDiscoveryTableRecord& Record : Records)
+	{
+		const float LocalX = FMath::Clamp(Record.LocalX + Placement.FRandRange(-PlacementJitter, PlacementJitter), 0.0f, 1.0f);
+		const float LocalY = FMath::Clamp(Record.LocalY + Placement.FRandRange(-PlacementJitter, PlacementJitter), 0.0f, 1.0f);
+
+		FDiscoveryData Data;
+		Data.Name = FName(Table->GetName(Record), SectionInstance);
+		Data.RequiredBiome = BiomeType;
+		Data.bIsLocated = true;
+		Data.Location = FVector(
+			SectionBounds.Min.X + LocalX * SectionSize.X,
+			SectionBounds.Min.Y + LocalY * SectionSize.Y,
+			SectionBounds.GetCenter().Z);
+
+		const int32 Index = AddDiscoveryInternal(Data, Table->GetRecordIndex(Record));
+		if (Index != INDEX_NONE)
+		{
+			Points.Emplace(GetProximityCell(Data.Location), Index);
+		}
+	}
+
+	// Sort the points by cell so each cell's points end up contiguous
+	Points.Sort([](const TPair<FIntPoint, int32>& A, const TPair<FIntPoint, int32>& B) { return IsCellBefore(A.Key, B.Key); });
+
+	FDiscoverySectionGrid& Grid = SectionGrids.Add(SectionCoordinates);
+	Grid.PointCells.Reserve(Points.Num());
+	Grid.PointSlots.Reserve(Points.Num());
+	Grid.MinCell = Points.Num() > 0 ? Points[0].Key : FIntPoint::ZeroValue;
+	Grid.MaxCell = Grid.MinCell;
+	for (const TPair<FIntPoint, int32>& Point : Points)
+	{
+		Grid.PointCells.Add(Point.Key);
+		Grid.PointSlots.Add(Point.Value);
+		Grid.MinCell = Grid.MinCell.ComponentMin(Point.Key);
+		Grid.MaxCell = Grid.MaxCell.ComponentMax(Point.Key);
+	}
+
+	// The rider may already be standing next to one of the new points
+	if (bHasRiderCell)
+	{
+		FindNearbyDiscoveries(Grid, RiderCell);
+	}
+
+	return Points.Num();
+}
+
+void UDiscoverySystem::HandleRiderCellChanged(const FIntPoint& Cell)
+{
+	RiderCell = Cell;
+	bHasRiderCell = true;
+	NumProximityQueries++;
+
+	for (const TPair<FIntVector, FDiscoverySectionGrid>& Pair : SectionGrids)
+	{
+		FindNearbyDiscoveries(Pair.Value, Cell);
+	}
+}
+
+void UDiscoverySystem::FindNearbyDiscoveries(const FDiscoverySectionGrid& Grid, const FIntPoint& Cell)
+{
+	// Grids the rider is not next to fall out here
+	if (Grid.PointCells.Num() == 0
+		|| Cell.X + 1 < Grid.MinCell.X || Cell.X - 1 > Grid.MaxCell.X
+		|| Cell.Y + 1 < Grid.MinCell.Y || Cell.Y - 1 > Grid.MaxCell.Y)
+	{
+		return;
+	}
+
+	// The three cells of each row of the 3x3 neighbourhood form one contiguous run
+	for (int32 Y = Cell.Y - 1; Y <= Cell.Y + 1; Y++)
+	{
+		int32 i = Algo::LowerBound(Grid.PointCells, FIntPoint(Cell.X - 1, Y), IsCellBefore);
+		for (; i < Grid.PointCells.Num() && Grid.PointCells[i].Y == Y && Grid.PointCells[i].X <= Cell.X + 1; i++)
+		{
+			const int32 Index = Grid.PointSlots[i];
+			if (!DiscoveredBits[Index])
+			{
+				MarkDiscovered(Index);
+			}
+		}
+	}
+}
+
+void UDiscoverySystem::UnloadSectionDiscoveries(const FIntVector& SectionCoordinates)
+{
+	FDiscoverySectionGrid Grid;
+	if (SectionGrids.RemoveAndCopyValue(SectionCoordinates, Grid))
+	{
+		for (int32 Index : Grid.PointSlots)
+		{
+			RemoveDiscovery(Index);
+		}
+	}
 }
 
 void UDiscoverySystem::LoadDefaultDiscoveries()
@@ -67,78 +265,268 @@ void UDiscoverySystem::LoadDefaultDiscoveries()
 	AvailableDiscoveries.Add(CountrysideFarm);
 }
 
-void UDiscoverySystem::HandleBiomeEntered(EBiomeType BiomeType)
+int32 UDiscoverySystem::GetBiomeBucket(EBiomeType BiomeType)
 {
-	// Randomly trigger a discovery for the entered biome
-	int32 BiomeSeed = SystemSeed + static_cast<int32>(BiomeType);
-	FRandomStream Random(BiomeSeed);
-	if (Random.FRand() < 0.3f) // 30% chance to find something
+	return BiomeType < EBiomeType::None ? static_cast<int32>(BiomeType) : NoBiomeBucket;
+}
+
+void UDiscoverySystem::RebuildIndex()
+{
+	// Entries without a unique name cannot be triggered, drop them up front
+	NameIndex.Reset();
+	NameIndex.Reserve(AvailableDiscoveries.Num());
+	AvailableDiscoveries.RemoveAll([this](const FDiscoveryData& Data)
 	{
-		for (FDiscoveryData& Data : AvailableDiscoveries)
+		if (Data.Name.IsNone() || NameIndex.Contains(Data.Name))
 		{
-			if (!Data.bIsDiscovered && Data.RequiredBiome == BiomeType)
-			{
-				TriggerDiscovery(Data.Name);
-				break;
-			}
+			UE_LOG(LogTemp, Warning, TEXT("Discovery System dropping entry with missing or duplicate name '%s'"), *Data.Name.ToString());
+			return true;
+		}
+		NameIndex.Add(Data.Name, INDEX_NONE);
+		return false;
+	});
+
+	const int32 NumDiscoveries = AvailableDiscoveries.Num();
+	for (TArray<int32>& Bucket : UndiscoveredByBiome)
+	{
+		Bucket.Reset();
+	}
+	BiomeBucketSlot.Init(INDEX_NONE, NumDiscoveries);
+	SlotTableRecord.Init(INDEX_NONE, NumDiscoveries);
+	DiscoveredBits.Init(false, NumDiscoveries);
+	FreeSlots.Reset();
+	SectionGrids.Reset();
+	bHasRiderCell = false;
+	DiscoveredNames.Reset();
+	DiscoveredItems.Reset();
+	NumResident = NumDiscoveries;
+
+	for (int32 Index = NumDiscoveries - 1; Index >= 0; Index--)
+	{
+		const FDiscoveryData& Data = AvailableDiscoveries[Index];
+		NameIndex[Data.Name] = Index;
+
+		if (!Data.bIsLocated)
+		{
+			TArray<int32>& Bucket = UndiscoveredByBiome[GetBiomeBucket(Data.RequiredBiome)];
+			BiomeBucketSlot[Index] = Bucket.Add(Index);
 		}
 	}
 }
 
-bool UDiscoverySystem::TriggerDiscovery(const FString& DiscoveryName)
+bool UDiscoverySystem::AddDiscovery(const FDiscoveryData& Discovery)
+{
+	return AddDiscoveryInternal(Discovery, INDEX_NONE) != INDEX_NONE;
+}
+
+int32 UDiscoverySystem::AddDiscoveryInternal(const FDiscoveryData& Discovery, int32 TableRecord)
+{
+	if (Discovery.Name.IsNone() || NameIndex.Contains(Discovery.Name))
+	{
+		return INDEX_NONE;
+	}
+
+	// Reuse a slot freed by an unloaded section before growing the catalogue
+	int32 Index;
+	if (FreeSlots.Num() > 0)
+	{
+		Index = FreeSlots.Pop(false);
+		AvailableDiscoveries[Index] = Discovery;
+		SlotTableRecord[Index] = TableRecord;
+		BiomeBucketSlot[Index] = INDEX_NONE;
+	}
+	else
+	{
+		Index = AvailableDiscoveries.Add(Discovery);
+		SlotTableRecord.Add(TableRecord);
+		BiomeBucketSlot.Add(INDEX_NONE);
+		DiscoveredBits.Add(false);
+	}
+
+	NameIndex.Add(Discovery.Name, Index);
+	NumResident++;
+
+	// Found before its section was last unloaded
+	const bool bAlreadyFound = DiscoveredNames.Contains(Discovery.Name);
+	DiscoveredBits[Index] = bAlreadyFound;
+
+	if (!bAlreadyFound && !Discovery.bIsLocated)
+	{
+		TArray<int32>& Bucket = UndiscoveredByBiome[GetBiomeBucket(Discovery.RequiredBiome)];
+		BiomeBucketSlot[Index] = Bucket.Add(Index);
+	}
+	return Index;
+}
+
+void UDiscoverySystem::RemoveDiscovery(int32 Index)
+{
+	FDiscoveryData& Data = AvailableDiscoveries[Index];
+	NameIndex.Remove(Data.Name);
+	RemoveFromBiomeBucket(Index);
+
+	Data = FDiscoveryData();
+	DiscoveredBits[Index] = false;
+	SlotTableRecord[Index] = INDEX_NONE;
+	FreeSlots.Add(Index);
+	NumResident--;
+}
+
+void UDiscoverySystem::RemoveFromBiomeBucket(int32 Index)
+{
+	const int32 Slot = BiomeBucketSlot[Index];
+	if (Slot == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Swap the last entry of the bucket into this one's slot
+	TArray<int32>& Bucket = UndiscoveredByBiome[GetBiomeBucket(AvailableDiscoveries[Index].RequiredBiome)];
+	BiomeBucketSlot[Bucket.Last()] = Slot;
+	Bucket.RemoveAtSwap(Slot, 1, false);
+	BiomeBucketSlot[Index] = INDEX_NONE;
+}
+
+int32 UDiscoverySystem::FindDiscoveryIndex(FName DiscoveryName) const
+{
+	const int32* Index = NameIndex.Find(DiscoveryName);
+	return Index ? *Index : INDEX_NONE;
+}
+
+int32 UDiscoverySystem::GetRemainingDiscoveriesInBiome(EBiomeType BiomeType) const
+{
+	return BiomeType < EBiomeType::None ? UndiscoveredByBiome[GetBiomeBucket(BiomeType)].Num() : 0;
+}
+
+void UDiscoverySystem::HandleBiomeEntered(EBiomeType BiomeType)
+{
+	if (GetRemainingDiscoveriesInBiome(BiomeType) == 0)
+	{
+		return;
+	}
+
+	// Randomly trigger a discovery for the entered biome; every entry rolls afresh, reproducibly per seed
+	const uint32 EntrySeed = HashCombine(HashCombine(::GetTypeHash(SystemSeed), ::GetTypeHash(static_cast<int32>(BiomeType))), ::GetTypeHash(NumBiomeEntries++));
+	FRandomStream Random(static_cast<int32>(EntrySeed));
+	if (Random.FRand() < 0.3f) // 30% chance to find something
+	{
+		MarkDiscovered(UndiscoveredByBiome[GetBiomeBucket(BiomeType)].Last());
+	}
+}
+
+bool UDiscoverySystem::TriggerDiscovery(FName DiscoveryName)
 {
-	for (FDiscoveryData& Data : AvailableDiscoveries)
+	const int32 Index = FindDiscoveryIndex(DiscoveryName);
+	if (Index == INDEX_NONE || DiscoveredBits[Index])
+	{
+		return false;
+	}
+
+	MarkDiscovered(Index);
+	return true;
+}
+
+void UDiscoverySystem::MarkDiscovered(int32 Index, bool bNotify)
+{
+	FDiscoveryData& Data = AvailableDiscoveries[Index];
+
+	DiscoveredBits[Index] = true;
+	RemoveFromBiomeBucket(Index);
+
+	// Table descriptions are only decoded once the discovery is actually found
+	if (Table.IsValid() && SlotTableRecord[Index] != INDEX_NONE)
+	{
+		Data.Description = Table->GetDescription(Table->GetRecord(SlotTableRecord[Index]));
+	}
+
+	DiscoveredNames.Add(Data.Name);
+	DiscoveredItems.Add(Data);
+
+	if (!bNotify)
+	{
+		return;
+	}
+
+	// Notify character via public method
+	UWorld* World = GetWorld();
+	if (World)
 	{
-		if (Data.Name == DiscoveryName && !Data.bIsDiscovered)
+		APlayerController* PC = World->GetFirstPlayerController();
+		if (PC)
 		{
-			Data.bIsDiscovered = true;
-			
-			// Notify character via public method
-			UWorld* World = GetWorld();
-			if (World)
+			ABikeCharacter* BikeChar = Cast<ABikeCharacter>(PC->GetPawn());
+			if (BikeChar)
 			{
-				APlayerController* PC = World->GetFirstPlayerController();
-				if (PC)
-				{
-					ABikeCharacter* BikeChar = Cast<ABikeCharacter>(PC->GetPawn());
-					if (BikeChar)
-					{
-						BikeChar->TriggerDiscoveryEvent(Data.Name, Data.Description);
-					}
-				}
+				BikeChar->TriggerDiscoveryEvent(Data.Name.GetPlainNameString(), Data.Description);
 			}
-			
-			UE_LOG(LogTemp, Log, TEXT("New Discovery: %s"), *DiscoveryName);
-			return true;
 		}
 	}
-	return false;
+
+	UE_LOG(LogTemp, Log, TEXT("New Discovery: %s"), *Data.Name.ToString());
 }
 
-int32 UDiscoverySystem::GetTotalDiscoveriesFound() const
+void UDiscoverySystem::CaptureSaveState(FDiscoverySaveState& OutState) const
 {
-	int32 Count = 0;
-	for (const FDiscoveryData& Data : AvailableDiscoveries)
+	TConstArrayView<FDiscoveryTableRecord> TableBiomeWide = Table.IsValid() ? Table->GetBiomeWideRecords() : TConstArrayView<FDiscoveryTableRecord>();
+	const int32 FirstBiomeWideRecord = TableBiomeWide.Num() > 0 ? Table->GetRecordIndex(TableBiomeWide[0]) : 0;
+
+	OutState.TableHash = Table.IsValid() ? Table->GetBiomeWideHash() : 0;
+	OutState.BiomeWideFound.Init(false, TableBiomeWide.Num());
+	OutState.FoundNames.Reset();
+
+	// Biome-wide table entries are keyed by their record, everything else by name
+	for (const FDiscoveryData& Data : DiscoveredItems)
 	{
-		if (Data.bIsDiscovered) Count++;
+		const int32 Index = Data.bIsLocated ? INDEX_NONE : FindDiscoveryIndex(Data.Name);
+		const int32 Bit = Index != INDEX_NONE && SlotTableRecord[Index] != INDEX_NONE ? SlotTableRecord[Index] - FirstBiomeWideRecord : INDEX_NONE;
+		if (OutState.BiomeWideFound.IsValidIndex(Bit))
+		{
+			OutState.BiomeWideFound[Bit] = true;
+		}
+		else
+		{
+			OutState.FoundNames.Add(Data.Name);
+		}
 	}
-	return Count;
 }
 
-int32 UDiscoverySystem::GetTotalDiscoveriesAvailable() const
+void UDiscoverySystem::RestoreSaveState(const FDiscoverySaveState& State)
 {
-	return AvailableDiscoveries.Num();
-}
+	TConstArrayView<FDiscoveryTableRecord> TableBiomeWide = Table.IsValid() ? Table->GetBiomeWideRecords() : TConstArrayView<FDiscoveryTableRecord>();
+	if (Table.IsValid() && State.TableHash == Table->GetBiomeWideHash() && State.BiomeWideFound.Num() == TableBiomeWide.Num())
+	{
+		for (TConstSetBitIterator<> It(State.BiomeWideFound); It; ++It)
+		{
+			const int32 Index = FindDiscoveryIndex(Table->GetName(TableBiomeWide[It.GetIndex()]));
+			if (Index != INDEX_NONE && !DiscoveredBits[Index])
+			{
+				MarkDiscovered(Index, false);
+			}
+		}
+	}
+	else if (State.BiomeWideFound.Contains(true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Save was written against a different discovery table, its biome-wide discoveries are dropped"));
+	}
 
-TArray<FDiscoveryData> UDiscoverySystem::GetDiscoveredItems() const
-{
-	TArray<FDiscoveryData> FoundItems;
-	for (const FDiscoveryData& Data : AvailableDiscoveries)
+	// Located discoveries are mostly in sections that are not resident; their names are enough
+	// to mark them found when the section streams in
+	for (const FName Name : State.FoundNames)
 	{
-		if (Data.bIsDiscovered)
+		if (DiscoveredNames.Contains(Name))
 		{
-			FoundItems.Add(Data);
+			continue;
 		}
+
+		const int32 Index = FindDiscoveryIndex(Name);
+		if (Index != INDEX_NONE)
+		{
+			MarkDiscovered(Index, false);
+			continue;
+		}
+
+		FDiscoveryData& Data = DiscoveredItems.AddDefaulted_GetRef();
+		Data.Name = Name;
+		Data.bIsLocated = true;
+		DiscoveredNames.Add(Name);
 	}
-	return FoundItems;
 }
@@ -3,60 +3,239 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "../Core/BiomeTypes.h"
+#include "Containers/BitArray.h"
 #include "DiscoverySystem.generated.h"
 
+class FDiscoveryTable;
+struct FDiscoverySaveState;
+
+/**
+ * Located discoveries of one section, sorted by world proximity cell row by row, so the points
+ * of a run of cells along a row are contiguous and found by binary search. Storage grows with
+ * the number of points rather than with the section's area; the cell bounds reject sections
+ * the rider is not next to.
+ */
+struct FDiscoverySectionGrid
+{
+	FIntPoint MinCell = FIntPoint::ZeroValue;
+	FIntPoint MaxCell = FIntPoint::ZeroValue;
+	TArray<FIntPoint> PointCells;
+	TArray<int32> PointSlots;
+};
+
 USTRUCT(BlueprintType)
 struct FDiscoveryData
 {
 	GENERATED_BODY()
 
+	/** Unique identifier; its plain string is the display title */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery")
-	FString Name;
+	FName Name;
 
+	/** Filled in when the discovery is found for entries streamed from the discovery table */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery")
 	FString Description;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery")
 	EBiomeType RequiredBiome = EBiomeType::None;
 
+	/** Whether this discovery sits at Location rather than anywhere in its biome */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery")
-	bool bIsDiscovered = false;
+	bool bIsLocated = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery", meta = (EditCondition = "bIsLocated"))
+	FVector Location = FVector::ZeroVector;
 };
 
+/**
+ * Tracks which discoveries the rider has found.
+ * Biome-wide discoveries come from the compiled discovery table (or built-in defaults without
+ * one) and stay resident; located discoveries are streamed in and out with world sections, so
+ * only those near the rider are in the catalogue. The catalogue is indexed as entries arrive:
+ * a name hash for triggers, per-biome buckets of undiscovered biome-wide entries, a discovered
+ * bitset and free slots for reuse, so triggers and queries are constant time and streaming
+ * does not reallocate the catalogue in steady state. Found discoveries are remembered by name
+ * across section unloads.
+ * Located discoveries are found by riding past them. Each resident section buckets its points
+ * into a grid of proximity cells, and the rider position is only tested against that grid when
+ * it crosses into another cell, so riding within a cell costs a single compare.
+ */
 UCLASS(BlueprintType, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class BIKEADVENTURE_API UDiscoverySystem : public UActorComponent
 {
 	GENERATED_BODY()
 
-public:	
+public:
 	UDiscoverySystem();
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery")
 	int32 SystemSeed = 12345;
 
+	/** Compiled discovery table, relative to the project content directory */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery Data")
+	FString DiscoveryTablePath = TEXT("Data/Discoveries.bin");
+
+	/**
+	 * Edge of a proximity cell in cm. A located discovery is found when the rider enters its
+	 * cell or one of the eight around it, so this is roughly the discovery radius.
+	 * Takes effect for sections loaded after it changes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery", meta = (ClampMin = "100.0"))
+	float ProximityCellSize = 2000.0f;
+
+	/** How far, as a fraction of the section edge, each section moves its table points so sections sharing a bucket differ */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+	float PlacementJitter = 0.1f;
+
 	virtual void BeginPlay() override;
 
 	UFUNCTION(BlueprintCallable, Category = "Discovery System")
 	void Initialize();
 
+	/** Use an already opened table instead of loading DiscoveryTablePath; call before Initialize */
+	void SetDiscoveryTable(TSharedPtr<const FDiscoveryTable> InTable) { Table = MoveTemp(InTable); }
+
+	/** Roll for a biome-wide discovery; each entry rolls afresh from the seed, biome and entry count */
 	UFUNCTION(BlueprintCallable, Category = "Discovery System")
 	void HandleBiomeEntered(EBiomeType BiomeType);
 
 	UFUNCTION(BlueprintCallable, Category = "Discovery System")
-	bool TriggerDiscovery(const FString& DiscoveryName);
+	bool TriggerDiscovery(FName DiscoveryName);
+
+	/** Add an entry to the catalogue and its indices; fails on a duplicate or empty name */
+	UFUNCTION(BlueprintCallable, Category = "Discovery System")
+	bool AddDiscovery(const FDiscoveryData& Discovery);
 
+	/** Feed the rider position; only does work when the rider crosses into another proximity cell */
+	UFUNCTION(BlueprintCallable, Category = "Discovery System")
+	void UpdateRiderLocation(const FVector& RiderLocation)
+	{
+		const FIntPoint Cell = GetProximityCell(RiderLocation);
+		if (!bHasRiderCell || Cell != RiderCell)
+		{
+			HandleRiderCellChanged(Cell);
+		}
+	}
+
+	/**
+	 * Make a section's located discoveries resident
+	 * @param SectionBounds - World bounds of the section; table positions are fractions of its extent
+	 * @return Number of discoveries added
+	 */
+	int32 LoadSectionDiscoveries(const FIntVector& SectionCoordinates, EBiomeType BiomeType, const FBox& SectionBounds);
+
+	/** Drop a section's located discoveries; found state is kept */
+	void UnloadSectionDiscoveries(const FIntVector& SectionCoordinates);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Discovery System")
+	bool IsDiscovered(FName DiscoveryName) const { return DiscoveredNames.Contains(DiscoveryName); }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Discovery System")
+	int32 GetTotalDiscoveriesFound() const { return DiscoveredItems.Num(); }
+
+	/** Discoveries currently resident in the catalogue */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Discovery System")
-	int32 GetTotalDiscoveriesFound() const;
+	int32 GetTotalDiscoveriesAvailable() const { return NumResident; }
 
+	/** Undiscovered biome-wide entries left in a biome */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Discovery System")
-	int32 GetTotalDiscoveriesAvailable() const;
+	int32 GetRemainingDiscoveriesInBiome(EBiomeType BiomeType) const;
 
+	/** Discovered entries in the order they were found */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Discovery System")
-	TArray<FDiscoveryData> GetDiscoveredItems() const;
+	const TArray<FDiscoveryData>& GetDiscoveredItems() const { return DiscoveredItems; }
+
+	/** Catalogue index of a resident entry, or INDEX_NONE */
+	int32 FindDiscoveryIndex(FName DiscoveryName) const;
+
+	const FDiscoveryData& GetDiscovery(int32 Index) const { return AvailableDiscoveries[Index]; }
+
+	/** Found state for the save file; biome-wide table entries as a bitset over their table records, the rest by name */
+	void CaptureSaveState(FDiscoverySaveState& OutState) const;
+
+	/** Mark saved discoveries found without notifying the rider; call after Initialize */
+	void RestoreSaveState(const FDiscoverySaveState& State);
+
+	/** Number of sections whose located discoveries are resident */
+	int32 GetNumResidentSections() const { return SectionGrids.Num(); }
+
+	/** Number of times the rider position has been tested against the proximity grids */
+	int32 GetNumProximityQueries() const { return NumProximityQueries; }
+
+	FIntPoint GetProximityCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X / ProximityCellSize), FMath::FloorToInt32(Location.Y / ProximityCellSize));
+	}
 
 protected:
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Discovery Data")
+	/** Resident catalogue; read-only outside the system since every entry is mirrored in the indices below */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Discovery Data")
 	TArray<FDiscoveryData> AvailableDiscoveries;
 
 	void LoadDefaultDiscoveries();
+
+	/** Rebuild every index from AvailableDiscoveries, dropping discovered state */
+	void RebuildIndex();
+
+	/** Mark an entry found and optionally notify the rider; the entry must be undiscovered */
+	void MarkDiscovered(int32 Index, bool bNotify = true);
+
+	/** Free a catalogue slot for reuse */
+	void RemoveDiscovery(int32 Index);
+
+	UFUNCTION()
+	void HandleSectionLoaded(const FIntVector& SectionCoordinates, EBiomeType BiomeType);
+
+	UFUNCTION()
+	void HandleSectionUnloaded(const FIntVector& SectionCoordinates, EBiomeType BiomeType);
+
+private:
+	/** Bucket slot for biome-less entries, which no biome event picks */
+	static constexpr int32 NoBiomeBucket = BiomeTables::NumBiomes;
+
+	static int32 GetBiomeBucket(EBiomeType BiomeType);
+
+	/** Add an entry, recording the table record its description is loaded from */
+	int32 AddDiscoveryInternal(const FDiscoveryData& Discovery, int32 TableRecord);
+
+	void RemoveFromBiomeBucket(int32 Index);
+
+	/** Bind to world streaming so located discoveries follow loaded sections */
+	void BindToWorldStreaming();
+
+	void HandleRiderCellChanged(const FIntPoint& Cell);
+
+	/** Mark every undiscovered point of a grid within one cell of the given cell */
+	void FindNearbyDiscoveries(const FDiscoverySectionGrid& Grid, const FIntPoint& Cell);
+
+	TSharedPtr<const FDiscoveryTable> Table;
+
+	TMap<FName, int32> NameIndex;
+
+	/** Undiscovered biome-wide catalogue indices per biome, unordered: removal swaps the last entry into the gap and additions append */
+	TArray<int32> UndiscoveredByBiome[BiomeTables::NumBiomes + 1];
+
+	/** Position of each entry inside its biome bucket, or INDEX_NONE */
+	TArray<int32> BiomeBucketSlot;
+
+	/** Table record each entry came from, or INDEX_NONE; descriptions are decoded from it and saves key found entries by it */
+	TArray<int32> SlotTableRecord;
+
+	TBitArray<> DiscoveredBits;
+	TArray<int32> FreeSlots;
+	int32 NumResident = 0;
+
+	/** Proximity grid of each resident section, holding the catalogue slots of its located discoveries */
+	TMap<FIntVector, FDiscoverySectionGrid> SectionGrids;
+
+	FIntPoint RiderCell = FIntPoint::ZeroValue;
+	bool bHasRiderCell = false;
+	int32 NumProximityQueries = 0;
+
+	/** Biome entries rolled so far, mixed into each roll's seed */
+	int32 NumBiomeEntries = 0;
+
+	/** Every discovery found this session, resident or not */
+	TSet<FName> DiscoveredNames;
+	TArray<FDiscoveryData> DiscoveredItems;
 };
@@ -0,0 +1,254 @@
+#include "DiscoveryTable.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+
+FDiscoveryTable::FDiscoveryTable()
+    : Header(nullptr)
+    , PartitionStarts(nullptr)
+    , Records(nullptr)
+    , Strings(nullptr)
+    , BiomeWideHash(0)
+{
+}
+
+FDiscoveryTable::~FDiscoveryTable()
+{
+    Close();
+}
+
+bool FDiscoveryTable::OpenFile(const FString& Path)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    MappedHandle.Reset(PlatformFile.OpenMapped(*Path));
+    if (MappedHandle.IsValid())
+    {
+        MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+        if (MappedRegion.IsValid() && Bind(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+        {
+            return true;
+        }
+        Close();
+    }
+
+    // Packaged files inside a pak cannot be mapped, read them instead
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+    {
+        return false;
+    }
+    return OpenFromBytes(MoveTemp(Bytes));
+}
+
+bool FDiscoveryTable::OpenFromBytes(TArray<uint8>&& Bytes)
+{
+    Close();
+
+    OwnedBytes = MoveTemp(Bytes);
+    if (!Bind(OwnedBytes.GetData(), OwnedBytes.Num()))
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void FDiscoveryTable::Close()
+{
+    Header = nullptr;
+    PartitionStarts = nullptr;
+    Records = nullptr;
+    Strings = nullptr;
+    BiomeWideHash = 0;
+
+    // Region must go before the handle it was mapped from
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+    OwnedBytes.Empty();
+}
+
+bool FDiscoveryTable::Bind(const uint8* Data, int64 Size)
+{
+    if (!Data || Size < static_cast<int64>(sizeof(FDiscoveryTableHeader)))
+    {
+        return false;
+    }
+
+    const FDiscoveryTableHeader* InHeader = reinterpret_cast<const FDiscoveryTableHeader*>(Data);
+    if (InHeader->Magic != FDiscoveryTableHeader::FileMagic
+        || InHeader->Version != FDiscoveryTableHeader::FileVersion
+        || InHeader->RecordSize != sizeof(FDiscoveryTableRecord)
+        || InHeader->BucketsPerBiome == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Discovery table has an unsupported header (version %d, record size %d)"), InHeader->Version, InHeader->RecordSize);
+        return false;
+    }
+
+    const int64 NumPartitionStarts = static_cast<int64>(BiomeTables::NumBiomes) * InHeader->BucketsPerBiome + 2;
+    const int64 PartitionBytes = NumPartitionStarts * sizeof(uint32);
+    const int64 RecordBytes = static_cast<int64>(InHeader->NumRecords) * sizeof(FDiscoveryTableRecord);
+    if (Size != static_cast<int64>(sizeof(FDiscoveryTableHeader)) + PartitionBytes + RecordBytes + InHeader->StringBytes)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Discovery table size does not match its header"));
+        return false;
+    }
+
+    const uint32* InPartitionStarts = reinterpret_cast<const uint32*>(Data + sizeof(FDiscoveryTableHeader));
+    if (InPartitionStarts[0] != 0 || InPartitionStarts[NumPartitionStarts - 1] != InHeader->NumRecords)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Discovery table partition table is corrupt"));
+        return false;
+    }
+    for (int64 i = 1; i < NumPartitionStarts; i++)
+    {
+        if (InPartitionStarts[i] < InPartitionStarts[i - 1])
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Discovery table partition table is corrupt"));
+            return false;
+        }
+    }
+
+    Header = InHeader;
+    PartitionStarts = InPartitionStarts;
+    Records = reinterpret_cast<const FDiscoveryTableRecord*>(Data + sizeof(FDiscoveryTableHeader) + PartitionBytes);
+    Strings = reinterpret_cast<const ANSICHAR*>(Data + sizeof(FDiscoveryTableHeader) + PartitionBytes + RecordBytes);
+
+    // Biome-wide records are read at startup anyway, so hashing them touches no extra pages
+    BiomeWideHash = 0;
+    for (const FDiscoveryTableRecord& Record : GetBiomeWideRecords())
+    {
+        BiomeWideHash = FCrc::MemCrc32(&Record.Biome, sizeof(Record.Biome), BiomeWideHash);
+        if (IsStringInBounds(Record.NameOffset, Record.NameLength))
+        {
+            BiomeWideHash = FCrc::MemCrc32(Strings + Record.NameOffset, Record.NameLength, BiomeWideHash);
+        }
+    }
+    return true;
+}
+
+int32 FDiscoveryTable::GetSectionBucket(const FIntVector& SectionCoordinates) const
+{
+    const uint32 Hash = HashCombine(::GetTypeHash(SectionCoordinates.X), ::GetTypeHash(SectionCoordinates.Y));
+    return Header ? static_cast<int32>(Hash % Header->BucketsPerBiome) : 0;
+}
+
+TConstArrayView<FDiscoveryTableRecord> FDiscoveryTable::GetPartition(int32 Partition) const
+{
+    if (!Header || Partition < 0 || Partition >= GetNumPartitions())
+    {
+        return TConstArrayView<FDiscoveryTableRecord>();
+    }
+
+    const uint32 Start = PartitionStarts[Partition];
+    return TConstArrayView<FDiscoveryTableRecord>(Records + Start, PartitionStarts[Partition + 1] - Start);
+}
+
+TConstArrayView<FDiscoveryTableRecord> FDiscoveryTable::GetSectionRecords(EBiomeType Biome, const FIntVector& SectionCoordinates) const
+{
+    if (!Header || Biome >= EBiomeType::None)
+    {
+        return TConstArrayView<FDiscoveryTableRecord>();
+    }
+    return GetPartition(static_cast<int32>(Biome) * GetBucketsPerBiome() + GetSectionBucket(SectionCoordinates));
+}
+
+TConstArrayView<FDiscoveryTableRecord> FDiscoveryTable::GetBiomeWideRecords() const
+{
+    return GetPartition(GetNumPartitions() - 1);
+}
+
+FName FDiscoveryTable::GetName(const FDiscoveryTableRecord& Record) const
+{
+    if (!Header || Record.NameLength == 0 || !IsStringInBounds(Record.NameOffset, Record.NameLength))
+    {
+        return NAME_None;
+    }
+
+    FUTF8ToTCHAR Converted(Strings + Record.NameOffset, Record.NameLength);
+    return FName(Converted.Length(), Converted.Get());
+}
+
+FString FDiscoveryTable::GetDescription(const FDiscoveryTableRecord& Record) const
+{
+    if (!Header || !IsStringInBounds(Record.DescriptionOffset, Record.DescriptionLength))
+    {
+        return FString();
+    }
+
+    FUTF8ToTCHAR Converted(Strings + Record.DescriptionOffset, Record.DescriptionLength);
+    return FString(Converted.Length(), Converted.Get());
+}
+
+void FDiscoveryTable::Build(TConstArrayView<FDiscoveryTableSourceRow> Rows, int32 BucketsPerBiome, TArray<uint8>& OutBytes)
+{
+    BucketsPerBiome = FMath::Max(BucketsPerBiome, 1);
+    const int32 NumPartitions = BiomeTables::NumBiomes * BucketsPerBiome + 1;
+
+    // Assign every row a partition, then lay records out partition by partition
+    TArray<int32> RowPartitions;
+    RowPartitions.Reserve(Rows.Num());
+    TArray<uint32> PartitionStarts;
+    PartitionStarts.Init(0, NumPartitions + 1);
+
+    for (const FDiscoveryTableSourceRow& Row : Rows)
+    {
+        int32 Partition = NumPartitions - 1;
+        if (Row.bLocated && Row.Biome < EBiomeType::None)
+        {
+            // Standard CRC-32 of the UTF-8 name, the same bucket the compile script derives
+            FTCHARToUTF8 NameUtf8(*Row.Name);
+            const int32 Bucket = Row.Bucket >= 0 ? Row.Bucket % BucketsPerBiome : static_cast<int32>(FCrc::MemCrc32(NameUtf8.Get(), NameUtf8.Length()) % BucketsPerBiome);
+            Partition = static_cast<int32>(Row.Biome) * BucketsPerBiome + Bucket;
+        }
+        RowPartitions.Add(Partition);
+        PartitionStarts[Partition + 1]++;
+    }
+    for (int32 i = 1; i <= NumPartitions; i++)
+    {
+        PartitionStarts[i] += PartitionStarts[i - 1];
+    }
+
+    TArray<FDiscoveryTableRecord> Records;
+    Records.SetNumZeroed(Rows.Num());
+    TArray<ANSICHAR> StringBlob;
+    TArray<uint32> Cursor(PartitionStarts.GetData(), NumPartitions);
+
+    auto AppendString = [&StringBlob](const FString& Value, uint32& OutOffset, uint16& OutLength)
+    {
+        FTCHARToUTF8 Converted(*Value);
+        OutOffset = StringBlob.Num();
+        OutLength = static_cast<uint16>(FMath::Min(Converted.Length(), static_cast<int32>(MAX_uint16)));
+        StringBlob.Append(Converted.Get(), OutLength);
+    };
+
+    for (int32 RowIndex = 0; RowIndex < Rows.Num(); RowIndex++)
+    {
+        const FDiscoveryTableSourceRow& Row = Rows[RowIndex];
+        FDiscoveryTableRecord& Record = Records[Cursor[RowPartitions[RowIndex]]++];
+
+        AppendString(Row.Name, Record.NameOffset, Record.NameLength);
+        AppendString(Row.Description, Record.DescriptionOffset, Record.DescriptionLength);
+        Record.LocalX = FMath::Clamp(Row.LocalPosition.X, 0.0f, 1.0f);
+        Record.LocalY = FMath::Clamp(Row.LocalPosition.Y, 0.0f, 1.0f);
+        Record.Biome = static_cast<uint8>(Row.Biome);
+        Record.Flags = Row.bLocated ? FDiscoveryTableRecord::FlagLocated : 0;
+    }
+
+    FDiscoveryTableHeader Header;
+    FMemory::Memzero(Header);
+    Header.Magic = FDiscoveryTableHeader::FileMagic;
+    Header.Version = FDiscoveryTableHeader::FileVersion;
+    Header.RecordSize = sizeof(FDiscoveryTableRecord);
+    Header.BucketsPerBiome = BucketsPerBiome;
+    Header.NumRecords = Records.Num();
+    Header.StringBytes = StringBlob.Num();
+
+    OutBytes.Reset();
+    OutBytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+    OutBytes.Append(reinterpret_cast<const uint8*>(PartitionStarts.GetData()), PartitionStarts.Num() * sizeof(uint32));
+    OutBytes.Append(reinterpret_cast<const uint8*>(Records.GetData()), Records.Num() * sizeof(FDiscoveryTableRecord));
+    OutBytes.Append(reinterpret_cast<const uint8*>(StringBlob.GetData()), StringBlob.Num());
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Core/BiomeTypes.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Header written once at the start of a compiled discovery table.
+ * Layout is part of the file format, see scripts/automation/compile-discoveries.py for the matching writer.
+ * The file continues with the partition table, the records and the UTF-8 string blob:
+ * uint32 PartitionStarts[NumBiomes * BucketsPerBiome + 2] | FDiscoveryTableRecord[NumRecords] | char Strings[StringBytes]
+ */
+struct FDiscoveryTableHeader
+{
+    static constexpr uint32 FileMagic = 0x54444B42; // "BKDT"
+    static constexpr uint16 FileVersion = 1;
+
+    uint32 Magic;
+    uint16 Version;
+    uint16 RecordSize;
+    uint32 BucketsPerBiome;
+    uint32 NumRecords;
+    uint32 StringBytes;
+    uint32 Reserved;
+};
+
+static_assert(sizeof(FDiscoveryTableHeader) == 24, "FDiscoveryTableHeader layout is part of the discovery table format");
+
+/**
+ * Fixed-size discovery record. Name and description are spans of the string blob so a record
+ * can be read straight out of the mapped file, and descriptions are only decoded when needed.
+ */
+struct FDiscoveryTableRecord
+{
+    /** Set for discoveries bound to a spot in a section; unset ones are biome-wide */
+    static constexpr uint8 FlagLocated = 1 << 0;
+
+    uint32 NameOffset;
+    uint32 DescriptionOffset;
+    uint16 NameLength;
+    uint16 DescriptionLength;
+
+    // Position inside the section as a fraction of its edge, so tables do not depend on section size
+    float LocalX;
+    float LocalY;
+
+    uint8 Biome;
+    uint8 Flags;
+    uint16 Reserved;
+};
+
+static_assert(sizeof(FDiscoveryTableRecord) == 24, "FDiscoveryTableRecord layout is part of the discovery table format");
+
+/**
+ * Authoring-side row used to build a table in memory
+ */
+struct FDiscoveryTableSourceRow
+{
+    FString Name;
+    FString Description;
+    EBiomeType Biome = EBiomeType::None;
+    bool bLocated = false;
+    FVector2f LocalPosition = FVector2f::ZeroVector;
+
+    /** Section hash bucket within the biome, or INDEX_NONE to derive one from the name */
+    int32 Bucket = INDEX_NONE;
+};
+
+/**
+ * Read-only view of a compiled discovery table.
+ * Located records are partitioned by biome and by a hash of the section coordinates, so the
+ * discoveries for a streamed-in section are one contiguous slice; biome-wide records sit in a
+ * final partition of their own. The file is memory mapped when the platform allows it, so only
+ * the pages of sections that are actually visited are ever read.
+ */
+class BIKEADVENTURE_API FDiscoveryTable
+{
+public:
+    FDiscoveryTable();
+    ~FDiscoveryTable();
+
+    FDiscoveryTable(const FDiscoveryTable&) = delete;
+    FDiscoveryTable& operator=(const FDiscoveryTable&) = delete;
+
+    /** Map a compiled table from disk, falling back to reading it whole */
+    bool OpenFile(const FString& Path);
+
+    /** Adopt a compiled table already in memory */
+    bool OpenFromBytes(TArray<uint8>&& Bytes);
+
+    void Close();
+
+    bool IsOpen() const { return Header != nullptr; }
+
+    int32 Num() const { return Header ? static_cast<int32>(Header->NumRecords) : 0; }
+    int32 GetBucketsPerBiome() const { return Header ? static_cast<int32>(Header->BucketsPerBiome) : 0; }
+
+    /** Section hash bucket a section draws its located discoveries from */
+    int32 GetSectionBucket(const FIntVector& SectionCoordinates) const;
+
+    /** Located discoveries for a section of the given biome */
+    TConstArrayView<FDiscoveryTableRecord> GetSectionRecords(EBiomeType Biome, const FIntVector& SectionCoordinates) const;
+
+    /** Biome-wide discoveries, resident for the whole session */
+    TConstArrayView<FDiscoveryTableRecord> GetBiomeWideRecords() const;
+
+    /** Checksum of the biome-wide records' names and biomes, so state keyed by their position can tell the table changed */
+    uint32 GetBiomeWideHash() const { return BiomeWideHash; }
+
+    const FDiscoveryTableRecord& GetRecord(int32 Index) const { return Records[Index]; }
+    int32 GetRecordIndex(const FDiscoveryTableRecord& Record) const { return static_cast<int32>(&Record - Records); }
+
+    /** Decode a record's name; returns NAME_None if the record points outside the string blob */
+    FName GetName(const FDiscoveryTableRecord& Record) const;
+
+    /** Decode a record's description */
+    FString GetDescription(const FDiscoveryTableRecord& Record) const;
+
+    /**
+     * Compile rows into the binary format
+     * @param BucketsPerBiome - Section hash buckets per biome; more buckets spread discoveries over more distinct sections
+     */
+    static void Build(TConstArrayView<FDiscoveryTableSourceRow> Rows, int32 BucketsPerBiome, TArray<uint8>& OutBytes);
+
+private:
+    /** Validate the layout and point the views into it */
+    bool Bind(const uint8* Data, int64 Size);
+
+    TConstArrayView<FDiscoveryTableRecord> GetPartition(int32 Partition) const;
+
+    int32 GetNumPartitions() const { return BiomeTables::NumBiomes * GetBucketsPerBiome() + 1; }
+
+    bool IsStringInBounds(uint32 Offset, uint16 Length) const { return static_cast<uint64>(Offset) + Length <= Header->StringBytes; }
+
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray<uint8> OwnedBytes;
+
+    const FDiscoveryTableHeader* Header;
+    const uint32* PartitionStarts;
+    const FDiscoveryTableRecord* Records;
+    const ANSICHAR* Strings;
+    uint32 BiomeWideHash;
+};
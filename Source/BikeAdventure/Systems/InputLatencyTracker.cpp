@@ -0,0 +1,109 @@
+#include "InputLatencyTracker.h"
+
+bool FInputLatencyTracker::MarkInput(float Value, double Seconds, uint64 Frame)
+{
+    if (FMath::Abs(Value - LastValue) < ChangeThreshold)
+    {
+        return false;
+    }
+
+    LastValue = Value;
+
+    // Fold into the open measurement so it keeps the earliest input time
+    if (bInputPending)
+    {
+        return false;
+    }
+
+    Pending = FInputLatencySample();
+    Pending.InputSeconds = Seconds;
+    Pending.InputFrame = Frame;
+    bInputPending = true;
+    bUpdatePending = false;
+    return true;
+}
+
+bool FInputLatencyTracker::MarkMovementUpdate(double Seconds)
+{
+    if (!bInputPending || bUpdatePending)
+    {
+        return false;
+    }
+
+    Pending.UpdateSeconds = Seconds;
+    bUpdatePending = true;
+    return true;
+}
+
+bool FInputLatencyTracker::MarkPresented(double Seconds, uint64 Frame)
+{
+    if (!bUpdatePending)
+    {
+        return false;
+    }
+
+    Pending.PresentSeconds = Seconds;
+    Pending.PresentFrame = Frame;
+
+    Samples[NextSample] = Pending;
+    NextSample = (NextSample + 1) % MaxSamples;
+    NumSamples = FMath::Min(NumSamples + 1, MaxSamples);
+
+    bInputPending = false;
+    bUpdatePending = false;
+    return true;
+}
+
+void FInputLatencyTracker::Reset()
+{
+    NextSample = 0;
+    NumSamples = 0;
+    bInputPending = false;
+    bUpdatePending = false;
+    LastValue = 0.0f;
+}
+
+const FInputLatencySample* FInputLatencyTracker::GetLastSample() const
+{
+    return NumSamples > 0 ? &Samples[(NextSample + MaxSamples - 1) % MaxSamples] : nullptr;
+}
+
+double FInputLatencyTracker::GetAverageInputToUpdateMs() const
+{
+    double Total = 0.0;
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        Total += Samples[i].GetInputToUpdateMs();
+    }
+    return NumSamples > 0 ? Total / NumSamples : 0.0;
+}
+
+double FInputLatencyTracker::GetAverageInputToPresentMs() const
+{
+    double Total = 0.0;
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        Total += Samples[i].GetInputToPresentMs();
+    }
+    return NumSamples > 0 ? Total / NumSamples : 0.0;
+}
+
+double FInputLatencyTracker::GetMaxInputToPresentMs() const
+{
+    double Max = 0.0;
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        Max = FMath::Max(Max, Samples[i].GetInputToPresentMs());
+    }
+    return Max;
+}
+
+double FInputLatencyTracker::GetAverageFrameDelay() const
+{
+    double Total = 0.0;
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        Total += Samples[i].GetFrameDelay();
+    }
+    return NumSamples > 0 ? Total / NumSamples : 0.0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One input change followed from the input event to the movement step that consumed it
+ * and on to the end of the frame that handed the resulting transform to rendering
+ */
+struct FInputLatencySample
+{
+    double InputSeconds = 0.0;
+    double UpdateSeconds = 0.0;
+    double PresentSeconds = 0.0;
+    uint64 InputFrame = 0;
+    uint64 PresentFrame = 0;
+
+    double GetInputToUpdateMs() const { return (UpdateSeconds - InputSeconds) * 1000.0; }
+    double GetInputToPresentMs() const { return (PresentSeconds - InputSeconds) * 1000.0; }
+
+    /** Whole frames between the input event and the frame that presented its effect; zero means same frame */
+    int32 GetFrameDelay() const { return static_cast<int32>(PresentFrame - InputFrame); }
+};
+
+/**
+ * Timestamps an input axis through the three points that make up steering latency:
+ * the input event, the movement update and the presented transform.
+ * Axis bindings report every frame, so only changes larger than ChangeThreshold open a
+ * measurement; further changes while one is open fold into it, which keeps the earliest
+ * timestamp and so measures the worst case. Completed samples go into a fixed ring.
+ * Timestamps and frame numbers are supplied by the caller so the tracker stays clock-agnostic.
+ */
+class BIKEADVENTURE_API FInputLatencyTracker
+{
+public:
+    /** Completed samples kept for statistics */
+    static constexpr int32 MaxSamples = 128;
+
+    /** Smallest change in the input value that starts a new measurement */
+    static constexpr float ChangeThreshold = 0.05f;
+
+    /** Report the current input value; returns true if this opened a new measurement */
+    bool MarkInput(float Value, double Seconds, uint64 Frame);
+
+    /**
+     * A movement step has consumed the input; only the first step after the input counts
+     * @return True if this was that first step
+     */
+    bool MarkMovementUpdate(double Seconds);
+
+    /**
+     * The frame's transforms are about to be sent to rendering
+     * @return True if this completed a sample, which is then available from GetLastSample
+     */
+    bool MarkPresented(double Seconds, uint64 Frame);
+
+    /** Drop every sample and any open measurement */
+    void Reset();
+
+    int32 Num() const { return NumSamples; }
+
+    /** Most recently completed sample, or null before the first one */
+    const FInputLatencySample* GetLastSample() const;
+
+    double GetAverageInputToUpdateMs() const;
+    double GetAverageInputToPresentMs() const;
+    double GetMaxInputToPresentMs() const;
+    double GetAverageFrameDelay() const;
+
+private:
+    FInputLatencySample Samples[MaxSamples];
+    int32 NextSample = 0;
+    int32 NumSamples = 0;
+
+    FInputLatencySample Pending;
+    bool bInputPending = false;
+    bool bUpdatePending = false;
+
+    /** Value the last measurement was opened against */
+    float LastValue = 0.0f;
+};
@@ -0,0 +1,182 @@
+#include "IntersectionAssetPrefetcher.h"
+#include "../Gameplay/Intersection.h"
+#include "Engine/AssetManager.h"
+
+UIntersectionAssetPrefetcher::UIntersectionAssetPrefetcher()
+{
+    MaxRetainedAssets = 256;
+    IntersectionClass = AIntersection::StaticClass();
+}
+
+FStreamableManager& UIntersectionAssetPrefetcher::GetStreamableManager()
+{
+    if (UAssetManager::IsInitialized())
+    {
+        return UAssetManager::GetStreamableManager();
+    }
+
+    // Commandlets and automation worlds may run without an asset manager
+    static FStreamableManager FallbackManager;
+    return FallbackManager;
+}
+
+void UIntersectionAssetPrefetcher::SetIntersectionClass(TSubclassOf<AIntersection> InIntersectionClass)
+{
+    IntersectionClass = InIntersectionClass ? InIntersectionClass : TSubclassOf<AIntersection>(AIntersection::StaticClass());
+}
+
+const AIntersection* UIntersectionAssetPrefetcher::GetIntersectionDefaults() const
+{
+    return IntersectionClass ? IntersectionClass->GetDefaultObject<AIntersection>() : GetDefault<AIntersection>();
+}
+
+void UIntersectionAssetPrefetcher::PrefetchForBiome(EBiomeType UpcomingBiome)
+{
+    if (!BiomeTables::IsValidBiome(UpcomingBiome))
+    {
+        return;
+    }
+
+    const AIntersection* Defaults = GetIntersectionDefaults();
+    if (!Defaults)
+    {
+        return;
+    }
+
+    const int32 BiomeIndex = static_cast<int32>(UpcomingBiome);
+
+    // Intersections in this biome lead to one of its transition targets
+    EBiomeType Biomes[BiomeTables::MaxTransitionsPerBiome + 1];
+    int32 NumBiomes = 0;
+    Biomes[NumBiomes++] = UpcomingBiome;
+    for (int32 i = 0; i < BiomeTables::TransitionCounts[BiomeIndex]; i++)
+    {
+        Biomes[NumBiomes++] = BiomeTables::Transitions[BiomeIndex][i];
+    }
+
+    ScratchPaths.Reset();
+    Defaults->GatherAssetPaths(
+        MakeArrayView(BiomeTables::PreferredIntersections[BiomeIndex], BiomeTables::PreferredIntersectionCounts[BiomeIndex]),
+        MakeArrayView(Biomes, NumBiomes),
+        true,
+        ScratchPaths);
+
+    RequestAssets(ScratchPaths);
+}
+
+void UIntersectionAssetPrefetcher::PrefetchForIntersection(EBiomeType CurrentBiome, EBiomeType LeftBiome, EBiomeType RightBiome)
+{
+    const AIntersection* Defaults = GetIntersectionDefaults();
+    if (!Defaults || !BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        return;
+    }
+
+    const int32 BiomeIndex = static_cast<int32>(CurrentBiome);
+    const EBiomeType Biomes[] = { LeftBiome, RightBiome };
+
+    ScratchPaths.Reset();
+    Defaults->GatherAssetPaths(
+        MakeArrayView(BiomeTables::PreferredIntersections[BiomeIndex], BiomeTables::PreferredIntersectionCounts[BiomeIndex]),
+        MakeArrayView(Biomes),
+        true,
+        ScratchPaths);
+
+    RequestAssets(ScratchPaths);
+}
+
+bool UIntersectionAssetPrefetcher::AreIntersectionAssetsReady(EBiomeType CurrentBiome, EBiomeType LeftBiome, EBiomeType RightBiome) const
+{
+    const AIntersection* Defaults = GetIntersectionDefaults();
+    if (!Defaults || !BiomeTables::IsValidBiome(CurrentBiome))
+    {
+        return true;
+    }
+
+    const int32 BiomeIndex = static_cast<int32>(CurrentBiome);
+    const EBiomeType Biomes[] = { LeftBiome, RightBiome };
+
+    TArray<FSoftObjectPath> Paths;
+    Defaults->GatherAssetPaths(
+        MakeArrayView(BiomeTables::PreferredIntersections[BiomeIndex], BiomeTables::PreferredIntersectionCounts[BiomeIndex]),
+        MakeArrayView(Biomes),
+        true,
+        Paths);
+
+    for (const FSoftObjectPath& Path : Paths)
+    {
+        if (!Path.ResolveObject())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int32 UIntersectionAssetPrefetcher::GetInFlightRequestCount() const
+{
+    // Several paths share one handle, so count distinct handles
+    TSet<const FStreamableHandle*> ActiveHandles;
+    for (const auto& HandlePair : RetainedHandles)
+    {
+        if (HandlePair.Value.IsValid() && HandlePair.Value->IsLoadingInProgress())
+        {
+            ActiveHandles.Add(HandlePair.Value.Get());
+        }
+    }
+
+    return ActiveHandles.Num();
+}
+
+void UIntersectionAssetPrefetcher::ReleaseAll()
+{
+    for (auto& HandlePair : RetainedHandles)
+    {
+        if (HandlePair.Value.IsValid())
+        {
+            HandlePair.Value->ReleaseHandle();
+        }
+    }
+
+    RetainedHandles.Empty();
+    RetainOrder.Empty();
+}
+
+void UIntersectionAssetPrefetcher::RequestAssets(const TArray<FSoftObjectPath>& AssetPaths)
+{
+    TArray<FSoftObjectPath> NewPaths;
+    for (const FSoftObjectPath& Path : AssetPaths)
+    {
+        if (!Path.IsNull() && !RetainedHandles.Contains(Path))
+        {
+            NewPaths.AddUnique(Path);
+        }
+    }
+
+    if (NewPaths.Num() == 0)
+    {
+        return;
+    }
+
+    // One handle per batch; it is released once every path sharing it has been evicted
+    TSharedPtr<FStreamableHandle> Handle = GetStreamableManager().RequestAsyncLoad(NewPaths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+    for (const FSoftObjectPath& Path : NewPaths)
+    {
+        RetainedHandles.Add(Path, Handle);
+        RetainOrder.Add(Path);
+    }
+
+    // Only paths older than this batch are evicted, even when the batch alone exceeds the cap
+    const int32 NumToEvict = FMath::Min(RetainOrder.Num() - MaxRetainedAssets, RetainOrder.Num() - NewPaths.Num());
+    if (NumToEvict > 0)
+    {
+        for (int32 i = 0; i < NumToEvict; i++)
+        {
+            RetainedHandles.Remove(RetainOrder[i]);
+        }
+        RetainOrder.RemoveAt(0, NumToEvict, false);
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Prefetching %d intersection assets (%d retained)"), NewPaths.Num(), RetainedHandles.Num());
+}
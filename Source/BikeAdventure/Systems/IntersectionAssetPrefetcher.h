@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Engine/StreamableManager.h"
+#include "../Core/BiomeTypes.h"
+#include "IntersectionAssetPrefetcher.generated.h"
+
+class AIntersection;
+
+/**
+ * Asynchronously preloads intersection visuals ahead of the rider.
+ * As soon as the streaming manager or biome generator knows which biomes an upcoming
+ * intersection connects, the meshes, materials, Niagara systems and sound cues it will
+ * need are requested through the streamable manager, so AIntersection never has to
+ * block the game thread on a synchronous load.
+ */
+UCLASS(BlueprintType)
+class BIKEADVENTURE_API UIntersectionAssetPrefetcher : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UIntersectionAssetPrefetcher();
+
+    /**
+     * Prefetch assets for intersections inside a newly determined section biome.
+     * The exact intersection type and path biomes are not known yet, so this covers the
+     * biome's preferred intersection types and every biome it can transition to.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Asset Prefetch")
+    void PrefetchForBiome(EBiomeType UpcomingBiome);
+
+    /**
+     * Prefetch assets for a specific intersection once its biome pair is known
+     */
+    UFUNCTION(BlueprintCallable, Category = "Asset Prefetch")
+    void PrefetchForIntersection(EBiomeType CurrentBiome, EBiomeType LeftBiome, EBiomeType RightBiome);
+
+    /**
+     * Whether every asset an intersection between these biomes could use is resident
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Asset Prefetch")
+    bool AreIntersectionAssetsReady(EBiomeType CurrentBiome, EBiomeType LeftBiome, EBiomeType RightBiome) const;
+
+    /**
+     * Set the intersection class whose asset maps are prefetched (defaults to AIntersection)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Asset Prefetch")
+    void SetIntersectionClass(TSubclassOf<AIntersection> InIntersectionClass);
+
+    /**
+     * Number of asset paths currently kept resident by the prefetcher
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Asset Prefetch")
+    int32 GetRetainedAssetCount() const { return RetainedHandles.Num(); }
+
+    /**
+     * Number of async requests that have not completed yet
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Asset Prefetch")
+    int32 GetInFlightRequestCount() const;
+
+    /**
+     * Release every retained asset
+     */
+    UFUNCTION(BlueprintCallable, Category = "Asset Prefetch")
+    void ReleaseAll();
+
+    /**
+     * Streamable manager shared by the prefetcher and intersections.
+     * Uses the asset manager's when available so requests are deduplicated across systems.
+     */
+    static FStreamableManager& GetStreamableManager();
+
+    // Maximum asset paths kept resident; the oldest are released first
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Prefetch", meta = (ClampMin = "16", ClampMax = "4096"))
+    int32 MaxRetainedAssets;
+
+private:
+    /**
+     * Request every path not already retained and evict the oldest beyond MaxRetainedAssets
+     */
+    void RequestAssets(const TArray<FSoftObjectPath>& AssetPaths);
+
+    /**
+     * Asset maps come from the configured intersection class defaults
+     */
+    const AIntersection* GetIntersectionDefaults() const;
+
+    // Intersection class whose soft asset maps are read
+    UPROPERTY()
+    TSubclassOf<AIntersection> IntersectionClass;
+
+    // Handles keeping prefetched assets resident, keyed by asset path
+    TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> RetainedHandles;
+
+    // Retained paths in request order, oldest first
+    TArray<FSoftObjectPath> RetainOrder;
+
+    // Scratch buffer reused between prefetch calls
+    TArray<FSoftObjectPath> ScratchPaths;
+};
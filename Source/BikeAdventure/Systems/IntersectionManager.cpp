@@ -1,6 +1,9 @@
 #include "IntersectionManager.h"
 #include "Gameplay/Intersection.h"
+#include "WorldStreamingManager.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 
 UIntersectionManager::UIntersectionManager()
 {
@@ -12,26 +15,82 @@ void UIntersectionManager::Initialize()
 {
 	if (!bInitialized)
 	{
-		RegisteredIntersections.Empty();
+		// Intersections may register during BeginPlay before the game mode initializes us
+		RebuildSpatialIndex();
 		bInitialized = true;
 		UE_LOG(LogTemp, Log, TEXT("Intersection Manager initialized"));
 	}
 }
 
+void UIntersectionManager::RebuildSpatialIndex()
+{
+	RegisteredIntersections.RemoveAll([](const TObjectPtr<AIntersection>& Intersection) { return !IsValid(Intersection); });
+
+	// Section buckets must line up with the sections the streaming manager loads
+	float SectionSize = UWorldStreamingManager::DefaultSectionSizeCm;
+	const UWorld* World = GetWorld();
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (const UWorldStreamingManager* StreamingManager = GameInstance ? GameInstance->GetSubsystem<UWorldStreamingManager>() : nullptr)
+	{
+		SectionSize = StreamingManager->GetSectionSize();
+	}
+
+	SpatialIndex.Reset(SpatialCellSize, SectionSize);
+	IntersectionIndices.Reset();
+
+	for (AIntersection* Intersection : RegisteredIntersections)
+	{
+		IntersectionIndices.Add(Intersection, SpatialIndex.Add(Intersection->GetActorLocation()));
+	}
+}
+
 void UIntersectionManager::RegisterIntersection(AIntersection* Intersection)
 {
-	if (Intersection && !RegisteredIntersections.Contains(Intersection))
+	if (Intersection && !IntersectionIndices.Contains(Intersection))
 	{
+		const int32 Index = SpatialIndex.Add(Intersection->GetActorLocation());
 		RegisteredIntersections.Add(Intersection);
-		UE_LOG(LogTemp, Log, TEXT("Registered intersection: %s"), *Intersection->GetName());
+		IntersectionIndices.Add(Intersection, Index);
+		UE_LOG(LogTemp, Verbose, TEXT("Registered intersection: %s"), *Intersection->GetName());
 	}
 }
 
 void UIntersectionManager::UnregisterIntersection(AIntersection* Intersection)
 {
-	if (Intersection)
+	int32 Index = INDEX_NONE;
+	if (Intersection && IntersectionIndices.RemoveAndCopyValue(Intersection, Index))
 	{
-		RegisteredIntersections.Remove(Intersection);
-		UE_LOG(LogTemp, Log, TEXT("Unregistered intersection: %s"), *Intersection->GetName());
+		// Both arrays move their last element into the freed slot
+		SpatialIndex.RemoveAtSwap(Index);
+		RegisteredIntersections.RemoveAtSwap(Index, 1, false);
+
+		if (RegisteredIntersections.IsValidIndex(Index))
+		{
+			IntersectionIndices[RegisteredIntersections[Index]] = Index;
+		}
+
+		UE_LOG(LogTemp, Verbose, TEXT("Unregistered intersection: %s"), *Intersection->GetName());
 	}
-}
\ No newline at end of file
+}
+
+TArray<AIntersection*> UIntersectionManager::GetIntersectionsInSection(const FIntVector& SectionCoordinates) const
+{
+	TArray<AIntersection*> SectionIntersections;
+
+	if (const TArray<int32>* Indices = SpatialIndex.FindInSection(SectionCoordinates))
+	{
+		SectionIntersections.Reserve(Indices->Num());
+		for (int32 Index : *Indices)
+		{
+			SectionIntersections.Add(RegisteredIntersections[Index]);
+		}
+	}
+
+	return SectionIntersections;
+}
+
+int32 UIntersectionManager::GetIntersectionCountInSection(const FIntVector& SectionCoordinates) const
+{
+	const TArray<int32>* Indices = SpatialIndex.FindInSection(SectionCoordinates);
+	return Indices ? Indices->Num() : 0;
+}
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Components/ActorComponent.h"
+#include "IntersectionSpatialIndex.h"
 #include "IntersectionManager.generated.h"
 
 class AIntersection;
@@ -10,6 +11,7 @@ class AIntersection;
 /**
  * Manages all intersections in the game world
  * Handles intersection spawning, tracking, and coordination
+ * Registered intersections are bucketed by world section so a section's intersections can be listed without scanning
  */
 UCLASS(BlueprintType, Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class BIKEADVENTURE_API UIntersectionManager : public UActorComponent
@@ -23,14 +25,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
 	void Initialize();
 
-	/** Register an intersection with the manager */
+	/** Register an intersection with the manager (O(1); its location is captured at registration) */
 	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
 	void RegisterIntersection(AIntersection* Intersection);
 
-	/** Unregister an intersection from the manager */
+	/** Unregister an intersection from the manager (O(1)) */
 	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
 	void UnregisterIntersection(AIntersection* Intersection);
 
+	/** Whether an intersection is currently registered */
+	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
+	bool IsRegistered(AIntersection* Intersection) const { return IntersectionIndices.Contains(Intersection); }
+
 	/** Get all registered intersections */
 	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
 	TArray<AIntersection*> GetAllIntersections() const { return RegisteredIntersections; }
@@ -39,12 +45,38 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
 	int32 GetIntersectionCount() const { return RegisteredIntersections.Num(); }
 
+	/** Get the intersections registered inside a world section */
+	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
+	TArray<AIntersection*> GetIntersectionsInSection(const FIntVector& SectionCoordinates) const;
+
+	/** Get the number of intersections registered inside a world section */
+	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
+	int32 GetIntersectionCountInSection(const FIntVector& SectionCoordinates) const;
+
+	/** World section containing a location */
+	UFUNCTION(BlueprintCallable, Category = "Intersection Manager")
+	FIntVector GetSectionCoordinates(const FVector& WorldLocation) const { return SpatialIndex.GetSectionCoordinates(WorldLocation); }
+
 protected:
-	/** Array of all registered intersections */
+	/** Array of all registered intersections, parallel to the spatial index */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State")
 	TArray<TObjectPtr<AIntersection>> RegisteredIntersections;
 
 	/** Whether the system has been initialized */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State")
 	bool bInitialized = false;
+
+	/** Edge length of the spatial grid cells used for proximity queries */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spatial Index", meta = (ClampMin = "1000.0"))
+	float SpatialCellSize = 20000.0f;
+
+private:
+	/** Rebuild the spatial index with the current cell size and the streaming manager's section size, keeping registrations */
+	void RebuildSpatialIndex();
+
+	/** Dense index of each registered intersection */
+	TMap<AIntersection*, int32> IntersectionIndices;
+
+	/** Grid over registered intersection locations */
+	FIntersectionSpatialIndex SpatialIndex;
 };
\ No newline at end of file
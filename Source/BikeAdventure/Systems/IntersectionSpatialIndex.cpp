@@ -0,0 +1,169 @@
+#include "IntersectionSpatialIndex.h"
+#include "WorldStreamingManager.h"
+
+namespace
+{
+    /** Remove a bucket slot by swapping in the last element and patch that element's stored slot */
+    template<typename KeyType, typename SlotAccessor>
+    void RemoveFromBucket(TMap<KeyType, TArray<int32>>& Buckets, const KeyType& Key, int32 Slot, SlotAccessor&& GetSlot)
+    {
+        TArray<int32>* Bucket = Buckets.Find(Key);
+        check(Bucket && Bucket->IsValidIndex(Slot));
+
+        Bucket->RemoveAtSwap(Slot, 1, false);
+        if (Bucket->Num() == 0)
+        {
+            Buckets.Remove(Key);
+        }
+        else if (Slot < Bucket->Num())
+        {
+            GetSlot((*Bucket)[Slot]) = Slot;
+        }
+    }
+
+    /** Point the bucket entry for a moved element at its new dense index */
+    template<typename KeyType>
+    void RetargetBucketEntry(TMap<KeyType, TArray<int32>>& Buckets, const KeyType& Key, int32 Slot, int32 NewIndex)
+    {
+        Buckets.FindChecked(Key)[Slot] = NewIndex;
+    }
+}
+
+FIntersectionSpatialIndex::FIntersectionSpatialIndex()
+{
+    Reset(20000.0f, UWorldStreamingManager::DefaultSectionSizeCm);
+}
+
+FIntersectionSpatialIndex::FIntersectionSpatialIndex(float InCellSize, float InSectionSize)
+{
+    Reset(InCellSize, InSectionSize);
+}
+
+void FIntersectionSpatialIndex::Reset(float InCellSize, float InSectionSize)
+{
+    Entries.Reset();
+    CellBuckets.Reset();
+    SectionBuckets.Reset();
+
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    SectionSize = FMath::Max(InSectionSize, 1.0f);
+}
+
+FIntPoint FIntersectionSpatialIndex::GetCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+FIntVector FIntersectionSpatialIndex::GetSectionCoordinates(const FVector& Location) const
+{
+    return FIntVector(
+        FMath::FloorToInt(Location.X / SectionSize),
+        FMath::FloorToInt(Location.Y / SectionSize),
+        FMath::FloorToInt(Location.Z / SectionSize)
+    );
+}
+
+int32 FIntersectionSpatialIndex::Add(const FVector& Location)
+{
+    const int32 Index = Entries.Num();
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Location = Location;
+    Entry.Cell = GetCell(Location);
+    Entry.Section = GetSectionCoordinates(Location);
+    Entry.CellSlot = CellBuckets.FindOrAdd(Entry.Cell).Add(Index);
+    Entry.SectionSlot = SectionBuckets.FindOrAdd(Entry.Section).Add(Index);
+
+    return Index;
+}
+
+void FIntersectionSpatialIndex::RemoveAtSwap(int32 Index)
+{
+    check(Entries.IsValidIndex(Index));
+
+    const FEntry Removed = Entries[Index];
+    RemoveFromBucket(CellBuckets, Removed.Cell, Removed.CellSlot, [this](int32 Moved) -> int32& { return Entries[Moved].CellSlot; });
+    RemoveFromBucket(SectionBuckets, Removed.Section, Removed.SectionSlot, [this](int32 Moved) -> int32& { return Entries[Moved].SectionSlot; });
+
+    const int32 LastIndex = Entries.Num() - 1;
+    if (Index != LastIndex)
+    {
+        // The last element takes the removed slot, so its bucket entries must follow it
+        const FEntry& Last = Entries[LastIndex];
+        RetargetBucketEntry(CellBuckets, Last.Cell, Last.CellSlot, Index);
+        RetargetBucketEntry(SectionBuckets, Last.Section, Last.SectionSlot, Index);
+    }
+
+    Entries.RemoveAtSwap(Index, 1, false);
+}
+
+int32 FIntersectionSpatialIndex::FindNearestAhead(const FVector& Location, const FVector& Heading, float MaxDistance, float MaxLateralOffset, int32 IgnoredIndex, float& OutDistance) const
+{
+    OutDistance = TNumericLimits<float>::Max();
+
+    const FVector2D Direction = FVector2D(Heading.X, Heading.Y).GetSafeNormal();
+    if (Direction.IsNearlyZero() || MaxDistance <= 0.0f || Entries.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    // Cells overlapping the corridor between the location and MaxDistance ahead
+    const FVector2D Start(Location.X, Location.Y);
+    const FVector2D End = Start + Direction * MaxDistance;
+    const FVector2D BoundsMin = FVector2D(FMath::Min(Start.X, End.X), FMath::Min(Start.Y, End.Y)) - FVector2D(MaxLateralOffset);
+    const FVector2D BoundsMax = FVector2D(FMath::Max(Start.X, End.X), FMath::Max(Start.Y, End.Y)) + FVector2D(MaxLateralOffset);
+
+    const int32 MinCellX = FMath::FloorToInt(BoundsMin.X / CellSize);
+    const int32 MinCellY = FMath::FloorToInt(BoundsMin.Y / CellSize);
+    const int32 MaxCellX = FMath::FloorToInt(BoundsMax.X / CellSize);
+    const int32 MaxCellY = FMath::FloorToInt(BoundsMax.Y / CellSize);
+
+    // Skip cells whose centre is further from the heading line than the corridor plus the cell's half diagonal
+    const float CellReach = MaxLateralOffset + CellSize * UE_HALF_SQRT_2;
+    const FVector2D Normal(-Direction.Y, Direction.X);
+
+    int32 BestIndex = INDEX_NONE;
+
+    for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++)
+    {
+        for (int32 CellY = MinCellY; CellY <= MaxCellY; CellY++)
+        {
+            const FVector2D CellCentre((CellX + 0.5f) * CellSize, (CellY + 0.5f) * CellSize);
+            if (FMath::Abs(FVector2D::DotProduct(CellCentre - Start, Normal)) > CellReach)
+            {
+                continue;
+            }
+
+            const TArray<int32>* Bucket = CellBuckets.Find(FIntPoint(CellX, CellY));
+            if (!Bucket)
+            {
+                continue;
+            }
+
+            for (int32 Index : *Bucket)
+            {
+                if (Index == IgnoredIndex)
+                {
+                    continue;
+                }
+
+                const FVector2D ToEntry = FVector2D(Entries[Index].Location.X, Entries[Index].Location.Y) - Start;
+                const float AlongDistance = FVector2D::DotProduct(ToEntry, Direction);
+                if (AlongDistance < 0.0f || AlongDistance > MaxDistance || AlongDistance >= OutDistance)
+                {
+                    continue;
+                }
+
+                if (FMath::Abs(FVector2D::DotProduct(ToEntry, Normal)) > MaxLateralOffset)
+                {
+                    continue;
+                }
+
+                BestIndex = Index;
+                OutDistance = AlongDistance;
+            }
+        }
+    }
+
+    return BestIndex;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid hash over intersection locations with a secondary bucket per world section.
+ * Elements are addressed by dense index so owners can keep a parallel array: Add appends and
+ * RemoveAtSwap moves the last element into the removed slot, exactly like TArray::RemoveAtSwap.
+ * Both operations are O(1); queries only touch the grid cells they overlap.
+ */
+struct BIKEADVENTURE_API FIntersectionSpatialIndex
+{
+    /** Default cell size over the streaming manager's default section size */
+    FIntersectionSpatialIndex();
+
+    /**
+     * @param InCellSize - Grid cell edge length used for proximity queries
+     * @param InSectionSize - World section edge length, matching the streaming manager
+     */
+    FIntersectionSpatialIndex(float InCellSize, float InSectionSize);
+
+    /** Drop every element and adopt new cell and section sizes */
+    void Reset(float InCellSize, float InSectionSize);
+
+    /** Add an element, returning its dense index (always the previous Num()) */
+    int32 Add(const FVector& Location);
+
+    /** Remove an element, moving the last element into its slot */
+    void RemoveAtSwap(int32 Index);
+
+    /**
+     * Nearest element ahead of a location along a heading
+     * @param Heading - Travel direction, only its horizontal component is used
+     * @param MaxDistance - Furthest distance along the heading to consider
+     * @param MaxLateralOffset - Maximum distance either side of the heading line
+     * @param IgnoredIndex - Element to skip, or INDEX_NONE
+     * @param OutDistance - Distance along the heading to the returned element
+     * @return Dense index of the nearest element ahead, or INDEX_NONE
+     */
+    int32 FindNearestAhead(const FVector& Location, const FVector& Heading, float MaxDistance, float MaxLateralOffset, int32 IgnoredIndex, float& OutDistance) const;
+
+    /** Dense indices of every element inside a world section, or null if it holds none */
+    const TArray<int32>* FindInSection(const FIntVector& SectionCoordinates) const { return SectionBuckets.Find(SectionCoordinates); }
+
+    /** World section containing a location, using the streaming manager's convention */
+    FIntVector GetSectionCoordinates(const FVector& Location) const;
+
+    int32 Num() const { return Entries.Num(); }
+    const FVector& GetLocation(int32 Index) const { return Entries[Index].Location; }
+    float GetCellSize() const { return CellSize; }
+    float GetSectionSize() const { return SectionSize; }
+
+private:
+    struct FEntry
+    {
+        FVector Location;
+        FIntPoint Cell;
+        FIntVector Section;
+
+        // Position of this element inside its cell and section buckets
+        int32 CellSlot;
+        int32 SectionSlot;
+    };
+
+    FIntPoint GetCell(const FVector& Location) const;
+
+    TArray<FEntry> Entries;
+    TMap<FIntPoint, TArray<int32>> CellBuckets;
+    TMap<FIntVector, TArray<int32>> SectionBuckets;
+
+    float CellSize;
+    float SectionSize;
+};
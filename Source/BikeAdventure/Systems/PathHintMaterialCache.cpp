@@ -0,0 +1,90 @@
+#include "PathHintMaterialCache.h"
+#include "Materials/MaterialInterface.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+void UPathHintMaterialCache::Deinitialize()
+{
+    Entries.Empty();
+    InstanceKeys.Empty();
+    LiveInstances.Empty();
+    TotalReferences = 0;
+
+    Super::Deinitialize();
+}
+
+UMaterialInterface* UPathHintMaterialCache::GetBaseMaterial(UMaterialInterface* Material)
+{
+    // Pooled instances are never parents themselves, so one step up is enough
+    if (UMaterialInstanceDynamic* DynamicMaterial = Cast<UMaterialInstanceDynamic>(Material))
+    {
+        return DynamicMaterial->Parent;
+    }
+
+    return Material;
+}
+
+UMaterialInstanceDynamic* UPathHintMaterialCache::AcquireInstance(UMaterialInterface* ParentMaterial, EPathPersonality Personality, EBiomeType BiomeType, bool bIsLeftPath, float HintSubtlety, float PathFactor)
+{
+    ParentMaterial = GetBaseMaterial(ParentMaterial);
+    if (!ParentMaterial)
+    {
+        return nullptr;
+    }
+
+    FPathHintMaterialKey Key;
+    Key.ParentMaterial = ParentMaterial;
+    Key.Personality = Personality;
+    Key.BiomeType = BiomeType;
+    Key.bIsLeftPath = bIsLeftPath;
+    Key.SubtletyLevel = Quantise(HintSubtlety);
+    Key.FactorLevel = Quantise(PathFactor);
+
+    FEntry& Entry = Entries.FindOrAdd(Key);
+    if (!Entry.Instance)
+    {
+        Entry.Instance = UMaterialInstanceDynamic::Create(ParentMaterial, this);
+        if (!Entry.Instance)
+        {
+            Entries.Remove(Key);
+            return nullptr;
+        }
+
+        // Parameters come from the quantised state so every sharer renders identically
+        const float QuantisedSubtlety = static_cast<float>(Key.SubtletyLevel) / QuantisationLevels;
+        const float QuantisedFactor = static_cast<float>(Key.FactorLevel) / QuantisationLevels;
+        Entry.Instance->SetScalarParameterValue(TEXT("Opacity"), 1.0f - QuantisedSubtlety);
+        Entry.Instance->SetScalarParameterValue(bIsLeftPath ? TEXT("Challenge") : TEXT("Scenery"), QuantisedFactor);
+
+        InstanceKeys.Add(Entry.Instance, Key);
+        LiveInstances.Add(Entry.Instance);
+    }
+
+    Entry.RefCount++;
+    TotalReferences++;
+    return Entry.Instance;
+}
+
+void UPathHintMaterialCache::ReleaseInstance(UMaterialInstanceDynamic* Instance)
+{
+    const FPathHintMaterialKey* Key = Instance ? InstanceKeys.Find(Instance) : nullptr;
+    if (!Key)
+    {
+        return;
+    }
+
+    FEntry* Entry = Entries.Find(*Key);
+    if (!Entry)
+    {
+        return;
+    }
+
+    Entry->RefCount--;
+    TotalReferences--;
+
+    if (Entry->RefCount <= 0)
+    {
+        Entries.Remove(*Key);
+        InstanceKeys.Remove(Instance);
+        LiveInstances.Remove(Instance);
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "../Core/BiomeTypes.h"
+#include "PathHintMaterialCache.generated.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ * Identifies one shared path indicator material state.
+ * Subtlety and path factor are quantised so intersections with near-identical hints share an instance.
+ */
+struct BIKEADVENTURE_API FPathHintMaterialKey
+{
+    TObjectKey<UMaterialInterface> ParentMaterial;
+    EPathPersonality Personality = EPathPersonality::None;
+    EBiomeType BiomeType = EBiomeType::None;
+    bool bIsLeftPath = false;
+    uint8 SubtletyLevel = 0;
+    uint8 FactorLevel = 0;
+
+    bool operator==(const FPathHintMaterialKey& Other) const
+    {
+        return ParentMaterial == Other.ParentMaterial
+            && Personality == Other.Personality
+            && BiomeType == Other.BiomeType
+            && bIsLeftPath == Other.bIsLeftPath
+            && SubtletyLevel == Other.SubtletyLevel
+            && FactorLevel == Other.FactorLevel;
+    }
+
+    friend uint32 GetTypeHash(const FPathHintMaterialKey& Key)
+    {
+        const uint32 PackedState = static_cast<uint32>(Key.Personality)
+            | (static_cast<uint32>(Key.BiomeType) << 8)
+            | (static_cast<uint32>(Key.bIsLeftPath) << 16)
+            | (static_cast<uint32>(Key.SubtletyLevel) << 17)
+            | (static_cast<uint32>(Key.FactorLevel) << 24);
+        return HashCombine(GetTypeHash(Key.ParentMaterial), PackedState);
+    }
+};
+
+/**
+ * Per-world pool of path indicator material instances.
+ * Intersections acquire a shared dynamic instance for their (personality, biome, quantised
+ * subtlety) hint state instead of creating one per indicator, so material instances scale
+ * with the number of distinct hint states rather than the number of intersections.
+ * Instances are reference counted and dropped when the last intersection releases them.
+ */
+UCLASS()
+class BIKEADVENTURE_API UPathHintMaterialCache : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Quantisation steps for hint subtlety and the challenge/scenery factor */
+    static constexpr int32 QuantisationLevels = 10;
+
+    virtual void Deinitialize() override;
+
+    /**
+     * Get the shared instance for a hint state, creating it on first use.
+     * Every successful acquire must be balanced by ReleaseInstance.
+     * @param PathFactor Challenge factor for left paths, scenery factor for right paths
+     */
+    UMaterialInstanceDynamic* AcquireInstance(UMaterialInterface* ParentMaterial, EPathPersonality Personality, EBiomeType BiomeType, bool bIsLeftPath, float HintSubtlety, float PathFactor);
+
+    /**
+     * Drop one reference to a shared instance
+     */
+    void ReleaseInstance(UMaterialInstanceDynamic* Instance);
+
+    /**
+     * Number of distinct material instances currently alive
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Path Hints")
+    int32 GetInstanceCount() const { return Entries.Num(); }
+
+    /**
+     * Number of outstanding references across all instances (one per indicator using the pool)
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Path Hints")
+    int32 GetReferenceCount() const { return TotalReferences; }
+
+    /**
+     * Parent material to key on when a component may already show a pooled instance
+     */
+    static UMaterialInterface* GetBaseMaterial(UMaterialInterface* Material);
+
+    /** Snap a 0-1 value to its quantisation level */
+    static uint8 Quantise(float Value)
+    {
+        return static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Value, 0.0f, 1.0f) * QuantisationLevels));
+    }
+
+private:
+    struct FEntry
+    {
+        UMaterialInstanceDynamic* Instance = nullptr;
+        int32 RefCount = 0;
+    };
+
+    // Shared instances by hint state
+    TMap<FPathHintMaterialKey, FEntry> Entries;
+
+    // Reverse lookup used on release
+    TMap<const UMaterialInstanceDynamic*, FPathHintMaterialKey> InstanceKeys;
+
+    // Keeps pooled instances alive for the garbage collector
+    UPROPERTY(Transient)
+    TSet<UMaterialInstanceDynamic*> LiveInstances;
+
+    int32 TotalReferences = 0;
+};
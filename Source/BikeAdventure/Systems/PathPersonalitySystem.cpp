@@ -1,5 +1,34 @@
 #include "PathPersonalitySystem.h"
 #include "Engine/Engine.h"
+#include "BikeTelemetry.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    // Personalities that favor left paths (Wild, Challenge, Mystery), indexed by EPathPersonality
+    constexpr bool PersonalityFavorsLeftPath[PathPersonalityTables::NumPersonalities] =
+    {
+        /* Wild */      true,
+        /* Safe */      false,
+        /* Scenic */    false,
+        /* Challenge */ true,
+        /* Mystery */   true,
+        /* Peaceful */  false,
+    };
+
+    // Transition context multipliers for the destination biome, indexed by [EBiomeType][EPathPersonality]
+    constexpr float BiomeContextMultipliers[BiomeTables::NumBiomes][PathPersonalityTables::NumPersonalities] =
+    {
+        //                  Wild  Safe  Scenic Challenge Mystery Peaceful
+        /* Forest */      { 1.3f, 1.0f, 1.0f,  1.0f,     1.2f,   1.0f },  // Natural biomes favor wild and mystery
+        /* Beach */       { 1.0f, 1.0f, 1.4f,  1.0f,     1.0f,   1.2f },  // Beaches are scenic and peaceful
+        /* Desert */      { 1.0f, 1.0f, 1.0f,  1.2f,     1.0f,   1.1f },  // Challenging but also peaceful
+        /* Urban */       { 1.0f, 1.4f, 0.8f,  1.0f,     1.0f,   1.0f },  // Safe and structured
+        /* Countryside */ { 1.0f, 1.0f, 1.2f,  1.0f,     1.0f,   1.3f },  // Balanced and peaceful
+        /* Mountains */   { 1.3f, 1.0f, 1.0f,  1.0f,     1.2f,   1.0f },
+        /* Wetlands */    { 1.3f, 1.0f, 1.0f,  1.0f,     1.2f,   1.0f },
+    };
+}
 
 UPathPersonalitySystem::UPathPersonalitySystem()
 {
@@ -11,6 +40,7 @@ void UPathPersonalitySystem::Initialize()
     InitializeBiomeRules();
     InitializePersonalityCharacteristics();
     InitializeVisualHints();
+    RebuildCharacteristicTables();
     
     UE_LOG(LogTemp, Log, TEXT("PathPersonalitySystem initialized"));
 }
@@ -50,15 +80,65 @@ FPathHints UPathPersonalitySystem::GeneratePathHintsForIntersection(EBiomeType C
     // Broadcast event
     OnPathPersonalityGeneratedEvent.Broadcast(LeftPersonality, RightPersonality, Hints.HintSubtlety);
     
-    UE_LOG(LogTemp, Log, TEXT("Generated path hints: Left=%s, Right=%s, Subtlety=%.2f"), 
-           *UEnum::GetValueAsString(LeftPersonality), 
-           *UEnum::GetValueAsString(RightPersonality), 
-           Hints.HintSubtlety);
+    FBikeTelemetry::Get().Record(EBikeTelemetryEvent::PathHintsGenerated, FIntVector::ZeroValue,
+                                 static_cast<uint8>(LeftPersonality), static_cast<uint8>(RightPersonality),
+                                 0, Hints.HintSubtlety);
     
     return Hints;
 }
 
-FPathCharacteristics UPathPersonalitySystem::GeneratePathCharacteristics(EPathPersonality Personality, EBiomeType BiomeType, bool bIsLeftPath)
+void UPathPersonalitySystem::GeneratePathHintsForIntersections(const TArray<FPathHintRequest>& Requests, const FPlayerChoiceHistory& PlayerHistory, TArray<FCompactPathHints>& OutHints)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    
+    OutHints.Reset(Requests.Num());
+    
+    // Subtlety only depends on the current biome and the player history, so evaluate it once per biome
+    float SubtletyByBiome[BiomeTables::NumBiomes + 1];
+    bool bSubtletyEvaluated[BiomeTables::NumBiomes + 1] = {};
+    
+    for (const FPathHintRequest& Request : Requests)
+    {
+        FCompactPathHints& Hints = OutHints.AddDefaulted_GetRef();
+        Hints.SectionCoordinates = Request.SectionCoordinates;
+        
+        // Random draws happen in the same order as GeneratePathHintsForIntersection so seeded results match
+        Hints.LeftPathPersonality = DeterminePathPersonality(Request.CurrentBiome, Request.LeftPathBiome, true, PlayerHistory);
+        Hints.RightPathPersonality = DeterminePathPersonality(Request.CurrentBiome, Request.RightPathBiome, false, PlayerHistory);
+        
+        const int32 LeftPersonalityIndex = FMath::Min(PathPersonalityTables::ToIndex(Hints.LeftPathPersonality), PathPersonalityTables::NumPersonalities);
+        const int32 RightPersonalityIndex = FMath::Min(PathPersonalityTables::ToIndex(Hints.RightPathPersonality), PathPersonalityTables::NumPersonalities);
+        const int32 LeftBiomeIndex = FMath::Min(static_cast<int32>(Request.LeftPathBiome), BiomeTables::NumBiomes);
+        const int32 RightBiomeIndex = FMath::Min(static_cast<int32>(Request.RightPathBiome), BiomeTables::NumBiomes);
+        
+        const float LeftRandomFactor = RandomStream.FRandRange(0.9f, 1.1f);
+        Hints.LeftPathChallengeFactor = FMath::Clamp(BaseLeftChallengeFactors[LeftPersonalityIndex][LeftBiomeIndex] * LeftRandomFactor, 0.0f, 1.0f);
+        
+        const float RightRandomFactor = RandomStream.FRandRange(0.9f, 1.1f);
+        Hints.RightPathSceneryFactor = FMath::Clamp(BaseRightSceneryFactors[RightPersonalityIndex][RightBiomeIndex] * RightRandomFactor, 0.0f, 1.0f);
+        
+        const int32 CurrentBiomeIndex = FMath::Min(static_cast<int32>(Request.CurrentBiome), BiomeTables::NumBiomes);
+        if (!bSubtletyEvaluated[CurrentBiomeIndex])
+        {
+            SubtletyByBiome[CurrentBiomeIndex] = CalculateHintSubtlety(Request.CurrentBiome, PlayerHistory);
+            bSubtletyEvaluated[CurrentBiomeIndex] = true;
+        }
+        Hints.HintSubtlety = SubtletyByBiome[CurrentBiomeIndex];
+    }
+    
+    if (OutHints.Num() == 0)
+    {
+        return;
+    }
+    
+    OnPathHintsBatchGeneratedEvent.Broadcast(OutHints);
+    
+    const float BatchTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    FBikeTelemetry::Get().Record(EBikeTelemetryEvent::PathHintsBatchGenerated, OutHints[0].SectionCoordinates,
+                                 0, 0, OutHints.Num(), BatchTimeMs);
+}
+
+FPathCharacteristics UPathPersonalitySystem::GenerateBaseCharacteristics(EPathPersonality Personality, EBiomeType BiomeType, bool bIsLeftPath)
 {
     FPathCharacteristics Characteristics;
     
@@ -90,6 +170,13 @@ FPathCharacteristics UPathPersonalitySystem::GeneratePathCharacteristics(EPathPe
         Characteristics.WeatherResistance = FMath::Clamp(Characteristics.WeatherResistance + 0.1f, 0.0f, 1.0f);
     }
     
+    return Characteristics;
+}
+
+FPathCharacteristics UPathPersonalitySystem::GeneratePathCharacteristics(EPathPersonality Personality, EBiomeType BiomeType, bool bIsLeftPath)
+{
+    FPathCharacteristics Characteristics = GenerateBaseCharacteristics(Personality, BiomeType, bIsLeftPath);
+    
     // Add some randomization to avoid predictability
     float RandomFactor = RandomStream.FRandRange(0.9f, 1.1f);
     Characteristics.DifficultyLevel *= RandomFactor;
@@ -109,90 +196,19 @@ FPathCharacteristics UPathPersonalitySystem::GeneratePathCharacteristics(EPathPe
 
 EPathPersonality UPathPersonalitySystem::DeterminePathPersonality(EBiomeType FromBiome, EBiomeType ToBiome, bool bIsLeftPath, const FPlayerChoiceHistory& PlayerHistory)
 {
-    // Get generation rules for the target biome
-    FPathGenerationRules* Rules = BiomeGenerationRules.Find(ToBiome);
-    if (!Rules)
+    // Calculate personality weights based on player history and the precomputed biome/side table
+    float PersonalityWeights[PathPersonalityTables::NumPersonalities];
+    const int32 NumCandidates = CalculatePersonalityWeights(ToBiome, bIsLeftPath, PlayerHistory, PersonalityWeights);
+    if (NumCandidates == 0)
     {
         return EPathPersonality::Peaceful; // Default fallback
     }
     
-    // Calculate personality weights based on player history and biome rules
-    TMap<EPathPersonality, float> PersonalityWeights = CalculatePersonalityWeights(ToBiome, PlayerHistory);
-    
-    // Apply left/right bias from rules
-    float BiasMultiplier = bIsLeftPath ? Rules->LeftPathBias : Rules->RightPathBias;
-    
-    // Adjust weights based on path side tendencies
-    for (auto& WeightPair : PersonalityWeights)
-    {
-        EPathPersonality Personality = WeightPair.Key;
-        float& Weight = WeightPair.Value;
-        
-        switch (Personality)
-        {
-            case EPathPersonality::Wild:
-            case EPathPersonality::Challenge:
-            case EPathPersonality::Mystery:
-                // These personalities favor left paths
-                Weight *= bIsLeftPath ? (1.0f + BiasMultiplier) : (1.0f - BiasMultiplier * 0.5f);
-                break;
-                
-            case EPathPersonality::Safe:
-            case EPathPersonality::Scenic:
-            case EPathPersonality::Peaceful:
-                // These personalities favor right paths
-                Weight *= bIsLeftPath ? (1.0f - BiasMultiplier * 0.5f) : (1.0f + BiasMultiplier);
-                break;
-                
-            default:
-                break;
-        }
-    }
-    
-    // Apply biome transition context
-    switch (ToBiome)
-    {
-        case EBiomeType::Forest:
-        case EBiomeType::Mountains:
-        case EBiomeType::Wetlands:
-            // Natural biomes favor wild and mystery personalities
-            PersonalityWeights[EPathPersonality::Wild] *= 1.3f;
-            PersonalityWeights[EPathPersonality::Mystery] *= 1.2f;
-            break;
-            
-        case EBiomeType::Urban:
-            // Urban areas favor safe and structured personalities
-            PersonalityWeights[EPathPersonality::Safe] *= 1.4f;
-            PersonalityWeights[EPathPersonality::Scenic] *= 0.8f;
-            break;
-            
-        case EBiomeType::Countryside:
-            // Countryside is balanced and peaceful
-            PersonalityWeights[EPathPersonality::Peaceful] *= 1.3f;
-            PersonalityWeights[EPathPersonality::Scenic] *= 1.2f;
-            break;
-            
-        case EBiomeType::Beach:
-            // Beaches are scenic and peaceful
-            PersonalityWeights[EPathPersonality::Scenic] *= 1.4f;
-            PersonalityWeights[EPathPersonality::Peaceful] *= 1.2f;
-            break;
-            
-        case EBiomeType::Desert:
-            // Deserts can be challenging but also peaceful
-            PersonalityWeights[EPathPersonality::Challenge] *= 1.2f;
-            PersonalityWeights[EPathPersonality::Peaceful] *= 1.1f;
-            break;
-            
-        default:
-            break;
-    }
-    
     // Select personality based on weighted random selection
     float TotalWeight = 0.0f;
-    for (const auto& WeightPair : PersonalityWeights)
+    for (int32 Index = 0; Index < NumCandidates; Index++)
     {
-        TotalWeight += WeightPair.Value;
+        TotalWeight += PersonalityWeights[Index];
     }
     
     if (TotalWeight <= 0.0f)
@@ -200,15 +216,16 @@ EPathPersonality UPathPersonalitySystem::DeterminePathPersonality(EBiomeType Fro
         return EPathPersonality::Peaceful;
     }
     
+    const FPersonalitySelectionTable& Table = SelectionTables[static_cast<int32>(ToBiome)];
     float RandomValue = RandomStream.FRandRange(0.0f, TotalWeight);
     float CurrentWeight = 0.0f;
     
-    for (const auto& WeightPair : PersonalityWeights)
+    for (int32 Index = 0; Index < NumCandidates; Index++)
     {
-        CurrentWeight += WeightPair.Value;
+        CurrentWeight += PersonalityWeights[Index];
         if (RandomValue <= CurrentWeight)
         {
-            return WeightPair.Key;
+            return Table.Order[Index];
         }
     }
     
@@ -228,44 +245,22 @@ void UPathPersonalitySystem::UpdatePlayerChoiceHistory(FPlayerChoiceHistory& Pla
         PlayerHistory.RightChoices++;
     }
     
-    // Update recent choice history (keep last 10)
-    PlayerHistory.RecentChoices.Add(bChoseLeftPath);
-    if (PlayerHistory.RecentChoices.Num() > 10)
-    {
-        PlayerHistory.RecentChoices.RemoveAt(0);
-    }
-    
-    // Update recent biome history
-    PlayerHistory.RecentBiomes.Add(BiomeChosen);
-    if (PlayerHistory.RecentBiomes.Num() > 10)
-    {
-        PlayerHistory.RecentBiomes.RemoveAt(0);
-    }
-    
-    // Update recent personality history
-    PlayerHistory.RecentPersonalities.Add(PersonalityChosen);
-    if (PlayerHistory.RecentPersonalities.Num() > 10)
-    {
-        PlayerHistory.RecentPersonalities.RemoveAt(0);
-    }
+    // Update the recent window and streak
+    PlayerHistory.PushRecent(bChoseLeftPath, BiomeChosen, PersonalityChosen);
     
     // Update personality preferences
-    float* CurrentPreference = PlayerHistory.PersonalityPreferences.Find(PersonalityChosen);
-    if (CurrentPreference)
-    {
-        *CurrentPreference = FMath::Clamp(*CurrentPreference + 0.1f, 0.0f, 1.0f);
-    }
-    else
+    if (PathPersonalityTables::IsValidPersonality(PersonalityChosen))
     {
-        PlayerHistory.PersonalityPreferences.Add(PersonalityChosen, 0.1f);
+        float& CurrentPreference = PlayerHistory.PersonalityPreferences[PathPersonalityTables::ToIndex(PersonalityChosen)];
+        CurrentPreference = FMath::Clamp(CurrentPreference + 0.1f, 0.0f, 1.0f);
     }
     
     // Decay other personality preferences slightly
-    for (auto& PrefPair : PlayerHistory.PersonalityPreferences)
+    for (int32 Index = 0; Index < PathPersonalityTables::NumPersonalities; Index++)
     {
-        if (PrefPair.Key != PersonalityChosen)
+        if (Index != PathPersonalityTables::ToIndex(PersonalityChosen))
         {
-            PrefPair.Value = FMath::Max(PrefPair.Value * 0.95f, 0.0f);
+            PlayerHistory.PersonalityPreferences[Index] = FMath::Max(PlayerHistory.PersonalityPreferences[Index] * 0.95f, 0.0f);
         }
     }
     
@@ -273,12 +268,12 @@ void UPathPersonalitySystem::UpdatePlayerChoiceHistory(FPlayerChoiceHistory& Pla
     EPathPersonality NewPreferredPersonality = EPathPersonality::None;
     float HighestPreference = 0.0f;
     
-    for (const auto& PrefPair : PlayerHistory.PersonalityPreferences)
+    for (int32 Index = 0; Index < PathPersonalityTables::NumPersonalities; Index++)
     {
-        if (PrefPair.Value > HighestPreference)
+        if (PlayerHistory.PersonalityPreferences[Index] > HighestPreference)
         {
-            HighestPreference = PrefPair.Value;
-            NewPreferredPersonality = PrefPair.Key;
+            HighestPreference = PlayerHistory.PersonalityPreferences[Index];
+            NewPreferredPersonality = static_cast<EPathPersonality>(Index);
         }
     }
     
@@ -293,8 +288,7 @@ void UPathPersonalitySystem::UpdatePlayerChoiceHistory(FPlayerChoiceHistory& Pla
     }
     
     // Calculate adaptive weight based on choice patterns
-    float LeftRatio = PlayerHistory.TotalChoices > 0 ? static_cast<float>(PlayerHistory.LeftChoices) / PlayerHistory.TotalChoices : 0.5f;
-    PlayerHistory.AdaptiveWeight = LeftRatio;
+    PlayerHistory.AdaptiveWeight = PlayerHistory.GetLeftRatio();
 }
 
 FPathVisualHints UPathPersonalitySystem::GetVisualHintsForPersonality(EPathPersonality Personality, EBiomeType BiomeType, float HintSubtlety)
@@ -387,7 +381,7 @@ FPathGenerationRules UPathPersonalitySystem::GenerateAdaptiveRules(EBiomeType Bi
     // Adapt based on player choice patterns
     if (PlayerHistory.TotalChoices > 5) // Only adapt after some choices
     {
-        float LeftRatio = static_cast<float>(PlayerHistory.LeftChoices) / PlayerHistory.TotalChoices;
+        const float LeftRatio = PlayerHistory.GetLeftRatio();
         
         // Adjust biases based on player preferences
         if (LeftRatio > 0.7f)
@@ -404,11 +398,12 @@ FPathGenerationRules UPathPersonalitySystem::GenerateAdaptiveRules(EBiomeType Bi
         }
         
         // Adjust personality weights based on preferences
-        for (const auto& PrefPair : PlayerHistory.PersonalityPreferences)
+        for (int32 Index = 0; Index < PathPersonalityTables::NumPersonalities; Index++)
         {
-            if (PrefPair.Value > 0.3f)
+            const float Preference = PlayerHistory.PersonalityPreferences[Index];
+            if (Preference > 0.3f)
             {
-                Rules.PersonalityWeights[PrefPair.Key] = FMath::Min(Rules.PersonalityWeights[PrefPair.Key] * (1.0f + PrefPair.Value), 2.0f);
+                Rules.PersonalityWeights[Index] = FMath::Min(Rules.PersonalityWeights[Index] * (1.0f + Preference), 2.0f);
             }
         }
     }
@@ -452,6 +447,11 @@ float UPathPersonalitySystem::CalculateHintSubtlety(EBiomeType BiomeType, const
     return BaseSubtlety;
 }
 
+float UPathPersonalitySystem::GetPersonalityPreference(const FPlayerChoiceHistory& PlayerHistory, EPathPersonality Personality)
+{
+    return PlayerHistory.GetPersonalityPreference(Personality);
+}
+
 void UPathPersonalitySystem::InitializeBiomeRules()
 {
     // Initialize rules for each biome type
@@ -474,63 +474,150 @@ void UPathPersonalitySystem::InitializeBiomeRules()
         {
             case EBiomeType::Forest:
                 Rules.AllowedPersonalities = {EPathPersonality::Wild, EPathPersonality::Mystery, EPathPersonality::Scenic, EPathPersonality::Peaceful};
-                Rules.PersonalityWeights.Add(EPathPersonality::Wild, 1.2f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Mystery, 1.1f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Scenic, 0.9f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Peaceful, 0.8f);
+                Rules.SetPersonalityWeight(EPathPersonality::Wild, 1.2f);
+                Rules.SetPersonalityWeight(EPathPersonality::Mystery, 1.1f);
+                Rules.SetPersonalityWeight(EPathPersonality::Scenic, 0.9f);
+                Rules.SetPersonalityWeight(EPathPersonality::Peaceful, 0.8f);
                 break;
                 
             case EBiomeType::Urban:
                 Rules.AllowedPersonalities = {EPathPersonality::Safe, EPathPersonality::Scenic, EPathPersonality::Challenge};
-                Rules.PersonalityWeights.Add(EPathPersonality::Safe, 1.3f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Scenic, 0.9f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Challenge, 0.7f);
+                Rules.SetPersonalityWeight(EPathPersonality::Safe, 1.3f);
+                Rules.SetPersonalityWeight(EPathPersonality::Scenic, 0.9f);
+                Rules.SetPersonalityWeight(EPathPersonality::Challenge, 0.7f);
                 break;
                 
             case EBiomeType::Mountains:
                 Rules.AllowedPersonalities = {EPathPersonality::Challenge, EPathPersonality::Scenic, EPathPersonality::Wild};
-                Rules.PersonalityWeights.Add(EPathPersonality::Challenge, 1.3f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Scenic, 1.2f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Wild, 1.0f);
+                Rules.SetPersonalityWeight(EPathPersonality::Challenge, 1.3f);
+                Rules.SetPersonalityWeight(EPathPersonality::Scenic, 1.2f);
+                Rules.SetPersonalityWeight(EPathPersonality::Wild, 1.0f);
                 break;
                 
             case EBiomeType::Beach:
                 Rules.AllowedPersonalities = {EPathPersonality::Scenic, EPathPersonality::Peaceful, EPathPersonality::Safe};
-                Rules.PersonalityWeights.Add(EPathPersonality::Scenic, 1.4f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Peaceful, 1.2f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Safe, 1.0f);
+                Rules.SetPersonalityWeight(EPathPersonality::Scenic, 1.4f);
+                Rules.SetPersonalityWeight(EPathPersonality::Peaceful, 1.2f);
+                Rules.SetPersonalityWeight(EPathPersonality::Safe, 1.0f);
                 break;
                 
             case EBiomeType::Countryside:
                 Rules.AllowedPersonalities = {EPathPersonality::Peaceful, EPathPersonality::Scenic, EPathPersonality::Safe};
-                Rules.PersonalityWeights.Add(EPathPersonality::Peaceful, 1.3f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Scenic, 1.1f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Safe, 1.0f);
+                Rules.SetPersonalityWeight(EPathPersonality::Peaceful, 1.3f);
+                Rules.SetPersonalityWeight(EPathPersonality::Scenic, 1.1f);
+                Rules.SetPersonalityWeight(EPathPersonality::Safe, 1.0f);
                 break;
                 
             case EBiomeType::Desert:
                 Rules.AllowedPersonalities = {EPathPersonality::Challenge, EPathPersonality::Peaceful, EPathPersonality::Mystery};
-                Rules.PersonalityWeights.Add(EPathPersonality::Challenge, 1.1f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Peaceful, 1.0f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Mystery, 0.8f);
+                Rules.SetPersonalityWeight(EPathPersonality::Challenge, 1.1f);
+                Rules.SetPersonalityWeight(EPathPersonality::Peaceful, 1.0f);
+                Rules.SetPersonalityWeight(EPathPersonality::Mystery, 0.8f);
                 break;
                 
             case EBiomeType::Wetlands:
                 Rules.AllowedPersonalities = {EPathPersonality::Mystery, EPathPersonality::Wild, EPathPersonality::Scenic};
-                Rules.PersonalityWeights.Add(EPathPersonality::Mystery, 1.3f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Wild, 1.1f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Scenic, 0.9f);
+                Rules.SetPersonalityWeight(EPathPersonality::Mystery, 1.3f);
+                Rules.SetPersonalityWeight(EPathPersonality::Wild, 1.1f);
+                Rules.SetPersonalityWeight(EPathPersonality::Scenic, 0.9f);
                 break;
                 
             default:
                 Rules.AllowedPersonalities = {EPathPersonality::Peaceful, EPathPersonality::Scenic};
-                Rules.PersonalityWeights.Add(EPathPersonality::Peaceful, 1.0f);
-                Rules.PersonalityWeights.Add(EPathPersonality::Scenic, 1.0f);
+                Rules.SetPersonalityWeight(EPathPersonality::Peaceful, 1.0f);
+                Rules.SetPersonalityWeight(EPathPersonality::Scenic, 1.0f);
                 break;
         }
         
         BiomeGenerationRules.Add(BiomeType, Rules);
     }
+    
+    RebuildSelectionTables();
+}
+
+void UPathPersonalitySystem::SetBiomeGenerationRules(EBiomeType BiomeType, const FPathGenerationRules& Rules)
+{
+    BiomeGenerationRules.Add(BiomeType, Rules);
+    RebuildSelectionTables();
+}
+
+void UPathPersonalitySystem::SetDefaultPathCharacteristics(EPathPersonality Personality, const FPathCharacteristics& Characteristics)
+{
+    DefaultPathCharacteristics.Add(Personality, Characteristics);
+    RebuildCharacteristicTables();
+}
+
+#if WITH_EDITOR
+void UPathPersonalitySystem::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Edits can land anywhere inside the nested rule structs, so key off the top-level member
+    const FName MemberName = PropertyChangedEvent.MemberProperty ? PropertyChangedEvent.MemberProperty->GetFName() : NAME_None;
+    if (MemberName == GET_MEMBER_NAME_CHECKED(UPathPersonalitySystem, BiomeGenerationRules))
+    {
+        RebuildSelectionTables();
+    }
+    else if (MemberName == GET_MEMBER_NAME_CHECKED(UPathPersonalitySystem, DefaultPathCharacteristics))
+    {
+        RebuildCharacteristicTables();
+    }
+}
+#endif
+
+void UPathPersonalitySystem::RebuildSelectionTables()
+{
+    for (int32 BiomeIndex = 0; BiomeIndex < BiomeTables::NumBiomes; BiomeIndex++)
+    {
+        bSelectionTableValid[BiomeIndex] = false;
+        
+        const FPathGenerationRules* Rules = BiomeGenerationRules.Find(static_cast<EBiomeType>(BiomeIndex));
+        if (!Rules)
+        {
+            continue;
+        }
+        
+        FPersonalitySelectionTable& Table = SelectionTables[BiomeIndex];
+        Table.NumCandidates = 0;
+        
+        // Allowed personalities keep their authored order; any other weighted personality follows
+        bool bInTable[PathPersonalityTables::NumPersonalities] = {};
+        for (EPathPersonality Personality : Rules->AllowedPersonalities)
+        {
+            if (PathPersonalityTables::IsValidPersonality(Personality) && !bInTable[PathPersonalityTables::ToIndex(Personality)])
+            {
+                bInTable[PathPersonalityTables::ToIndex(Personality)] = true;
+                Table.Order[Table.NumCandidates++] = Personality;
+            }
+        }
+        for (int32 Index = 0; Index < PathPersonalityTables::NumPersonalities; Index++)
+        {
+            if (!bInTable[Index] && Rules->PersonalityWeights[Index] > 0.0f)
+            {
+                Table.Order[Table.NumCandidates++] = static_cast<EPathPersonality>(Index);
+            }
+        }
+        
+        for (int32 Side = 0; Side < 2; Side++)
+        {
+            const bool bIsLeftPath = Side == 1;
+            const float BiasMultiplier = bIsLeftPath ? Rules->LeftPathBias : Rules->RightPathBias;
+            
+            for (int32 Candidate = 0; Candidate < Table.NumCandidates; Candidate++)
+            {
+                const int32 Index = PathPersonalityTables::ToIndex(Table.Order[Candidate]);
+                
+                // Wild, Challenge and Mystery favor left paths; the rest favor right paths
+                const float SideFactor = PersonalityFavorsLeftPath[Index]
+                    ? (bIsLeftPath ? (1.0f + BiasMultiplier) : (1.0f - BiasMultiplier * 0.5f))
+                    : (bIsLeftPath ? (1.0f - BiasMultiplier * 0.5f) : (1.0f + BiasMultiplier));
+                
+                Table.SideWeights[Side][Candidate] = Rules->PersonalityWeights[Index] * SideFactor * BiomeContextMultipliers[BiomeIndex][Index];
+            }
+        }
+        
+        bSelectionTableValid[BiomeIndex] = true;
+    }
 }
 
 void UPathPersonalitySystem::InitializePersonalityCharacteristics()
@@ -617,6 +704,22 @@ void UPathPersonalitySystem::InitializePersonalityCharacteristics()
     DefaultPathCharacteristics.Add(EPathPersonality::Peaceful, PeacefulCharacteristics);
 }
 
+void UPathPersonalitySystem::RebuildCharacteristicTables()
+{
+    // Include the None entries so out-of-rule personalities and biomes resolve like GeneratePathCharacteristics
+    for (int32 PersonalityIndex = 0; PersonalityIndex <= PathPersonalityTables::NumPersonalities; PersonalityIndex++)
+    {
+        for (int32 BiomeIndex = 0; BiomeIndex <= BiomeTables::NumBiomes; BiomeIndex++)
+        {
+            const EPathPersonality Personality = static_cast<EPathPersonality>(PersonalityIndex);
+            const EBiomeType BiomeType = static_cast<EBiomeType>(BiomeIndex);
+            
+            BaseLeftChallengeFactors[PersonalityIndex][BiomeIndex] = GenerateBaseCharacteristics(Personality, BiomeType, true).DifficultyLevel;
+            BaseRightSceneryFactors[PersonalityIndex][BiomeIndex] = GenerateBaseCharacteristics(Personality, BiomeType, false).SceneryRating;
+        }
+    }
+}
+
 void UPathPersonalitySystem::InitializeVisualHints()
 {
     // Initialize base visual hint configurations for each personality
@@ -638,34 +741,22 @@ void UPathPersonalitySystem::InitializeVisualHints()
     }
 }
 
-TMap<EPathPersonality, float> UPathPersonalitySystem::CalculatePersonalityWeights(EBiomeType BiomeType, const FPlayerChoiceHistory& PlayerHistory)
+int32 UPathPersonalitySystem::CalculatePersonalityWeights(EBiomeType BiomeType, bool bIsLeftPath, const FPlayerChoiceHistory& PlayerHistory, float OutWeights[PathPersonalityTables::NumPersonalities]) const
 {
-    TMap<EPathPersonality, float> Weights;
-    
-    // Get base weights from biome rules
-    FPathGenerationRules* Rules = BiomeGenerationRules.Find(BiomeType);
-    if (Rules)
-    {
-        Weights = Rules->PersonalityWeights;
-    }
-    else
+    if (!BiomeTables::IsValidBiome(BiomeType) || !bSelectionTableValid[static_cast<int32>(BiomeType)])
     {
-        // Default weights
-        Weights.Add(EPathPersonality::Peaceful, 1.0f);
-        Weights.Add(EPathPersonality::Scenic, 1.0f);
+        return 0;
     }
     
-    // Apply player preference adjustments
-    for (const auto& PrefPair : PlayerHistory.PersonalityPreferences)
+    // Biome weights, side bias and biome context are already folded together; apply player preferences
+    const FPersonalitySelectionTable& Table = SelectionTables[static_cast<int32>(BiomeType)];
+    const float* SideWeights = Table.SideWeights[bIsLeftPath ? 1 : 0];
+    for (int32 Candidate = 0; Candidate < Table.NumCandidates; Candidate++)
     {
-        float* Weight = Weights.Find(PrefPair.Key);
-        if (Weight)
-        {
-            *Weight *= (1.0f + PrefPair.Value);
-        }
+        OutWeights[Candidate] = SideWeights[Candidate] * (1.0f + PlayerHistory.PersonalityPreferences[PathPersonalityTables::ToIndex(Table.Order[Candidate])]);
     }
     
-    return Weights;
+    return Table.NumCandidates;
 }
 
 void UPathPersonalitySystem::ApplyBiomeModifiers(FPathCharacteristics& Characteristics, EBiomeType BiomeType)
@@ -9,6 +9,26 @@ class UNiagaraSystem;
 class UStaticMesh;
 class UMaterialInterface;
 
+/**
+ * Dense indexing helpers for per-personality data.
+ * Weights and preferences are stored in fixed arrays indexed by EPathPersonality
+ * rather than TMaps, so evaluating an intersection never hashes or allocates.
+ */
+namespace PathPersonalityTables
+{
+    constexpr int32 NumPersonalities = static_cast<int32>(EPathPersonality::None);
+
+    constexpr bool IsValidPersonality(EPathPersonality Personality)
+    {
+        return static_cast<uint8>(Personality) < NumPersonalities;
+    }
+
+    constexpr int32 ToIndex(EPathPersonality Personality)
+    {
+        return static_cast<int32>(Personality);
+    }
+}
+
 /**
  * Detailed path characteristics for generation
  */
@@ -147,6 +167,79 @@ struct BIKEADVENTURE_API FPathVisualHints
     TMap<EPathPersonality, TSoftObjectPtr<USoundCue>> PersonalityAudioCues;
 };
 
+/**
+ * One intersection to evaluate in a batched path hint request
+ */
+USTRUCT(BlueprintType)
+struct BIKEADVENTURE_API FPathHintRequest
+{
+    GENERATED_BODY()
+
+    FPathHintRequest()
+    {
+        SectionCoordinates = FIntVector::ZeroValue;
+        CurrentBiome = EBiomeType::None;
+        LeftPathBiome = EBiomeType::None;
+        RightPathBiome = EBiomeType::None;
+    }
+
+    // Section that owns the intersection
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Hints")
+    FIntVector SectionCoordinates;
+
+    // Biome the intersection sits in
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Hints")
+    EBiomeType CurrentBiome;
+
+    // Biome reached by taking the left path
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Hints")
+    EBiomeType LeftPathBiome;
+
+    // Biome reached by taking the right path
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Hints")
+    EBiomeType RightPathBiome;
+};
+
+/**
+ * Compact per-intersection result of a batched path hint request.
+ * Holds the same values GeneratePathHintsForIntersection fills into FPathHints,
+ * without the visual hint arrays.
+ */
+USTRUCT(BlueprintType)
+struct BIKEADVENTURE_API FCompactPathHints
+{
+    GENERATED_BODY()
+
+    FCompactPathHints()
+    {
+        SectionCoordinates = FIntVector::ZeroValue;
+        LeftPathPersonality = EPathPersonality::None;
+        RightPathPersonality = EPathPersonality::None;
+        LeftPathChallengeFactor = 0.0f;
+        RightPathSceneryFactor = 0.0f;
+        HintSubtlety = 0.0f;
+    }
+
+    // Section that owns the intersection
+    UPROPERTY(BlueprintReadOnly, Category = "Path Hints")
+    FIntVector SectionCoordinates;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Path Hints")
+    EPathPersonality LeftPathPersonality;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Path Hints")
+    EPathPersonality RightPathPersonality;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Path Hints")
+    float LeftPathChallengeFactor;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Path Hints")
+    float RightPathSceneryFactor;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Path Hints")
+    float HintSubtlety;
+};
+
 /**
  * Path generation rules based on biome and context
  */
@@ -165,6 +258,27 @@ struct BIKEADVENTURE_API FPathGenerationRules
         bAllowPersonalityOverride = true;
         MinimumHintSubtlety = 0.2f;
         MaximumHintSubtlety = 0.9f;
+
+        for (int32 Index = 0; Index < PathPersonalityTables::NumPersonalities; Index++)
+        {
+            PersonalityWeights[Index] = 0.0f;
+        }
+    }
+
+    /** Weight for a personality, 0 when the personality is not used in this biome */
+    float GetPersonalityWeight(EPathPersonality Personality) const
+    {
+        return PathPersonalityTables::IsValidPersonality(Personality) ? PersonalityWeights[PathPersonalityTables::ToIndex(Personality)] : 0.0f;
+    }
+
+    /** Set a personality weight and append it to AllowedPersonalities if new */
+    void SetPersonalityWeight(EPathPersonality Personality, float Weight)
+    {
+        if (PathPersonalityTables::IsValidPersonality(Personality))
+        {
+            PersonalityWeights[PathPersonalityTables::ToIndex(Personality)] = Weight;
+            AllowedPersonalities.AddUnique(Personality);
+        }
     }
 
     // Biome context for path generation
@@ -207,23 +321,29 @@ struct BIKEADVENTURE_API FPathGenerationRules
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default Characteristics")
     FPathCharacteristics DefaultRightPathCharacteristics;
 
-    // Allowed personalities for paths in this biome
+    // Allowed personalities for paths in this biome, in weighted-selection order
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Allowed Personalities")
     TArray<EPathPersonality> AllowedPersonalities;
 
-    // Probability weights for each personality type
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Personality Weights")
-    TMap<EPathPersonality, float> PersonalityWeights;
+    // Probability weights for each personality type, indexed by EPathPersonality
+    UPROPERTY(EditAnywhere, Category = "Personality Weights")
+    float PersonalityWeights[PathPersonalityTables::NumPersonalities];
 };
 
 /**
- * Player choice history for adaptive path generation
+ * Player choice history for adaptive path generation.
+ * Lifetime totals plus a fixed-capacity ring of the most recent choices, packed one bit per
+ * side and one nibble per biome and personality. The window's left count and the current streak
+ * are kept up to date as choices are pushed, so both are O(1) to read.
  */
 USTRUCT(BlueprintType)
 struct BIKEADVENTURE_API FPlayerChoiceHistory
 {
     GENERATED_BODY()
 
+    /** Choices held in the recent window; one nibble each fills a uint64 */
+    static constexpr int32 RecentCapacity = 16;
+
     FPlayerChoiceHistory()
     {
         TotalChoices = 0;
@@ -231,8 +351,76 @@ struct BIKEADVENTURE_API FPlayerChoiceHistory
         RightChoices = 0;
         PreferredPersonality = EPathPersonality::None;
         AdaptiveWeight = 0.5f;
+
+        for (int32 Index = 0; Index < PathPersonalityTables::NumPersonalities; Index++)
+        {
+            PersonalityPreferences[Index] = 0.0f;
+        }
+    }
+
+    /** Preference score for a personality, 0 when it has never been chosen */
+    float GetPersonalityPreference(EPathPersonality Personality) const
+    {
+        return PathPersonalityTables::IsValidPersonality(Personality) ? PersonalityPreferences[PathPersonalityTables::ToIndex(Personality)] : 0.0f;
+    }
+
+    /**
+     * Push a choice into the recent window, evicting the oldest once it is full, and extend or
+     * restart the streak. Lifetime totals are left to the caller.
+     */
+    void PushRecent(bool bChoseLeft, EBiomeType Biome, EPathPersonality Personality)
+    {
+        const uint64 Shift = static_cast<uint64>(RecentHead) * 4;
+        if (RecentCount == RecentCapacity)
+        {
+            RecentLeftCount -= static_cast<uint8>((RecentLeftBits >> RecentHead) & 1);
+        }
+        else
+        {
+            RecentCount++;
+        }
+
+        RecentLeftBits = static_cast<uint16>((RecentLeftBits & ~(1u << RecentHead)) | (static_cast<uint32>(bChoseLeft) << RecentHead));
+        RecentBiomeNibbles = (RecentBiomeNibbles & ~(0xFull << Shift)) | ((static_cast<uint64>(Biome) & 0xF) << Shift);
+        RecentPersonalityNibbles = (RecentPersonalityNibbles & ~(0xFull << Shift)) | ((static_cast<uint64>(Personality) & 0xF) << Shift);
+        RecentLeftCount += static_cast<uint8>(bChoseLeft);
+        RecentHead = static_cast<uint8>((RecentHead + 1) % RecentCapacity);
+
+        StreakLength = (StreakLength > 0 && bStreakLeft == bChoseLeft) ? StreakLength + 1 : 1;
+        bStreakLeft = bChoseLeft;
+    }
+
+    /** Choices currently in the recent window */
+    int32 GetNumRecent() const { return RecentCount; }
+
+    /** Side of a recent choice, StepsBack 0 being the latest; StepsBack must be below GetNumRecent */
+    bool GetRecentChoice(int32 StepsBack) const { return ((RecentLeftBits >> GetRecentSlot(StepsBack)) & 1) != 0; }
+
+    EBiomeType GetRecentBiome(int32 StepsBack) const
+    {
+        return static_cast<EBiomeType>((RecentBiomeNibbles >> (GetRecentSlot(StepsBack) * 4)) & 0xF);
     }
 
+    EPathPersonality GetRecentPersonality(int32 StepsBack) const
+    {
+        return static_cast<EPathPersonality>((RecentPersonalityNibbles >> (GetRecentSlot(StepsBack) * 4)) & 0xF);
+    }
+
+    /** Biome of the latest choice, None before the first */
+    EBiomeType GetLastBiome() const { return RecentCount > 0 ? GetRecentBiome(0) : EBiomeType::None; }
+
+    /** Share of left choices over the whole run, 0.5 before the first */
+    float GetLeftRatio() const { return TotalChoices > 0 ? static_cast<float>(LeftChoices) / TotalChoices : 0.5f; }
+
+    /** Share of left choices in the recent window, 0.5 while it is empty */
+    float GetRecentLeftRatio() const { return RecentCount > 0 ? static_cast<float>(RecentLeftCount) / RecentCount : 0.5f; }
+
+    /** Consecutive choices of the same side ending with the latest, which may reach back past the window */
+    int32 GetStreakLength() const { return StreakLength; }
+
+    /** Side of the current streak; meaningless while GetStreakLength is 0 */
+    bool IsStreakLeft() const { return bStreakLeft; }
+
     // Total number of choices made
     UPROPERTY(BlueprintReadOnly, Category = "Choice Statistics")
     int32 TotalChoices;
@@ -245,18 +433,6 @@ struct BIKEADVENTURE_API FPlayerChoiceHistory
     UPROPERTY(BlueprintReadOnly, Category = "Choice Statistics")
     int32 RightChoices;
 
-    // Recent choice history (last 10 choices)
-    UPROPERTY(BlueprintReadOnly, Category = "Recent History")
-    TArray<bool> RecentChoices; // true = left, false = right
-
-    // Recent biome history
-    UPROPERTY(BlueprintReadOnly, Category = "Recent History")
-    TArray<EBiomeType> RecentBiomes;
-
-    // Recent personality choices
-    UPROPERTY(BlueprintReadOnly, Category = "Recent History")
-    TArray<EPathPersonality> RecentPersonalities;
-
     // Player's apparent preferred personality
     UPROPERTY(BlueprintReadOnly, Category = "Player Profile")
     EPathPersonality PreferredPersonality;
@@ -265,9 +441,27 @@ struct BIKEADVENTURE_API FPlayerChoiceHistory
     UPROPERTY(BlueprintReadOnly, Category = "Player Profile")
     float AdaptiveWeight;
 
-    // Personality preference scores
-    UPROPERTY(BlueprintReadOnly, Category = "Player Profile")
-    TMap<EPathPersonality, float> PersonalityPreferences;
+    // Personality preference scores, indexed by EPathPersonality
+    UPROPERTY(VisibleAnywhere, Category = "Player Profile")
+    float PersonalityPreferences[PathPersonalityTables::NumPersonalities];
+
+private:
+    int32 GetRecentSlot(int32 StepsBack) const
+    {
+        check(StepsBack >= 0 && StepsBack < RecentCount);
+        return (RecentHead + RecentCapacity - 1 - StepsBack) % RecentCapacity;
+    }
+
+    // Recent window ring, slot i holding bit i and nibble i; RecentHead is the next slot written
+    uint64 RecentBiomeNibbles = 0;
+    uint64 RecentPersonalityNibbles = 0;
+    uint16 RecentLeftBits = 0;
+    uint8 RecentHead = 0;
+    uint8 RecentCount = 0;
+    uint8 RecentLeftCount = 0;
+
+    int32 StreakLength = 0;
+    bool bStreakLeft = false;
 };
 
 /**
@@ -293,6 +487,15 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Path Personality")
     FPathHints GeneratePathHintsForIntersection(EBiomeType CurrentBiome, EBiomeType LeftPathBiome, EBiomeType RightPathBiome, const FPlayerChoiceHistory& PlayerHistory);
 
+    /**
+     * Generate compact path hints for many intersections at once, e.g. every intersection
+     * in a newly streamed ring of sections. Produces the same personalities and factors as
+     * calling GeneratePathHintsForIntersection for each request in order, but shares rule
+     * lookups across the batch and fires a single OnPathHintsBatchGeneratedEvent.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Path Personality")
+    void GeneratePathHintsForIntersections(const TArray<FPathHintRequest>& Requests, const FPlayerChoiceHistory& PlayerHistory, TArray<FCompactPathHints>& OutHints);
+
     /**
      * Generate path characteristics based on personality and biome
      */
@@ -329,17 +532,39 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Path Personality")
     float CalculateHintSubtlety(EBiomeType BiomeType, const FPlayerChoiceHistory& PlayerHistory);
 
+    /**
+     * Get the player's preference score for a personality
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Path Personality")
+    static float GetPersonalityPreference(const FPlayerChoiceHistory& PlayerHistory, EPathPersonality Personality);
+
+    /**
+     * Replace the generation rules for a biome and rebuild its selection table
+     */
+    UFUNCTION(BlueprintCallable, Category = "Path Personality")
+    void SetBiomeGenerationRules(EBiomeType BiomeType, const FPathGenerationRules& Rules);
+
+    /**
+     * Replace the default characteristics for a personality and rebuild the compact hint factors
+     */
+    UFUNCTION(BlueprintCallable, Category = "Path Personality")
+    void SetDefaultPathCharacteristics(EPathPersonality Personality, const FPathCharacteristics& Characteristics);
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 protected:
-    // Default path generation rules for each biome
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation Rules")
+    // Default path generation rules for each biome; change through SetBiomeGenerationRules so the selection tables follow
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Generation Rules")
     TMap<EBiomeType, FPathGenerationRules> BiomeGenerationRules;
 
     // Visual hint configurations for each personality
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visual Configuration")
     TMap<EPathPersonality, FPathVisualHints> PersonalityVisualHints;
 
-    // Default path characteristics for each personality
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Path Characteristics")
+    // Default path characteristics for each personality; change through SetDefaultPathCharacteristics
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Path Characteristics")
     TMap<EPathPersonality, FPathCharacteristics> DefaultPathCharacteristics;
 
     // Random stream for consistent generation
@@ -347,6 +572,44 @@ protected:
     FRandomStream RandomStream;
 
 private:
+    /**
+     * Per-biome, per-side selection data derived from BiomeGenerationRules.
+     * Multipliers fold the rule weight, the side bias and the biome context
+     * together, so only the player preference is applied per evaluation.
+     */
+    struct FPersonalitySelectionTable
+    {
+        // Candidates in the order they are accumulated during weighted selection
+        EPathPersonality Order[PathPersonalityTables::NumPersonalities];
+        int32 NumCandidates = 0;
+
+        // Precomputed weight per candidate for [0] = right path, [1] = left path
+        float SideWeights[2][PathPersonalityTables::NumPersonalities];
+    };
+
+    // Selection tables for each biome, valid where bSelectionTableValid is set
+    FPersonalitySelectionTable SelectionTables[BiomeTables::NumBiomes];
+    bool bSelectionTableValid[BiomeTables::NumBiomes] = {};
+
+    /**
+     * Rebuild SelectionTables from BiomeGenerationRules
+     */
+    void RebuildSelectionTables();
+
+    // Pre-randomisation factors used by compact hints, indexed by [EPathPersonality][EBiomeType] including None
+    float BaseLeftChallengeFactors[PathPersonalityTables::NumPersonalities + 1][BiomeTables::NumBiomes + 1] = {};
+    float BaseRightSceneryFactors[PathPersonalityTables::NumPersonalities + 1][BiomeTables::NumBiomes + 1] = {};
+
+    /**
+     * Rebuild the compact hint factor tables from DefaultPathCharacteristics
+     */
+    void RebuildCharacteristicTables();
+
+    /**
+     * Path characteristics before the per-path random variation is applied
+     */
+    FPathCharacteristics GenerateBaseCharacteristics(EPathPersonality Personality, EBiomeType BiomeType, bool bIsLeftPath);
+
     /**
      * Initialize default biome generation rules
      */
@@ -364,8 +627,10 @@ private:
 
     /**
      * Calculate personality weights based on player history
+     * @param OutWeights Receives one weight per candidate in selection order
+     * @return Number of candidates written, 0 if the biome has no rules
      */
-    TMap<EPathPersonality, float> CalculatePersonalityWeights(EBiomeType BiomeType, const FPlayerChoiceHistory& PlayerHistory);
+    int32 CalculatePersonalityWeights(EBiomeType BiomeType, bool bIsLeftPath, const FPlayerChoiceHistory& PlayerHistory, float OutWeights[PathPersonalityTables::NumPersonalities]) const;
 
     /**
      * Apply biome-specific modifiers to path characteristics
@@ -381,10 +646,14 @@ public:
     // Delegates for path personality events
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnPathPersonalityGenerated, EPathPersonality, LeftPersonality, EPathPersonality, RightPersonality, float, HintSubtlety);
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPlayerPatternDetected, EPathPersonality, DetectedPreference, float, Confidence);
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPathHintsBatchGenerated, const TArray<FCompactPathHints>&, Hints);
     
     UPROPERTY(BlueprintAssignable, Category = "Path Events")
     FOnPathPersonalityGenerated OnPathPersonalityGeneratedEvent;
     
     UPROPERTY(BlueprintAssignable, Category = "Path Events")
     FOnPlayerPatternDetected OnPlayerPatternDetectedEvent;
+    
+    UPROPERTY(BlueprintAssignable, Category = "Path Events")
+    FOnPathHintsBatchGenerated OnPathHintsBatchGeneratedEvent;
 };
\ No newline at end of file
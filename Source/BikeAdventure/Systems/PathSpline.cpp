@@ -0,0 +1,157 @@
+#include "PathSpline.h"
+#include "Math/InterpCurve.h"
+
+namespace
+{
+    // Dense polyline resolution used to measure arc length while building the table
+    constexpr int32 SubdivisionsPerSegment = 32;
+}
+
+void FPathSpline::Build(TArrayView<const FVector> ControlPoints, float InSampleSpacing)
+{
+    Locations.Reset();
+    Directions.Reset();
+    Length = 0.0f;
+    SampleSpacing = FMath::Max(InSampleSpacing, 1.0f);
+
+    if (ControlPoints.Num() < 2)
+    {
+        return;
+    }
+
+    FInterpCurveVector Curve;
+    for (int32 i = 0; i < ControlPoints.Num(); i++)
+    {
+        const int32 PointIndex = Curve.AddPoint(static_cast<float>(i), ControlPoints[i]);
+        Curve.Points[PointIndex].InterpMode = CIM_CurveAuto;
+    }
+    Curve.AutoSetTangents(0.0f, false);
+
+    // Measure the curve as a dense polyline of (parameter, cumulative length) pairs
+    const int32 DenseCount = (ControlPoints.Num() - 1) * SubdivisionsPerSegment + 1;
+    TArray<float> DenseParams;
+    TArray<float> DenseLengths;
+    DenseParams.Reserve(DenseCount);
+    DenseLengths.Reserve(DenseCount);
+
+    FVector PreviousLocation = ControlPoints[0];
+    for (int32 i = 0; i < DenseCount; i++)
+    {
+        const float Param = static_cast<float>(i) / SubdivisionsPerSegment;
+        const FVector Location = Curve.Eval(Param, FVector::ZeroVector);
+        Length += FVector::Dist(PreviousLocation, Location);
+        PreviousLocation = Location;
+
+        DenseParams.Add(Param);
+        DenseLengths.Add(Length);
+    }
+
+    if (Length <= KINDA_SMALL_NUMBER)
+    {
+        Length = 0.0f;
+        return;
+    }
+
+    // Resample at even arc-length steps, walking the dense polyline once
+    const int32 SampleCount = FMath::CeilToInt(Length / SampleSpacing) + 1;
+    Locations.Reserve(SampleCount);
+    Directions.Reserve(SampleCount);
+
+    int32 DenseIndex = 0;
+    for (int32 i = 0; i < SampleCount; i++)
+    {
+        const float Distance = FMath::Min(i * SampleSpacing, Length);
+        while (DenseIndex < DenseCount - 2 && DenseLengths[DenseIndex + 1] < Distance)
+        {
+            DenseIndex++;
+        }
+
+        const float SpanLength = DenseLengths[DenseIndex + 1] - DenseLengths[DenseIndex];
+        const float Alpha = SpanLength > KINDA_SMALL_NUMBER ? FMath::Clamp((Distance - DenseLengths[DenseIndex]) / SpanLength, 0.0f, 1.0f) : 0.0f;
+        const float Param = FMath::Lerp(DenseParams[DenseIndex], DenseParams[DenseIndex + 1], Alpha);
+
+        Locations.Add(Curve.Eval(Param, FVector::ZeroVector));
+
+        FVector Direction = Curve.EvalDerivative(Param, FVector::ZeroVector).GetSafeNormal();
+        if (Direction.IsNearlyZero())
+        {
+            Direction = (Curve.Eval(DenseParams[DenseIndex + 1], FVector::ZeroVector) - Curve.Eval(DenseParams[DenseIndex], FVector::ZeroVector)).GetSafeNormal();
+        }
+        Directions.Add(Direction);
+    }
+}
+
+void FPathSpline::LocateSample(float Distance, int32& OutIndex, float& OutAlpha) const
+{
+    const float Clamped = FMath::Clamp(Distance, 0.0f, Length);
+    OutIndex = FMath::Min(FMath::FloorToInt(Clamped / SampleSpacing), Locations.Num() - 2);
+
+    const float SpanStart = OutIndex * SampleSpacing;
+    const float SpanLength = FMath::Min(SampleSpacing, Length - SpanStart);
+    OutAlpha = SpanLength > KINDA_SMALL_NUMBER ? FMath::Clamp((Clamped - SpanStart) / SpanLength, 0.0f, 1.0f) : 0.0f;
+}
+
+FVector FPathSpline::GetLocationAtDistance(float Distance) const
+{
+    if (!IsValid())
+    {
+        return Locations.Num() > 0 ? Locations[0] : FVector::ZeroVector;
+    }
+
+    int32 Index;
+    float Alpha;
+    LocateSample(Distance, Index, Alpha);
+    return FMath::Lerp(Locations[Index], Locations[Index + 1], Alpha);
+}
+
+FVector FPathSpline::GetDirectionAtDistance(float Distance) const
+{
+    if (!IsValid())
+    {
+        return FVector::ForwardVector;
+    }
+
+    int32 Index;
+    float Alpha;
+    LocateSample(Distance, Index, Alpha);
+    const FVector Direction = FMath::Lerp(Directions[Index], Directions[Index + 1], Alpha).GetSafeNormal();
+    return Direction.IsNearlyZero() ? Directions[Index] : Direction;
+}
+
+float FPathSpline::FindNearestDistance(const FVector& Location, float HintDistance, float SearchRadius) const
+{
+    if (!IsValid())
+    {
+        return 0.0f;
+    }
+
+    int32 FirstSpan = 0;
+    int32 LastSpan = Locations.Num() - 2;
+    if (HintDistance >= 0.0f)
+    {
+        FirstSpan = FMath::Clamp(FMath::FloorToInt((HintDistance - SearchRadius) / SampleSpacing), 0, LastSpan);
+        LastSpan = FMath::Clamp(FMath::FloorToInt((HintDistance + SearchRadius) / SampleSpacing), FirstSpan, LastSpan);
+    }
+
+    const FVector2D Point(Location.X, Location.Y);
+    float BestDistanceSquared = TNumericLimits<float>::Max();
+    float BestDistance = 0.0f;
+
+    for (int32 Span = FirstSpan; Span <= LastSpan; Span++)
+    {
+        const FVector2D SpanStart(Locations[Span].X, Locations[Span].Y);
+        const FVector2D SpanEnd(Locations[Span + 1].X, Locations[Span + 1].Y);
+        const FVector2D SpanVector = SpanEnd - SpanStart;
+        const float SpanLengthSquared = SpanVector.SizeSquared();
+        const float Alpha = SpanLengthSquared > KINDA_SMALL_NUMBER ? FMath::Clamp(FVector2D::DotProduct(Point - SpanStart, SpanVector) / SpanLengthSquared, 0.0f, 1.0f) : 0.0f;
+
+        const float DistanceSquared = FVector2D::DistSquared(Point, SpanStart + SpanVector * Alpha);
+        if (DistanceSquared < BestDistanceSquared)
+        {
+            BestDistanceSquared = DistanceSquared;
+            BestDistance = FMath::Min(Span * SampleSpacing + Alpha * FMath::Min(SampleSpacing, Length - Span * SampleSpacing), Length);
+        }
+    }
+
+    return BestDistance;
+}
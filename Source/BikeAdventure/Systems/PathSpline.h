@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Path spline through a section's control points, reparameterised by arc length.
+ * Build samples the curve once into a table of evenly spaced locations, so every distance
+ * lookup afterwards is an index plus a lerp. Distances passed to the lookups are local to
+ * this spline; StartDistance places it in the shared distance-along-path coordinate used by
+ * movement and by anything placed along the path.
+ */
+struct BIKEADVENTURE_API FPathSpline
+{
+    /**
+     * Fit a curve through the control points and precompute the arc-length table
+     * @param ControlPoints - At least two points in travel order
+     * @param InSampleSpacing - Distance between table entries; lookups lerp between them
+     */
+    void Build(TArrayView<const FVector> ControlPoints, float InSampleSpacing = 100.0f);
+
+    /** Whether Build produced a usable table */
+    bool IsValid() const { return Locations.Num() >= 2; }
+
+    /** Arc length of the whole spline */
+    float GetLength() const { return Length; }
+
+    float GetSampleSpacing() const { return SampleSpacing; }
+
+    /** Location at a local distance along the spline, clamped to its ends */
+    FVector GetLocationAtDistance(float Distance) const;
+
+    /** Unit travel direction at a local distance along the spline, clamped to its ends */
+    FVector GetDirectionAtDistance(float Distance) const;
+
+    /**
+     * Local distance of the point on the spline horizontally closest to a location
+     * @param HintDistance - Previous answer to search around, or negative to search the whole spline
+     * @param SearchRadius - Distance either side of the hint to search
+     */
+    float FindNearestDistance(const FVector& Location, float HintDistance = -1.0f, float SearchRadius = 1000.0f) const;
+
+    /** Convert between local distance and the shared distance-along-path coordinate */
+    float ToPathDistance(float LocalDistance) const { return StartDistance + LocalDistance; }
+    float ToLocalDistance(float PathDistance) const { return PathDistance - StartDistance; }
+
+    /** Whether a shared path distance falls on this spline */
+    bool ContainsPathDistance(float PathDistance) const { return PathDistance >= StartDistance && PathDistance <= StartDistance + Length; }
+
+    /** Offset of this spline's start in the shared distance-along-path coordinate */
+    float StartDistance = 0.0f;
+
+private:
+    /** Table entry before a distance and the fraction towards the next one */
+    void LocateSample(float Distance, int32& OutIndex, float& OutAlpha) const;
+
+    // Evenly spaced by arc length; the final entry sits at the spline end and may be closer
+    TArray<FVector> Locations;
+    TArray<FVector> Directions;
+
+    float Length = 0.0f;
+    float SampleSpacing = 100.0f;
+};
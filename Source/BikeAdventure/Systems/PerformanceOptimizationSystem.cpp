@@ -1,4 +1,5 @@
 #include "PerformanceOptimizationSystem.h"
+#include "PathHintMaterialCache.h"
 #include "Components/StaticMeshComponent.h"
 #include "NiagaraComponent.h"
 #include "PCGActor.h"
@@ -224,6 +225,11 @@ void UPerformanceOptimizationSystem::UpdatePerformanceMetrics()
     CleanupTrackedObjects(); // Clean up first to get accurate counts
     CurrentMetrics.VisibleObjects = TrackedMeshComponents.Num();
     CurrentMetrics.ActiveParticleSystems = TrackedParticleSystems.Num();
+
+    if (const UPathHintMaterialCache* HintMaterialCache = GetWorld()->GetSubsystem<UPathHintMaterialCache>())
+    {
+        CurrentMetrics.PathHintMaterialInstances = HintMaterialCache->GetInstanceCount();
+    }
     
     // Estimate draw calls (simplified)
     CurrentMetrics.DrawCalls = CurrentMetrics.VisibleObjects + CurrentMetrics.ActiveParticleSystems;
@@ -82,6 +82,7 @@ struct BIKEADVENTURE_API FPerformanceMetrics
         DrawCalls = 0;
         VisibleObjects = 0;
         ActiveParticleSystems = 0;
+        PathHintMaterialInstances = 0;
         StreamingSectionsLoaded = 0;
         LODLevel = 0;
         bWithinPerformanceTarget = true;
@@ -109,6 +110,10 @@ struct BIKEADVENTURE_API FPerformanceMetrics
     UPROPERTY(BlueprintReadOnly, Category = "Effects")
     int32 ActiveParticleSystems;
 
+    // Shared path hint material instances alive (one per distinct hint state, not per intersection)
+    UPROPERTY(BlueprintReadOnly, Category = "Rendering")
+    int32 PathHintMaterialInstances;
+
     // Number of streaming sections currently loaded
     UPROPERTY(BlueprintReadOnly, Category = "Streaming")
     int32 StreamingSectionsLoaded;
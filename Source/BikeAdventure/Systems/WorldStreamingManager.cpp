@@ -1,5 +1,9 @@
 #include "WorldStreamingManager.h"
 #include "BiomeGenerator.h"
+#include "BikeTelemetry.h"
+#include "IntersectionAssetPrefetcher.h"
+#include "BiomeAssetPrefetcher.h"
+#include "../Core/BiomeTransitionSampler.h"
 #include "../Gameplay/Intersection.h"
 #include "Engine/World.h"
 #include "Engine/LevelStreamingDynamic.h"
@@ -14,7 +18,7 @@ void UWorldStreamingManager::Initialize(FSubsystemCollectionBase& Collection)
     // Initialize default settings
     MaxStreamingDistanceCm = 500000.0f; // 5km
     MaxActiveSections = 9; // 3x3 grid
-    SectionSizeCm = 200000.0f; // 2km per section
+    SectionSizeCm = DefaultSectionSizeCm; // 2km per section
     MaxMemoryBudgetKB = 4194304; // 4GB in KB
     UnloadTimeThreshold = 30.0f; // 30 seconds
     bEnablePredictiveLoading = true;
@@ -23,6 +27,9 @@ void UWorldStreamingManager::Initialize(FSubsystemCollectionBase& Collection)
     // Initialize performance metrics
     PerformanceMetrics = FStreamingPerformanceMetrics();
     LastPlayerPosition = FVector::ZeroVector;
+    NextPathStartDistance = 0.0f;
+    RiderHeading = FVector::ZeroVector;
+    RiderBiome = EBiomeType::None;
     
     // Get biome generator reference
     BiomeGenerator = NewObject<UBiomeGenerator>();
@@ -86,12 +93,13 @@ bool UWorldStreamingManager::StreamInBiomeSection(const FVector& PlayerLocation,
     FWorldSection NewSection = CreateWorldSection(SectionCoords, BiomeType);
     ActiveSections.Add(SectionCoords, NewSection);
     
+    // The path is data rather than level content, so it joins the ride graph straight away
+    BuildSectionPath(SectionCoords);
+    
     // Start async loading
     LoadSection(SectionCoords);
     
-    UE_LOG(LogTemp, Log, TEXT("Streaming in %s biome section at coordinates (%d, %d, %d)"), 
-           *UBiomeUtilities::GetBiomeName(BiomeType), 
-           SectionCoords.X, SectionCoords.Y, SectionCoords.Z);
+    FBikeTelemetry::Get().Record(EBikeTelemetryEvent::SectionStreamIn, SectionCoords, BiomeType);
     
     return true;
 }
@@ -159,6 +167,18 @@ void UWorldStreamingManager::UpdateStreamingForPlayer(const FVector& PlayerLocat
     {
         CurrentSection->LastAccessTime = GetWorld()->GetTimeSeconds();
         CurrentSection->bIsVisible = true;
+
+        // Entering a new biome moves the horizon of biomes whose meshes are kept resident
+        if (CurrentSection->BiomeType != RiderBiome && BiomeGenerator)
+        {
+            RiderBiome = CurrentSection->BiomeType;
+            BiomeGenerator->GetBiomeAssetPrefetcher()->UpdateForBiome(RiderBiome);
+        }
+    }
+    
+    if (!PlayerVelocity.IsNearlyZero())
+    {
+        RiderHeading = PlayerVelocity.GetSafeNormal2D();
     }
     
     // Get sections that should be loaded
@@ -186,6 +206,9 @@ void UWorldStreamingManager::UpdateStreamingForPlayer(const FVector& PlayerLocat
         }
     }
     
+    // Populate sections whose biome meshes have arrived since they were streamed in
+    GenerateWaitingSections();
+    
     // Update visibility and check for distant sections in a single pass
     TArray<FIntVector> SectionsToUnload;
     float CurrentTime = GetWorld()->GetTimeSeconds();
@@ -263,6 +286,61 @@ FStreamingPerformanceMetrics UWorldStreamingManager::GetPerformanceMetrics()
     return PerformanceMetrics;
 }
 
+bool UWorldStreamingManager::FindNextIntersectionAhead(const FVector& Location, AIntersection* IgnoredIntersection, AIntersection*& OutIntersection, float& OutPathDistance) const
+{
+    OutIntersection = nullptr;
+    OutPathDistance = TNumericLimits<float>::Max();
+
+    const FWorldSection* Section = ActiveSections.Find(WorldToSectionCoordinates(Location));
+    if (!Section || !Section->PathSpline.IsValid())
+    {
+        return false;
+    }
+
+    const float RiderPathDistance = Section->PathSpline->ToPathDistance(Section->PathSpline->FindNearestDistance(Location));
+
+    // Walk the ride graph forward; a section's intersection sits on its spline, so its distance is exact
+    for (int32 Visited = 0; Section && Visited < ActiveSections.Num(); Visited++)
+    {
+        if (Section->bHasIntersection && IsValid(Section->IntersectionActor) && Section->IntersectionActor != IgnoredIntersection)
+        {
+            const FPathSpline& Path = *Section->PathSpline;
+            const float IntersectionPathDistance = Path.ToPathDistance(Path.FindNearestDistance(Section->IntersectionActor->GetActorLocation()));
+            if (IntersectionPathDistance >= RiderPathDistance)
+            {
+                OutIntersection = Section->IntersectionActor;
+                OutPathDistance = IntersectionPathDistance;
+                return true;
+            }
+        }
+
+        const FWorldSection* NextSection = ActiveSections.Find(Section->PathExitSection);
+        Section = NextSection && NextSection->PathEntrySection == Section->SectionCoordinates && NextSection->PathSpline.IsValid() ? NextSection : nullptr;
+    }
+
+    return false;
+}
+
+TSharedPtr<const FPathSpline> UWorldStreamingManager::FindPathSplineAt(const FVector& Location) const
+{
+    const FWorldSection* Section = ActiveSections.Find(WorldToSectionCoordinates(Location));
+    return Section ? Section->PathSpline : nullptr;
+}
+
+TSharedPtr<const FPathSpline> UWorldStreamingManager::FindNextPathSpline(const FPathSpline& Path) const
+{
+    for (const auto& SectionPair : ActiveSections)
+    {
+        if (SectionPair.Value.PathSpline.Get() == &Path)
+        {
+            const FWorldSection* NextSection = ActiveSections.Find(SectionPair.Value.PathExitSection);
+            return NextSection && NextSection->PathEntrySection == SectionPair.Key ? NextSection->PathSpline : nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
 void UWorldStreamingManager::PreloadSections(const FVector& PlayerLocation, const FVector& MovementDirection, int32 PreloadDistance)
 {
     if (MovementDirection.IsZero())
@@ -311,7 +389,7 @@ bool UWorldStreamingManager::IsWithinMemoryBudget()
     return GetTotalMemoryUsageKB() < MaxMemoryBudgetKB;
 }
 
-FIntVector UWorldStreamingManager::WorldToSectionCoordinates(const FVector& WorldLocation)
+FIntVector UWorldStreamingManager::WorldToSectionCoordinates(const FVector& WorldLocation) const
 {
     return FIntVector(
         FMath::FloorToInt(WorldLocation.X / SectionSizeCm),
@@ -320,7 +398,7 @@ FIntVector UWorldStreamingManager::WorldToSectionCoordinates(const FVector& Worl
     );
 }
 
-FVector UWorldStreamingManager::SectionCoordinatesToWorld(const FIntVector& SectionCoordinates)
+FVector UWorldStreamingManager::SectionCoordinatesToWorld(const FIntVector& SectionCoordinates) const
 {
     return FVector(
         SectionCoordinates.X * SectionSizeCm + (SectionSizeCm * 0.5f),
@@ -329,6 +407,89 @@ FVector UWorldStreamingManager::SectionCoordinatesToWorld(const FIntVector& Sect
     );
 }
 
+FVector UWorldStreamingManager::GetPathCrossingPoint(const FIntVector& SectionA, const FIntVector& SectionB) const
+{
+    // Order the pair so both sections hash it the same way
+    const bool bAFirst = SectionA.X != SectionB.X ? SectionA.X < SectionB.X : (SectionA.Y != SectionB.Y ? SectionA.Y < SectionB.Y : SectionA.Z < SectionB.Z);
+    const FIntVector& First = bAFirst ? SectionA : SectionB;
+    const FIntVector& Second = bAFirst ? SectionB : SectionA;
+
+    // Somewhere along the middle half of the shared edge
+    const FIntVector Step = Second - First;
+    const FVector EdgeDirection(FMath::Abs(Step.Y), FMath::Abs(Step.X), 0.0f);
+    FRandomStream CrossingStream(HashCombine(GetTypeHash(First), GetTypeHash(Second)));
+    const float Offset = CrossingStream.FRandRange(-0.25f, 0.25f) * SectionSizeCm;
+
+    return (SectionCoordinatesToWorld(First) + SectionCoordinatesToWorld(Second)) * 0.5f + EdgeDirection * Offset;
+}
+
+void UWorldStreamingManager::BuildSectionPath(const FIntVector& SectionCoordinates)
+{
+    FWorldSection* Section = ActiveSections.Find(SectionCoordinates);
+    if (!Section || !BiomeGenerator)
+    {
+        return;
+    }
+
+    // Continue a neighbour's path that leaves into this section, or lead into one that enters from it
+    static const FIntVector NeighbourSteps[] = { FIntVector(1, 0, 0), FIntVector(-1, 0, 0), FIntVector(0, 1, 0), FIntVector(0, -1, 0) };
+    const FWorldSection* PreviousSection = nullptr;
+    const FWorldSection* NextSection = nullptr;
+    for (const FIntVector& Step : NeighbourSteps)
+    {
+        const FWorldSection* Neighbour = ActiveSections.Find(SectionCoordinates + Step);
+        if (!Neighbour || !Neighbour->PathSpline.IsValid())
+        {
+            continue;
+        }
+
+        if (!PreviousSection && Neighbour->PathExitSection == SectionCoordinates)
+        {
+            PreviousSection = Neighbour;
+        }
+        else if (!NextSection && Neighbour->PathEntrySection == SectionCoordinates)
+        {
+            NextSection = Neighbour;
+        }
+    }
+
+    // Paths run straight through a section; a section with no linked neighbour starts a chain along the rider's heading
+    FIntVector Travel;
+    if (PreviousSection)
+    {
+        Travel = SectionCoordinates - PreviousSection->SectionCoordinates;
+    }
+    else if (NextSection)
+    {
+        Travel = NextSection->SectionCoordinates - SectionCoordinates;
+    }
+    else
+    {
+        const FVector Heading = RiderHeading.IsNearlyZero() ? Section->WorldPosition - LastPlayerPosition : RiderHeading;
+        Travel = FMath::Abs(Heading.X) >= FMath::Abs(Heading.Y) ? FIntVector(Heading.X >= 0.0f ? 1 : -1, 0, 0) : FIntVector(0, Heading.Y >= 0.0f ? 1 : -1, 0);
+    }
+
+    Section->PathEntrySection = SectionCoordinates - Travel;
+    Section->PathExitSection = SectionCoordinates + Travel;
+
+    // Distance runs on from the previous section, ends where the next begins, or opens a fresh range
+    const float StartDistance = PreviousSection ? PreviousSection->PathSpline->ToPathDistance(PreviousSection->PathSpline->GetLength()) : NextPathStartDistance;
+    TSharedRef<FPathSpline> PathSpline = MakeShared<FPathSpline>(BiomeGenerator->GeneratePathSpline(
+        Section->WorldPosition,
+        GetPathCrossingPoint(Section->PathEntrySection, SectionCoordinates),
+        GetPathCrossingPoint(SectionCoordinates, Section->PathExitSection),
+        Section->BiomeType,
+        StartDistance));
+
+    if (!PreviousSection && NextSection)
+    {
+        PathSpline->StartDistance = NextSection->PathSpline->StartDistance - PathSpline->GetLength();
+    }
+
+    NextPathStartDistance = FMath::Max(NextPathStartDistance, PathSpline->ToPathDistance(PathSpline->GetLength()));
+    Section->PathSpline = PathSpline;
+}
+
 FWorldSection UWorldStreamingManager::CreateWorldSection(const FIntVector& SectionCoordinates, EBiomeType BiomeType)
 {
     FWorldSection NewSection;
@@ -361,7 +522,7 @@ void UWorldStreamingManager::LoadSection(const FIntVector& SectionCoordinates)
         return;
     }
     
-    float LoadStartTime = FPlatformTime::Seconds();
+    double LoadStartTime = FPlatformTime::Seconds();
     
     // Create dynamic streaming level
     FString LevelName = FString::Printf(TEXT("BiomeSection_%d_%d_%d"), 
@@ -384,48 +545,85 @@ void UWorldStreamingManager::LoadSection(const FIntVector& SectionCoordinates)
         // Bind completion delegate
         StreamingLevel->OnLevelShown.AddDynamic(this, &UWorldStreamingManager::OnSectionLoadCompleted);
         
-        // Generate biome content using PCG
-        if (BiomeGenerator)
+        // Generating before the biome's meshes are resident would load them synchronously; wait for the prefetch instead
+        UBiomeAssetPrefetcher* MeshPrefetcher = BiomeGenerator ? BiomeGenerator->GetBiomeAssetPrefetcher() : nullptr;
+        if (MeshPrefetcher && !MeshPrefetcher->IsBiomeReady(Section->BiomeType))
         {
-            // Generate the path segment for this section
-            FVector PathDirection = (Section->WorldPosition - LastPlayerPosition).GetSafeNormal();
-            Section->PCGActors = BiomeGenerator->GeneratePathSegment(Section->WorldPosition, Section->BiomeType, PathDirection);
-            
-            // Determine if this section should have an intersection
-            // For example, every 3rd section or based on some algorithm
-            bool bShouldHaveIntersection = (FMath::Abs(SectionCoordinates.X + SectionCoordinates.Y) % 3 == 0);
-            
-            if (bShouldHaveIntersection)
-            {
-                // Generate intersection with random left/right biomes
-                EBiomeType LeftBiome = UBiomeUtilities::GetRandomValidTransition(Section->BiomeType, TArray<EBiomeType>());
-                EBiomeType RightBiome = UBiomeUtilities::GetRandomValidTransition(Section->BiomeType, {LeftBiome});
-                
-                Section->IntersectionActor = BiomeGenerator->GenerateIntersection(
-                    Section->WorldPosition, 
-                    Section->BiomeType, 
-                    LeftBiome, 
-                    RightBiome
-                );
-                
-                Section->bHasIntersection = (Section->IntersectionActor != nullptr);
-            }
+            MeshPrefetcher->PrefetchBiome(Section->BiomeType);
+            PendingLoadSections.AddUnique(SectionCoordinates);
+            return;
         }
         
-        // Calculate estimated memory usage
-        Section->MemoryUsageKB = CalculateSectionMemoryUsage(*Section);
+        FinishSectionLoad(SectionCoordinates, LoadStartTime);
+    }
+}
+
+void UWorldStreamingManager::FinishSectionLoad(const FIntVector& SectionCoordinates, double LoadStartTime)
+{
+    FWorldSection* Section = ActiveSections.Find(SectionCoordinates);
+    if (!Section)
+    {
+        return;
+    }
+    
+    // Generate biome content using PCG
+    if (BiomeGenerator)
+    {
+        // Generate the path segment for this section along the ride graph
+        FVector PathDirection = FVector(Section->PathExitSection - Section->PathEntrySection).GetSafeNormal();
+        Section->PCGActors = BiomeGenerator->GeneratePathSegment(Section->WorldPosition, Section->BiomeType, PathDirection);
         
-        float LoadTime = FPlatformTime::Seconds() - LoadStartTime;
-        PerformanceMetrics.StreamingLoadTime = (PerformanceMetrics.StreamingLoadTime + LoadTime) * 0.5f;
+        // Determine if this section should have an intersection
+        // For example, every 3rd section or based on some algorithm
+        bool bShouldHaveIntersection = (FMath::Abs(SectionCoordinates.X + SectionCoordinates.Y) % 3 == 0);
         
-        UE_LOG(LogTemp, Log, TEXT("Loaded section (%d, %d, %d) with %s biome in %.3fs, using %dKB"), 
-               SectionCoordinates.X, SectionCoordinates.Y, SectionCoordinates.Z,
-               *UBiomeUtilities::GetBiomeName(Section->BiomeType),
-               LoadTime,
-               Section->MemoryUsageKB);
+        if (bShouldHaveIntersection)
+        {
+            // Generate intersection with random left/right biomes
+            EBiomeType LeftBiome = FBiomeTransitionSampler::Sample(Section->BiomeType, FBiomeHistorySignature());
+            EBiomeType RightBiome = FBiomeTransitionSampler::Sample(Section->BiomeType, FBiomeHistorySignature::FromSingle(Section->BiomeType, LeftBiome));
+            
+            Section->IntersectionActor = BiomeGenerator->GenerateIntersection(
+                Section->WorldPosition, 
+                Section->BiomeType, 
+                LeftBiome, 
+                RightBiome
+            );
+            
+            Section->bHasIntersection = (Section->IntersectionActor != nullptr);
+        }
+    }
+    
+    // Calculate estimated memory usage
+    Section->MemoryUsageKB = CalculateSectionMemoryUsage(*Section);
+    
+    float LoadTime = FPlatformTime::Seconds() - LoadStartTime;
+    PerformanceMetrics.StreamingLoadTime = (PerformanceMetrics.StreamingLoadTime + LoadTime) * 0.5f;
+    
+    FBikeTelemetry::Get().Record(EBikeTelemetryEvent::SectionLoaded, SectionCoordinates, Section->BiomeType, EBiomeType::None,
+                                 Section->MemoryUsageKB, LoadTime * 1000.0f, Section->bHasIntersection ? 1 : 0);
+    
+    // Broadcast event
+    OnSectionLoadedEvent.Broadcast(SectionCoordinates, Section->BiomeType);
+}
+
+void UWorldStreamingManager::GenerateWaitingSections()
+{
+    UBiomeAssetPrefetcher* MeshPrefetcher = BiomeGenerator ? BiomeGenerator->GetBiomeAssetPrefetcher() : nullptr;
+    
+    for (int32 Index = PendingLoadSections.Num() - 1; Index >= 0; Index--)
+    {
+        const FIntVector SectionCoords = PendingLoadSections[Index];
+        const FWorldSection* Section = ActiveSections.Find(SectionCoords);
+        if (Section && MeshPrefetcher && !MeshPrefetcher->IsBiomeReady(Section->BiomeType))
+        {
+            // Evicted while waiting; ask again so the section is not stranded
+            MeshPrefetcher->PrefetchBiome(Section->BiomeType);
+            continue;
+        }
         
-        // Broadcast event
-        OnSectionLoadedEvent.Broadcast(SectionCoordinates, Section->BiomeType);
+        PendingLoadSections.RemoveAt(Index);
+        FinishSectionLoad(SectionCoords, FPlatformTime::Seconds());
     }
 }
 
@@ -440,6 +638,7 @@ void UWorldStreamingManager::UnloadSection(const FIntVector& SectionCoordinates)
     float UnloadStartTime = FPlatformTime::Seconds();
     
     EBiomeType BiomeType = Section->BiomeType;
+    PendingLoadSections.Remove(SectionCoordinates);
     
     // Cleanup PCG actors
     for (APCGActor* PCGActor : Section->PCGActors)
@@ -472,10 +671,8 @@ void UWorldStreamingManager::UnloadSection(const FIntVector& SectionCoordinates)
     float UnloadTime = FPlatformTime::Seconds() - UnloadStartTime;
     PerformanceMetrics.StreamingUnloadTime = (PerformanceMetrics.StreamingUnloadTime + UnloadTime) * 0.5f;
     
-    UE_LOG(LogTemp, Log, TEXT("Unloaded section (%d, %d, %d) with %s biome in %.3fs"), 
-           SectionCoordinates.X, SectionCoordinates.Y, SectionCoordinates.Z,
-           *UBiomeUtilities::GetBiomeName(BiomeType),
-           UnloadTime);
+    FBikeTelemetry::Get().Record(EBikeTelemetryEvent::SectionUnloaded, SectionCoordinates, BiomeType, EBiomeType::None,
+                                 0, UnloadTime * 1000.0f);
     
     // Broadcast event
     OnSectionUnloadedEvent.Broadcast(SectionCoordinates, BiomeType);
@@ -585,13 +782,19 @@ EBiomeType UWorldStreamingManager::DetermineSectionBiome(const FIntVector& Secti
     // Use biome generator to determine next biome based on context
     if (BiomeGenerator)
     {
-        // Create a simple biome history with the context biome
-        TArray<EBiomeType> BiomeHistory = {ContextBiome};
+        // History is just the context biome; summarise it directly instead of building an array
+        const FBiomeHistorySignature BiomeHistory = FBiomeHistorySignature::FromSingle(ContextBiome, ContextBiome);
         
         // Determine choice based on section coordinates (pseudo-random)
         bool bLeftChoice = (SectionCoordinates.X + SectionCoordinates.Y) % 2 == 0;
         
-        return BiomeGenerator->GenerateNextBiome(ContextBiome, bLeftChoice, BiomeHistory);
+        const EBiomeType SectionBiome = BiomeGenerator->GenerateNextBiomeWithHistory(ContextBiome, bLeftChoice, BiomeHistory);
+        
+        // Start loading intersection visuals now so they are resident by the time LoadSection spawns them
+        BiomeGenerator->GetAssetPrefetcher()->PrefetchForBiome(SectionBiome);
+        BiomeGenerator->GetBiomeAssetPrefetcher()->PrefetchBiome(SectionBiome);
+        
+        return SectionBiome;
     }
     
     return ContextBiome;
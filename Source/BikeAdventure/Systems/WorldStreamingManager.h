@@ -5,6 +5,7 @@
 #include "Engine/LevelStreamingDynamic.h"
 #include "Engine/Level.h"
 #include "../Core/BiomeTypes.h"
+#include "PathSpline.h"
 #include "WorldStreamingManager.generated.h"
 
 class ULevelStreamingDynamic;
@@ -28,6 +29,8 @@ struct BIKEADVENTURE_API FWorldSection
         LastAccessTime = 0.0f;
         MemoryUsageKB = 0;
         bHasIntersection = false;
+        PathEntrySection = FIntVector::ZeroValue;
+        PathExitSection = FIntVector::ZeroValue;
     }
 
     // Grid coordinates of this section
@@ -77,6 +80,14 @@ struct BIKEADVENTURE_API FWorldSection
     // Intersection actor if present
     UPROPERTY()
     AIntersection* IntersectionActor;
+
+    // Rideable path through this section, shared with riders following it
+    TSharedPtr<const FPathSpline> PathSpline;
+
+    // Neighbouring sections the path enters from and leaves towards; two sections are linked in
+    // the ride graph when one's exit is the other and the other's entry is the first
+    FIntVector PathEntrySection;
+    FIntVector PathExitSection;
 };
 
 /**
@@ -137,6 +148,9 @@ class BIKEADVENTURE_API UWorldStreamingManager : public UGameInstanceSubsystem
     GENERATED_BODY()
 
 public:
+    // Section edge length used unless overridden; shared with anything that buckets by section
+    static constexpr float DefaultSectionSizeCm = 200000.0f;
+
     // USubsystem interface
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
     virtual void Deinitialize() override;
@@ -179,12 +193,41 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "World Streaming")
     TArray<FWorldSection> GetActiveSections();
 
+    /**
+     * Find a loaded section by its grid coordinates
+     * @return The section, or nullptr if it is not loaded
+     */
+    const FWorldSection* FindSection(const FIntVector& SectionCoordinates) const { return ActiveSections.Find(SectionCoordinates); }
+
     /**
      * Get current streaming performance metrics
      */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Performance")
     FStreamingPerformanceMetrics GetPerformanceMetrics();
 
+    /**
+     * Find the next loaded intersection ahead of the rider along the ride graph
+     * Follows linked sections forward from the one containing Location, so only sections on the path are visited
+     * @param Location - Current rider location
+     * @param IgnoredIntersection - Intersection to skip, typically the one just resolved
+     * @param OutIntersection - Nearest intersection ahead
+     * @param OutPathDistance - Position of that intersection in the shared distance-along-path coordinate
+     * @return Whether an intersection ahead is loaded
+     */
+    UFUNCTION(BlueprintCallable, Category = "World Streaming")
+    bool FindNextIntersectionAhead(const FVector& Location, AIntersection* IgnoredIntersection, AIntersection*& OutIntersection, float& OutPathDistance) const;
+
+    /**
+     * Path spline of the loaded section containing a location
+     * Splines linked in the ride graph take consecutive ranges of the shared distance-along-path coordinate
+     */
+    TSharedPtr<const FPathSpline> FindPathSplineAt(const FVector& Location) const;
+
+    /**
+     * Spline that continues a section's spline across its exit edge, if that section is loaded
+     */
+    TSharedPtr<const FPathSpline> FindNextPathSpline(const FPathSpline& Path) const;
+
     /**
      * Preload sections in the specified direction for smoother experience
      */
@@ -209,6 +252,12 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Performance")
     bool IsWithinMemoryBudget();
 
+    /**
+     * Edge length of each world section in Unreal units
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "World Streaming")
+    float GetSectionSize() const { return SectionSizeCm; }
+
 protected:
     // Maximum streaming distance in Unreal units (5km default)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming Settings", meta = (ClampMin = "1000.0", ClampMax = "10000.0"))
@@ -246,7 +295,7 @@ protected:
     UPROPERTY()
     TMap<FIntVector, FWorldSection> ActiveSections;
 
-    // Sections pending loading
+    // Loaded sections whose content waits for their biome's meshes to become resident
     UPROPERTY()
     TArray<FIntVector> PendingLoadSections;
 
@@ -262,16 +311,36 @@ protected:
     UPROPERTY()
     FVector LastPlayerPosition;
 
+    // Shared path distance past every generated spline, where a new chain of sections starts
+    float NextPathStartDistance;
+
+    // Last non-zero rider velocity direction; a section with no linked neighbour lays its path along it
+    FVector RiderHeading;
+
+    // Biome of the section the rider was last in; the biome asset prefetcher is refreshed when it changes
+    EBiomeType RiderBiome;
+
 private:
     /**
      * Convert world position to section coordinates
      */
-    FIntVector WorldToSectionCoordinates(const FVector& WorldLocation);
+    FIntVector WorldToSectionCoordinates(const FVector& WorldLocation) const;
 
     /**
      * Convert section coordinates to world position
      */
-    FVector SectionCoordinatesToWorld(const FIntVector& SectionCoordinates);
+    FVector SectionCoordinatesToWorld(const FIntVector& SectionCoordinates) const;
+
+    /**
+     * Link a new section into the ride graph and build the path spline across it
+     */
+    void BuildSectionPath(const FIntVector& SectionCoordinates);
+
+    /**
+     * Point on the edge shared by two adjacent sections where the path crosses between them
+     * Depends only on the pair, so both sections agree on it whichever loads first
+     */
+    FVector GetPathCrossingPoint(const FIntVector& SectionA, const FIntVector& SectionB) const;
 
     /**
      * Create a new world section at the specified coordinates
@@ -283,6 +352,16 @@ private:
      */
     void LoadSection(const FIntVector& SectionCoordinates);
 
+    /**
+     * Generate a loaded section's PCG content and intersection, then announce it
+     */
+    void FinishSectionLoad(const FIntVector& SectionCoordinates, double LoadStartTime);
+
+    /**
+     * Finish loading every section whose biome meshes have become resident
+     */
+    void GenerateWaitingSections();
+
     /**
      * Unload a world section and clean up resources
      */
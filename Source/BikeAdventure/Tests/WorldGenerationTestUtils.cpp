@@ -183,17 +183,15 @@ FPlayerChoiceHistory FWorldGenerationTestUtils::GenerateTestPlayerHistory(int32
     History.RightChoices = NumChoices - History.LeftChoices;
 
     // Generate recent choices
-    for (int32 i = 0; i < FMath::Min(NumChoices, 10); i++)
+    for (int32 i = 0; i < FMath::Min(NumChoices, FPlayerChoiceHistory::RecentCapacity); i++)
     {
         bool bLeftChoice = FMath::RandRange(0.0f, 1.0f) < LeftBias;
-        History.RecentChoices.Add(bLeftChoice);
         
         // Add random biome and personality
         EBiomeType RandomBiome = (EBiomeType)FMath::RandRange(0, 6);
         EPathPersonality RandomPersonality = (EPathPersonality)FMath::RandRange(0, 5);
         
-        History.RecentBiomes.Add(RandomBiome);
-        History.RecentPersonalities.Add(RandomPersonality);
+        History.PushRecent(bLeftChoice, RandomBiome, RandomPersonality);
     }
 
     // Generate personality preferences
@@ -204,19 +202,20 @@ FPlayerChoiceHistory FWorldGenerationTestUtils::GenerateTestPlayerHistory(int32
 
     for (EPathPersonality Personality : AllPersonalities)
     {
-        History.PersonalityPreferences.Add(Personality, FMath::RandRange(0.0f, 1.0f));
+        History.PersonalityPreferences[PathPersonalityTables::ToIndex(Personality)] = FMath::RandRange(0.0f, 1.0f);
     }
 
     // Set preferred personality to highest scoring
     EPathPersonality PreferredPersonality = EPathPersonality::Peaceful;
     float HighestScore = 0.0f;
     
-    for (const auto& PrefPair : History.PersonalityPreferences)
+    for (EPathPersonality Personality : AllPersonalities)
     {
-        if (PrefPair.Value > HighestScore)
+        const float Score = History.GetPersonalityPreference(Personality);
+        if (Score > HighestScore)
         {
-            HighestScore = PrefPair.Value;
-            PreferredPersonality = PrefPair.Key;
+            HighestScore = Score;
+            PreferredPersonality = Personality;
         }
     }
     
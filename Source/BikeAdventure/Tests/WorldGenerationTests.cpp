@@ -277,6 +277,41 @@ bool FPathPersonalityTest::RunTest(const FString& Parameters)
         }
     }
 
+    // Every determined personality must carry weight in the destination biome's rules
+    for (uint8 BiomeIndex = 0; BiomeIndex < BiomeTables::NumBiomes; BiomeIndex++)
+    {
+        EBiomeType ToBiome = (EBiomeType)BiomeIndex;
+        FPathGenerationRules Rules = PathSystem->GenerateAdaptiveRules(ToBiome, FPlayerChoiceHistory());
+
+        for (int32 Sample = 0; Sample < 64; Sample++)
+        {
+            EPathPersonality Personality = PathSystem->DeterminePathPersonality(EBiomeType::Countryside, ToBiome, (Sample & 1) != 0, TestHistory);
+            if (Rules.GetPersonalityWeight(Personality) <= 0.0f)
+            {
+                AddError(FString::Printf(TEXT("%s path personality %s has no weight in %s"),
+                    (Sample & 1) ? TEXT("Left") : TEXT("Right"),
+                    *UEnum::GetValueAsString(Personality), *UEnum::GetValueAsString(ToBiome)));
+                bTestPassed = false;
+                break;
+            }
+        }
+    }
+
+    // Preferences accumulate on the chosen personality and decay on the others
+    FPlayerChoiceHistory PreferenceHistory;
+    for (int32 Choice = 0; Choice < 8; Choice++)
+    {
+        PathSystem->UpdatePlayerChoiceHistory(PreferenceHistory, true, EBiomeType::Forest, EPathPersonality::Mystery);
+    }
+    PathSystem->UpdatePlayerChoiceHistory(PreferenceHistory, false, EBiomeType::Forest, EPathPersonality::Safe);
+
+    if (PreferenceHistory.PreferredPersonality != EPathPersonality::Mystery ||
+        PreferenceHistory.GetPersonalityPreference(EPathPersonality::Safe) >= PreferenceHistory.GetPersonalityPreference(EPathPersonality::Mystery))
+    {
+        AddError(TEXT("Personality preferences did not track repeated choices"));
+        bTestPassed = false;
+    }
+
     return bTestPassed;
 }
 
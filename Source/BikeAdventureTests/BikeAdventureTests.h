@@ -2,4 +2,25 @@
 
 #pragma once
 
-#include "CoreMinimal.h"
\ No newline at end of file
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "Components/BoxComponent.h"
+#include "GameFramework/Actor.h"
+
+namespace BikeAdventureTests
+{
+	/** Spawn a static collision box; defaults to a flat ground slab the bike can ride on */
+	inline AActor* SpawnStaticBox(UWorld* World, const FVector& Location = FVector(0.0f, 0.0f, -50.0f), const FVector& Extent = FVector(100000.0f, 100000.0f, 50.0f))
+	{
+		AActor* BoxActor = World->SpawnActor<AActor>();
+		UBoxComponent* Box = NewObject<UBoxComponent>(BoxActor);
+		Box->SetBoxExtent(Extent);
+		Box->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Box->SetCollisionObjectType(ECC_WorldStatic);
+		Box->SetCollisionResponseToAllChannels(ECR_Block);
+		BoxActor->SetRootComponent(Box);
+		Box->RegisterComponent();
+		BoxActor->SetActorLocation(Location);
+		return BoxActor;
+	}
+}
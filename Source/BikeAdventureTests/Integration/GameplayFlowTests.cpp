@@ -1,10 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
+#include "BikeAdventureTests.h"
 #include "CoreMinimal.h"
 #include "Misc/AutomationTest.h"
 #include "Tests/AutomationCommon.h"
 #include "Engine/World.h"
-#include "Core/BikeMovementComponent.h"
+#include "Core/BikeCharacter.h"
+#include "Systems/BikeMovementComponent.h"
 #include "Gameplay/IntersectionDetector.h"
 #include "Systems/BiomeGenerator.h"
 #include "GameFramework/Actor.h"
@@ -55,15 +57,22 @@ bool FGameplayFlowTest::TestGameStartToIntersectionFlow()
 		return false;
 	}
 
-	// Create player bike actor with all necessary components
-	AActor* BikeActor = TestWorld->SpawnActor<AActor>();
+	// Ground long enough for the whole ride
+	BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(0.0f, 0.0f, -50.0f), FVector(1000000.0f, 1000000.0f, 50.0f));
+
+	// Create player bike with all necessary components
+	ABikeCharacter* BikeActor = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
 	TestNotNull("Bike actor created", BikeActor);
 
-	// Add movement component
-	UBikeMovementComponent* BikeMovement = NewObject<UBikeMovementComponent>(BikeActor);
+	if (!BikeActor)
+	{
+		TestWorld->DestroyWorld(false);
+		return false;
+	}
+
+	// Movement component comes with the pawn
+	UBikeMovementComponent* BikeMovement = BikeActor->GetBikeMovement();
 	TestNotNull("Bike movement component created", BikeMovement);
-	BikeMovement->RegisterComponent();
-	BikeActor->AddOwnedComponent(BikeMovement);
 
 	// Add intersection detector
 	UIntersectionDetector* IntersectionDetector = NewObject<UIntersectionDetector>(BikeActor);
@@ -72,7 +81,6 @@ bool FGameplayFlowTest::TestGameStartToIntersectionFlow()
 	BikeActor->AddOwnedComponent(IntersectionDetector);
 
 	// Initialize components
-	BikeMovement->BeginPlay();
 	IntersectionDetector->BeginPlay();
 
 	// Test initial game state
@@ -141,16 +149,15 @@ bool FGameplayFlowTest::TestContinuousExplorationSession()
 	}
 
 	// Setup bike with all components
-	AActor* BikeActor = TestWorld->SpawnActor<AActor>();
-	UBikeMovementComponent* BikeMovement = NewObject<UBikeMovementComponent>(BikeActor);
+	BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(0.0f, 0.0f, -50.0f), FVector(1000000.0f, 1000000.0f, 50.0f));
+
+	ABikeCharacter* BikeActor = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+	UBikeMovementComponent* BikeMovement = BikeActor->GetBikeMovement();
 	UIntersectionDetector* IntersectionDetector = NewObject<UIntersectionDetector>(BikeActor);
 	
-	BikeMovement->RegisterComponent();
 	IntersectionDetector->RegisterComponent();
-	BikeActor->AddOwnedComponent(BikeMovement);
 	BikeActor->AddOwnedComponent(IntersectionDetector);
 	
-	BikeMovement->BeginPlay();
 	IntersectionDetector->BeginPlay();
 
 	// Simulate extended exploration session
@@ -229,16 +236,15 @@ bool FGameplayFlowTest::TestBiomeTransitionDuringGameplay()
 	TestNotNull("Biome generator created", BiomeGen);
 
 	// Setup bike
-	AActor* BikeActor = TestWorld->SpawnActor<AActor>();
-	UBikeMovementComponent* BikeMovement = NewObject<UBikeMovementComponent>(BikeActor);
+	BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(0.0f, 0.0f, -50.0f), FVector(1000000.0f, 1000000.0f, 50.0f));
+
+	ABikeCharacter* BikeActor = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+	UBikeMovementComponent* BikeMovement = BikeActor->GetBikeMovement();
 	UIntersectionDetector* IntersectionDetector = NewObject<UIntersectionDetector>(BikeActor);
 	
-	BikeMovement->RegisterComponent();
 	IntersectionDetector->RegisterComponent();
-	BikeActor->AddOwnedComponent(BikeMovement);
 	BikeActor->AddOwnedComponent(IntersectionDetector);
 	
-	BikeMovement->BeginPlay();
 	IntersectionDetector->BeginPlay();
 
 	// Simulate gameplay with biome transitions
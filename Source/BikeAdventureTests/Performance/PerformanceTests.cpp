@@ -1,15 +1,29 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
+#include "BikeAdventureTests.h"
 #include "CoreMinimal.h"
 #include "Misc/AutomationTest.h"
 #include "Tests/AutomationCommon.h"
 #include "Engine/World.h"
 #include "HAL/PlatformMemory.h"
 #include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
 #include "Stats/Stats.h"
-#include "Core/BikeMovementComponent.h"
+#include "Core/BikeCharacter.h"
+#include "Systems/BikeMovementComponent.h"
 #include "Gameplay/IntersectionDetector.h"
+#include "Gameplay/Intersection.h"
+#include "Gameplay/PathCrowdSimulation.h"
+#include "Components/SplineComponent.h"
+#include "GameFramework/Pawn.h"
 #include "Systems/BiomeGenerator.h"
+#include "Systems/BikeTelemetry.h"
+#include "Systems/BikeSaveFormat.h"
+#include "Systems/PathPersonalitySystem.h"
+#include "Systems/IntersectionSpatialIndex.h"
+#include "Core/BiomeTransitionSampler.h"
 #include "GameFramework/Actor.h"
 
 // Frame rate performance test
@@ -28,20 +42,19 @@ bool FFrameRatePerformanceTest::RunTest(const FString& Parameters)
 		return false;
 	}
 
+	BikeAdventureTests::SpawnStaticBox(TestWorld);
+
 	// Setup test scenario with multiple actors
 	TArray<AActor*> TestActors;
 	for (int i = 0; i < 10; i++) // Create multiple bike actors for load testing
 	{
-		AActor* BikeActor = TestWorld->SpawnActor<AActor>();
-		UBikeMovementComponent* BikeMovement = NewObject<UBikeMovementComponent>(BikeActor);
+		ABikeCharacter* BikeActor = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, i * 500.0f, 100.0f), FRotator::ZeroRotator);
+		UBikeMovementComponent* BikeMovement = BikeActor->GetBikeMovement();
 		UIntersectionDetector* IntersectionDetector = NewObject<UIntersectionDetector>(BikeActor);
 		
-		BikeMovement->RegisterComponent();
 		IntersectionDetector->RegisterComponent();
-		BikeActor->AddOwnedComponent(BikeMovement);
 		BikeActor->AddOwnedComponent(IntersectionDetector);
 		
-		BikeMovement->BeginPlay();
 		IntersectionDetector->BeginPlay();
 		BikeMovement->SetThrottle(1.0f);
 		
@@ -153,13 +166,10 @@ bool FMemoryUsagePerformanceTest::RunTest(const FString& Parameters)
 	TArray<AActor*> BikeActors;
 	for (int i = 0; i < 50; i++)
 	{
-		AActor* BikeActor = TestWorld->SpawnActor<AActor>();
-		UBikeMovementComponent* BikeMovement = NewObject<UBikeMovementComponent>(BikeActor);
+		ABikeCharacter* BikeActor = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, i * 500.0f, 100.0f), FRotator::ZeroRotator);
 		UIntersectionDetector* IntersectionDetector = NewObject<UIntersectionDetector>(BikeActor);
 		
-		BikeMovement->RegisterComponent();
 		IntersectionDetector->RegisterComponent();
-		BikeActor->AddOwnedComponent(BikeMovement);
 		BikeActor->AddOwnedComponent(IntersectionDetector);
 		
 		BikeActors.Add(BikeActor);
@@ -241,17 +251,16 @@ bool FLoadingTimePerformanceTest::RunTest(const FString& Parameters)
 		return false;
 	}
 
+	BikeAdventureTests::SpawnStaticBox(TestWorld);
+
 	// Simulate loading game objects
 	TArray<AActor*> LoadedActors;
 	for (int i = 0; i < 20; i++)
 	{
-		AActor* Actor = TestWorld->SpawnActor<AActor>();
-		UBikeMovementComponent* BikeMovement = NewObject<UBikeMovementComponent>(Actor);
+		ABikeCharacter* Actor = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, i * 500.0f, 100.0f), FRotator::ZeroRotator);
 		UIntersectionDetector* IntersectionDetector = NewObject<UIntersectionDetector>(Actor);
 		
-		BikeMovement->RegisterComponent();
 		IntersectionDetector->RegisterComponent();
-		Actor->AddOwnedComponent(BikeMovement);
 		Actor->AddOwnedComponent(IntersectionDetector);
 		
 		LoadedActors.Add(Actor);
@@ -296,7 +305,7 @@ bool FLoadingTimePerformanceTest::RunTest(const FString& Parameters)
 		if (BikeMovement)
 		{
 			BikeMovement->SetThrottle(1.0f);
-			BikeMovement->UpdateMovement(0.016f);
+			BikeMovement->UpdateMovement(1.0f / 60.0f);
 			TestTrue("Loaded bike can move", BikeMovement->GetVelocity().Size() > 0);
 		}
 	}
@@ -305,4 +314,648 @@ bool FLoadingTimePerformanceTest::RunTest(const FString& Parameters)
 	TestWorld->DestroyWorld(false);
 
 	return true;
-}
\ No newline at end of file
+}
+
+// Hot-path telemetry overhead test
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTelemetryOverheadPerformanceTest,
+	"BikeAdventure.Performance.TelemetryOverhead",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTelemetryOverheadPerformanceTest::RunTest(const FString& Parameters)
+{
+	FBikeTelemetry& Telemetry = FBikeTelemetry::Get();
+	const bool bWasEnabled = Telemetry.IsEnabled();
+	if (!bWasEnabled)
+	{
+		Telemetry.Startup(FPaths::ProjectSavedDir() / TEXT("Telemetry") / TEXT("BikeTelemetry_PerfTest.bin"));
+	}
+	TestTrue("Telemetry enabled", Telemetry.IsEnabled());
+
+	// Stay below ring capacity so every call measures the normal enqueue path
+	const int32 Iterations = FBikeTelemetry::RingCapacity / 2;
+	Telemetry.Flush();
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		Telemetry.Record(EBikeTelemetryEvent::SectionLoaded, FIntVector(i, i, 0), EBiomeType::Forest, EBiomeType::None, 15360, 1.0f);
+	}
+	double RecordTime = FPlatformTime::Seconds() - StartTime;
+
+	// Equivalent string formatting previously done by UE_LOG on the same path
+	StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		FString Message = FString::Printf(TEXT("Loaded section (%d, %d, %d) with %s biome in %.3fs, using %dKB"),
+			i, i, 0, *UBiomeUtilities::GetBiomeName(EBiomeType::Forest), 0.001f, 15360);
+	}
+	double FormatTime = FPlatformTime::Seconds() - StartTime;
+
+	Telemetry.Flush();
+
+	const double NanosecondsPerRecord = (RecordTime / Iterations) * 1e9;
+	const double NanosecondsPerFormat = (FormatTime / Iterations) * 1e9;
+
+	UE_LOG(LogTemp, Warning, TEXT("Telemetry Overhead Results:"));
+	UE_LOG(LogTemp, Warning, TEXT("Record: %.1f ns/event, String formatting: %.1f ns/event"), NanosecondsPerRecord, NanosecondsPerFormat);
+
+	TestTrue("Telemetry record is cheaper than string formatting", RecordTime < FormatTime);
+	TestTrue("Telemetry record stays under 250ns", NanosecondsPerRecord < 250.0);
+
+	if (!bWasEnabled)
+	{
+		Telemetry.Shutdown();
+		IFileManager::Get().Delete(*Telemetry.GetOutputPath());
+	}
+
+	return true;
+}
+
+// Biome transition selection throughput test
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBiomeTransitionPerformanceTest,
+	"BikeAdventure.Performance.BiomeTransitionSelection",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBiomeTransitionPerformanceTest::RunTest(const FString& Parameters)
+{
+	const int32 Iterations = 100000;
+	TArray<EBiomeType> RecentBiomes = { EBiomeType::Countryside, EBiomeType::Forest };
+
+	FMath::RandInit(12345);
+	EBiomeType CurrentBiome = EBiomeType::Forest;
+	int32 InvalidTransitions = 0;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		EBiomeType NextBiome = UBiomeUtilities::GetRandomValidTransition(CurrentBiome, RecentBiomes);
+		if (!UBiomeUtilities::CanBiomesTransition(CurrentBiome, NextBiome))
+		{
+			InvalidTransitions++;
+		}
+
+		RecentBiomes[0] = RecentBiomes[1];
+		RecentBiomes[1] = CurrentBiome;
+		CurrentBiome = NextBiome;
+	}
+	double SelectionTime = FPlatformTime::Seconds() - StartTime;
+
+	// Table lookups used on the generation path
+	float Checksum = 0.0f;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		const EBiomeType Biome = static_cast<EBiomeType>(i % BiomeTables::NumBiomes);
+		Checksum += UBiomeUtilities::GetDefaultBiomeParamsRef(Biome).PathWidth;
+		Checksum += UBiomeUtilities::GetDefaultTransitionRulesRef(Biome).PreferredIntersectionTypes.Num();
+	}
+	double LookupTime = FPlatformTime::Seconds() - StartTime;
+
+	const double NanosecondsPerSelection = (SelectionTime / Iterations) * 1e9;
+	const double NanosecondsPerLookup = (LookupTime / Iterations) * 1e9;
+
+	UE_LOG(LogTemp, Warning, TEXT("Biome Transition Performance Results:"));
+	UE_LOG(LogTemp, Warning, TEXT("GetRandomValidTransition: %.1f ns/call"), NanosecondsPerSelection);
+	UE_LOG(LogTemp, Warning, TEXT("Params + rules lookup: %.1f ns/call (checksum %.0f)"), NanosecondsPerLookup, Checksum);
+
+	TestEqual("Every selected transition is valid", InvalidTransitions, 0);
+	TestTrue("Transition selection stays under 500ns", NanosecondsPerSelection < 500.0);
+	TestTrue("Table lookups stay under 50ns", NanosecondsPerLookup < 50.0);
+
+	return true;
+}
+
+// Alias-table transition sampler throughput test
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBiomeTransitionSamplerPerformanceTest,
+	"BikeAdventure.Performance.BiomeTransitionSampler",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBiomeTransitionSamplerPerformanceTest::RunTest(const FString& Parameters)
+{
+	const int32 Iterations = 100000;
+	FRandomStream Stream(12345);
+
+	// Warm the table cache so the timing covers sampling only
+	FBiomeTransitionSampler::Sample(EBiomeType::Forest, FBiomeHistorySignature(), 0.5f);
+
+	EBiomeType CurrentBiome = EBiomeType::Countryside;
+	EBiomeType PreviousBiome = EBiomeType::None;
+	int32 InvalidTransitions = 0;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		const EBiomeType NextBiome = FBiomeTransitionSampler::Sample(CurrentBiome, FBiomeHistorySignature::FromSingle(CurrentBiome, PreviousBiome), Stream);
+		if (!BiomeTables::CanTransition(CurrentBiome, NextBiome))
+		{
+			InvalidTransitions++;
+		}
+
+		PreviousBiome = CurrentBiome;
+		CurrentBiome = NextBiome;
+	}
+	double SamplerTime = FPlatformTime::Seconds() - StartTime;
+
+	const double NanosecondsPerSample = (SamplerTime / Iterations) * 1e9;
+
+	UE_LOG(LogTemp, Warning, TEXT("Biome Transition Sampler Results:"));
+	UE_LOG(LogTemp, Warning, TEXT("Sample: %.1f ns/call (distribution v%d)"), NanosecondsPerSample, FBiomeTransitionSampler::DistributionVersion);
+
+	TestEqual("Every sampled transition is valid", InvalidTransitions, 0);
+	TestTrue("Sampling stays under 100ns", NanosecondsPerSample < 100.0);
+
+	return true;
+}
+
+// Path personality evaluation throughput test
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathPersonalityEvaluationPerformanceTest,
+	"BikeAdventure.Performance.PathPersonalityEvaluation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathPersonalityEvaluationPerformanceTest::RunTest(const FString& Parameters)
+{
+	UPathPersonalitySystem* PathSystem = NewObject<UPathPersonalitySystem>();
+	TestNotNull("Path personality system created", PathSystem);
+
+	if (!PathSystem)
+	{
+		return false;
+	}
+
+	PathSystem->Initialize();
+
+	// A history with every preference populated exercises the full weight calculation
+	FPlayerChoiceHistory History;
+	for (int32 i = 0; i < 40; i++)
+	{
+		const EPathPersonality Personality = static_cast<EPathPersonality>(i % PathPersonalityTables::NumPersonalities);
+		PathSystem->UpdatePlayerChoiceHistory(History, (i % 3) != 0, static_cast<EBiomeType>(i % BiomeTables::NumBiomes), Personality);
+	}
+
+	const int32 Iterations = 100000;
+	int32 InvalidPersonalities = 0;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		const EBiomeType ToBiome = static_cast<EBiomeType>(i % BiomeTables::NumBiomes);
+		const EPathPersonality Personality = PathSystem->DeterminePathPersonality(EBiomeType::Countryside, ToBiome, (i & 1) != 0, History);
+		if (!PathPersonalityTables::IsValidPersonality(Personality))
+		{
+			InvalidPersonalities++;
+		}
+	}
+	double EvaluationTime = FPlatformTime::Seconds() - StartTime;
+
+	const double NanosecondsPerEvaluation = (EvaluationTime / Iterations) * 1e9;
+
+	UE_LOG(LogTemp, Warning, TEXT("Path Personality Evaluation Results:"));
+	UE_LOG(LogTemp, Warning, TEXT("DeterminePathPersonality: %.1f ns/call"), NanosecondsPerEvaluation);
+
+	TestEqual("Every evaluation returns a concrete personality", InvalidPersonalities, 0);
+	TestTrue("Evaluation stays under 150ns", NanosecondsPerEvaluation < 150.0);
+
+	return true;
+}
+
+// Batched path hint generation cost per intersection
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathHintsBatchPerformanceTest,
+	"BikeAdventure.Performance.PathHintsBatch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathHintsBatchPerformanceTest::RunTest(const FString& Parameters)
+{
+	UPathPersonalitySystem* PathSystem = NewObject<UPathPersonalitySystem>();
+	TestNotNull("Path personality system created", PathSystem);
+
+	if (!PathSystem)
+	{
+		return false;
+	}
+
+	PathSystem->Initialize();
+
+	// Three rings of sections ahead of the rider, one intersection per section
+	const int32 RingSize = 24;
+	const int32 Iterations = 2000;
+
+	TArray<FPathHintRequest> Requests;
+	for (int32 i = 0; i < RingSize; i++)
+	{
+		FPathHintRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.SectionCoordinates = FIntVector(i, 0, 0);
+		Request.CurrentBiome = static_cast<EBiomeType>(i % BiomeTables::NumBiomes);
+		Request.LeftPathBiome = static_cast<EBiomeType>((i + 1) % BiomeTables::NumBiomes);
+		Request.RightPathBiome = static_cast<EBiomeType>((i + 3) % BiomeTables::NumBiomes);
+	}
+
+	FPlayerChoiceHistory History;
+	TArray<FCompactPathHints> Hints;
+
+	// Warm the output allocation so the timing covers evaluation only
+	PathSystem->GeneratePathHintsForIntersections(Requests, History, Hints);
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		PathSystem->GeneratePathHintsForIntersections(Requests, History, Hints);
+	}
+	double BatchTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		for (const FPathHintRequest& Request : Requests)
+		{
+			PathSystem->GeneratePathHintsForIntersection(Request.CurrentBiome, Request.LeftPathBiome, Request.RightPathBiome, History);
+		}
+	}
+	double SingleTime = FPlatformTime::Seconds() - StartTime;
+
+	const double NanosecondsPerBatchedIntersection = (BatchTime / (Iterations * RingSize)) * 1e9;
+	const double NanosecondsPerSingleIntersection = (SingleTime / (Iterations * RingSize)) * 1e9;
+
+	UE_LOG(LogTemp, Warning, TEXT("Path Hints Batch Results (%d intersections per ring):"), RingSize);
+	UE_LOG(LogTemp, Warning, TEXT("Batched: %.1f ns/intersection"), NanosecondsPerBatchedIntersection);
+	UE_LOG(LogTemp, Warning, TEXT("Per-intersection calls: %.1f ns/intersection"), NanosecondsPerSingleIntersection);
+
+	TestEqual("Every intersection produced hints", Hints.Num(), RingSize);
+	TestTrue("Batched evaluation is cheaper than per-intersection calls", NanosecondsPerBatchedIntersection < NanosecondsPerSingleIntersection);
+	TestTrue("Batched evaluation stays under 500ns per intersection", NanosecondsPerBatchedIntersection < 500.0);
+
+	return true;
+}
+
+// Intersection spatial index under tens of thousands of registrations
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIntersectionIndexStressPerformanceTest,
+	"BikeAdventure.Performance.IntersectionIndexStress",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FIntersectionIndexStressPerformanceTest::RunTest(const FString& Parameters)
+{
+	// Roughly one intersection per 200m over a 40km square, the index behind UIntersectionManager
+	const int32 NumIntersections = 50000;
+	const int32 NumQueries = 20000;
+	const float WorldExtent = 2000000.0f;
+
+	FIntersectionSpatialIndex Index;
+	FRandomStream Stream(4242);
+
+	TArray<FVector> Locations;
+	Locations.Reserve(NumIntersections);
+	for (int32 i = 0; i < NumIntersections; i++)
+	{
+		Locations.Add(FVector(Stream.FRandRange(-WorldExtent, WorldExtent), Stream.FRandRange(-WorldExtent, WorldExtent), 0.0f));
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	for (const FVector& Location : Locations)
+	{
+		Index.Add(Location);
+	}
+	const double RegisterTime = FPlatformTime::Seconds() - StartTime;
+
+	// Rider-style queries: next decision within two sections along a random heading
+	int32 Hits = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumQueries; i++)
+	{
+		const FVector Location(Stream.FRandRange(-WorldExtent, WorldExtent), Stream.FRandRange(-WorldExtent, WorldExtent), 0.0f);
+		const FVector Heading = FRotator(0.0f, Stream.FRandRange(0.0f, 360.0f), 0.0f).Vector();
+
+		float Distance = 0.0f;
+		if (Index.FindNearestAhead(Location, Heading, 400000.0f, 5000.0f, INDEX_NONE, Distance) != INDEX_NONE)
+		{
+			Hits++;
+		}
+	}
+	const double QueryTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 SectionTotal = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumQueries; i++)
+	{
+		const FIntVector Section(Stream.RandRange(-10, 9), Stream.RandRange(-10, 9), 0);
+		if (const TArray<int32>* Bucket = Index.FindInSection(Section))
+		{
+			SectionTotal += Bucket->Num();
+		}
+	}
+	const double SectionQueryTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	while (Index.Num() > 0)
+	{
+		Index.RemoveAtSwap(Stream.RandRange(0, Index.Num() - 1));
+	}
+	const double UnregisterTime = FPlatformTime::Seconds() - StartTime;
+
+	const double RegisterNs = (RegisterTime / NumIntersections) * 1e9;
+	const double UnregisterNs = (UnregisterTime / NumIntersections) * 1e9;
+	const double QueryUs = (QueryTime / NumQueries) * 1e6;
+	const double SectionQueryNs = (SectionQueryTime / NumQueries) * 1e9;
+
+	UE_LOG(LogTemp, Warning, TEXT("Intersection Index Stress Results (%d intersections):"), NumIntersections);
+	UE_LOG(LogTemp, Warning, TEXT("Register: %.1f ns, Unregister: %.1f ns"), RegisterNs, UnregisterNs);
+	UE_LOG(LogTemp, Warning, TEXT("Nearest ahead: %.2f us (%d/%d hits)"), QueryUs, Hits, NumQueries);
+	UE_LOG(LogTemp, Warning, TEXT("Section lookup: %.1f ns (%d intersections visited)"), SectionQueryNs, SectionTotal);
+
+	TestTrue("Most ahead queries find an intersection", Hits > NumQueries / 2);
+	TestTrue("Register stays under 2us", RegisterNs < 2000.0);
+	TestTrue("Unregister stays under 2us", UnregisterNs < 2000.0);
+	TestTrue("Nearest-ahead query stays under 50us", QueryUs < 50.0);
+	TestTrue("Section lookup stays under 1us", SectionQueryNs < 1000.0);
+
+	return true;
+}
+
+// Idle intersections must not add tick functions as the streamed intersection count grows
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIntersectionIdleTickPerformanceTest,
+	"BikeAdventure.Performance.IntersectionIdleTicks",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FIntersectionIdleTickPerformanceTest::RunTest(const FString& Parameters)
+{
+	UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	TestNotNull("Test world created", TestWorld);
+
+	if (!TestWorld)
+	{
+		return false;
+	}
+
+	// Enabled actor tick functions across a set of intersections
+	auto CountEnabledTicks = [](const TArray<AIntersection*>& Intersections)
+	{
+		int32 TickCount = 0;
+		for (AIntersection* Intersection : Intersections)
+		{
+			TickCount += Intersection->IsActorTickEnabled() ? 1 : 0;
+		}
+		return TickCount;
+	};
+
+	// Component ticks are engine-owned (audio, effects) and only logged for reference
+	auto CountEnabledComponentTicks = [](const TArray<AIntersection*>& Intersections)
+	{
+		int32 TickCount = 0;
+		for (AIntersection* Intersection : Intersections)
+		{
+			for (UActorComponent* Component : Intersection->GetComponents())
+			{
+				TickCount += (Component->PrimaryComponentTick.bCanEverTick && Component->IsComponentTickEnabled()) ? 1 : 0;
+			}
+		}
+		return TickCount;
+	};
+
+	APawn* Rider = TestWorld->SpawnActor<APawn>();
+	TestNotNull("Rider spawned", Rider);
+
+	const int32 IntersectionCounts[] = { 10, 100, 500 };
+	TArray<AIntersection*> Intersections;
+	TArray<int32> IdleTickCounts;
+	TArray<int32> VisitTickCounts;
+
+	for (int32 TargetCount : IntersectionCounts)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		while (Intersections.Num() < TargetCount)
+		{
+			const FVector Location(Intersections.Num() * 2000.0f, 0.0f, 0.0f);
+			Intersections.Add(TestWorld->SpawnActor<AIntersection>(Location, FRotator::ZeroRotator));
+		}
+		const double SpawnTime = FPlatformTime::Seconds() - StartTime;
+
+		IdleTickCounts.Add(CountEnabledTicks(Intersections));
+
+		// The rider inside one intersection enables exactly that intersection's tick
+		AIntersection* Visited = Intersections.Last();
+		Visited->OnPlayerEnterIntersection(nullptr, Rider, nullptr, 0, false, FHitResult());
+		VisitTickCounts.Add(CountEnabledTicks(Intersections));
+		Visited->OnPlayerExitIntersection(nullptr, Rider, nullptr, 0);
+
+		UE_LOG(LogTemp, Warning, TEXT("Intersection Ticks (%d intersections): idle %d, visiting %d, component ticks %d, spawn %.2f ms"),
+			TargetCount, IdleTickCounts.Last(), VisitTickCounts.Last(), CountEnabledComponentTicks(Intersections), SpawnTime * 1000.0);
+	}
+
+	for (int32 i = 0; i < IdleTickCounts.Num(); i++)
+	{
+		TestEqual(FString::Printf(TEXT("No idle intersection ticks [%d]"), IntersectionCounts[i]), IdleTickCounts[i], 0);
+		TestEqual(FString::Printf(TEXT("One tick while visiting [%d]"), IntersectionCounts[i]), VisitTickCounts[i], 1);
+	}
+
+	TestEqual("Ticks disabled again after leaving", CountEnabledTicks(Intersections), 0);
+
+	TestWorld->DestroyWorld(false);
+	return true;
+}
+
+// Per-tick cost of the bike movement update across a field of riders
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeMovementTickCostPerformanceTest,
+	"BikeAdventure.Performance.MovementTickCost",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeMovementTickCostPerformanceTest::RunTest(const FString& Parameters)
+{
+	UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	TestNotNull("Test world created", TestWorld);
+
+	if (!TestWorld)
+	{
+		return false;
+	}
+
+	BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(0.0f, 0.0f, -50.0f), FVector(1000000.0f, 1000000.0f, 50.0f));
+
+	const int32 NumBikes = 100;
+	const int32 NumFrames = 600;
+	const float FrameTime = 1.0f / 60.0f;
+
+	TArray<UBikeMovementComponent*> Movements;
+	for (int32 i = 0; i < NumBikes; i++)
+	{
+		ABikeCharacter* Bike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, i * 500.0f, 100.0f), FRotator::ZeroRotator);
+		if (UBikeMovementComponent* BikeMovement = Bike ? Bike->GetBikeMovement() : nullptr)
+		{
+			BikeMovement->SetThrottle(1.0f);
+			Movements.Add(BikeMovement);
+		}
+	}
+	TestEqual("Every bike has a movement component", Movements.Num(), NumBikes);
+
+	// Gentle weaving keeps steering, tilt and rotation on the measured path
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		const float Steering = FMath::Sin(Frame * 0.05f) * 0.5f;
+		for (UBikeMovementComponent* BikeMovement : Movements)
+		{
+			BikeMovement->SetSteering(Steering);
+			BikeMovement->UpdateMovement(FrameTime);
+		}
+	}
+	const double UpdateTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 MovingBikes = 0;
+	for (UBikeMovementComponent* BikeMovement : Movements)
+	{
+		MovingBikes += BikeMovement->GetCurrentSpeed() > 0.0f ? 1 : 0;
+	}
+
+	const double MicrosecondsPerUpdate = (UpdateTime / (NumBikes * NumFrames)) * 1e6;
+
+	UE_LOG(LogTemp, Warning, TEXT("Movement Tick Cost Results (%d bikes, %d frames):"), NumBikes, NumFrames);
+	UE_LOG(LogTemp, Warning, TEXT("UpdateMovement: %.2f us/bike/frame, hot state %d bytes"), MicrosecondsPerUpdate, static_cast<int32>(sizeof(FBikeMovementState)));
+
+	TestEqual("Every bike is moving", MovingBikes, Movements.Num());
+	TestTrue("Movement update stays under 20us per bike", MicrosecondsPerUpdate < 20.0);
+
+	TestWorld->DestroyWorld(false);
+	return true;
+}
+
+// Save size and time with a long run's worth of intersection choices
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGamePerformanceTest,
+	"BikeAdventure.Performance.SaveGame",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSaveGamePerformanceTest::RunTest(const FString& Parameters)
+{
+	const int32 NumChoices = 100000;
+	const int32 NumAppended = 50;
+
+	FBikeChoiceLog Log;
+	Log.Reserve(NumChoices + NumAppended);
+	FRandomStream Random(4242);
+	for (int32 i = 0; i < NumChoices; i++)
+	{
+		Log.Add(Random.FRand() < 0.5f, static_cast<EBiomeType>(Random.RandRange(0, BiomeTables::NumBiomes - 1)),
+			static_cast<EPathPersonality>(Random.RandRange(0, PathPersonalityTables::NumPersonalities - 1)));
+	}
+
+	FBikeSaveCounters Counters;
+	Counters.TotalChoices = NumChoices;
+	Counters.PersonalityPreferences.Init(0.5f, PathPersonalityTables::NumPersonalities);
+	FDiscoverySaveState Discoveries;
+	Discoveries.BiomeWideFound.Init(true, 200);
+	for (int32 i = 0; i < 1000; i++)
+	{
+		Discoveries.FoundNames.Add(FName(TEXT("Hollow Oak"), i + 1));
+	}
+
+	const FString SavePath = FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("SaveGame_Performance.bsav");
+
+	// Full save: capture, encode and write
+	double StartTime = FPlatformTime::Seconds();
+	TArray<uint8> Packed;
+	Log.CopyRange(0, Log.Num(), Packed);
+	const double CaptureTime = FPlatformTime::Seconds() - StartTime;
+
+	TArray<uint8> Bytes;
+	BikeSaveFormat::WriteFileHeader(Bytes);
+	BikeSaveFormat::WriteCounters(Counters, Bytes);
+	BikeSaveFormat::WriteDiscoveries(Discoveries, Bytes);
+	BikeSaveFormat::WriteChoices(0, Log.Num(), Packed, Bytes);
+	const bool bSaved = FFileHelper::SaveArrayToFile(Bytes, *SavePath);
+	const double FullSaveTime = FPlatformTime::Seconds() - StartTime;
+	const int32 FullSize = Bytes.Num();
+
+	// Incremental save after a few more intersections
+	for (int32 i = 0; i < NumAppended; i++)
+	{
+		Log.Add(i % 2 == 0, EBiomeType::Forest, EPathPersonality::Scenic);
+	}
+	StartTime = FPlatformTime::Seconds();
+	Log.CopyRange(NumChoices, NumAppended, Packed);
+	TArray<uint8> Appended;
+	BikeSaveFormat::WriteCounters(Counters, Appended);
+	BikeSaveFormat::WriteDiscoveries(Discoveries, Appended);
+	BikeSaveFormat::WriteChoices(NumChoices, NumAppended, Packed, Appended);
+	const bool bAppended = FFileHelper::SaveArrayToFile(Appended, *SavePath, &IFileManager::Get(), FILEWRITE_Append);
+	const double IncrementalSaveTime = FPlatformTime::Seconds() - StartTime;
+
+	// Load everything back
+	StartTime = FPlatformTime::Seconds();
+	TArray<uint8> Loaded;
+	FBikeSaveSnapshot Snapshot;
+	const bool bLoaded = FFileHelper::LoadFileToArray(Loaded, *SavePath) && BikeSaveFormat::Read(Loaded, Snapshot);
+	const double LoadTime = FPlatformTime::Seconds() - StartTime;
+	IFileManager::Get().Delete(*SavePath);
+
+	// One byte per choice is the naive packed baseline
+	const double BytesPerChoice = static_cast<double>(FullSize) / NumChoices;
+
+	UE_LOG(LogTemp, Warning, TEXT("Save Game Results (%d choices, %d discoveries):"), NumChoices, Discoveries.BiomeWideFound.Num() + Discoveries.FoundNames.Num());
+	UE_LOG(LogTemp, Warning, TEXT("Full save: %d bytes (%.3f bytes/choice), capture %.3f ms, total %.2f ms"), FullSize, BytesPerChoice, CaptureTime * 1000.0, FullSaveTime * 1000.0);
+	UE_LOG(LogTemp, Warning, TEXT("Incremental save of %d choices: %d bytes, %.3f ms"), NumAppended, Appended.Num(), IncrementalSaveTime * 1000.0);
+	UE_LOG(LogTemp, Warning, TEXT("Load: %d bytes, %.2f ms"), Loaded.Num(), LoadTime * 1000.0);
+
+	TestTrue("Save written", bSaved && bAppended);
+	TestTrue("Save loaded", bLoaded);
+	TestEqual("Every choice loaded", Snapshot.Choices.Num(), NumChoices + NumAppended);
+	TestEqual("Located discoveries loaded", Snapshot.Discoveries.FoundNames.Num(), Discoveries.FoundNames.Num());
+	TestTrue("Choices stored in under one byte each", BytesPerChoice < 1.0);
+	TestTrue("Incremental save only writes what changed", Appended.Num() < 1024 * 4);
+	TestTrue("Game thread capture stays under 1ms", CaptureTime < 0.001);
+
+	return true;
+}
+
+// Batched path NPC locomotion for a dense crowd
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCrowdSimulationPerformanceTest,
+	"BikeAdventure.Performance.CrowdSimulation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCrowdSimulationPerformanceTest::RunTest(const FString& Parameters)
+{
+	// A winding 2km path
+	USplineComponent* Spline = NewObject<USplineComponent>();
+	Spline->ClearSplinePoints(false);
+	for (int32 i = 0; i < 20; i++)
+	{
+		Spline->AddSplinePoint(FVector(i * 10000.0f, (i % 2) * 4000.0f, (i % 3) * 300.0f), ESplineCoordinateSpace::Local, false);
+	}
+	Spline->UpdateSpline();
+
+	const int32 NumAgents = 10000;
+	const int32 Frames = 120;
+	const float DeltaTime = 1.0f / 60.0f;
+
+	FPathCrowdSimulation Simulation;
+	Simulation.BuildTrack(*Spline);
+	FRandomStream Random(777);
+	for (int32 i = 0; i < NumAgents; i++)
+	{
+		Simulation.AddAgent(Random.FRandRange(0.0f, Simulation.GetTrackLength()), Random.FRandRange(-150.0f, 150.0f),
+			Random.FRandRange(-150.0f, 150.0f), Random.FRandRange(0.0f, UE_TWO_PI));
+	}
+
+	// Warm the worker threads
+	Simulation.Step(DeltaTime);
+
+	double WorstFrame = 0.0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < Frames; Frame++)
+	{
+		const double FrameStart = FPlatformTime::Seconds();
+		Simulation.Step(DeltaTime);
+		WorstFrame = FMath::Max(WorstFrame, FPlatformTime::Seconds() - FrameStart);
+	}
+	const double AverageFrame = (FPlatformTime::Seconds() - StartTime) / Frames;
+
+	int32 OffPath = 0;
+	for (int32 i = 0; i < NumAgents; i++)
+	{
+		const float Distance = Simulation.GetAgentDistance(i);
+		OffPath += (Distance < 0.0f || Distance > Simulation.GetTrackLength()) ? 1 : 0;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("Crowd Simulation Results (%d agents):"), NumAgents);
+	UE_LOG(LogTemp, Warning, TEXT("Step: %.3f ms average, %.3f ms worst, %.1f ns/agent"), AverageFrame * 1000.0, WorstFrame * 1000.0, AverageFrame * 1e9 / NumAgents);
+
+	TestEqual("Every agent stays on the path", OffPath, 0);
+	TestTrue("10k agents step within 1ms", AverageFrame < 0.001);
+
+	return true;
+}
@@ -1,15 +1,31 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
+#include "BikeAdventureTests.h"
 #include "CoreMinimal.h"
 #include "Misc/AutomationTest.h"
 #include "Tests/AutomationCommon.h"
 #include "Engine/World.h"
-#include "Core/BikeMovementComponent.h"
+#include "Core/BikeCharacter.h"
+#include "Systems/BikeMovementComponent.h"
 #include "GameFramework/Actor.h"
 
+namespace
+{
+	// One simulation step per update keeps frame counts and step counts aligned
+	constexpr float MovementTestFrameTime = 1.0f / 60.0f;
+
+	void RunMovementFrames(UBikeMovementComponent* BikeMovement, int32 Frames)
+	{
+		for (int32 i = 0; i < Frames; i++)
+		{
+			BikeMovement->UpdateMovement(MovementTestFrameTime);
+		}
+	}
+}
+
 // Basic bike movement test
-IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeMovementBasicTest, 
-	"BikeAdventure.Unit.Movement.BasicMovement", 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeMovementBasicTest,
+	"BikeAdventure.Unit.Movement.BasicMovement",
 	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
 
 bool FBikeMovementBasicTest::RunTest(const FString& Parameters)
@@ -23,60 +39,63 @@ bool FBikeMovementBasicTest::RunTest(const FString& Parameters)
 		return false;
 	}
 
-	// Create test actor with bike movement component
-	AActor* TestActor = TestWorld->SpawnActor<AActor>();
-	TestNotNull("Test actor created", TestActor);
+	BikeAdventureTests::SpawnStaticBox(TestWorld);
+
+	// Create test bike with its movement component
+	ABikeCharacter* TestBike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+	TestNotNull("Test bike created", TestBike);
 
-	UBikeMovementComponent* BikeMovement = NewObject<UBikeMovementComponent>(TestActor);
+	UBikeMovementComponent* BikeMovement = TestBike ? TestBike->GetBikeMovement() : nullptr;
 	TestNotNull("Bike movement component created", BikeMovement);
 
-	if (!TestActor || !BikeMovement)
+	if (!BikeMovement)
 	{
+		TestWorld->DestroyWorld(false);
 		return false;
 	}
 
-	// Initialize component
-	BikeMovement->RegisterComponent();
-	TestActor->AddOwnedComponent(BikeMovement);
-
 	// Test initial state
 	TestEqual("Initial velocity is zero", BikeMovement->GetVelocity(), FVector::ZeroVector);
 	TestEqual("Initial angular velocity is zero", BikeMovement->GetAngularVelocity(), FVector::ZeroVector);
+	TestEqual("Initial speed is zero", BikeMovement->GetCurrentSpeed(), 0.0f);
 
 	// Test throttle input
 	BikeMovement->SetThrottle(1.0f);
-	BikeMovement->UpdateMovement(0.016f); // 60fps frame time
+	RunMovementFrames(BikeMovement, 1);
 
 	TestTrue("Bike moves forward with throttle", BikeMovement->GetVelocity().X > 0);
 	TestTrue("Forward velocity is reasonable", BikeMovement->GetVelocity().Size() < BikeMovement->GetMaxSpeed());
 
-	// Test steering
+	// Test speed approaches the target forward speed
+	RunMovementFrames(BikeMovement, 120);
+	TestTrue("Speed approaches target forward speed", FMath::Abs(BikeMovement->GetCurrentSpeed() - BikeMovement->ForwardSpeed) < 50.0f);
+	TestTrue("Speed respects maximum limit", BikeMovement->GetVelocity().Size() <= BikeMovement->GetMaxSpeed() + 1.0f); // Small tolerance
+
+	// Test steering in both directions
+	float InitialYaw = TestBike->GetActorRotation().Yaw;
 	BikeMovement->SetSteering(1.0f);
-	BikeMovement->UpdateMovement(0.016f);
+	RunMovementFrames(BikeMovement, 60);
 
-	TestTrue("Bike turns with steering input", FMath::Abs(BikeMovement->GetAngularVelocity().Z) > 0);
+	TestTrue("Bike turns with steering input", BikeMovement->GetAngularVelocity().Z > 0);
+	TestTrue("Positive steering turns right", FRotator::NormalizeAxis(TestBike->GetActorRotation().Yaw - InitialYaw) > 0.0f);
 
-	// Test speed limits
-	for (int i = 0; i < 100; i++) // Simulate extended acceleration
-	{
-		BikeMovement->UpdateMovement(0.016f);
-	}
+	InitialYaw = TestBike->GetActorRotation().Yaw;
+	BikeMovement->SetSteering(-1.0f);
+	RunMovementFrames(BikeMovement, 60);
+	TestTrue("Negative steering turns left", FRotator::NormalizeAxis(TestBike->GetActorRotation().Yaw - InitialYaw) < 0.0f);
 
-	TestTrue("Speed respects maximum limit", BikeMovement->GetVelocity().Size() <= BikeMovement->GetMaxSpeed() + 1.0f); // Small tolerance
+	// Test tilt follows steering
+	TestTrue("Bike leans into the turn", BikeMovement->GetMovementState().TiltAngle < 0.0f);
 
-	// Test throttle clamping
+	// Test input clamping
 	BikeMovement->SetThrottle(2.0f); // Over maximum
-	BikeMovement->UpdateMovement(0.016f);
-	// Should not crash or cause issues
-
+	TestEqual("Throttle clamped high", BikeMovement->GetMovementState().Throttle, 1.0f);
 	BikeMovement->SetThrottle(-1.0f); // Under minimum
-	BikeMovement->UpdateMovement(0.016f);
-	// Should not crash or cause issues
+	TestEqual("Throttle clamped low", BikeMovement->GetMovementState().Throttle, 0.0f);
 
-	// Test steering clamping
 	BikeMovement->SetSteering(5.0f);
-	BikeMovement->UpdateMovement(0.016f);
-	TestTrue("Steering input is clamped", FMath::Abs(BikeMovement->GetAngularVelocity().Z) <= 90.0f + 1.0f);
+	RunMovementFrames(BikeMovement, 120);
+	TestTrue("Steering input is clamped", FMath::Abs(BikeMovement->GetAngularVelocity().Z) <= BikeMovement->MaxTurnRate + 1.0f);
 
 	// Cleanup
 	TestWorld->DestroyWorld(false);
@@ -100,47 +119,108 @@ bool FBikeMovementPhysicsTest::RunTest(const FString& Parameters)
 		return false;
 	}
 
-	AActor* TestActor = TestWorld->SpawnActor<AActor>();
-	UBikeMovementComponent* BikeMovement = NewObject<UBikeMovementComponent>(TestActor);
-	BikeMovement->RegisterComponent();
-	TestActor->AddOwnedComponent(BikeMovement);
+	BikeAdventureTests::SpawnStaticBox(TestWorld);
 
-	// Test friction behavior
+	ABikeCharacter* TestBike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+	UBikeMovementComponent* BikeMovement = TestBike ? TestBike->GetBikeMovement() : nullptr;
+	TestNotNull("Bike movement component created", BikeMovement);
+
+	if (!BikeMovement)
+	{
+		TestWorld->DestroyWorld(false);
+		return false;
+	}
+
+	// Test coasting behavior
 	BikeMovement->SetThrottle(1.0f);
-	BikeMovement->UpdateMovement(0.016f);
+	RunMovementFrames(BikeMovement, 60);
 	float InitialSpeed = BikeMovement->GetVelocity().Size();
 
 	BikeMovement->SetThrottle(0.0f); // No more throttle
-	BikeMovement->UpdateMovement(0.016f);
+	RunMovementFrames(BikeMovement, 1);
 	float SpeedAfterFriction = BikeMovement->GetVelocity().Size();
 
-	TestTrue("Friction reduces speed", SpeedAfterFriction < InitialSpeed);
+	TestTrue("Coasting reduces speed", SpeedAfterFriction < InitialSpeed);
 
 	// Test that bike eventually stops without throttle
-	for (int i = 0; i < 1000; i++)
-	{
-		BikeMovement->UpdateMovement(0.016f);
-	}
-
-	TestTrue("Bike eventually stops due to friction", BikeMovement->GetVelocity().Size() < 1.0f);
+	RunMovementFrames(BikeMovement, 1000);
+	TestTrue("Bike eventually stops", BikeMovement->GetVelocity().Size() < 1.0f);
 
 	// Test turning physics
-	FVector InitialPosition = TestActor->GetActorLocation();
-	FRotator InitialRotation = TestActor->GetActorRotation();
+	FVector InitialPosition = TestBike->GetActorLocation();
+	FRotator InitialRotation = TestBike->GetActorRotation();
 
 	BikeMovement->SetThrottle(1.0f);
 	BikeMovement->SetSteering(1.0f);
+	RunMovementFrames(BikeMovement, 60); // 1 second at 60fps
+
+	TestTrue("Bike moved", FVector::Dist2D(TestBike->GetActorLocation(), InitialPosition) > 0.0f);
+	TestTrue("Bike rotated", !TestBike->GetActorRotation().Equals(InitialRotation, 1.0f));
+	TestTrue("Velocity follows the heading", BikeMovement->GetVelocity().GetSafeNormal().Equals(TestBike->GetActorForwardVector(), 0.01f));
 
-	for (int i = 0; i < 60; i++) // 1 second at 60fps
+	// Without ground under it the bike does not drive
+	ABikeCharacter* AirborneBike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 5000.0f), FRotator::ZeroRotator);
+	if (UBikeMovementComponent* AirborneMovement = AirborneBike ? AirborneBike->GetBikeMovement() : nullptr)
 	{
-		BikeMovement->UpdateMovement(0.016f);
+		AirborneMovement->SetThrottle(1.0f);
+		RunMovementFrames(AirborneMovement, 10);
+		TestFalse("Airborne bike has no ground contact", AirborneMovement->IsOnGround());
+		TestEqual("Airborne bike does not accelerate", AirborneMovement->GetVelocity(), FVector::ZeroVector);
 	}
 
-	TestTrue("Actor moved forward", TestActor->GetActorLocation().X > InitialPosition.X);
-	TestTrue("Actor rotated", !TestActor->GetActorRotation().Equals(InitialRotation, 1.0f));
-
 	// Cleanup
 	TestWorld->DestroyWorld(false);
 
 	return true;
-}
\ No newline at end of file
+}
+
+// Intersection mode slows the bike and releases it again
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeMovementIntersectionModeTest,
+	"BikeAdventure.Unit.Movement.IntersectionMode",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeMovementIntersectionModeTest::RunTest(const FString& Parameters)
+{
+	UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	TestNotNull("Test world created", TestWorld);
+
+	if (!TestWorld)
+	{
+		return false;
+	}
+
+	BikeAdventureTests::SpawnStaticBox(TestWorld);
+
+	ABikeCharacter* TestBike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+	UBikeMovementComponent* BikeMovement = TestBike ? TestBike->GetBikeMovement() : nullptr;
+	TestNotNull("Bike movement component created", BikeMovement);
+
+	if (!BikeMovement)
+	{
+		TestWorld->DestroyWorld(false);
+		return false;
+	}
+
+	// Let bike reach normal speed first
+	BikeMovement->SetThrottle(1.0f);
+	RunMovementFrames(BikeMovement, 120);
+	const float NormalSpeed = BikeMovement->GetCurrentSpeed();
+
+	// Enable intersection mode and let speed adjust
+	BikeMovement->SetIntersectionMode(true);
+	TestTrue("Intersection mode enabled", BikeMovement->IsInIntersectionMode());
+	TestEqual("Max speed drops to intersection speed", BikeMovement->GetMaxSpeed(), BikeMovement->IntersectionSpeed);
+	RunMovementFrames(BikeMovement, 120);
+
+	const float SlowedSpeed = BikeMovement->GetCurrentSpeed();
+	TestTrue("Intersection mode reduces speed", SlowedSpeed < NormalSpeed);
+	TestTrue("Intersection speed close to target", FMath::Abs(SlowedSpeed - BikeMovement->IntersectionSpeed) < 50.0f);
+
+	// Disable intersection mode and let speed adjust back
+	BikeMovement->SetIntersectionMode(false);
+	RunMovementFrames(BikeMovement, 120);
+	TestTrue("Speed restores after leaving intersection", FMath::Abs(BikeMovement->GetCurrentSpeed() - NormalSpeed) < 50.0f);
+
+	TestWorld->DestroyWorld(false);
+	return true;
+}
@@ -0,0 +1,444 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BikeAdventureTests.h"
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Core/BikeCharacter.h"
+#include "Systems/BikeMovementComponent.h"
+#include "GameFramework/Actor.h"
+#include "Camera/CameraComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Systems/WorldStreamingManager.h"
+
+// Fixed-step bike simulation must not depend on how frame time is sliced
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeFixedStepDeterminismTest,
+	"BikeAdventure.Unit.Movement.FixedStepDeterminism",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeFixedStepDeterminismTest::RunTest(const FString& Parameters)
+{
+	UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	TestNotNull("Test world created", TestWorld);
+
+	if (!TestWorld)
+	{
+		return false;
+	}
+
+	// Flat ground for the ground contact trace
+	BikeAdventureTests::SpawnStaticBox(TestWorld);
+
+	// Frame slicings covering the same four seconds; 1/64 steps keep every delta exact in binary
+	const float Step = 1.0f / 64.0f;
+	TArray<TArray<float>> FramePatterns;
+	FramePatterns.AddDefaulted(4);
+	FramePatterns[0].Init(Step, 256);
+	FramePatterns[1].Init(Step * 2.0f, 128);
+	for (int32 i = 0; i < 64; i++)
+	{
+		FramePatterns[2].Add(Step);
+		FramePatterns[2].Add(Step * 3.0f);
+	}
+	FramePatterns[3].Add(Step * 8.0f); // A hitch within the substep budget
+	FramePatterns[3].Add(Step * 0.5f);
+	FramePatterns[3].Add(Step * 0.5f);
+	for (int32 i = 0; i < 247; i++)
+	{
+		FramePatterns[3].Add(Step);
+	}
+
+	TArray<FVector> Displacements;
+	TArray<float> Yaws;
+	TArray<int32> StepCounts;
+
+	for (int32 PatternIndex = 0; PatternIndex < FramePatterns.Num(); PatternIndex++)
+	{
+		const FVector Start(0.0f, PatternIndex * 20000.0f, 100.0f);
+		ABikeCharacter* Bike = TestWorld->SpawnActor<ABikeCharacter>(Start, FRotator::ZeroRotator);
+		UBikeMovementComponent* Movement = Bike ? Bike->GetBikeMovement() : nullptr;
+		TestNotNull("Bike movement available", Movement);
+
+		if (!Movement)
+		{
+			TestWorld->DestroyWorld(false);
+			return false;
+		}
+
+		Movement->FixedTimeStep = Step;
+		Movement->SetThrottle(1.0f);
+		Movement->SetSteering(0.3f);
+
+		for (float FrameTime : FramePatterns[PatternIndex])
+		{
+			Movement->UpdateMovement(FrameTime);
+		}
+
+		Displacements.Add(Bike->GetActorLocation() - Start);
+		Yaws.Add(Bike->GetActorRotation().Yaw);
+		StepCounts.Add(Movement->GetSimulationStepCount());
+	}
+
+	TestEqual("Four seconds simulate 256 steps", StepCounts[0], 256);
+	TestTrue("Bike moved forward", Displacements[0].X > 1000.0f);
+
+	for (int32 i = 1; i < FramePatterns.Num(); i++)
+	{
+		TestEqual(FString::Printf(TEXT("Step count matches [%d]"), i), StepCounts[i], StepCounts[0]);
+		TestTrue(FString::Printf(TEXT("Trajectory matches [%d]"), i), Displacements[i].Equals(Displacements[0], 0.01f));
+		TestEqual(FString::Printf(TEXT("Heading matches [%d]"), i), Yaws[i], Yaws[0], 0.001f);
+	}
+
+	// A hitch beyond the substep budget drops the excess instead of catching up later
+	ABikeCharacter* HitchBike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, -20000.0f, 100.0f), FRotator::ZeroRotator);
+	UBikeMovementComponent* HitchMovement = HitchBike ? HitchBike->GetBikeMovement() : nullptr;
+	if (HitchMovement)
+	{
+		HitchMovement->FixedTimeStep = Step;
+		HitchMovement->MaxSubstepsPerFrame = 4;
+		HitchMovement->UpdateMovement(Step * 10.5f);
+		TestEqual("Hitch limited to the substep budget", HitchMovement->GetSimulationStepCount(), 4);
+		TestTrue("Leftover time stays below one step", HitchMovement->GetInterpolationAlpha() < 1.0f);
+	}
+
+	TestWorld->DestroyWorld(false);
+	return true;
+}
+
+// Cached ground probes must agree with per-step traces while issuing far fewer of them
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeGroundProbeCacheTest,
+	"BikeAdventure.Unit.Movement.GroundProbeCache",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeGroundProbeCacheTest::RunTest(const FString& Parameters)
+{
+	UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	TestNotNull("Test world created", TestWorld);
+
+	if (!TestWorld)
+	{
+		return false;
+	}
+
+	// Forest floor of tiles with trunks lining the path and a canopy overhead
+	for (int32 Tile = 0; Tile < 40; Tile++)
+	{
+		BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(Tile * 500.0f, 0.0f, -50.0f), FVector(250.0f, 2000.0f, 50.0f));
+		BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(Tile * 500.0f, 600.0f, 500.0f), FVector(40.0f, 40.0f, 500.0f));
+		BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(Tile * 500.0f, -600.0f, 500.0f), FVector(40.0f, 40.0f, 500.0f));
+		BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(Tile * 500.0f, 0.0f, 1200.0f), FVector(250.0f, 800.0f, 20.0f));
+	}
+
+	const float Step = 1.0f / 64.0f;
+	const int32 StepCount = 640;
+
+	TArray<bool> GroundContacts[2];
+	FVector FinalLocations[2];
+	float TracesPerSecond[2] = { 0.0f, 0.0f };
+	int32 CacheHits = 0;
+
+	for (int32 Run = 0; Run < 2; Run++)
+	{
+		const bool bUseCache = Run == 1;
+		ABikeCharacter* Bike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+		UBikeMovementComponent* Movement = Bike ? Bike->GetBikeMovement() : nullptr;
+		TestNotNull("Bike movement available", Movement);
+
+		if (!Movement)
+		{
+			TestWorld->DestroyWorld(false);
+			return false;
+		}
+
+		Movement->FixedTimeStep = Step;
+		Movement->bUseGroundProbeCache = bUseCache;
+		Movement->SetThrottle(1.0f);
+
+		for (int32 i = 0; i < StepCount; i++)
+		{
+			Movement->UpdateMovement(Step);
+			GroundContacts[Run].Add(Movement->IsOnGround());
+		}
+
+		FinalLocations[Run] = Bike->GetActorLocation();
+		TracesPerSecond[Run] = Movement->GetGroundTracesPerSecond();
+		if (bUseCache)
+		{
+			CacheHits = Movement->GetGroundProbeCacheHits();
+		}
+
+		Bike->Destroy();
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("Ground traces per second on forest ride: %.1f per-step, %.1f cached (%d cache hits)"),
+		TracesPerSecond[0], TracesPerSecond[1], CacheHits);
+
+	TestTrue("Bike rode into the forest", FinalLocations[0].X > 2000.0f);
+	TestTrue("Cached ride follows the same trajectory", FinalLocations[1].Equals(FinalLocations[0], 0.01f));
+	TestTrue("Ground contact matches every step", GroundContacts[1] == GroundContacts[0]);
+	TestEqual("Per-step probing traces once per step", TracesPerSecond[0], 1.0f / Step, 0.01f);
+	TestTrue("Cache cuts ground traces by at least 4x", TracesPerSecond[1] * 4.0f < TracesPerSecond[0]);
+
+	TestWorld->DestroyWorld(false);
+	return true;
+}
+
+// The camera boom renders between fixed steps together with the bike mesh
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeCameraInterpolationTest,
+	"BikeAdventure.Unit.Movement.CameraInterpolation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeCameraInterpolationTest::RunTest(const FString& Parameters)
+{
+	UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	TestNotNull("Test world created", TestWorld);
+
+	if (!TestWorld)
+	{
+		return false;
+	}
+
+	BikeAdventureTests::SpawnStaticBox(TestWorld);
+
+	ABikeCharacter* Bike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+	UBikeMovementComponent* Movement = Bike ? Bike->GetBikeMovement() : nullptr;
+	UCameraComponent* Camera = Bike ? Bike->FindComponentByClass<UCameraComponent>() : nullptr;
+	TestNotNull("Bike movement available", Movement);
+	TestNotNull("Bike camera available", Camera);
+
+	if (!Movement || !Camera)
+	{
+		TestWorld->DestroyWorld(false);
+		return false;
+	}
+
+	// BeginPlay registers the interpolated components
+	Bike->DispatchBeginPlay();
+
+	const float Step = 1.0f / 64.0f;
+	Movement->FixedTimeStep = Step;
+	Movement->SetThrottle(1.0f);
+
+	// Get up to speed, ending exactly on a step boundary
+	for (int32 i = 0; i < 64; i++)
+	{
+		Movement->UpdateMovement(Step);
+	}
+
+	const FVector CameraAtStep = Camera->GetComponentLocation();
+	const FVector ActorAtStep = Bike->GetActorLocation();
+
+	// Half a step: no simulation runs, so only interpolation can move the camera
+	Movement->UpdateMovement(Step * 0.5f);
+	const FVector CameraBetweenSteps = Camera->GetComponentLocation();
+	TestTrue("Actor holds its simulated transform between steps", Bike->GetActorLocation().Equals(ActorAtStep, 0.001f));
+
+	Movement->UpdateMovement(Step * 0.5f);
+	const FVector CameraAtNextStep = Camera->GetComponentLocation();
+
+	TestTrue("Camera moves on every step", FVector::Dist(CameraAtStep, CameraAtNextStep) > 1.0f);
+	TestTrue("Camera renders halfway between steps", CameraBetweenSteps.Equals((CameraAtStep + CameraAtNextStep) * 0.5f, 0.1f));
+
+	TestWorld->DestroyWorld(false);
+	return true;
+}
+
+// Path-follow mode advances by distance along the spline and hands back to free steering at its end
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikePathFollowTest,
+	"BikeAdventure.Unit.Movement.PathFollow",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikePathFollowTest::RunTest(const FString& Parameters)
+{
+	UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	TestNotNull("Test world created", TestWorld);
+
+	if (!TestWorld)
+	{
+		return false;
+	}
+
+	BikeAdventureTests::SpawnStaticBox(TestWorld);
+
+	// Gentle S-bend starting under the bike
+	const TArray<FVector> ControlPoints = { FVector(0.0f, 0.0f, 0.0f), FVector(2000.0f, 300.0f, 0.0f), FVector(4000.0f, -300.0f, 0.0f), FVector(6000.0f, 0.0f, 0.0f) };
+	TSharedRef<FPathSpline> Path = MakeShared<FPathSpline>();
+	Path->Build(ControlPoints);
+	Path->StartDistance = 100000.0f;
+
+	ABikeCharacter* Bike = TestWorld->SpawnActor<ABikeCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+	UBikeMovementComponent* Movement = Bike ? Bike->GetBikeMovement() : nullptr;
+	TestNotNull("Bike movement available", Movement);
+
+	if (!Movement)
+	{
+		TestWorld->DestroyWorld(false);
+		return false;
+	}
+
+	const float Step = 1.0f / 64.0f;
+	Movement->FixedTimeStep = Step;
+	Movement->SetThrottle(1.0f);
+	Movement->SetSteering(1.0f); // Ignored while following
+	Movement->FollowPath(Path);
+
+	TestTrue("Following the path", Movement->IsFollowingPath());
+	TestEqual("Joined at the start of the path", Movement->GetPathDistance(), 100000.0f, 1.0f);
+
+	bool bStayedOnPath = true;
+	bool bDistanceMatchesSpeed = true;
+	float PreviousPathDistance = Movement->GetPathDistance();
+
+	for (int32 i = 0; i < 192 && Movement->IsFollowingPath(); i++)
+	{
+		Movement->UpdateMovement(Step);
+		if (!Movement->IsFollowingPath())
+		{
+			break;
+		}
+
+		const float PathDistance = Movement->GetPathDistance();
+		bDistanceMatchesSpeed &= FMath::IsNearlyEqual(PathDistance - PreviousPathDistance, Movement->GetCurrentSpeed() * Step, 0.01f);
+		PreviousPathDistance = PathDistance;
+
+		const FVector OnPath = Path->GetLocationAtDistance(Path->ToLocalDistance(PathDistance));
+		const FVector BikeLocation = Bike->GetActorLocation();
+		bStayedOnPath &= FVector2D::Distance(FVector2D(BikeLocation.X, BikeLocation.Y), FVector2D(OnPath.X, OnPath.Y)) < 1.0f;
+	}
+
+	TestTrue("Bike stays on the spline", bStayedOnPath);
+	TestTrue("Path distance advances by speed times step", bDistanceMatchesSpeed);
+	TestTrue("Bike travelled along the path", PreviousPathDistance > 101000.0f);
+
+	// Ride past the end; with no streamed section ahead the bike returns to free steering
+	for (int32 i = 0; i < 1024 && Movement->IsFollowingPath(); i++)
+	{
+		Movement->UpdateMovement(Step);
+	}
+	TestFalse("Free steering after the path ends", Movement->IsFollowingPath());
+	TestTrue("Stopped near the path end", FVector2D::Distance(FVector2D(Bike->GetActorLocation()), FVector2D(ControlPoints.Last())) < 50.0f);
+
+	TestWorld->DestroyWorld(false);
+	return true;
+}
+
+// A rider following a path crosses into the next streamed section without leaving the path
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeSectionHandoverTest,
+	"BikeAdventure.Unit.Movement.SectionHandover",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeSectionHandoverTest::RunTest(const FString& Parameters)
+{
+	// The streaming manager is a game instance subsystem, so the world needs a game instance
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone();
+	UWorld* TestWorld = GameInstance->GetWorld();
+	UWorldStreamingManager* StreamingManager = GameInstance->GetSubsystem<UWorldStreamingManager>();
+	TestNotNull("Test world created", TestWorld);
+	TestNotNull("Streaming manager available", StreamingManager);
+
+	auto Cleanup = [GameInstance, TestWorld]()
+	{
+		GameInstance->Shutdown();
+		if (TestWorld)
+		{
+			GEngine->DestroyWorldContext(TestWorld);
+			TestWorld->DestroyWorld(false);
+		}
+	};
+
+	if (!TestWorld || !StreamingManager)
+	{
+		Cleanup();
+		return false;
+	}
+
+	// Ground under the two sections the ride crosses
+	const float SectionSize = StreamingManager->GetSectionSize();
+	BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(SectionSize, SectionSize * 0.5f, -50.0f), FVector(SectionSize * 1.5f, SectionSize, 50.0f));
+
+	// Rider near the far edge of the first section, heading into the second
+	const FVector RiderLocation(SectionSize * 0.95f, SectionSize * 0.5f, 100.0f);
+	StreamingManager->UpdateStreamingForPlayer(RiderLocation, FVector(1000.0f, 0.0f, 0.0f));
+
+	TSharedPtr<const FPathSpline> FirstPath = StreamingManager->FindPathSplineAt(RiderLocation);
+	TSharedPtr<const FPathSpline> SecondPath = StreamingManager->FindPathSplineAt(RiderLocation + FVector(SectionSize * 0.5f, 0.0f, 0.0f));
+	TestTrue("Both sections have paths", FirstPath.IsValid() && SecondPath.IsValid() && FirstPath != SecondPath);
+
+	if (!FirstPath.IsValid() || !SecondPath.IsValid())
+	{
+		Cleanup();
+		return false;
+	}
+
+	const FVector FirstEnd = FirstPath->GetLocationAtDistance(FirstPath->GetLength());
+	TestTrue("First path crosses its section", FirstPath->GetLength() >= SectionSize);
+	TestTrue("First path ends on the shared edge", FMath::IsNearlyEqual(FirstEnd.X, SectionSize, 1.0f));
+	TestTrue("Paths join at the crossing point", FirstEnd.Equals(SecondPath->GetLocationAtDistance(0.0f), 1.0f));
+	TestEqual("Distance runs on along the ride graph", SecondPath->StartDistance, FirstPath->ToPathDistance(FirstPath->GetLength()), 1.0f);
+	TestTrue("Ride graph links the sections", StreamingManager->FindNextPathSpline(*FirstPath) == SecondPath);
+
+	// Join the first path a little before its end
+	const float JoinDistance = FirstPath->GetLength() - 1000.0f;
+	const FVector JoinLocation = FirstPath->GetLocationAtDistance(JoinDistance);
+	ABikeCharacter* Bike = TestWorld->SpawnActor<ABikeCharacter>(FVector(JoinLocation.X, JoinLocation.Y, 100.0f), FRotator::ZeroRotator);
+	UBikeMovementComponent* Movement = Bike ? Bike->GetBikeMovement() : nullptr;
+	TestNotNull("Bike movement available", Movement);
+
+	if (!Movement)
+	{
+		Cleanup();
+		return false;
+	}
+
+	const float Step = 1.0f / 64.0f;
+	Movement->FixedTimeStep = Step;
+	Movement->SetThrottle(1.0f);
+	Movement->FollowPath(FirstPath, JoinDistance);
+
+	bool bStayedOnPath = true;
+	bool bDistanceContinuous = true;
+	float PreviousPathDistance = Movement->GetPathDistance();
+
+	for (int32 i = 0; i < 1024 && Movement->GetFollowedPath() != SecondPath; i++)
+	{
+		Movement->UpdateMovement(Step);
+		if (!Movement->IsFollowingPath())
+		{
+			break;
+		}
+
+		const float PathDistance = Movement->GetPathDistance();
+		bDistanceContinuous &= PathDistance >= PreviousPathDistance && PathDistance - PreviousPathDistance <= Movement->GetCurrentSpeed() * Step + 0.01f;
+		PreviousPathDistance = PathDistance;
+
+		TSharedPtr<const FPathSpline> Path = Movement->GetFollowedPath();
+		const FVector OnPath = Path->GetLocationAtDistance(Path->ToLocalDistance(PathDistance));
+		bStayedOnPath &= FVector2D::Distance(FVector2D(Bike->GetActorLocation()), FVector2D(OnPath)) < 1.0f;
+	}
+
+	TestTrue("Handed over to the next section's path", Movement->GetFollowedPath() == SecondPath);
+	TestTrue("Still following after the boundary", Movement->IsFollowingPath());
+	TestTrue("Bike crossed into the second section", Bike->GetActorLocation().X > SectionSize);
+	TestTrue("Bike stays on the splines", bStayedOnPath);
+	TestTrue("Path distance is continuous across the boundary", bDistanceContinuous);
+
+	// A wall across the path: the path distance must stop with the bike
+	const float WallDistance = SecondPath->ToLocalDistance(Movement->GetPathDistance()) + 500.0f;
+	const FVector WallLocation = SecondPath->GetLocationAtDistance(WallDistance);
+	BikeAdventureTests::SpawnStaticBox(TestWorld, FVector(WallLocation.X, WallLocation.Y, 200.0f), FVector(20.0f, 1000.0f, 300.0f));
+
+	for (int32 i = 0; i < 128 && Movement->IsFollowingPath(); i++)
+	{
+		Movement->UpdateMovement(Step);
+	}
+
+	const float BlockedLocalDistance = SecondPath->ToLocalDistance(Movement->GetPathDistance());
+	TestTrue("Still following while blocked", Movement->IsFollowingPath());
+	TestTrue("Path distance stops at the wall", BlockedLocalDistance < WallDistance);
+	TestEqual("Path distance matches where the bike is", BlockedLocalDistance, SecondPath->FindNearestDistance(Bike->GetActorLocation(), BlockedLocalDistance), 50.0f);
+
+	Cleanup();
+	return true;
+}
@@ -4,6 +4,11 @@
 #include "Misc/AutomationTest.h"
 #include "Tests/AutomationCommon.h"
 #include "Systems/BiomeGenerator.h"
+#include "Core/BiomeTypes.h"
+#include "Core/BiomeTransitionSampler.h"
+#include "Systems/AdvancedBiomePCGSettings.h"
+#include "Systems/BiomeAssetPrefetcher.h"
+#include "Engine/StaticMesh.h"
 
 // Basic biome generation test
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBiomeGenerationBasicTest,
@@ -156,4 +161,307 @@ bool FBiomeDiversityTest::RunTest(const FString& Parameters)
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+// Compile-time biome table consistency test
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBiomeTablesConsistencyTest,
+	"BikeAdventure.Unit.WorldGen.BiomeTables",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBiomeTablesConsistencyTest::RunTest(const FString& Parameters)
+{
+	for (int32 FromIndex = 0; FromIndex < BiomeTables::NumBiomes; FromIndex++)
+	{
+		const EBiomeType FromBiome = static_cast<EBiomeType>(FromIndex);
+		const FBiomeTransitionRules& Rules = UBiomeUtilities::GetDefaultTransitionRulesRef(FromBiome);
+
+		// Adjacency mask must agree with the ordered transition list
+		for (int32 ToIndex = 0; ToIndex < BiomeTables::NumBiomes; ToIndex++)
+		{
+			const EBiomeType ToBiome = static_cast<EBiomeType>(ToIndex);
+			TestEqual(FString::Printf(TEXT("%s -> %s mask matches list"), *UBiomeUtilities::GetBiomeName(FromBiome), *UBiomeUtilities::GetBiomeName(ToBiome)),
+				UBiomeUtilities::CanBiomesTransition(FromBiome, ToBiome), Rules.ValidTransitions.Contains(ToBiome));
+		}
+
+		TestFalse("Transition to None is invalid", UBiomeUtilities::CanBiomesTransition(FromBiome, EBiomeType::None));
+		TestTrue("Preferred intersections populated", Rules.PreferredIntersectionTypes.Num() > 0);
+
+		// Shared accessors return the same storage every call
+		TestTrue("Rules are shared", &Rules == &UBiomeUtilities::GetDefaultTransitionRulesRef(FromBiome));
+		TestTrue("Params are shared", &UBiomeUtilities::GetDefaultBiomeParamsRef(FromBiome) == &UBiomeUtilities::GetDefaultBiomeParamsRef(FromBiome));
+		TestTrue("Names are interned", &UBiomeUtilities::GetBiomeNameRef(FromBiome) == &UBiomeUtilities::GetBiomeNameRef(FromBiome));
+	}
+
+	TestEqual("Forest path width", UBiomeUtilities::GetDefaultBiomeParams(EBiomeType::Forest).PathWidth, 350.0f);
+	TestEqual("Urban vegetation", UBiomeUtilities::GetDefaultBiomeParams(EBiomeType::Urban).VegetationDensity, 0.4f);
+	TestEqual("None uses constructor defaults", UBiomeUtilities::GetDefaultBiomeParams(EBiomeType::None).PathWidth, FBiomeGenerationParams().PathWidth);
+	TestEqual("Countryside name", UBiomeUtilities::GetBiomeName(EBiomeType::Countryside), FString(TEXT("Countryside")));
+	TestEqual("None name", UBiomeUtilities::GetBiomeName(EBiomeType::None), FString(TEXT("Unknown")));
+	TestEqual("None has no transitions", UBiomeUtilities::GetDefaultTransitionRules(EBiomeType::None).ValidTransitions.Num(), 0);
+
+	return true;
+}
+
+// Alias-table sampler must reproduce the candidate-array selection bit for bit
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBiomeTransitionSamplerEquivalenceTest,
+	"BikeAdventure.Unit.WorldGen.TransitionSamplerEquivalence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBiomeTransitionSamplerEquivalenceTest::RunTest(const FString& Parameters)
+{
+	TestEqual("Sampler distribution version", FBiomeTransitionSampler::DistributionVersion, 1);
+
+	// Reference: the original GetRandomValidTransition, driven by an explicit uniform draw
+	auto ReferenceSample = [](EBiomeType CurrentBiome, const TArray<EBiomeType>& RecentBiomes, float Uniform) -> EBiomeType
+	{
+		const FBiomeTransitionRules& Rules = UBiomeUtilities::GetDefaultTransitionRulesRef(CurrentBiome);
+		TArray<EBiomeType> ValidOptions = Rules.ValidTransitions;
+		if (RecentBiomes.Num() > 0)
+		{
+			if (!Rules.bAllowImmediateReturn)
+			{
+				ValidOptions.Remove(RecentBiomes.Last());
+			}
+
+			int32 ConsecutiveCount = 0;
+			for (int32 i = RecentBiomes.Num() - 1; i >= 0 && RecentBiomes[i] == CurrentBiome; i--)
+			{
+				ConsecutiveCount++;
+			}
+
+			if (ConsecutiveCount >= Rules.MaxConsecutiveSameBiome)
+			{
+				ValidOptions.Remove(CurrentBiome);
+			}
+		}
+
+		if (ValidOptions.Num() == 0)
+		{
+			ValidOptions = Rules.ValidTransitions;
+		}
+
+		if (ValidOptions.Num() == 0)
+		{
+			return EBiomeType::Countryside;
+		}
+
+		// FMath::RandRange(0, N - 1) column selection
+		const int32 N = ValidOptions.Num();
+		return ValidOptions[FMath::Min(FMath::TruncToInt(Uniform * static_cast<float>(N)), N - 1)];
+	};
+
+	FRandomStream Stream(12345);
+	int32 Mismatches = 0;
+
+	for (int32 BiomeIndex = 0; BiomeIndex <= BiomeTables::NumBiomes; BiomeIndex++)
+	{
+		const EBiomeType CurrentBiome = static_cast<EBiomeType>(BiomeIndex);
+
+		for (int32 PreviousIndex = 0; PreviousIndex <= BiomeTables::NumBiomes; PreviousIndex++)
+		{
+			for (int32 RunLength = 0; RunLength <= 4; RunLength++)
+			{
+				// History: optional run of the current biome preceded by the previous biome
+				TArray<EBiomeType> History;
+				if (PreviousIndex < BiomeTables::NumBiomes)
+				{
+					History.Add(static_cast<EBiomeType>(PreviousIndex));
+				}
+				for (int32 i = 0; i < RunLength; i++)
+				{
+					History.Add(CurrentBiome);
+				}
+
+				const FBiomeHistorySignature Signature = FBiomeHistorySignature::FromHistory(CurrentBiome, History);
+
+				for (int32 Draw = 0; Draw < 64; Draw++)
+				{
+					// Include the edges of the range as well as random draws
+					const float Uniform = Draw == 0 ? 0.0f : (Draw == 1 ? 1.0f : Stream.GetFraction());
+					if (ReferenceSample(CurrentBiome, History, Uniform) != FBiomeTransitionSampler::Sample(CurrentBiome, Signature, Uniform))
+					{
+						Mismatches++;
+					}
+				}
+			}
+		}
+	}
+
+	TestEqual("Sampler matches reference selection", Mismatches, 0);
+
+	// Single-entry signatures used by the streaming manager
+	const FBiomeHistorySignature Single = FBiomeHistorySignature::FromSingle(EBiomeType::Forest, EBiomeType::Forest);
+	const FBiomeHistorySignature FromArray = FBiomeHistorySignature::FromHistory(EBiomeType::Forest, { EBiomeType::Forest });
+	TestEqual("FromSingle previous biome", static_cast<int32>(Single.PreviousBiome), static_cast<int32>(FromArray.PreviousBiome));
+	TestEqual("FromSingle run length", Single.ConsecutiveCount, FromArray.ConsecutiveCount);
+
+	// Version 1 is uniform over the filtered candidates
+	const float ExpectedProbability = 1.0f / 3.0f;
+	TestTrue("Uniform candidate probability",
+		FMath::IsNearlyEqual(FBiomeTransitionSampler::GetSampleProbability(EBiomeType::Forest, EBiomeType::Wetlands, FBiomeHistorySignature()), ExpectedProbability));
+	TestEqual("Excluded candidate has zero probability",
+		FBiomeTransitionSampler::GetSampleProbability(EBiomeType::Forest, EBiomeType::Wetlands, FBiomeHistorySignature(EBiomeType::Wetlands, 0)), 0.0f);
+
+	return true;
+}
+
+// Preset warm-up order and non-blocking preset access
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBiomePresetWarmupTest,
+	"BikeAdventure.Unit.WorldGen.BiomePresetWarmup",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBiomePresetWarmupTest::RunTest(const FString& Parameters)
+{
+	// Breadth first over the transition graph: neighbours of the current biome come first
+	TArray<EBiomeType> Order;
+	UBiomePresetManager::GetPredictedBiomeOrder(EBiomeType::Forest, Order);
+	const TArray<EBiomeType> ExpectedFromForest = { EBiomeType::Forest, EBiomeType::Mountains, EBiomeType::Countryside,
+		EBiomeType::Wetlands, EBiomeType::Desert, EBiomeType::Beach, EBiomeType::Urban };
+	TestTrue("Order from Forest follows the transition graph", Order == ExpectedFromForest);
+
+	// With no current biome, the biomes most transitions lead into come first
+	UBiomePresetManager::GetPredictedBiomeOrder(EBiomeType::None, Order);
+	TestEqual("Every biome is ordered", Order.Num(), BiomeTables::NumBiomes);
+	TestTrue("Countryside is the likeliest destination", Order[0] == EBiomeType::Countryside);
+	TestTrue("Wetlands is the least likely destination", Order.Last() == EBiomeType::Wetlands);
+
+	for (int32 Index = 0; Index < BiomeTables::NumBiomes; Index++)
+	{
+		TArray<EBiomeType> Reachable;
+		UBiomePresetManager::GetPredictedBiomeOrder(static_cast<EBiomeType>(Index), Reachable);
+		TestEqual("Order covers every biome", Reachable.Num(), BiomeTables::NumBiomes);
+		TestTrue("Order starts at the current biome", Reachable[0] == static_cast<EBiomeType>(Index));
+	}
+
+	// Presets held in memory resolve at once, so the two-stage load completes inside the request
+	UStaticMesh* Mesh = NewObject<UStaticMesh>(GetTransientPackage(), TEXT("PresetWarmupMesh"));
+	TMap<EBiomeType, TArray<FSoftObjectPath>> PresetPaths;
+	for (EBiomeType BiomeType : { EBiomeType::Forest, EBiomeType::Urban })
+	{
+		UBiomeGenerationPreset* Preset = NewObject<UBiomeGenerationPreset>(GetTransientPackage(),
+			*FString::Printf(TEXT("PresetWarmup%d"), static_cast<int32>(BiomeType)));
+		Preset->TargetBiome = BiomeType;
+		Preset->PrimaryMeshes.Add(Mesh);
+		PresetPaths.Add(BiomeType, { FSoftObjectPath(Preset) });
+	}
+
+	UBiomePresetManager* Manager = NewObject<UBiomePresetManager>();
+	Manager->LoadBiomePresetsFromPaths(PresetPaths);
+
+	TestTrue("Biome with presets is ready", Manager->IsBiomeReady(EBiomeType::Forest));
+	TestEqual("Presets are returned once ready", Manager->GetPresetsForBiome(EBiomeType::Forest).Num(), 1);
+	UBiomeGenerationPreset* ForestPreset = Manager->GetPresetForBiome(EBiomeType::Forest);
+	TestTrue("Default preset is the first one", ForestPreset && ForestPreset->TargetBiome == EBiomeType::Forest);
+
+	TFuture<UBiomeGenerationPreset*> Future = Manager->GetPresetForBiomeAsync(EBiomeType::Forest);
+	TestTrue("Future of a ready biome is fulfilled", Future.IsReady());
+	TestTrue("Future carries the default preset", Future.Get() == ForestPreset);
+
+	// A biome without presets is ready as soon as discovery finishes, and waiters are answered
+	bool bCallbackRan = false;
+	Manager->WhenBiomeReady(EBiomeType::Beach, [&bCallbackRan]() { bCallbackRan = true; });
+	TestTrue("Waiter runs once the biome is ready", bCallbackRan);
+	TestTrue("Biome with no presets is ready", Manager->IsBiomeReady(EBiomeType::Beach));
+	TestNull("Biome with no presets has no default", Manager->GetPresetForBiome(EBiomeType::Beach));
+
+	TFuture<UBiomeGenerationPreset*> MissingFuture = Manager->GetPresetForBiomeAsync(EBiomeType::Beach);
+	TestTrue("Future is fulfilled without waiting", MissingFuture.IsReady());
+	TestNull("Future carries the missing default", MissingFuture.Get());
+
+	// Once the rider is in Forest, biomes beyond RetainDepth are released
+	int32 Distances[BiomeTables::NumBiomes];
+	UBiomeAssetPrefetcher::GetTransitionDistances(EBiomeType::Forest, Distances);
+	TestTrue("Urban is more than one transition from Forest", Distances[static_cast<int32>(EBiomeType::Urban)] > 1);
+
+	TestTrue("Urban was warmed without a rider", Manager->IsBiomeReady(EBiomeType::Urban));
+	Manager->RetainDepth = 1;
+	Manager->UpdateForBiome(EBiomeType::Forest);
+	TestTrue("Current biome stays resident", Manager->IsBiomeReady(EBiomeType::Forest));
+	TestFalse("Far biome is released", Manager->IsBiomeReady(EBiomeType::Urban));
+
+	// A released biome is requested again on demand
+	TestEqual("Released biome returns nothing on the call that requests it", Manager->GetPresetsForBiome(EBiomeType::Urban).Num(), 0);
+	TestTrue("Released biome reloads", Manager->IsBiomeReady(EBiomeType::Urban));
+	TestEqual("Reloaded biome returns its presets", Manager->GetPresetsForBiome(EBiomeType::Urban).Num(), 1);
+
+	TestFalse("Invalid biome is never ready", Manager->IsBiomeReady(EBiomeType::None));
+
+	// A preset whose mesh is not resident stays hidden until the second stage finishes
+	UBiomeGenerationPreset* PendingPreset = NewObject<UBiomeGenerationPreset>(GetTransientPackage(), TEXT("PresetWarmupPending"));
+	PendingPreset->TargetBiome = EBiomeType::Desert;
+	PendingPreset->PrimaryMeshes.Add(TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Game/Tests/PresetWarmup/SM_NotLoaded.SM_NotLoaded"))));
+	Manager->LoadBiomePresetsFromPaths({ { EBiomeType::Desert, { FSoftObjectPath(PendingPreset) } } });
+
+	TestFalse("Biome with assets still loading is not ready", Manager->IsBiomeReady(EBiomeType::Desert));
+	TestNull("No default preset while its assets load", Manager->GetPresetForBiome(EBiomeType::Desert));
+	TestEqual("No presets while their assets load", Manager->GetPresetsForBiome(EBiomeType::Desert).Num(), 0);
+	TFuture<UBiomeGenerationPreset*> PendingFuture = Manager->GetPresetForBiomeAsync(EBiomeType::Desert);
+	TestFalse("Future waits for the assets", PendingFuture.IsReady());
+
+	// Dropping the presets cancels the pending load but keeps its waiters for the next one
+	Manager->LoadBiomePresetsFromPaths({});
+	TestNull("Biome without presets after the reset has no default", Manager->GetPresetForBiome(EBiomeType::Desert));
+	TestTrue("Waiting future is answered by the next load", PendingFuture.IsReady());
+
+	return true;
+}
+
+// Transition-graph driven biome mesh prefetch
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBiomeAssetPrefetchTest,
+	"BikeAdventure.Unit.WorldGen.BiomeAssetPrefetch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBiomeAssetPrefetchTest::RunTest(const FString& Parameters)
+{
+	int32 Distances[BiomeTables::NumBiomes];
+	UBiomeAssetPrefetcher::GetTransitionDistances(EBiomeType::Forest, Distances);
+	TestEqual("Current biome is zero transitions away", Distances[static_cast<int32>(EBiomeType::Forest)], 0);
+	TestEqual("Mountains is one transition from Forest", Distances[static_cast<int32>(EBiomeType::Mountains)], 1);
+	TestEqual("Wetlands is one transition from Forest", Distances[static_cast<int32>(EBiomeType::Wetlands)], 1);
+	TestEqual("Desert is two transitions from Forest", Distances[static_cast<int32>(EBiomeType::Desert)], 2);
+	TestEqual("Urban is two transitions from Forest", Distances[static_cast<int32>(EBiomeType::Urban)], 2);
+
+	// Meshes come from the biome's PCG settings defaults
+	TArray<FSoftObjectPath> Paths;
+	UBiomeAssetPrefetcher::GatherBiomeMeshPaths(EBiomeType::Forest, Paths);
+	TestTrue("Forest meshes include the pine tree", Paths.Contains(FSoftObjectPath(TEXT("/Game/Art/Models/Forest/SM_PineTree.SM_PineTree"))));
+	for (int32 Index = 0; Index < BiomeTables::NumBiomes; Index++)
+	{
+		Paths.Reset();
+		UBiomeAssetPrefetcher::GatherBiomeMeshPaths(static_cast<EBiomeType>(Index), Paths);
+		TestTrue("Every biome references meshes", Paths.Num() > 0);
+	}
+
+	// Only biomes within the prefetch depth are requested
+	UBiomeAssetPrefetcher* Prefetcher = NewObject<UBiomeAssetPrefetcher>();
+	Prefetcher->PrefetchDepth = 1;
+	Prefetcher->PendingMeshEstimateKB = 1024;
+	Prefetcher->UpdateForBiome(EBiomeType::Forest);
+	TestTrue("Current biome retained", Prefetcher->IsBiomeRetained(EBiomeType::Forest));
+	TestTrue("Neighbouring biome retained", Prefetcher->IsBiomeRetained(EBiomeType::Countryside));
+	TestFalse("Biome two transitions away not requested", Prefetcher->IsBiomeRetained(EBiomeType::Desert));
+	TestEqual("Forest and its three neighbours retained", Prefetcher->GetRetainedBiomeCount(), 4);
+
+	// Within budget, biomes that fall out of reach stay cached
+	Prefetcher->UpdateForBiome(EBiomeType::Desert);
+	TestTrue("New neighbour retained", Prefetcher->IsBiomeRetained(EBiomeType::Urban));
+	TestTrue("Unreachable biome kept within budget", Prefetcher->IsBiomeRetained(EBiomeType::Wetlands));
+
+	// Nothing has been ticked, so every request is either still pending at the estimate or already resident
+	TestTrue("Retained biomes count against the budget before their loads finish", Prefetcher->GetEstimatedRetainedBytes() > 0);
+
+	// Over budget, unreachable biomes go and reachable ones stay
+	AddExpectedError(TEXT("over the 0 MB budget"), EAutomationExpectedErrorFlags::Contains, 1);
+	Prefetcher->MemoryBudgetMB = 0;
+	Prefetcher->UpdateForBiome(EBiomeType::Desert);
+	TestTrue("Current biome survives eviction", Prefetcher->IsBiomeRetained(EBiomeType::Desert));
+	TestTrue("Reachable biome survives eviction", Prefetcher->IsBiomeRetained(EBiomeType::Mountains));
+	TestFalse("Unreachable biome evicted over budget", Prefetcher->IsBiomeRetained(EBiomeType::Wetlands));
+	TestFalse("Former current biome evicted over budget", Prefetcher->IsBiomeRetained(EBiomeType::Forest));
+
+	Prefetcher->ReleaseAll();
+	TestEqual("Release all empties the prefetcher", Prefetcher->GetRetainedBiomeCount(), 0);
+	TestEqual("Nothing estimated after release", Prefetcher->GetEstimatedRetainedBytes(), static_cast<int64>(0));
+
+	return true;
+}
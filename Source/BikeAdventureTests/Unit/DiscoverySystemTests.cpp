@@ -5,6 +5,7 @@
 #include "Tests/AutomationCommon.h"
 #include "Engine/World.h"
 #include "Systems/DiscoverySystem.h"
+#include "Systems/DiscoveryTable.h"
 #include "Core/BikeCharacter.h"
 #include "Core/BiomeTypes.h"
 
@@ -175,3 +176,279 @@ bool FDiscoverySystemGettersTest::RunTest(const FString& Parameters)
 	TestWorld->DestroyWorld(false);
 	return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDiscoverySystemCatalogueIndexTest,
+	"BikeAdventure.Unit.Systems.Discovery.CatalogueIndex",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDiscoverySystemCatalogueIndexTest::RunTest(const FString& Parameters)
+{
+	UDiscoverySystem* DiscoverySystem = NewObject<UDiscoverySystem>();
+	DiscoverySystem->Initialize();
+
+	const int32 DefaultCount = DiscoverySystem->GetTotalDiscoveriesAvailable();
+	const int32 DefaultForest = DiscoverySystem->GetRemainingDiscoveriesInBiome(EBiomeType::Forest);
+
+	// Grow the catalogue to thousands of entries spread over every biome
+	const int32 NumAdded = 5000;
+	for (int32 i = 0; i < NumAdded; i++)
+	{
+		FDiscoveryData Data;
+		Data.Name = FName(TEXT("Catalogue"), i + 1);
+		Data.RequiredBiome = static_cast<EBiomeType>(i % BiomeTables::NumBiomes);
+		TestTrue(TEXT("New entry added"), DiscoverySystem->AddDiscovery(Data));
+	}
+
+	FDiscoveryData Duplicate;
+	Duplicate.Name = TEXT("Deer Crossing");
+	TestFalse(TEXT("Duplicate name rejected"), DiscoverySystem->AddDiscovery(Duplicate));
+	TestFalse(TEXT("Empty name rejected"), DiscoverySystem->AddDiscovery(FDiscoveryData()));
+
+	TestEqual(TEXT("Catalogue size"), DiscoverySystem->GetTotalDiscoveriesAvailable(), DefaultCount + NumAdded);
+	const int32 ForestEntries = DefaultForest + (NumAdded + BiomeTables::NumBiomes - 1) / BiomeTables::NumBiomes;
+	TestEqual(TEXT("Forest bucket holds its entries"), DiscoverySystem->GetRemainingDiscoveriesInBiome(EBiomeType::Forest), ForestEntries);
+
+	// Name lookups resolve to the right entry
+	const FName Probe(TEXT("Catalogue"), 4321);
+	const int32 ProbeIndex = DiscoverySystem->FindDiscoveryIndex(Probe);
+	TestTrue(TEXT("Entry found by name"), ProbeIndex != INDEX_NONE);
+	TestEqual(TEXT("Index maps back to the name"), DiscoverySystem->GetDiscovery(ProbeIndex).Name, Probe);
+	TestEqual(TEXT("Unknown name not found"), DiscoverySystem->FindDiscoveryIndex(TEXT("Not In Catalogue")), static_cast<int32>(INDEX_NONE));
+
+	// Triggering by name updates the count, bitset and biome bucket
+	const EBiomeType ProbeBiome = DiscoverySystem->GetDiscovery(ProbeIndex).RequiredBiome;
+	const int32 RemainingBefore = DiscoverySystem->GetRemainingDiscoveriesInBiome(ProbeBiome);
+	TestTrue(TEXT("Trigger by name"), DiscoverySystem->TriggerDiscovery(Probe));
+	TestTrue(TEXT("Marked discovered"), DiscoverySystem->IsDiscovered(Probe));
+	TestEqual(TEXT("Removed from its biome bucket"), DiscoverySystem->GetRemainingDiscoveriesInBiome(ProbeBiome), RemainingBefore - 1);
+	TestEqual(TEXT("Running count"), DiscoverySystem->GetTotalDiscoveriesFound(), 1);
+
+	// Draining a biome through biome events never repeats an entry or leaves the biome
+	// Every entry rolls the 30% chance afresh, so allow far more entries than forest discoveries
+	int32 Triggered = 0;
+	const int32 ForestBefore = DiscoverySystem->GetRemainingDiscoveriesInBiome(EBiomeType::Forest);
+	for (int32 i = 0; i < ForestEntries * 40 && DiscoverySystem->GetRemainingDiscoveriesInBiome(EBiomeType::Forest) > 0; i++)
+	{
+		const int32 Before = DiscoverySystem->GetTotalDiscoveriesFound();
+		DiscoverySystem->HandleBiomeEntered(EBiomeType::Forest);
+		Triggered += DiscoverySystem->GetTotalDiscoveriesFound() - Before;
+	}
+
+	bool bOnlyForest = true;
+	const TArray<FDiscoveryData>& Found = DiscoverySystem->GetDiscoveredItems();
+	for (int32 i = 1; i < Found.Num(); i++)
+	{
+		bOnlyForest &= Found[i].RequiredBiome == EBiomeType::Forest;
+	}
+	TestTrue(TEXT("Biome events only find entries of that biome"), bOnlyForest);
+	TestEqual(TEXT("Found count matches the discovered list"), DiscoverySystem->GetTotalDiscoveriesFound(), Found.Num());
+	TestEqual(TEXT("Every forest entry found exactly once"), Triggered, ForestBefore);
+	TestEqual(TEXT("Forest bucket drained"), DiscoverySystem->GetRemainingDiscoveriesInBiome(EBiomeType::Forest), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDiscoverySystemSectionStreamingTest,
+	"BikeAdventure.Unit.Systems.Discovery.SectionStreaming",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDiscoverySystemSectionStreamingTest::RunTest(const FString& Parameters)
+{
+	TArray<FDiscoveryTableSourceRow> Rows;
+	FDiscoveryTableSourceRow& Lighthouse = Rows.AddDefaulted_GetRef();
+	Lighthouse.Name = TEXT("Lighthouse");
+	Lighthouse.Description = TEXT("A lighthouse on the headland.");
+	Lighthouse.Biome = EBiomeType::Beach;
+
+	FDiscoveryTableSourceRow& Oak = Rows.AddDefaulted_GetRef();
+	Oak.Name = TEXT("Hollow Oak");
+	Oak.Description = TEXT("An ancient hollow oak.");
+	Oak.Biome = EBiomeType::Forest;
+	Oak.bLocated = true;
+	Oak.LocalPosition = FVector2f(0.25f, 0.75f);
+
+	// One bucket per biome so every forest section carries the oak
+	TArray<uint8> Bytes;
+	FDiscoveryTable::Build(Rows, 1, Bytes);
+	TSharedRef<FDiscoveryTable> Table = MakeShared<FDiscoveryTable>();
+	TestTrue(TEXT("Table opened"), Table->OpenFromBytes(MoveTemp(Bytes)));
+
+	UDiscoverySystem* DiscoverySystem = NewObject<UDiscoverySystem>();
+	DiscoverySystem->SetDiscoveryTable(Table);
+	DiscoverySystem->PlacementJitter = 0.0f;
+	DiscoverySystem->Initialize();
+
+	// Only biome-wide entries are resident before any section streams in
+	TestEqual(TEXT("Biome-wide entries resident"), DiscoverySystem->GetTotalDiscoveriesAvailable(), 1);
+	TestEqual(TEXT("Defaults not loaded alongside a table"), DiscoverySystem->FindDiscoveryIndex(TEXT("Deer Crossing")), static_cast<int32>(INDEX_NONE));
+
+	const FIntVector Section(2, 3, 0);
+	const FBox Bounds(FVector(0.0, 0.0, 0.0), FVector(1000.0, 1000.0, 200.0));
+	TestEqual(TEXT("Section loads its located entry"), DiscoverySystem->LoadSectionDiscoveries(Section, EBiomeType::Forest, Bounds), 1);
+	TestEqual(TEXT("Loading twice adds nothing"), DiscoverySystem->LoadSectionDiscoveries(Section, EBiomeType::Forest, Bounds), 0);
+	TestEqual(TEXT("Beach sections have no located entries"), DiscoverySystem->LoadSectionDiscoveries(FIntVector(5, 5, 0), EBiomeType::Beach, Bounds), 0);
+	TestEqual(TEXT("Catalogue grew"), DiscoverySystem->GetTotalDiscoveriesAvailable(), 2);
+	TestEqual(TEXT("Located entries stay out of biome events"), DiscoverySystem->GetRemainingDiscoveriesInBiome(EBiomeType::Forest), 0);
+
+	int32 OakIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < 2; Index++)
+	{
+		if (DiscoverySystem->GetDiscovery(Index).bIsLocated)
+		{
+			OakIndex = Index;
+		}
+	}
+	if (!TestTrue(TEXT("Located entry resident"), OakIndex != INDEX_NONE))
+	{
+		return false;
+	}
+
+	const FDiscoveryData& OakData = DiscoverySystem->GetDiscovery(OakIndex);
+	const FName OakName = OakData.Name;
+	TestEqual(TEXT("Instance keeps the table name"), OakName.GetPlainNameString(), FString(TEXT("Hollow Oak")));
+	TestEqual(TEXT("Placed inside the section"), OakData.Location, FVector(250.0, 750.0, 100.0));
+	TestTrue(TEXT("Description not decoded before it is found"), OakData.Description.IsEmpty());
+
+	// Descriptions are decoded on trigger
+	TestTrue(TEXT("Trigger located entry"), DiscoverySystem->TriggerDiscovery(OakName));
+	TestEqual(TEXT("Description loaded on trigger"), DiscoverySystem->GetDiscoveredItems().Last().Description, FString(TEXT("An ancient hollow oak.")));
+	TestTrue(TEXT("Trigger biome-wide entry"), DiscoverySystem->TriggerDiscovery(TEXT("Lighthouse")));
+	TestEqual(TEXT("Biome-wide description loaded on trigger"), DiscoverySystem->GetDiscoveredItems().Last().Description, FString(TEXT("A lighthouse on the headland.")));
+
+	// Unloading frees the slot but the find is remembered when the section returns
+	DiscoverySystem->UnloadSectionDiscoveries(Section);
+	TestEqual(TEXT("Located entry unloaded"), DiscoverySystem->GetTotalDiscoveriesAvailable(), 1);
+	TestEqual(TEXT("No sections resident"), DiscoverySystem->GetNumResidentSections(), 0);
+	TestTrue(TEXT("Still discovered after unload"), DiscoverySystem->IsDiscovered(OakName));
+
+	DiscoverySystem->LoadSectionDiscoveries(Section, EBiomeType::Forest, Bounds);
+	TestEqual(TEXT("Freed slot reused"), DiscoverySystem->FindDiscoveryIndex(OakName), OakIndex);
+	TestFalse(TEXT("Found entry cannot trigger again"), DiscoverySystem->TriggerDiscovery(OakName));
+
+	// Another section gets its own instance of the same record
+	const FIntVector OtherSection(-4, 7, 0);
+	DiscoverySystem->LoadSectionDiscoveries(OtherSection, EBiomeType::Forest, Bounds.ShiftBy(FVector(1000.0, 0.0, 0.0)));
+	TestEqual(TEXT("Both sections resident"), DiscoverySystem->GetTotalDiscoveriesAvailable(), 3);
+	TestEqual(TEXT("Found count unchanged"), DiscoverySystem->GetTotalDiscoveriesFound(), 2);
+
+	return true;
+}
+
+namespace
+{
+	/** Forest table with a 10x10 field of located discoveries in every section */
+	TSharedRef<FDiscoveryTable> BuildDiscoveryFieldTable()
+	{
+		TArray<FDiscoveryTableSourceRow> Rows;
+		for (int32 i = 0; i < 100; i++)
+		{
+			FDiscoveryTableSourceRow& Row = Rows.AddDefaulted_GetRef();
+			Row.Name = FString::Printf(TEXT("Field %d"), i);
+			Row.Biome = EBiomeType::Forest;
+			Row.bLocated = true;
+			Row.LocalPosition = FVector2f((i % 10 + 0.5f) / 10.0f, (i / 10 + 0.5f) / 10.0f);
+		}
+
+		TArray<uint8> Bytes;
+		FDiscoveryTable::Build(Rows, 1, Bytes);
+		TSharedRef<FDiscoveryTable> Table = MakeShared<FDiscoveryTable>();
+		Table->OpenFromBytes(MoveTemp(Bytes));
+		return Table;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDiscoverySystemPlacementTest,
+	"BikeAdventure.Unit.Systems.Discovery.Placement",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDiscoverySystemPlacementTest::RunTest(const FString& Parameters)
+{
+	TSharedRef<FDiscoveryTable> Table = BuildDiscoveryFieldTable();
+	const FIntVector Section(1, 1, 0);
+	const FBox Bounds(FVector(0.0, 0.0, 0.0), FVector(10000.0, 10000.0, 0.0));
+
+	auto LoadWithSeed = [&Table, &Section, &Bounds](int32 Seed)
+	{
+		UDiscoverySystem* DiscoverySystem = NewObject<UDiscoverySystem>();
+		DiscoverySystem->SetDiscoveryTable(Table);
+		DiscoverySystem->SystemSeed = Seed;
+		DiscoverySystem->Initialize();
+		DiscoverySystem->LoadSectionDiscoveries(Section, EBiomeType::Forest, Bounds);
+		return DiscoverySystem;
+	};
+
+	UDiscoverySystem* First = LoadWithSeed(7);
+	UDiscoverySystem* Again = LoadWithSeed(7);
+	UDiscoverySystem* OtherSeed = LoadWithSeed(8);
+
+	bool bSamePlacement = true;
+	bool bInsideSection = true;
+	int32 NumMoved = 0;
+	for (int32 Index = 0; Index < First->GetTotalDiscoveriesAvailable(); Index++)
+	{
+		const FDiscoveryData& Data = First->GetDiscovery(Index);
+		bSamePlacement &= Again->GetDiscovery(Again->FindDiscoveryIndex(Data.Name)).Location == Data.Location;
+		bInsideSection &= Bounds.IsInsideOrOn(Data.Location);
+		NumMoved += OtherSeed->GetDiscovery(OtherSeed->FindDiscoveryIndex(Data.Name)).Location != Data.Location;
+	}
+	TestEqual(TEXT("Whole field loaded"), First->GetTotalDiscoveriesAvailable(), 100);
+	TestTrue(TEXT("Same seed places points identically"), bSamePlacement);
+	TestTrue(TEXT("Jittered points stay inside the section"), bInsideSection);
+	TestTrue(TEXT("Another seed places points elsewhere"), NumMoved > 50);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDiscoverySystemProximityTest,
+	"BikeAdventure.Unit.Systems.Discovery.Proximity",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDiscoverySystemProximityTest::RunTest(const FString& Parameters)
+{
+	UDiscoverySystem* DiscoverySystem = NewObject<UDiscoverySystem>();
+	DiscoverySystem->SetDiscoveryTable(BuildDiscoveryFieldTable());
+	DiscoverySystem->ProximityCellSize = 1000.0f;
+	DiscoverySystem->PlacementJitter = 0.0f;
+	DiscoverySystem->Initialize();
+
+	// A 100m section with one discovery in the middle of each of its 10x10 cells
+	const FBox Bounds(FVector(0.0, 0.0, 0.0), FVector(10000.0, 10000.0, 0.0));
+	DiscoverySystem->LoadSectionDiscoveries(FIntVector(0, 0, 0), EBiomeType::Forest, Bounds);
+
+	DiscoverySystem->UpdateRiderLocation(FVector(-5000.0, -5000.0, 0.0));
+	TestEqual(TEXT("First position is queried"), DiscoverySystem->GetNumProximityQueries(), 1);
+	TestEqual(TEXT("Nothing near the start"), DiscoverySystem->GetTotalDiscoveriesFound(), 0);
+
+	// Riding inside a cell never touches the grid
+	for (int32 Step = 0; Step < 100; Step++)
+	{
+		DiscoverySystem->UpdateRiderLocation(FVector(-5000.0 + Step * 5.0, -5000.0 + Step * 2.0, 0.0));
+	}
+	TestEqual(TEXT("No queries while the cell is unchanged"), DiscoverySystem->GetNumProximityQueries(), 1);
+
+	// Entering a corner cell finds the points in it and the cells around it
+	DiscoverySystem->UpdateRiderLocation(FVector(500.0, 500.0, 0.0));
+	TestEqual(TEXT("Corner neighbourhood found"), DiscoverySystem->GetTotalDiscoveriesFound(), 4);
+
+	// Riding along the first row sweeps two rows of points, querying once per cell crossed
+	for (double X = 500.0; X <= 9500.0; X += 100.0)
+	{
+		DiscoverySystem->UpdateRiderLocation(FVector(X, 500.0, 0.0));
+	}
+	TestEqual(TEXT("Two rows found"), DiscoverySystem->GetTotalDiscoveriesFound(), 20);
+	TestEqual(TEXT("One query per cell crossed"), DiscoverySystem->GetNumProximityQueries(), 11);
+
+	bool bAllNearPath = true;
+	for (const FDiscoveryData& Found : DiscoverySystem->GetDiscoveredItems())
+	{
+		bAllNearPath &= Found.bIsLocated && Found.Location.Y < 2000.0;
+	}
+	TestTrue(TEXT("Only points next to the ridden cells were found"), bAllNearPath);
+
+	// A section streaming in next to the rider is checked straight away
+	DiscoverySystem->LoadSectionDiscoveries(FIntVector(1, 0, 0), EBiomeType::Forest, Bounds.ShiftBy(FVector(10000.0, 0.0, 0.0)));
+	TestEqual(TEXT("Points across the section edge found on load"), DiscoverySystem->GetTotalDiscoveriesFound(), 22);
+	TestEqual(TEXT("Loading does not count as a rider query"), DiscoverySystem->GetNumProximityQueries(), 11);
+
+	return true;
+}
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Systems/DiscoveryTable.h"
+
+/**
+ * Unit tests for the compiled discovery table format
+ */
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDiscoveryTableRoundTripTest,
+	"BikeAdventure.Unit.Systems.DiscoveryTable.RoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDiscoveryTableRoundTripTest::RunTest(const FString& Parameters)
+{
+	const int32 BucketsPerBiome = 4;
+	const FIntVector Section(3, -2, 0);
+
+	TArray<FDiscoveryTableSourceRow> Rows;
+	for (int32 i = 0; i < 40; i++)
+	{
+		FDiscoveryTableSourceRow& Row = Rows.AddDefaulted_GetRef();
+		Row.Name = FString::Printf(TEXT("Located %d"), i);
+		Row.Description = FString::Printf(TEXT("Description of located discovery %d"), i);
+		Row.Biome = static_cast<EBiomeType>(i % BiomeTables::NumBiomes);
+		Row.bLocated = true;
+		Row.LocalPosition = FVector2f(i / 40.0f, 1.0f - i / 40.0f);
+		Row.Bucket = i % BucketsPerBiome;
+	}
+	FDiscoveryTableSourceRow& BiomeWide = Rows.AddDefaulted_GetRef();
+	BiomeWide.Name = TEXT("Caf\u00e9 Terrace");
+	BiomeWide.Description = TEXT("Coffee in the sun.");
+	BiomeWide.Biome = EBiomeType::Urban;
+
+	TArray<uint8> Bytes;
+	FDiscoveryTable::Build(Rows, BucketsPerBiome, Bytes);
+	const TArray<uint8> Compiled = Bytes;
+
+	FDiscoveryTable Table;
+	if (!TestTrue(TEXT("Compiled table opens"), Table.OpenFromBytes(MoveTemp(Bytes))))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Record count"), Table.Num(), Rows.Num());
+	TestEqual(TEXT("Buckets per biome"), Table.GetBucketsPerBiome(), BucketsPerBiome);
+
+	// Biome-wide records sit in their own partition with non-ASCII names intact
+	TConstArrayView<FDiscoveryTableRecord> BiomeWideRecords = Table.GetBiomeWideRecords();
+	if (TestEqual(TEXT("One biome-wide record"), BiomeWideRecords.Num(), 1))
+	{
+		TestEqual(TEXT("UTF-8 name decoded"), Table.GetName(BiomeWideRecords[0]).ToString(), BiomeWide.Name);
+		TestEqual(TEXT("Biome-wide description"), Table.GetDescription(BiomeWideRecords[0]), BiomeWide.Description);
+	}
+
+	// A section only sees the rows of its biome and hash bucket
+	int32 Expected = 0;
+	for (const FDiscoveryTableSourceRow& Row : Rows)
+	{
+		Expected += Row.bLocated && Row.Biome == EBiomeType::Forest && Row.Bucket == Table.GetSectionBucket(Section);
+	}
+	TConstArrayView<FDiscoveryTableRecord> SectionRecords = Table.GetSectionRecords(EBiomeType::Forest, Section);
+	TestEqual(TEXT("Section partition size"), SectionRecords.Num(), Expected);
+	for (const FDiscoveryTableRecord& Record : SectionRecords)
+	{
+		const int32 RowIndex = FCString::Atoi(*Table.GetName(Record).ToString().RightChop(FCString::Strlen(TEXT("Located "))));
+		TestEqual(TEXT("Record in the right biome"), Record.Biome, static_cast<uint8>(EBiomeType::Forest));
+		TestTrue(TEXT("Record is located"), (Record.Flags & FDiscoveryTableRecord::FlagLocated) != 0);
+		if (Rows.IsValidIndex(RowIndex))
+		{
+			TestEqual(TEXT("Description matches its row"), Table.GetDescription(Record), Rows[RowIndex].Description);
+			TestEqual(TEXT("Local position kept"), Record.LocalX, Rows[RowIndex].LocalPosition.X);
+		}
+	}
+	TestEqual(TEXT("No records for an unknown biome"), Table.GetSectionRecords(EBiomeType::None, Section).Num(), 0);
+
+	// The same bytes map from disk
+	const FString TestPath = FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("DiscoveryTable_UnitTest.bin");
+	if (TestTrue(TEXT("Table written"), FFileHelper::SaveArrayToFile(Compiled, *TestPath)))
+	{
+		FDiscoveryTable Mapped;
+		TestTrue(TEXT("Table opened from file"), Mapped.OpenFile(TestPath));
+		TestEqual(TEXT("Mapped record count"), Mapped.Num(), Rows.Num());
+		TestEqual(TEXT("Mapped section partition"), Mapped.GetSectionRecords(EBiomeType::Forest, Section).Num(), Expected);
+		Mapped.Close();
+		IFileManager::Get().Delete(*TestPath);
+	}
+
+	// Damaged tables are rejected rather than read out of bounds
+	TArray<uint8> Truncated = Compiled;
+	Truncated.SetNum(Truncated.Num() - 1);
+	TestFalse(TEXT("Truncated table rejected"), Table.OpenFromBytes(MoveTemp(Truncated)));
+	TestFalse(TEXT("Rejected table is closed"), Table.IsOpen());
+
+	TArray<uint8> WrongVersion = Compiled;
+	reinterpret_cast<FDiscoveryTableHeader*>(WrongVersion.GetData())->Version++;
+	TestFalse(TEXT("Unknown version rejected"), Table.OpenFromBytes(MoveTemp(WrongVersion)));
+
+	TArray<uint8> BadPartitions = Compiled;
+	uint32* PartitionStarts = reinterpret_cast<uint32*>(BadPartitions.GetData() + sizeof(FDiscoveryTableHeader));
+	Swap(PartitionStarts[1], PartitionStarts[BiomeTables::NumBiomes * BucketsPerBiome]);
+	TestFalse(TEXT("Unordered partitions rejected"), Table.OpenFromBytes(MoveTemp(BadPartitions)));
+
+	return true;
+}
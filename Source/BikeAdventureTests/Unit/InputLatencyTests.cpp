@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Systems/InputLatencyTracker.h"
+
+// Input changes must be followed through the movement update to the presented frame
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputLatencyTrackerTest,
+	"BikeAdventure.Unit.Input.LatencyTracker",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FInputLatencyTrackerTest::RunTest(const FString& Parameters)
+{
+	FInputLatencyTracker Tracker;
+
+	// Steady or barely moving input does not open a measurement
+	TestFalse("Zero input ignored", Tracker.MarkInput(0.0f, 0.0, 1));
+	TestFalse("Small change ignored", Tracker.MarkInput(FInputLatencyTracker::ChangeThreshold * 0.5f, 0.0, 1));
+	Tracker.MarkMovementUpdate(0.001);
+	TestFalse("Nothing to present without input", Tracker.MarkPresented(0.002, 1));
+	TestEqual("No samples yet", Tracker.Num(), 0);
+
+	// Input, a frame with no simulation step, then the step and the present a frame later
+	TestTrue("Steering change opens a measurement", Tracker.MarkInput(1.0f, 1.000, 10));
+	TestFalse("Present before any movement update does not complete", Tracker.MarkPresented(1.010, 10));
+	TestFalse("Further changes fold into the open measurement", Tracker.MarkInput(-1.0f, 1.012, 11));
+	TestTrue("First step after the input is the update", Tracker.MarkMovementUpdate(1.020));
+	TestFalse("Later steps do not move the update time", Tracker.MarkMovementUpdate(1.025));
+	TestTrue("Present after the update completes a sample", Tracker.MarkPresented(1.030, 11));
+
+	const FInputLatencySample* Sample = Tracker.GetLastSample();
+	TestNotNull("Sample recorded", Sample);
+	if (Sample)
+	{
+		TestEqual("Input to update", Sample->GetInputToUpdateMs(), 20.0, 0.001);
+		TestEqual("Input to present", Sample->GetInputToPresentMs(), 30.0, 0.001);
+		TestEqual("One frame of delay", Sample->GetFrameDelay(), 1);
+	}
+
+	// A same-frame sample pulls the averages down
+	TestTrue("Change back opens a new measurement", Tracker.MarkInput(0.0f, 2.000, 20));
+	Tracker.MarkMovementUpdate(2.002);
+	TestTrue("Same-frame present completes", Tracker.MarkPresented(2.004, 20));
+
+	TestEqual("Two samples", Tracker.Num(), 2);
+	TestEqual("Average input to update", Tracker.GetAverageInputToUpdateMs(), 11.0, 0.001);
+	TestEqual("Average input to present", Tracker.GetAverageInputToPresentMs(), 17.0, 0.001);
+	TestEqual("Max input to present", Tracker.GetMaxInputToPresentMs(), 30.0, 0.001);
+	TestEqual("Average frame delay", Tracker.GetAverageFrameDelay(), 0.5, 0.001);
+
+	// The ring keeps the most recent samples only
+	for (int32 i = 0; i < FInputLatencyTracker::MaxSamples + 10; i++)
+	{
+		const double Start = 10.0 + i;
+		Tracker.MarkInput((i & 1) ? 0.0f : 1.0f, Start, 100 + i);
+		Tracker.MarkMovementUpdate(Start + 0.004);
+		Tracker.MarkPresented(Start + 0.008, 100 + i);
+	}
+	TestEqual("Ring is bounded", Tracker.Num(), FInputLatencyTracker::MaxSamples);
+	TestEqual("Older slow samples have been overwritten", Tracker.GetMaxInputToPresentMs(), 8.0, 0.001);
+
+	Tracker.Reset();
+	TestEqual("Reset drops samples", Tracker.Num(), 0);
+	TestNull("No last sample after reset", Tracker.GetLastSample());
+
+	return true;
+}
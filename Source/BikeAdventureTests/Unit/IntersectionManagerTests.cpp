@@ -0,0 +1,177 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Gameplay/Intersection.h"
+#include "Systems/IntersectionManager.h"
+#include "Systems/IntersectionSpatialIndex.h"
+
+namespace
+{
+	/** Reference answer for FindNearestAhead by scanning every point */
+	float BruteForceNearestAhead(const TArray<FVector>& Points, const FVector& Location, const FVector& Heading, float MaxDistance, float MaxLateralOffset)
+	{
+		const FVector2D Direction = FVector2D(Heading.X, Heading.Y).GetSafeNormal();
+		const FVector2D Normal(-Direction.Y, Direction.X);
+		float Best = TNumericLimits<float>::Max();
+
+		for (const FVector& Point : Points)
+		{
+			const FVector2D ToPoint = FVector2D(Point.X - Location.X, Point.Y - Location.Y);
+			const float Along = FVector2D::DotProduct(ToPoint, Direction);
+			if (Along >= 0.0f && Along <= MaxDistance && FMath::Abs(FVector2D::DotProduct(ToPoint, Normal)) <= MaxLateralOffset)
+			{
+				Best = FMath::Min(Best, Along);
+			}
+		}
+
+		return Best;
+	}
+}
+
+// Spatial index must agree with a linear scan through adds and swap-removals
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIntersectionSpatialIndexConsistencyTest,
+	"BikeAdventure.Unit.IntersectionManager.SpatialIndexConsistency",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FIntersectionSpatialIndexConsistencyTest::RunTest(const FString& Parameters)
+{
+	FIntersectionSpatialIndex Index(5000.0f, 50000.0f);
+	TArray<FVector> Points;
+	FRandomStream Stream(1337);
+
+	for (int32 i = 0; i < 2000; i++)
+	{
+		const FVector Location(Stream.FRandRange(-100000.0f, 100000.0f), Stream.FRandRange(-100000.0f, 100000.0f), 0.0f);
+		TestEqual("Add returns the dense index", Index.Add(Location), Points.Num());
+		Points.Add(Location);
+	}
+
+	// Remove a third of the points, mirroring the swap with the reference array
+	for (int32 i = 0; i < 700; i++)
+	{
+		const int32 Removed = Stream.RandRange(0, Points.Num() - 1);
+		Index.RemoveAtSwap(Removed);
+		Points.RemoveAtSwap(Removed, 1, false);
+	}
+
+	TestEqual("Element count tracks removals", Index.Num(), Points.Num());
+
+	bool bLocationsMatch = true;
+	for (int32 i = 0; i < Points.Num(); i++)
+	{
+		bLocationsMatch &= Index.GetLocation(i) == Points[i];
+	}
+	TestTrue("Dense order matches TArray::RemoveAtSwap", bLocationsMatch);
+
+	// Section buckets cover every element exactly once
+	TMap<FIntVector, int32> ExpectedSectionCounts;
+	for (const FVector& Point : Points)
+	{
+		ExpectedSectionCounts.FindOrAdd(Index.GetSectionCoordinates(Point))++;
+	}
+
+	for (const auto& SectionPair : ExpectedSectionCounts)
+	{
+		const TArray<int32>* Bucket = Index.FindInSection(SectionPair.Key);
+		TestTrue("Section bucket exists", Bucket != nullptr);
+		if (Bucket)
+		{
+			TestEqual("Section bucket size", Bucket->Num(), SectionPair.Value);
+			for (int32 ElementIndex : *Bucket)
+			{
+				TestTrue("Bucket entry belongs to section", Index.GetSectionCoordinates(Points[ElementIndex]) == SectionPair.Key);
+			}
+		}
+	}
+
+	// Ahead queries match the brute-force answer
+	for (int32 i = 0; i < 200; i++)
+	{
+		const FVector Location(Stream.FRandRange(-100000.0f, 100000.0f), Stream.FRandRange(-100000.0f, 100000.0f), 0.0f);
+		const FVector Heading = FRotator(0.0f, Stream.FRandRange(0.0f, 360.0f), 0.0f).Vector();
+		const float MaxDistance = Stream.FRandRange(1000.0f, 60000.0f);
+
+		float Distance = 0.0f;
+		const int32 Found = Index.FindNearestAhead(Location, Heading, MaxDistance, 3000.0f, INDEX_NONE, Distance);
+		const float Expected = BruteForceNearestAhead(Points, Location, Heading, MaxDistance, 3000.0f);
+
+		if (Expected == TNumericLimits<float>::Max())
+		{
+			TestEqual(FString::Printf(TEXT("No intersection ahead [%d]"), i), Found, static_cast<int32>(INDEX_NONE));
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("Intersection found ahead [%d]"), i), Found != INDEX_NONE);
+			TestEqual(FString::Printf(TEXT("Nearest distance ahead [%d]"), i), Distance, Expected, 0.01f);
+		}
+	}
+
+	// Removing everything leaves no buckets behind
+	while (Index.Num() > 0)
+	{
+		Index.RemoveAtSwap(0);
+	}
+	TestTrue("Empty index has no section buckets", Index.FindInSection(FIntVector::ZeroValue) == nullptr);
+
+	return true;
+}
+
+// Manager registration and queries with real intersection actors
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIntersectionManagerQueryTest,
+	"BikeAdventure.Unit.IntersectionManager.Queries",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FIntersectionManagerQueryTest::RunTest(const FString& Parameters)
+{
+	UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	TestNotNull("Test world created", TestWorld);
+
+	if (!TestWorld)
+	{
+		return false;
+	}
+
+	AActor* Owner = TestWorld->SpawnActor<AActor>();
+	UIntersectionManager* Manager = NewObject<UIntersectionManager>(Owner);
+	Manager->RegisterComponent();
+	Manager->Initialize();
+
+	// A row of intersections along +X, one every 10000 units
+	TArray<AIntersection*> Intersections;
+	for (int32 i = 0; i < 40; i++)
+	{
+		AIntersection* Intersection = TestWorld->SpawnActor<AIntersection>(FVector(i * 10000.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+		Manager->RegisterIntersection(Intersection);
+		Intersections.Add(Intersection);
+	}
+
+	// Registering twice is ignored
+	Manager->RegisterIntersection(Intersections[0]);
+	TestEqual("All intersections registered once", Manager->GetIntersectionCount(), 40);
+
+	// Sections are 200000 units wide, so the row spans sections 0 and 1
+	TestEqual("Intersections in section 0", Manager->GetIntersectionCountInSection(FIntVector(0, 0, 0)), 20);
+	TestEqual("Intersections in section 1", Manager->GetIntersectionCountInSection(FIntVector(1, 0, 0)), 20);
+	TestEqual("Empty section", Manager->GetIntersectionCountInSection(FIntVector(5, 5, 0)), 0);
+
+	// Unregistering keeps the remaining entries addressable
+	Manager->UnregisterIntersection(Intersections[2]);
+	Manager->UnregisterIntersection(Intersections[0]);
+	Manager->UnregisterIntersection(Intersections[0]);
+	TestEqual("Unregistered intersections removed", Manager->GetIntersectionCount(), 38);
+	TestFalse("Removed intersection not registered", Manager->IsRegistered(Intersections[2]));
+	TestTrue("Last intersection still registered", Manager->IsRegistered(Intersections[39]));
+
+	TArray<AIntersection*> SectionIntersections = Manager->GetIntersectionsInSection(FIntVector(1, 0, 0));
+	TestEqual("Section query after removals", SectionIntersections.Num(), 20);
+	TestTrue("Section query returns section members", SectionIntersections.Contains(Intersections[39]));
+
+	SectionIntersections = Manager->GetIntersectionsInSection(FIntVector(0, 0, 0));
+	TestEqual("Removed intersections leave their section", SectionIntersections.Num(), 18);
+	TestFalse("Section query skips unregistered intersection", SectionIntersections.Contains(Intersections[2]));
+
+	TestWorld->DestroyWorld(false);
+	return true;
+}
@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Components/SplineComponent.h"
+#include "Gameplay/PathCrowdSimulation.h"
+
+/**
+ * Unit tests for the batched path NPC locomotion kernel
+ */
+
+namespace
+{
+	USplineComponent* CreateStraightPath(float Length)
+	{
+		USplineComponent* Spline = NewObject<USplineComponent>();
+		Spline->ClearSplinePoints(false);
+		Spline->AddSplinePoint(FVector::ZeroVector, ESplineCoordinateSpace::Local, false);
+		Spline->AddSplinePoint(FVector(Length, 0.0f, 0.0f), ESplineCoordinateSpace::Local, false);
+		Spline->UpdateSpline();
+		return Spline;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathCrowdSimulationMotionTest,
+	"BikeAdventure.Unit.Gameplay.PathCrowdSimulation.Motion",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathCrowdSimulationMotionTest::RunTest(const FString& Parameters)
+{
+	FPathCrowdSimulation Simulation;
+	Simulation.SwayDistance = 0.0f;
+	Simulation.BuildTrack(*CreateStraightPath(10000.0f));
+	TestEqual(TEXT("Track length"), Simulation.GetTrackLength(), 10000.0f, 1.0f);
+
+	const int32 Forward = Simulation.AddAgent(1000.0f, 200.0f, 0.0f, 0.0f);
+	const int32 Lane = Simulation.AddAgent(5000.0f, 100.0f, 50.0f, 0.0f);
+	const int32 Returning = Simulation.AddAgent(100.0f, -200.0f, 0.0f, 0.0f);
+	const int32 Hidden = Simulation.AddAgent(2000.0f, 0.0f, 0.0f, 0.0f);
+	Simulation.SetAgentVisible(Hidden, false);
+	const int32 Inactive = Simulation.AddAgent(3000.0f, 200.0f, 0.0f, 0.0f);
+	Simulation.DeactivateAgent(Inactive);
+
+	Simulation.Step(1.0f);
+	const TArray<FTransform>& Transforms = Simulation.GetTransforms();
+
+	TestEqual(TEXT("Agent walks its speed"), Simulation.GetAgentDistance(Forward), 1200.0f, 0.5f);
+	TestTrue(TEXT("Agent placed on the path"), Transforms[Forward].GetLocation().Equals(FVector(1200.0f, 0.0f, 0.0f), 1.0f));
+	TestTrue(TEXT("Agent faces down the path"), Transforms[Forward].GetRotation().GetForwardVector().Equals(FVector::ForwardVector, 0.01f));
+	TestTrue(TEXT("Lane offset is to the right of the path"), Transforms[Lane].GetLocation().Equals(FVector(5100.0f, 50.0f, 0.0f), 1.0f));
+
+	// Walking off the start turns the agent round
+	TestEqual(TEXT("Agent turns at the end of the path"), Simulation.GetAgentDistance(Returning), 100.0f, 0.5f);
+	TestTrue(TEXT("Turned agent faces back up the path"), Transforms[Returning].GetRotation().GetForwardVector().Equals(FVector::ForwardVector, 0.01f));
+	TestTrue(TEXT("Hidden agent is scaled away"), Transforms[Hidden].GetScale3D().IsNearlyZero());
+	TestEqual(TEXT("Deactivated agent is not stepped"), Simulation.GetAgentDistance(Inactive), 3000.0f);
+	TestTrue(TEXT("Deactivated agent is scaled away"), Transforms[Inactive].GetScale3D().IsNearlyZero());
+
+	// Reusing a deactivated agent brings it back into the step
+	Simulation.SetAgent(Inactive, 3000.0f, 200.0f, 0.0f, 0.0f);
+	Simulation.Step(1.0f);
+	TestEqual(TEXT("Reused agent walks again"), Simulation.GetAgentDistance(Inactive), 3200.0f, 0.5f);
+	TestFalse(TEXT("Reused agent is drawn again"), Transforms[Inactive].GetScale3D().IsNearlyZero());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathCrowdSimulationChunksTest,
+	"BikeAdventure.Unit.Gameplay.PathCrowdSimulation.Chunks",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathCrowdSimulationChunksTest::RunTest(const FString& Parameters)
+{
+	FPathCrowdSimulation Simulation;
+	Simulation.SwayDistance = 0.0f;
+	Simulation.BuildTrack(*CreateStraightPath(100000.0f));
+
+	// Agents either side of every chunk boundary must all be advanced exactly once
+	const int32 NumAgents = FPathCrowdSimulation::ChunkSize * 3 + 7;
+	for (int32 i = 0; i < NumAgents; i++)
+	{
+		Simulation.AddAgent(1000.0f + i * 10.0f, 100.0f, 0.0f, 0.0f);
+	}
+
+	Simulation.Step(0.5f);
+	Simulation.Step(0.5f);
+
+	bool bAllAdvanced = true;
+	for (int32 i = 0; bAllAdvanced && i < NumAgents; i++)
+	{
+		const float Expected = 1100.0f + i * 10.0f;
+		bAllAdvanced = FMath::IsNearlyEqual(Simulation.GetAgentDistance(i), Expected, 0.5f)
+			&& FMath::IsNearlyEqual(static_cast<float>(Simulation.GetTransforms()[i].GetLocation().X), Expected, 1.0f);
+	}
+	TestTrue(TEXT("Every agent in every chunk advanced once per step"), bAllAdvanced);
+
+	return true;
+}
@@ -4,8 +4,11 @@
 #include "Misc/AutomationTest.h"
 #include "Tests/AutomationCommon.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Camera/CameraActor.h"
 #include "Gameplay/PathNPCSpawner.h"
 #include "Components/SplineComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 
 /**
  * Unit tests for PathNPCSpawner
@@ -121,3 +124,215 @@ bool FPathNPCSpawnerSuccessfulSpawnTest::RunTest(const FString& Parameters)
     TestWorld->DestroyWorld(false);
     return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathNPCSpawnerCrowdModeTest,
+    "BikeAdventure.Unit.Gameplay.PathNPCSpawner.CrowdMode",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathNPCSpawnerCrowdModeTest::RunTest(const FString& Parameters)
+{
+    UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+    TestNotNull("Test world created", TestWorld);
+
+    if (!TestWorld)
+    {
+        return false;
+    }
+
+    APathNPCSpawner* Spawner = TestWorld->SpawnActor<APathNPCSpawner>();
+    TestNotNull("Spawner created", Spawner);
+
+    if (Spawner && Spawner->PathSpline)
+    {
+        // A bent 100m path carrying a crowd of 500
+        Spawner->PathSpline->ClearSplinePoints();
+        Spawner->PathSpline->AddSplinePoint(FVector(0, 0, 0), ESplineCoordinateSpace::Local);
+        Spawner->PathSpline->AddSplinePoint(FVector(4000, 0, 0), ESplineCoordinateSpace::Local);
+        Spawner->PathSpline->AddSplinePoint(FVector(6000, 3000, 0), ESplineCoordinateSpace::Local);
+        Spawner->PathSpline->AddSplinePoint(FVector(9000, 3000, 0), ESplineCoordinateSpace::Local);
+        Spawner->PathSpline->UpdateSpline();
+
+        Spawner->NPCClass = AActor::StaticClass();
+        Spawner->NPCCount = 500;
+        Spawner->SpawnBatchSize = 20;
+        Spawner->SpawnDistanceAhead = 2000.0f;
+        Spawner->DespawnDistanceBehind = 500.0f;
+
+        Spawner->StartCrowdSpawning();
+
+        const TArray<float>& Distances = Spawner->GetPlacementDistances();
+        TestEqual("One placement per NPC", Distances.Num(), 500);
+
+        bool bSorted = true;
+        for (int32 i = 1; i < Distances.Num(); i++)
+        {
+            bSorted &= Distances[i - 1] <= Distances[i];
+        }
+        TestTrue("Placements are sorted along the path", bSorted);
+
+        // The forward walk must land where a direct distance lookup does
+        const TArray<FTransform>& Transforms = Spawner->GetPlacementTransforms();
+        bool bPlacedAtDistance = Transforms.Num() == Distances.Num();
+        for (int32 i = 0; bPlacedAtDistance && i < Distances.Num(); i++)
+        {
+            const FVector Expected = Spawner->PathSpline->GetLocationAtDistanceAlongSpline(Distances[i], ESplineCoordinateSpace::World);
+            bPlacedAtDistance = Transforms[i].GetLocation().Equals(Expected, 1.0f);
+        }
+        TestTrue("Placements sit at their distance along the path", bPlacedAtDistance);
+
+        Spawner->UpdateCrowd(0.0f);
+        TestEqual("First frame spawns one batch", Spawner->GetNumActiveCrowdNPCs(), 20);
+
+        // Ride the path; the crowd never exceeds the window and is recycled through the pool
+        const float SplineLength = Spawner->PathSpline->GetSplineLength();
+        int32 MaxExpectedActive = 0;
+        for (float RiderDistance = 0.0f; RiderDistance <= SplineLength + 1000.0f; RiderDistance += 100.0f)
+        {
+            Spawner->UpdateCrowd(RiderDistance);
+        }
+        for (int32 i = 0; i < Distances.Num(); i++)
+        {
+            int32 InWindow = 0;
+            for (int32 j = i; j < Distances.Num() && Distances[j] <= Distances[i] + Spawner->SpawnDistanceAhead + Spawner->DespawnDistanceBehind + 100.0f; j++)
+            {
+                InWindow++;
+            }
+            MaxExpectedActive = FMath::Max(MaxExpectedActive, InWindow);
+        }
+
+        TestEqual("Everything is behind the rider at the end", Spawner->GetNumActiveCrowdNPCs(), 0);
+        TestEqual("Every created NPC is back in the pool", Spawner->GetNumPooledNPCs(), Spawner->GetNumCrowdActorsCreated());
+        TestTrue("Pool keeps created actors to the window size", Spawner->GetNumCrowdActorsCreated() <= MaxExpectedActive);
+        TestTrue("Far fewer actors than placements", Spawner->GetNumCrowdActorsCreated() < Distances.Num());
+    }
+
+    TestWorld->DestroyWorld(false);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathNPCSpawnerInstancedCrowdTest,
+    "BikeAdventure.Unit.Gameplay.PathNPCSpawner.InstancedCrowd",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathNPCSpawnerInstancedCrowdTest::RunTest(const FString& Parameters)
+{
+    UWorld* TestWorld = UWorld::CreateWorld(EWorldType::Game, false);
+    TestNotNull("Test world created", TestWorld);
+
+    if (!TestWorld)
+    {
+        return false;
+    }
+
+    APathNPCSpawner* Spawner = TestWorld->SpawnActor<APathNPCSpawner>();
+    TestNotNull("Spawner created", Spawner);
+
+    if (Spawner && Spawner->PathSpline)
+    {
+        Spawner->PathSpline->ClearSplinePoints();
+        Spawner->PathSpline->AddSplinePoint(FVector(0, 0, 0), ESplineCoordinateSpace::Local);
+        Spawner->PathSpline->AddSplinePoint(FVector(10000, 0, 0), ESplineCoordinateSpace::Local);
+        Spawner->PathSpline->UpdateSpline();
+
+        // Promoted actors need a root component to be moved
+        Spawner->NPCClass = ACameraActor::StaticClass();
+        Spawner->NPCCount = 400;
+        Spawner->SpawnBatchSize = 400;
+        Spawner->SpawnDistanceAhead = 3000.0f;
+        Spawner->DespawnDistanceBehind = 500.0f;
+        Spawner->bInstancedCrowd = true;
+        Spawner->MaxFullActors = 4;
+        Spawner->SignificanceDistance = 3000.0f;
+
+        Spawner->StartCrowdSpawning();
+        Spawner->UpdateCrowd(0.0f);
+        Spawner->UpdateCrowdInstances(0.0f);
+
+        const int32 NumActive = Spawner->GetNumActiveCrowdNPCs();
+        TestTrue("Window filled with instances", NumActive > 50);
+        TestEqual("One instance per crowd slot", Spawner->CrowdInstances->GetInstanceCount(), Spawner->GetNumCrowdSlots());
+        TestEqual("No actors before significance runs", Spawner->GetNumCrowdActorsCreated(), 0);
+
+        // Looking down the path from its start, the nearest NPCs ahead are promoted, capped
+        Spawner->UpdateSignificance(FVector::ZeroVector, FVector::ForwardVector);
+        TestEqual("Promotion capped at MaxFullActors", Spawner->GetNumPromotedNPCs(), 4);
+        TestEqual("Promoted NPCs are actors", Spawner->GetNumCrowdActorsCreated(), 4);
+
+        auto GetPromotedLocations = [TestWorld]()
+        {
+            TArray<FVector> Locations;
+            for (TActorIterator<ACameraActor> It(TestWorld); It; ++It)
+            {
+                if (!It->IsHidden())
+                {
+                    Locations.Add(It->GetActorLocation());
+                }
+            }
+            return Locations;
+        };
+
+        // Promoted actors walk on with the crowd
+        const TArray<FVector> PromotedAt = GetPromotedLocations();
+        Spawner->UpdateCrowdInstances(1.0f);
+        const TArray<FVector> PromotedWalked = GetPromotedLocations();
+        bool bActorsWalked = PromotedAt.Num() == 4 && PromotedWalked.Num() == 4;
+        for (int32 Index = 0; bActorsWalked && Index < PromotedAt.Num(); Index++)
+        {
+            bActorsWalked = FVector::Dist(PromotedAt[Index], PromotedWalked[Index]) > 50.0f;
+        }
+        TestTrue("Promoted actors move with their NPCs", bActorsWalked);
+
+        // Looking away drops significance under the demotion threshold and the actors go back to the pool
+        Spawner->UpdateSignificance(FVector(0, 0, 0), -FVector::ForwardVector);
+        TestEqual("Facing away demotes everything", Spawner->GetNumPromotedNPCs(), 0);
+        TestEqual("Demoted actors are pooled", Spawner->GetNumPooledNPCs(), 4);
+
+        // Demoted instances carry on exactly where their actors were, lane included
+        Spawner->UpdateCrowdInstances(0.0f);
+        int32 NumResumed = 0;
+        for (const FVector& Location : PromotedWalked)
+        {
+            for (int32 Instance = 0; Instance < Spawner->CrowdInstances->GetInstanceCount(); Instance++)
+            {
+                FTransform InstanceTransform;
+                Spawner->CrowdInstances->GetInstanceTransform(Instance, InstanceTransform, true);
+                if (!InstanceTransform.GetScale3D().IsNearlyZero() && InstanceTransform.GetLocation().Equals(Location, 1.0f))
+                {
+                    NumResumed++;
+                    break;
+                }
+            }
+        }
+        TestEqual("Demoted NPCs resume from their actors", NumResumed, 4);
+
+        // Re-promotion reuses the pool instead of spawning
+        Spawner->UpdateSignificance(FVector::ZeroVector, FVector::ForwardVector);
+        TestEqual("Re-promoted from the pool", Spawner->GetNumCrowdActorsCreated(), 4);
+
+        // Riding on moves the window; slots are recycled, so instances stay at the window size.
+        // NPCs walking back toward the rider are released once they are behind, wherever they were placed
+        bool bBehindReleased = true;
+        for (float RiderDistance = 0.0f; RiderDistance <= 12000.0f; RiderDistance += 100.0f)
+        {
+            Spawner->UpdateCrowd(RiderDistance);
+            Spawner->UpdateSignificance(FVector(RiderDistance, 0, 0), FVector::ForwardVector);
+            Spawner->UpdateCrowdInstances(0.1f);
+
+            for (int32 Instance = 0; Instance < Spawner->CrowdInstances->GetInstanceCount(); Instance++)
+            {
+                FTransform InstanceTransform;
+                Spawner->CrowdInstances->GetInstanceTransform(Instance, InstanceTransform, true);
+                bBehindReleased &= InstanceTransform.GetScale3D().IsNearlyZero()
+                    || InstanceTransform.GetLocation().X >= RiderDistance - Spawner->DespawnDistanceBehind - 20.0f;
+            }
+        }
+        TestTrue("NPCs released by where they walked to", bBehindReleased);
+        TestEqual("Crowd empty past the end", Spawner->GetNumActiveCrowdNPCs(), 0);
+        TestEqual("No actors left promoted", Spawner->GetNumPromotedNPCs(), 0);
+        TestTrue("Slots recycled across the path", Spawner->GetNumCrowdSlots() < Spawner->NPCCount / 2);
+        TestTrue("Actor tier stays small", Spawner->GetNumCrowdActorsCreated() <= Spawner->MaxFullActors);
+    }
+
+    TestWorld->DestroyWorld(false);
+    return true;
+}
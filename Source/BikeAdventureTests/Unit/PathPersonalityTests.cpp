@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Core/BiomeTypes.h"
+#include "Systems/PathPersonalitySystem.h"
+
+// Batched path hints must match per-intersection generation under the same seed
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathHintsBatchEquivalenceTest,
+	"BikeAdventure.Unit.PathPersonality.BatchEquivalence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathHintsBatchEquivalenceTest::RunTest(const FString& Parameters)
+{
+	UPathPersonalitySystem* SequentialSystem = NewObject<UPathPersonalitySystem>();
+	UPathPersonalitySystem* BatchSystem = NewObject<UPathPersonalitySystem>();
+	TestNotNull("Sequential system created", SequentialSystem);
+	TestNotNull("Batch system created", BatchSystem);
+
+	if (!SequentialSystem || !BatchSystem)
+	{
+		return false;
+	}
+
+	SequentialSystem->Initialize();
+	BatchSystem->Initialize();
+
+	FPlayerChoiceHistory History;
+	for (int32 i = 0; i < 12; i++)
+	{
+		SequentialSystem->UpdatePlayerChoiceHistory(History, (i % 3) != 0, EBiomeType::Forest, (i % 2) ? EPathPersonality::Wild : EPathPersonality::Scenic);
+	}
+
+	// A ring of intersections covering every biome, including an unknown destination
+	FRandomStream RequestStream(2024);
+	TArray<FPathHintRequest> Requests;
+	for (int32 i = 0; i < 48; i++)
+	{
+		FPathHintRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.SectionCoordinates = FIntVector(i % 8, i / 8, 0);
+		Request.CurrentBiome = static_cast<EBiomeType>(i % BiomeTables::NumBiomes);
+		Request.LeftPathBiome = static_cast<EBiomeType>(RequestStream.RandRange(0, BiomeTables::NumBiomes - 1));
+		Request.RightPathBiome = (i == 47) ? EBiomeType::None : static_cast<EBiomeType>(RequestStream.RandRange(0, BiomeTables::NumBiomes - 1));
+	}
+
+	TArray<FCompactPathHints> BatchHints;
+	BatchSystem->GeneratePathHintsForIntersections(Requests, History, BatchHints);
+	TestEqual("One result per request", BatchHints.Num(), Requests.Num());
+
+	if (BatchHints.Num() != Requests.Num())
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < Requests.Num(); i++)
+	{
+		const FPathHintRequest& Request = Requests[i];
+		const FPathHints Expected = SequentialSystem->GeneratePathHintsForIntersection(Request.CurrentBiome, Request.LeftPathBiome, Request.RightPathBiome, History);
+		const FCompactPathHints& Actual = BatchHints[i];
+
+		TestTrue(FString::Printf(TEXT("Section preserved [%d]"), i), Actual.SectionCoordinates == Request.SectionCoordinates);
+		TestEqual(FString::Printf(TEXT("Left personality [%d]"), i), static_cast<int32>(Actual.LeftPathPersonality), static_cast<int32>(Expected.LeftPathPersonality));
+		TestEqual(FString::Printf(TEXT("Right personality [%d]"), i), static_cast<int32>(Actual.RightPathPersonality), static_cast<int32>(Expected.RightPathPersonality));
+		TestEqual(FString::Printf(TEXT("Left challenge factor [%d]"), i), Actual.LeftPathChallengeFactor, Expected.LeftPathChallengeFactor);
+		TestEqual(FString::Printf(TEXT("Right scenery factor [%d]"), i), Actual.RightPathSceneryFactor, Expected.RightPathSceneryFactor);
+		TestEqual(FString::Printf(TEXT("Hint subtlety [%d]"), i), Actual.HintSubtlety, Expected.HintSubtlety);
+	}
+
+	// An empty ring produces no results
+	TArray<FCompactPathHints> EmptyHints;
+	BatchSystem->GeneratePathHintsForIntersections(TArray<FPathHintRequest>(), History, EmptyHints);
+	TestEqual("Empty batch yields no hints", EmptyHints.Num(), 0);
+
+	return true;
+}
+
+// Rules changed after initialisation must reach the selection tables
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathRulesRebuildTest,
+	"BikeAdventure.Unit.PathPersonality.RulesRebuild",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathRulesRebuildTest::RunTest(const FString& Parameters)
+{
+	UPathPersonalitySystem* PathSystem = NewObject<UPathPersonalitySystem>();
+	PathSystem->Initialize();
+
+	FPathGenerationRules MysteryOnly;
+	MysteryOnly.BiomeType = EBiomeType::Forest;
+	MysteryOnly.SetPersonalityWeight(EPathPersonality::Mystery, 1.0f);
+	PathSystem->SetBiomeGenerationRules(EBiomeType::Forest, MysteryOnly);
+
+	const FPlayerChoiceHistory History;
+	bool bAlwaysMystery = true;
+	for (int32 i = 0; i < 32; i++)
+	{
+		bAlwaysMystery &= PathSystem->DeterminePathPersonality(EBiomeType::Countryside, EBiomeType::Forest, (i % 2) == 0, History) == EPathPersonality::Mystery;
+	}
+	TestTrue("Replaced rules drive personality selection", bAlwaysMystery);
+
+	return true;
+}
+
+// The packed recent window and its rolling statistics must match a plain replay of the choices
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerChoiceHistoryRingTest,
+	"BikeAdventure.Unit.PathPersonality.ChoiceHistoryRing",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPlayerChoiceHistoryRingTest::RunTest(const FString& Parameters)
+{
+	UPathPersonalitySystem* PathSystem = NewObject<UPathPersonalitySystem>();
+	TestNotNull("Path personality system created", PathSystem);
+
+	if (!PathSystem)
+	{
+		return false;
+	}
+
+	PathSystem->Initialize();
+
+	FPlayerChoiceHistory History;
+	TestEqual("Empty window ratio is neutral", History.GetRecentLeftRatio(), 0.5f);
+	TestEqual("No streak before the first choice", History.GetStreakLength(), 0);
+	TestTrue("No last biome before the first choice", History.GetLastBiome() == EBiomeType::None);
+
+	// Runs of unequal length cross the window boundary several times
+	TArray<bool> Sides;
+	TArray<EBiomeType> Biomes;
+	TArray<EPathPersonality> Personalities;
+	for (int32 i = 0; i < 100; i++)
+	{
+		const bool bLeft = ((i / 7) % 2) == 0 || (i % 5) == 0;
+		const EBiomeType Biome = static_cast<EBiomeType>(i % (BiomeTables::NumBiomes + 1));
+		const EPathPersonality Personality = static_cast<EPathPersonality>(i % (PathPersonalityTables::NumPersonalities + 1));
+		Sides.Add(bLeft);
+		Biomes.Add(Biome);
+		Personalities.Add(Personality);
+		PathSystem->UpdatePlayerChoiceHistory(History, bLeft, Biome, Personality);
+
+		const int32 Expected = FMath::Min(i + 1, FPlayerChoiceHistory::RecentCapacity);
+		int32 ExpectedLeft = 0;
+		bool bWindowMatches = History.GetNumRecent() == Expected;
+		for (int32 Back = 0; bWindowMatches && Back < Expected; Back++)
+		{
+			const int32 Source = i - Back;
+			ExpectedLeft += Sides[Source] ? 1 : 0;
+			bWindowMatches = History.GetRecentChoice(Back) == Sides[Source]
+				&& History.GetRecentBiome(Back) == Biomes[Source]
+				&& History.GetRecentPersonality(Back) == Personalities[Source];
+		}
+
+		int32 ExpectedStreak = 1;
+		while (ExpectedStreak <= i && Sides[i - ExpectedStreak] == bLeft)
+		{
+			ExpectedStreak++;
+		}
+
+		TestTrue(FString::Printf(TEXT("Window contents [%d]"), i), bWindowMatches);
+		TestEqual(FString::Printf(TEXT("Window left ratio [%d]"), i), History.GetRecentLeftRatio(), static_cast<float>(ExpectedLeft) / Expected);
+		TestEqual(FString::Printf(TEXT("Streak length [%d]"), i), History.GetStreakLength(), ExpectedStreak);
+		TestTrue(FString::Printf(TEXT("Streak side [%d]"), i), History.IsStreakLeft() == bLeft);
+	}
+
+	TestEqual("Lifetime totals keep counting past the window", History.TotalChoices, 100);
+	TestTrue("Last biome is the latest choice", History.GetLastBiome() == Biomes.Last());
+
+	return true;
+}
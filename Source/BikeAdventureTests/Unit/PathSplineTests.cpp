@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Systems/PathSpline.h"
+#include "Systems/BiomeGenerator.h"
+
+// Arc-length table must give evenly spaced, consistent lookups along a curved path
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathSplineArcLengthTest,
+	"BikeAdventure.Unit.PathSpline.ArcLength",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathSplineArcLengthTest::RunTest(const FString& Parameters)
+{
+	// A straight spline is parameterised exactly
+	FPathSpline Straight;
+	const FVector StraightPoints[] = { FVector(0.0f, 0.0f, 0.0f), FVector(1000.0f, 0.0f, 0.0f) };
+	Straight.Build(StraightPoints);
+	TestTrue("Straight spline built", Straight.IsValid());
+	TestEqual("Straight length", Straight.GetLength(), 1000.0f, 0.5f);
+	TestTrue("Straight lookup", Straight.GetLocationAtDistance(250.0f).Equals(FVector(250.0f, 0.0f, 0.0f), 1.0f));
+	TestTrue("Straight direction", Straight.GetDirectionAtDistance(500.0f).Equals(FVector::ForwardVector, 0.01f));
+
+	// A winding spline like the ones sections generate
+	TArray<FVector> ControlPoints;
+	FRandomStream Stream(42);
+	for (int32 i = 0; i < 11; i++)
+	{
+		ControlPoints.Add(FVector(i * 2000.0f, i == 0 ? 0.0f : Stream.FRandRange(-200.0f, 200.0f), 0.0f));
+	}
+
+	FPathSpline Path;
+	Path.Build(ControlPoints);
+	TestTrue("Winding spline built", Path.IsValid());
+	TestTrue("Winding spline longer than its chord", Path.GetLength() >= 20000.0f);
+
+	TestTrue("Starts on the first control point", Path.GetLocationAtDistance(0.0f).Equals(ControlPoints[0], 1.0f));
+	TestTrue("Ends on the last control point", Path.GetLocationAtDistance(Path.GetLength()).Equals(ControlPoints.Last(), 1.0f));
+	TestTrue("Clamped before the start", Path.GetLocationAtDistance(-500.0f).Equals(Path.GetLocationAtDistance(0.0f)));
+	TestTrue("Clamped past the end", Path.GetLocationAtDistance(Path.GetLength() + 500.0f).Equals(Path.GetLocationAtDistance(Path.GetLength())));
+
+	// Equal distance steps cover equal ground, and nearest-point queries invert the lookup
+	bool bEvenlySpaced = true;
+	bool bNearestRoundTrips = true;
+	bool bHintedMatchesFull = true;
+	for (float Distance = 0.0f; Distance + 50.0f <= Path.GetLength(); Distance += 37.0f)
+	{
+		const FVector Location = Path.GetLocationAtDistance(Distance);
+		bEvenlySpaced &= FMath::IsNearlyEqual(FVector::Dist(Location, Path.GetLocationAtDistance(Distance + 50.0f)), 50.0f, 0.5f);
+
+		const FVector Side = FVector::CrossProduct(Path.GetDirectionAtDistance(Distance), FVector::UpVector);
+		const FVector OffPath = Location + Side * 50.0f;
+		const float Nearest = Path.FindNearestDistance(OffPath);
+		bNearestRoundTrips &= FMath::IsNearlyEqual(Nearest, Distance, 5.0f);
+		bHintedMatchesFull &= FMath::IsNearlyEqual(Path.FindNearestDistance(OffPath, Distance + 200.0f), Nearest, 0.01f);
+	}
+	TestTrue("Lookups are evenly spaced by arc length", bEvenlySpaced);
+	TestTrue("Nearest distance inverts the lookup", bNearestRoundTrips);
+	TestTrue("Hinted search matches the full search", bHintedMatchesFull);
+
+	// Shared path coordinate
+	Path.StartDistance = 50000.0f;
+	TestEqual("Local to path distance", Path.ToPathDistance(1200.0f), 51200.0f);
+	TestEqual("Path to local distance", Path.ToLocalDistance(51200.0f), 1200.0f);
+	TestTrue("Contains its own range", Path.ContainsPathDistance(50000.0f + Path.GetLength() * 0.5f));
+	TestFalse("Excludes earlier distances", Path.ContainsPathDistance(49000.0f));
+
+	FPathSpline Degenerate;
+	const FVector SinglePoint[] = { FVector::ZeroVector };
+	Degenerate.Build(SinglePoint);
+	TestFalse("One control point is not a path", Degenerate.IsValid());
+
+	return true;
+}
+
+// Generated section splines must be deterministic and run from the entry to the exit point
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathSplineGenerationTest,
+	"BikeAdventure.Unit.PathSpline.Generation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPathSplineGenerationTest::RunTest(const FString& Parameters)
+{
+	UBiomeGenerator* BiomeGen = NewObject<UBiomeGenerator>();
+	TestNotNull("Biome generator created", BiomeGen);
+
+	if (!BiomeGen)
+	{
+		return false;
+	}
+
+	BiomeGen->SetGenerationSeed(1234);
+
+	const FVector Origin(100000.0f, 300000.0f, 0.0f);
+	const FVector Entry(100000.0f, 200000.0f, 0.0f);
+	const FVector Exit(130000.0f, 400000.0f, 0.0f);
+	const FPathSpline First = BiomeGen->GeneratePathSpline(Origin, Entry, Exit, EBiomeType::Forest, 5000.0f);
+	const FPathSpline Second = BiomeGen->GeneratePathSpline(Origin, Entry, Exit, EBiomeType::Forest, 5000.0f);
+
+	TestTrue("Generated spline is valid", First.IsValid());
+	TestEqual("Start distance applied", First.StartDistance, 5000.0f);
+	TestTrue("Spline starts at the entry point", First.GetLocationAtDistance(0.0f).Equals(Entry, 1.0f));
+	TestTrue("Spline ends at the exit point", First.GetLocationAtDistance(First.GetLength()).Equals(Exit, 1.0f));
+	TestTrue("Spline crosses the section", First.GetLength() >= FVector::Dist(Entry, Exit));
+	TestTrue("Spline passes through the section centre", First.GetLocationAtDistance(First.FindNearestDistance(Origin)).Equals(Origin, 5.0f));
+	TestEqual("Same inputs give the same length", First.GetLength(), Second.GetLength());
+	TestTrue("Same inputs give the same shape", First.GetLocationAtDistance(First.GetLength() * 0.5f).Equals(Second.GetLocationAtDistance(Second.GetLength() * 0.5f)));
+
+	return true;
+}
@@ -0,0 +1,416 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Systems/BikeSaveFormat.h"
+#include "Systems/BikeSaveSubsystem.h"
+#include "Systems/DiscoverySystem.h"
+#include "Systems/DiscoveryTable.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+
+/**
+ * Unit tests for the compact save format and the subsystem that writes it
+ */
+
+namespace
+{
+	void AddTestChoices(FBikeChoiceLog& Log, int32 First, int32 Count)
+	{
+		for (int32 i = First; i < First + Count; i++)
+		{
+			Log.Add((i % 3) == 0, static_cast<EBiomeType>(i % (BiomeTables::NumBiomes + 1)), static_cast<EPathPersonality>(i % 7));
+		}
+	}
+
+	bool ChoicesMatch(const FBikeChoiceLog& Log, int32 First, int32 Count)
+	{
+		bool bMatch = Log.Num() == First + Count;
+		for (int32 i = First; bMatch && i < First + Count; i++)
+		{
+			const FBikeChoiceLog::FChoice Choice = Log.Get(i);
+			bMatch = Choice.bChoseLeft == ((i % 3) == 0)
+				&& Choice.Biome == static_cast<EBiomeType>(i % (BiomeTables::NumBiomes + 1))
+				&& Choice.Personality == static_cast<EPathPersonality>(i % 7);
+		}
+		return bMatch;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeChoiceLogTest,
+	"BikeAdventure.Unit.Save.ChoiceLog",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeChoiceLogTest::RunTest(const FString& Parameters)
+{
+	FBikeChoiceLog Log;
+	AddTestChoices(Log, 0, 1000);
+	TestTrue(TEXT("Every field of every choice survives packing"), ChoicesMatch(Log, 0, 1000));
+
+	// Copy ranges that start on and off byte boundaries, and splice them back together
+	FBikeChoiceLog Rebuilt;
+	const int32 Splits[] = { 0, 8, 13, 500, 999, 1000 };
+	for (int32 i = 0; i + 1 < UE_ARRAY_COUNT(Splits); i++)
+	{
+		TArray<uint8> Packed;
+		Log.CopyRange(Splits[i], Splits[i + 1] - Splits[i], Packed);
+		TestEqual(TEXT("Range packs into the minimum bytes"), Packed.Num(), FBikeChoiceLog::GetNumBytes(Splits[i + 1] - Splits[i]));
+		Rebuilt.AppendPacked(Packed.GetData(), Splits[i + 1] - Splits[i]);
+	}
+	TestTrue(TEXT("Spliced ranges rebuild the log"), ChoicesMatch(Rebuilt, 0, 1000));
+
+	TArray<uint8> Whole;
+	TArray<uint8> Spliced;
+	Log.CopyRange(0, Log.Num(), Whole);
+	Rebuilt.CopyRange(0, Rebuilt.Num(), Spliced);
+	TestTrue(TEXT("Rebuilt log packs to the same bytes"), Whole == Spliced);
+
+	Log.Reset();
+	TestEqual(TEXT("Reset empties the log"), Log.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeSaveFormatRoundTripTest,
+	"BikeAdventure.Unit.Save.RoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeSaveFormatRoundTripTest::RunTest(const FString& Parameters)
+{
+	FBikeChoiceLog Log;
+	AddTestChoices(Log, 0, 300);
+
+	FBikeSaveCounters Counters;
+	Counters.TotalChoices = 300;
+	Counters.LeftChoices = 100;
+	Counters.RightChoices = 200;
+	Counters.DiscoveriesFound = 4;
+	Counters.PreferredPersonality = EPathPersonality::Scenic;
+	Counters.AdaptiveWeight = 0.25f;
+	Counters.PersonalityPreferences = { 0.1f, 0.2f, 0.9f, 0.0f, 0.3f, 0.05f };
+
+	FDiscoverySaveState Discoveries;
+	Discoveries.TableHash = 0xC0FFEE;
+	Discoveries.BiomeWideFound.Init(false, 11);
+	Discoveries.BiomeWideFound[3] = true;
+	Discoveries.BiomeWideFound[10] = true;
+	Discoveries.FoundNames = { FName(TEXT("Hollow Oak"), 12345), FName(TEXT("Hollow Oak"), 777), FName(TEXT("Tide Pools"), 5) };
+
+	// Full save of the first 300 choices
+	TArray<uint8> Bytes;
+	TArray<uint8> Packed;
+	BikeSaveFormat::WriteFileHeader(Bytes);
+	BikeSaveFormat::WriteCounters(Counters, Bytes);
+	BikeSaveFormat::WriteDiscoveries(Discoveries, Bytes);
+	Log.CopyRange(0, Log.Num(), Packed);
+	BikeSaveFormat::WriteChoices(0, Log.Num(), Packed, Bytes);
+
+	FBikeSaveSnapshot Snapshot;
+	int32 NumChunks = 0;
+	TestTrue(TEXT("Full save reads"), BikeSaveFormat::Read(Bytes, Snapshot, &NumChunks));
+	TestEqual(TEXT("Three chunks"), NumChunks, 3);
+	TestTrue(TEXT("Choices read back"), ChoicesMatch(Snapshot.Choices, 0, 300));
+	TestEqual(TEXT("Total choices"), static_cast<int32>(Snapshot.Counters.TotalChoices), 300);
+	TestEqual(TEXT("Right choices"), static_cast<int32>(Snapshot.Counters.RightChoices), 200);
+	TestTrue(TEXT("Preferred personality"), Snapshot.Counters.PreferredPersonality == EPathPersonality::Scenic);
+	TestEqual(TEXT("Preference values"), Snapshot.Counters.PersonalityPreferences[2], 0.9f);
+	TestEqual(TEXT("Discovery table hash"), Snapshot.Discoveries.TableHash, Discoveries.TableHash);
+	TestTrue(TEXT("Discovery bits"), Snapshot.Discoveries.BiomeWideFound == Discoveries.BiomeWideFound);
+	TestTrue(TEXT("Located names with their instance numbers"), Snapshot.Discoveries.FoundNames == Discoveries.FoundNames);
+
+	// An incremental save appends only the new choices and fresh snapshots
+	const int32 FullSize = Bytes.Num();
+	AddTestChoices(Log, 300, 45);
+	Counters.TotalChoices = 345;
+	Log.CopyRange(300, 45, Packed);
+	BikeSaveFormat::WriteCounters(Counters, Bytes);
+	BikeSaveFormat::WriteDiscoveries(Discoveries, Bytes);
+	BikeSaveFormat::WriteChoices(300, 45, Packed, Bytes);
+	TestTrue(TEXT("Append is much smaller than the full save"), Bytes.Num() - FullSize < FullSize / 2);
+
+	TestTrue(TEXT("Appended save reads"), BikeSaveFormat::Read(Bytes, Snapshot, &NumChunks));
+	TestEqual(TEXT("Six chunks"), NumChunks, 6);
+	TestTrue(TEXT("Appended choices follow on"), ChoicesMatch(Snapshot.Choices, 0, 345));
+	TestEqual(TEXT("Latest counters win"), static_cast<int32>(Snapshot.Counters.TotalChoices), 345);
+
+	// A torn append loses only the chunk being written
+	TArray<uint8> Torn = Bytes;
+	Torn.SetNum(Torn.Num() - 3);
+	TestTrue(TEXT("Torn save still reads"), BikeSaveFormat::Read(Torn, Snapshot, &NumChunks));
+	TestEqual(TEXT("Torn chunk dropped"), NumChunks, 5);
+	TestTrue(TEXT("Choices up to the torn chunk kept"), ChoicesMatch(Snapshot.Choices, 0, 300));
+
+	// A corrupt payload is caught by its checksum
+	TArray<uint8> Corrupt = Bytes;
+	Corrupt[FullSize - 10] ^= 0xFF;
+	TestTrue(TEXT("Corrupt save still reads"), BikeSaveFormat::Read(Corrupt, Snapshot, &NumChunks));
+	TestTrue(TEXT("Corrupt chunk and everything after dropped"), NumChunks < 3);
+
+	// A gap in the choice sequence is not spliced in
+	TArray<uint8> Gap;
+	BikeSaveFormat::WriteFileHeader(Gap);
+	Log.CopyRange(0, 10, Packed);
+	BikeSaveFormat::WriteChoices(0, 10, Packed, Gap);
+	Log.CopyRange(20, 10, Packed);
+	BikeSaveFormat::WriteChoices(20, 10, Packed, Gap);
+	TestTrue(TEXT("Save with a gap reads"), BikeSaveFormat::Read(Gap, Snapshot));
+	TestEqual(TEXT("Choices stop at the gap"), Snapshot.Choices.Num(), 10);
+
+	TArray<uint8> WrongVersion = Bytes;
+	WrongVersion[4]++;
+	TestFalse(TEXT("Unknown version rejected"), BikeSaveFormat::Read(WrongVersion, Snapshot));
+
+	// Version 1 keyed discovery bits by catalogue position; its choices still load, its discoveries do not
+	TArray<uint8> OldVersion = Bytes;
+	OldVersion[4] = 1;
+	TestTrue(TEXT("Previous version reads"), BikeSaveFormat::Read(OldVersion, Snapshot, &NumChunks));
+	TestTrue(TEXT("Previous version choices kept"), ChoicesMatch(Snapshot.Choices, 0, 345));
+	TestEqual(TEXT("Previous version discoveries skipped"), Snapshot.Discoveries.FoundNames.Num(), 0);
+	TestEqual(TEXT("Previous version is rewritten rather than appended to"), NumChunks, 0);
+	TestFalse(TEXT("Empty file rejected"), BikeSaveFormat::Read(TArray<uint8>(), Snapshot));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeSaveDiscoveryStateTest,
+	"BikeAdventure.Unit.Save.DiscoveryState",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeSaveDiscoveryStateTest::RunTest(const FString& Parameters)
+{
+	UDiscoverySystem* Source = NewObject<UDiscoverySystem>();
+	Source->DiscoveryTablePath.Empty();
+	Source->Initialize();
+
+	FDiscoveryData Located;
+	Located.Name = FName(TEXT("Hollow Oak"), 42);
+	Located.RequiredBiome = EBiomeType::Forest;
+	Located.bIsLocated = true;
+	Source->AddDiscovery(Located);
+
+	Source->TriggerDiscovery(TEXT("Breaching Whale"));
+	Source->TriggerDiscovery(TEXT("Rural Farm"));
+	Source->TriggerDiscovery(Located.Name);
+
+	FDiscoverySaveState State;
+	Source->CaptureSaveState(State);
+	TestEqual(TEXT("No table, so no table bits"), State.BiomeWideFound.Num(), 0);
+	TestEqual(TEXT("Finds without a table record saved by name"), State.FoundNames.Num(), 3);
+
+	// Restoring into a fresh catalogue marks the same entries found
+	UDiscoverySystem* Restored = NewObject<UDiscoverySystem>();
+	Restored->DiscoveryTablePath.Empty();
+	Restored->Initialize();
+	Restored->RestoreSaveState(State);
+
+	TestTrue(TEXT("Biome-wide find restored"), Restored->IsDiscovered(TEXT("Breaching Whale")));
+	TestTrue(TEXT("Second biome-wide find restored"), Restored->IsDiscovered(TEXT("Rural Farm")));
+	TestFalse(TEXT("Unfound entry stays unfound"), Restored->IsDiscovered(TEXT("Deer Crossing")));
+	TestTrue(TEXT("Non-resident located find restored"), Restored->IsDiscovered(Located.Name));
+	TestEqual(TEXT("Found count restored"), Restored->GetTotalDiscoveriesFound(), 3);
+	TestEqual(TEXT("Restored entries leave their biome buckets"), Restored->GetRemainingDiscoveriesInBiome(EBiomeType::Beach), 0);
+
+	// A located entry arriving later comes in already found
+	Restored->AddDiscovery(Located);
+	TestFalse(TEXT("Restored located entry cannot trigger again"), Restored->TriggerDiscovery(Located.Name));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeSaveDiscoveryTableKeysTest,
+	"BikeAdventure.Unit.Save.DiscoveryTableKeys",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeSaveDiscoveryTableKeysTest::RunTest(const FString& Parameters)
+{
+	auto BuildTable = [](TArrayView<const TCHAR* const> Names)
+	{
+		TArray<FDiscoveryTableSourceRow> Rows;
+		for (const TCHAR* Name : Names)
+		{
+			FDiscoveryTableSourceRow& Row = Rows.AddDefaulted_GetRef();
+			Row.Name = Name;
+			Row.Biome = EBiomeType::Forest;
+		}
+
+		TArray<uint8> Bytes;
+		FDiscoveryTable::Build(Rows, 1, Bytes);
+		TSharedRef<FDiscoveryTable> Table = MakeShared<FDiscoveryTable>();
+		Table->OpenFromBytes(MoveTemp(Bytes));
+		return Table;
+	};
+
+	auto MakeSystem = [](const TSharedRef<FDiscoveryTable>& Table)
+	{
+		UDiscoverySystem* DiscoverySystem = NewObject<UDiscoverySystem>();
+		DiscoverySystem->SetDiscoveryTable(Table);
+		DiscoverySystem->Initialize();
+		return DiscoverySystem;
+	};
+
+	const TCHAR* const Names[] = { TEXT("Mossy Bridge"), TEXT("Owl Hollow"), TEXT("Fern Gully") };
+	const TSharedRef<FDiscoveryTable> Table = BuildTable(Names);
+
+	// A biome-wide entry added at runtime has no table record
+	FDiscoveryData Shrine;
+	Shrine.Name = TEXT("Roadside Shrine");
+	Shrine.RequiredBiome = EBiomeType::Forest;
+
+	UDiscoverySystem* Source = MakeSystem(Table);
+	Source->AddDiscovery(Shrine);
+	Source->TriggerDiscovery(TEXT("Owl Hollow"));
+	Source->TriggerDiscovery(Shrine.Name);
+
+	FDiscoverySaveState State;
+	Source->CaptureSaveState(State);
+	TestEqual(TEXT("Saved against the table's hash"), State.TableHash, Table->GetBiomeWideHash());
+	TestEqual(TEXT("One bit per biome-wide table record"), State.BiomeWideFound.Num(), 3);
+	TestEqual(TEXT("Only the found record's bit set"), State.BiomeWideFound.CountSetBits(), 1);
+	TestTrue(TEXT("Runtime entry saved by name"), State.FoundNames.Num() == 1 && State.FoundNames[0] == Shrine.Name);
+
+	// Runtime entries do not shift the keys of table entries
+	UDiscoverySystem* Restored = MakeSystem(Table);
+	Restored->RestoreSaveState(State);
+	TestTrue(TEXT("Table find restored"), Restored->IsDiscovered(TEXT("Owl Hollow")));
+	TestFalse(TEXT("Neighbouring record untouched"), Restored->IsDiscovered(TEXT("Mossy Bridge")));
+	TestFalse(TEXT("Other neighbouring record untouched"), Restored->IsDiscovered(TEXT("Fern Gully")));
+	TestTrue(TEXT("Runtime find remembered before it is added"), Restored->IsDiscovered(Shrine.Name));
+
+	// Against a reordered table the bits mean nothing, so they are dropped rather than misread
+	const TCHAR* const Reordered[] = { TEXT("Owl Hollow"), TEXT("Mossy Bridge"), TEXT("Fern Gully") };
+	const TSharedRef<FDiscoveryTable> OtherTable = BuildTable(Reordered);
+	TestNotEqual(TEXT("Reordered table hashes differently"), OtherTable->GetBiomeWideHash(), Table->GetBiomeWideHash());
+
+	AddExpectedError(TEXT("different discovery table"), EAutomationExpectedErrorFlags::Contains, 1);
+	UDiscoverySystem* Mismatched = MakeSystem(OtherTable);
+	Mismatched->RestoreSaveState(State);
+	TestFalse(TEXT("Record at the old position not marked"), Mismatched->IsDiscovered(TEXT("Mossy Bridge")));
+	TestEqual(TEXT("Only the named find restored"), Mismatched->GetTotalDiscoveriesFound(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeSaveSubsystemTest,
+	"BikeAdventure.Unit.Save.Subsystem",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeSaveSubsystemTest::RunTest(const FString& Parameters)
+{
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone();
+	UWorld* TestWorld = GameInstance->GetWorld();
+	UBikeSaveSubsystem* Save = GameInstance->GetSubsystem<UBikeSaveSubsystem>();
+	TestNotNull("Save subsystem available", Save);
+
+	auto Cleanup = [GameInstance, TestWorld]()
+	{
+		GameInstance->Shutdown();
+		if (TestWorld)
+		{
+			GEngine->DestroyWorldContext(TestWorld);
+			TestWorld->DestroyWorld(false);
+		}
+	};
+
+	if (!Save)
+	{
+		Cleanup();
+		return false;
+	}
+
+	Save->SaveFileName = FString::Printf(TEXT("SaveSubsystemTest_%s.bsav"), *FGuid::NewGuid().ToString());
+	Save->MaxChunksBeforeRewrite = 8;
+	const FString SavePath = Save->GetSavePath();
+
+	UDiscoverySystem* Discovery = NewObject<UDiscoverySystem>();
+	Discovery->DiscoveryTablePath.Empty();
+	Discovery->Initialize();
+	Discovery->TriggerDiscovery(TEXT("Breaching Whale"));
+	Save->SetDiscoverySystem(Discovery);
+
+	auto RecordChoices = [Save](int32 First, int32 Count)
+	{
+		for (int32 i = First; i < First + Count; i++)
+		{
+			Save->RecordChoice((i % 3) == 0, static_cast<EBiomeType>(i % (BiomeTables::NumBiomes + 1)), static_cast<EPathPersonality>(i % 7));
+		}
+	};
+
+	auto ReadFile = [&SavePath](FBikeSaveSnapshot& OutSnapshot, int32& OutNumChunks)
+	{
+		TArray<uint8> Bytes;
+		return FFileHelper::LoadFileToArray(Bytes, *SavePath) && BikeSaveFormat::Read(Bytes, OutSnapshot, &OutNumChunks);
+	};
+
+	FBikeSaveSnapshot Snapshot;
+	int32 NumChunks = 0;
+
+	// A save asked for while one is running is queued and runs once the first finishes
+	RecordChoices(0, 20);
+	TestTrue(TEXT("First save starts"), Save->SaveGame());
+	TestTrue(TEXT("Save runs in the background"), Save->IsBusy());
+	RecordChoices(20, 5);
+	TestFalse(TEXT("Second save is queued"), Save->SaveGame());
+	Save->WaitForPendingIO();
+	TestTrue(TEXT("Queued save started when the first finished"), Save->IsBusy());
+	Save->WaitForPendingIO();
+	TestFalse(TEXT("Queued save finished"), Save->IsBusy());
+
+	TestTrue(TEXT("Saved file reads"), ReadFile(Snapshot, NumChunks));
+	TestEqual(TEXT("Queued save appended to the first"), NumChunks, 6);
+	TestTrue(TEXT("Every choice saved"), ChoicesMatch(Snapshot.Choices, 0, 25));
+
+	// Another append would pass the chunk limit, so the file is rewritten whole
+	RecordChoices(25, 5);
+	Save->SaveGame();
+	Save->WaitForPendingIO();
+	TestTrue(TEXT("Rewritten file reads"), ReadFile(Snapshot, NumChunks));
+	TestEqual(TEXT("Rewrite starts over"), NumChunks, 3);
+	TestTrue(TEXT("Rewrite keeps every choice"), ChoicesMatch(Snapshot.Choices, 0, 30));
+	TestFalse(TEXT("No temporary file left behind"), IFileManager::Get().FileExists(*(SavePath + TEXT(".tmp"))));
+
+	// Loading replaces unsaved state, but choices made while the file is read are kept
+	UDiscoverySystem* FreshDiscovery = NewObject<UDiscoverySystem>();
+	FreshDiscovery->DiscoveryTablePath.Empty();
+	FreshDiscovery->Initialize();
+	Save->SetDiscoverySystem(FreshDiscovery);
+
+	Save->RecordChoice(false, EBiomeType::Desert, EPathPersonality::Scenic);
+	TestTrue(TEXT("Load starts"), Save->LoadGame());
+	RecordChoices(30, 2);
+	Save->WaitForPendingIO();
+	TestTrue(TEXT("Loaded run followed by the choices made during the load"), ChoicesMatch(Save->GetChoiceLog(), 0, 32));
+	TestEqual(TEXT("Choice history counts them too"), static_cast<int32>(Save->GetChoiceHistory().TotalChoices), 32);
+	TestTrue(TEXT("Discoveries restored"), FreshDiscovery->IsDiscovered(TEXT("Breaching Whale")));
+
+	// Only the choices made during the load are new to the file
+	Save->SaveGame();
+	Save->WaitForPendingIO();
+	TestTrue(TEXT("File after load reads"), ReadFile(Snapshot, NumChunks));
+	TestEqual(TEXT("Save after load appends"), NumChunks, 6);
+	TestTrue(TEXT("Appended choices follow the loaded ones"), ChoicesMatch(Snapshot.Choices, 0, 32));
+
+	// A failed append may leave a partial chunk behind, so the next save rewrites the file
+	Save->MaxChunksBeforeRewrite = 16;
+	IFileManager::Get().Delete(*SavePath);
+	IFileManager::Get().MakeDirectory(*SavePath, true);
+	AddExpectedError(TEXT("Failed to write save file"), EAutomationExpectedErrorFlags::Contains, 1);
+	RecordChoices(32, 3);
+	Save->SaveGame();
+	Save->WaitForPendingIO();
+	IFileManager::Get().DeleteDirectory(*SavePath, false, true);
+
+	Save->SaveGame();
+	Save->WaitForPendingIO();
+	TestTrue(TEXT("File after a failed write reads"), ReadFile(Snapshot, NumChunks));
+	TestEqual(TEXT("Failed write forced a rewrite"), NumChunks, 3);
+	TestTrue(TEXT("Rewrite holds every choice"), ChoicesMatch(Snapshot.Choices, 0, 35));
+
+	IFileManager::Get().Delete(*SavePath);
+	Cleanup();
+	return true;
+}
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Systems/BikeTelemetry.h"
+
+/**
+ * Unit tests for the binary hot-path telemetry channel
+ */
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeTelemetryRoundTripTest,
+    "BikeAdventure.Unit.Telemetry.RoundTrip",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeTelemetryRoundTripTest::RunTest(const FString& Parameters)
+{
+    FBikeTelemetry& Telemetry = FBikeTelemetry::Get();
+
+    // Reuse the session file if recording was requested for this run, otherwise record briefly to a scratch file
+    const bool bWasEnabled = Telemetry.IsEnabled();
+    if (!bWasEnabled)
+    {
+        const FString TestPath = FPaths::ProjectSavedDir() / TEXT("Telemetry") / TEXT("BikeTelemetry_UnitTest.bin");
+        TestTrue("Telemetry started", Telemetry.Startup(TestPath));
+    }
+
+    if (!Telemetry.IsEnabled())
+    {
+        return false;
+    }
+
+    const int32 Marker = 0x7E57;
+    const int32 NumRecords = 100;
+    for (int32 i = 0; i < NumRecords; i++)
+    {
+        Telemetry.Record(EBikeTelemetryEvent::SectionLoaded, FIntVector(i, -i, 0), EBiomeType::Forest, EBiomeType::None, Marker, static_cast<float>(i));
+    }
+    Telemetry.Flush();
+
+    TArray<uint8> FileData;
+    TestTrue("Telemetry file readable", FFileHelper::LoadFileToArray(FileData, *Telemetry.GetOutputPath()));
+    TestTrue("File holds header", FileData.Num() >= static_cast<int32>(sizeof(FBikeTelemetryFileHeader)));
+
+    if (FileData.Num() < static_cast<int32>(sizeof(FBikeTelemetryFileHeader)))
+    {
+        return false;
+    }
+
+    const FBikeTelemetryFileHeader* Header = reinterpret_cast<const FBikeTelemetryFileHeader*>(FileData.GetData());
+    TestEqual("Header magic", Header->Magic, FBikeTelemetryFileHeader::FileMagic);
+    TestEqual("Header version", static_cast<int32>(Header->Version), static_cast<int32>(FBikeTelemetryFileHeader::FileVersion));
+    TestEqual("Header record size", static_cast<int32>(Header->RecordSize), static_cast<int32>(sizeof(FBikeTelemetryRecord)));
+
+    const int32 PayloadSize = FileData.Num() - sizeof(FBikeTelemetryFileHeader);
+    TestEqual("Payload is whole records", PayloadSize % static_cast<int32>(sizeof(FBikeTelemetryRecord)), 0);
+
+    const FBikeTelemetryRecord* Records = reinterpret_cast<const FBikeTelemetryRecord*>(FileData.GetData() + sizeof(FBikeTelemetryFileHeader));
+    const int32 NumInFile = PayloadSize / sizeof(FBikeTelemetryRecord);
+
+    int32 Found = 0;
+    for (int32 i = 0; i < NumInFile; i++)
+    {
+        const FBikeTelemetryRecord& Entry = Records[i];
+        if (Entry.EventType == static_cast<uint8>(EBikeTelemetryEvent::SectionLoaded) && Entry.IntValue == Marker)
+        {
+            TestEqual("Record order preserved", Entry.X, Found);
+            TestEqual("Record Y preserved", Entry.Y, -Found);
+            TestEqual("Record biome preserved", Entry.BiomeA, static_cast<uint8>(EBiomeType::Forest));
+            Found++;
+        }
+    }
+
+    TestEqual("All records flushed", Found, NumRecords);
+
+    if (!bWasEnabled)
+    {
+        Telemetry.Shutdown();
+        IFileManager::Get().Delete(*Telemetry.GetOutputPath());
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBikeTelemetryOverflowTest,
+    "BikeAdventure.Unit.Telemetry.OverflowNeverBlocks",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBikeTelemetryOverflowTest::RunTest(const FString& Parameters)
+{
+    FBikeTelemetry& Telemetry = FBikeTelemetry::Get();
+    const bool bWasEnabled = Telemetry.IsEnabled();
+    if (!bWasEnabled)
+    {
+        Telemetry.Startup(FPaths::ProjectSavedDir() / TEXT("Telemetry") / TEXT("BikeTelemetry_UnitTest.bin"));
+    }
+
+    Telemetry.Flush();
+    const uint64 DroppedBefore = Telemetry.GetDroppedCount();
+
+    // Overfill the ring faster than the background thread can drain it
+    const int32 NumRecords = FBikeTelemetry::RingCapacity * 4;
+    for (int32 i = 0; i < NumRecords; i++)
+    {
+        Telemetry.Record(EBikeTelemetryEvent::BiomeTransition, FIntVector::ZeroValue, EBiomeType::Beach, EBiomeType::Urban);
+    }
+
+    // The background thread may drain part of the burst, so only bound what this flush and the drop counter saw
+    const int32 Written = Telemetry.Flush();
+    const uint64 Dropped = Telemetry.GetDroppedCount() - DroppedBefore;
+    TestTrue("Single flush is bounded by ring capacity", Written <= static_cast<int32>(FBikeTelemetry::RingCapacity));
+    TestTrue("Records are never duplicated", static_cast<uint64>(Written) + Dropped <= static_cast<uint64>(NumRecords));
+
+    if (!bWasEnabled)
+    {
+        Telemetry.Shutdown();
+        IFileManager::Get().Delete(*Telemetry.GetOutputPath());
+    }
+    return true;
+}
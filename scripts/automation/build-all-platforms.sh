@@ -237,6 +237,25 @@ generate_project_files() {
     fi
 }
 
+compile_game_data() {
+    log_header "Compiling Game Data"
+    
+    local source_csv="$PROJECT_ROOT/Content/Data/Discoveries.csv"
+    local output_bin="$PROJECT_ROOT/Content/Data/Discoveries.bin"
+    
+    if [ ! -f "$source_csv" ]; then
+        log_warning "Discovery table source not found, the built-in discoveries will be used"
+        return 0
+    fi
+    
+    if python3 "$SCRIPT_DIR/compile-discoveries.py" "$source_csv" -o "$output_bin"; then
+        log_success "Discovery table compiled"
+    else
+        log_error "Failed to compile discovery table"
+        exit 1
+    fi
+}
+
 build_platform() {
     local platform=$1
     local start_time=$(date +%s)
@@ -670,6 +689,7 @@ main() {
     update_git_lfs
     clean_intermediate_files
     generate_project_files
+    compile_game_data
     
     # Build phase
     local build_start_time=$(date +%s)
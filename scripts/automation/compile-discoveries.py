@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+BikeAdventure Discovery Table Compiler
+Compiles the authored discovery CSV (Content/Data/Discoveries.csv) into the binary table
+read by FDiscoveryTable (Content/Data/Discoveries.bin).
+
+CSV columns:
+  name         Unique discovery name, shown as the discovery title
+  biome        Biome name (Forest, Beach, Desert, Urban, Countryside, Mountains, Wetlands)
+  local_x      Position inside the section as a 0-1 fraction of its edge; leave empty for
+  local_y      biome-wide discoveries that can be found anywhere in the biome
+  bucket       Optional section hash bucket for located discoveries; derived from the name when empty
+  description  Text shown when the discovery is found
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import zlib
+from pathlib import Path
+from typing import Dict, List
+
+# Must match FDiscoveryTableHeader / FDiscoveryTableRecord in Systems/DiscoveryTable.h
+HEADER_FORMAT = "<IHHIIII"
+RECORD_FORMAT = "<IIHHffBBH"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+FILE_MAGIC = 0x54444B42
+FILE_VERSION = 1
+FLAG_LOCATED = 1
+
+BIOMES = ["Forest", "Beach", "Desert", "Urban", "Countryside", "Mountains", "Wetlands"]
+BIOME_NONE = len(BIOMES)
+MAX_STRING_BYTES = 0xFFFF
+
+
+def parse_rows(path: Path) -> List[Dict]:
+    """Read and validate the authored rows"""
+    rows = []
+    seen = set()
+    with open(path, newline="", encoding="utf-8") as handle:
+        for line, source in enumerate(csv.DictReader(handle), start=2):
+            name = (source.get("name") or "").strip()
+            if not name:
+                raise ValueError(f"{path}:{line}: missing name")
+            if name in seen:
+                raise ValueError(f"{path}:{line}: duplicate name '{name}'")
+            seen.add(name)
+
+            biome_name = (source.get("biome") or "").strip()
+            if biome_name not in BIOMES:
+                raise ValueError(f"{path}:{line}: unknown biome '{biome_name}'")
+
+            local_x = (source.get("local_x") or "").strip()
+            local_y = (source.get("local_y") or "").strip()
+            located = bool(local_x or local_y)
+            position = (float(local_x or 0.0), float(local_y or 0.0))
+            if located and not all(0.0 <= value <= 1.0 for value in position):
+                raise ValueError(f"{path}:{line}: local position must be within 0-1")
+
+            bucket = (source.get("bucket") or "").strip()
+            rows.append({
+                "name": name,
+                "description": (source.get("description") or "").strip(),
+                "biome": BIOMES.index(biome_name),
+                "located": located,
+                "position": position,
+                "bucket": int(bucket) if bucket else None,
+            })
+    return rows
+
+
+def build_table(rows: List[Dict], buckets_per_biome: int) -> bytes:
+    """Lay rows out partition by partition, biome-wide rows last"""
+    num_partitions = len(BIOMES) * buckets_per_biome + 1
+    partitions: List[List[Dict]] = [[] for _ in range(num_partitions)]
+
+    for row in rows:
+        partition = num_partitions - 1
+        if row["located"]:
+            # Same derivation as FDiscoveryTable::Build: CRC-32 of the UTF-8 name
+            bucket = row["bucket"] if row["bucket"] is not None else zlib.crc32(row["name"].encode("utf-8"))
+            partition = row["biome"] * buckets_per_biome + bucket % buckets_per_biome
+        partitions[partition].append(row)
+
+    partition_starts = [0]
+    records = bytearray()
+    strings = bytearray()
+
+    def append_string(value: str):
+        encoded = value.encode("utf-8")[:MAX_STRING_BYTES]
+        offset = len(strings)
+        strings.extend(encoded)
+        return offset, len(encoded)
+
+    for partition in partitions:
+        for row in partition:
+            name_offset, name_length = append_string(row["name"])
+            desc_offset, desc_length = append_string(row["description"])
+            records.extend(struct.pack(
+                RECORD_FORMAT, name_offset, desc_offset, name_length, desc_length,
+                row["position"][0], row["position"][1], row["biome"],
+                FLAG_LOCATED if row["located"] else 0, 0))
+        partition_starts.append(partition_starts[-1] + len(partition))
+
+    header = struct.pack(HEADER_FORMAT, FILE_MAGIC, FILE_VERSION, RECORD_SIZE, buckets_per_biome,
+                         len(rows), len(strings), 0)
+    return header + struct.pack(f"<{len(partition_starts)}I", *partition_starts) + bytes(records) + bytes(strings)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compile the BikeAdventure discovery table")
+    parser.add_argument("input", type=Path, help="Discovery CSV")
+    parser.add_argument("-o", "--output", type=Path, required=True, help="Output .bin file")
+    parser.add_argument("-b", "--buckets", type=int, default=16, help="Section hash buckets per biome")
+    args = parser.parse_args()
+
+    if args.buckets < 1:
+        print("Error: at least one bucket per biome is required", file=sys.stderr)
+        return 1
+
+    try:
+        rows = parse_rows(args.input)
+        table = build_table(rows, args.buckets)
+        args.output.parent.mkdir(parents=True, exist_ok=True)
+        args.output.write_bytes(table)
+    except (OSError, ValueError) as error:
+        print(f"Error: {error}", file=sys.stderr)
+        return 1
+
+    located = sum(1 for row in rows if row["located"])
+    print(f"Compiled {len(rows)} discoveries ({located} located) into {args.output} ({len(table)} bytes)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+BikeAdventure Telemetry Decoder
+Converts the binary hot-path telemetry files written by FBikeTelemetry
+(Saved/Telemetry/BikeTelemetry_*.bin) into CSV or JSON.
+"""
+
+import argparse
+import csv
+import json
+import struct
+import sys
+from pathlib import Path
+from typing import Any, Dict, Iterator, List
+
+# Must match FBikeTelemetryFileHeader / FBikeTelemetryRecord in Systems/BikeTelemetry.h
+HEADER_FORMAT = "<IHHdQ"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+RECORD_FORMAT = "<QBBBBiiiif"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+FILE_MAGIC = 0x4C544B42
+SUPPORTED_VERSIONS = {1}
+
+BIOMES = ["Forest", "Beach", "Desert", "Urban", "Countryside", "Mountains", "Wetlands", "None"]
+PERSONALITIES = ["Wild", "Safe", "Scenic", "Challenge", "Mystery", "Peaceful", "None"]
+QUALITY_LEVELS = ["Low", "Medium", "High", "Ultra"]
+
+EVENTS = {
+    1: "SectionStreamIn",
+    2: "SectionLoaded",
+    3: "SectionUnloaded",
+    4: "PathSegmentGenerated",
+    5: "BiomeTransition",
+    6: "PathHintsGenerated",
+    7: "PathHintsBatchGenerated",
+    8: "InputLatency",
+}
+
+
+def enum_name(table: List[str], value: int) -> str:
+    return table[value] if 0 <= value < len(table) else str(value)
+
+
+def decode_record(raw: tuple, seconds_per_cycle: float, start_cycles: int) -> Dict[str, Any]:
+    """Expand one raw record into named fields according to its event type"""
+    cycles, event, value_a, value_b, flags, x, y, z, int_value, float_value = raw
+    event_name = EVENTS.get(event, f"Unknown({event})")
+
+    row: Dict[str, Any] = {
+        "time_s": round((cycles - start_cycles) * seconds_per_cycle, 6),
+        "event": event_name,
+    }
+
+    if event in (1, 2, 3):
+        row.update({"section_x": x, "section_y": y, "section_z": z, "biome": enum_name(BIOMES, value_a)})
+        if event == 2:
+            row.update({"memory_kb": int_value, "duration_ms": round(float_value, 4), "has_intersection": bool(flags & 1)})
+        elif event == 3:
+            row["duration_ms"] = round(float_value, 4)
+    elif event == 4:
+        row.update({
+            "location_x": x, "location_y": y, "location_z": z,
+            "biome": enum_name(BIOMES, value_a),
+            "actors_spawned": int_value,
+            "duration_ms": round(float_value, 4),
+            "quality": enum_name(QUALITY_LEVELS, flags),
+        })
+    elif event == 5:
+        row.update({"from_biome": enum_name(BIOMES, value_a), "to_biome": enum_name(BIOMES, value_b),
+                    "path": "left" if flags & 1 else "right"})
+    elif event == 6:
+        row.update({"left_personality": enum_name(PERSONALITIES, value_a),
+                    "right_personality": enum_name(PERSONALITIES, value_b),
+                    "hint_subtlety": round(float_value, 4)})
+    elif event == 7:
+        row.update({"section_x": x, "section_y": y, "section_z": z, "intersections": int_value,
+                    "duration_ms": round(float_value, 4),
+                    "us_per_intersection": round(float_value * 1000.0 / int_value, 3) if int_value > 0 else 0.0})
+    elif event == 8:
+        # BiomeA carries the frame count; there are no flags
+        row.update({"frames_to_present": value_a, "input_to_update_ms": round(int_value / 1000.0, 3),
+                    "input_to_present_ms": round(float_value, 4)})
+    else:
+        row.update({"value_a": value_a, "value_b": value_b, "flags": flags, "x": x, "y": y, "z": z,
+                    "int_value": int_value, "float_value": float_value})
+
+    return row
+
+
+def read_telemetry(path: Path) -> Iterator[Dict[str, Any]]:
+    """Yield decoded records from a telemetry file"""
+    with open(path, "rb") as handle:
+        header = handle.read(HEADER_SIZE)
+        if len(header) < HEADER_SIZE:
+            raise ValueError(f"{path}: file too short for telemetry header")
+
+        magic, version, record_size, seconds_per_cycle, start_cycles = struct.unpack(HEADER_FORMAT, header)
+        if magic != FILE_MAGIC:
+            raise ValueError(f"{path}: not a BikeAdventure telemetry file")
+        if version not in SUPPORTED_VERSIONS:
+            raise ValueError(f"{path}: unsupported telemetry version {version}")
+        if record_size != RECORD_SIZE:
+            raise ValueError(f"{path}: unexpected record size {record_size} (expected {RECORD_SIZE})")
+
+        while True:
+            chunk = handle.read(RECORD_SIZE)
+            if len(chunk) < RECORD_SIZE:
+                # A trailing partial record means the game was still writing; ignore it
+                break
+            yield decode_record(struct.unpack(RECORD_FORMAT, chunk), seconds_per_cycle, start_cycles)
+
+
+def write_csv(rows: List[Dict[str, Any]], output) -> None:
+    fieldnames: List[str] = []
+    for row in rows:
+        for key in row:
+            if key not in fieldnames:
+                fieldnames.append(key)
+
+    writer = csv.DictWriter(output, fieldnames=fieldnames)
+    writer.writeheader()
+    writer.writerows(rows)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Decode BikeAdventure binary telemetry files")
+    parser.add_argument("input", type=Path, help="Telemetry .bin file")
+    parser.add_argument("-f", "--format", choices=["csv", "json"], default="csv", help="Output format")
+    parser.add_argument("-o", "--output", type=Path, help="Output file (defaults to stdout)")
+    parser.add_argument("-e", "--event", action="append", help="Only include the given event name (repeatable)")
+    args = parser.parse_args()
+
+    try:
+        rows = [row for row in read_telemetry(args.input) if not args.event or row["event"] in args.event]
+    except (OSError, ValueError) as error:
+        print(f"Error: {error}", file=sys.stderr)
+        return 1
+
+    output = open(args.output, "w", newline="") if args.output else sys.stdout
+    try:
+        if args.format == "json":
+            json.dump(rows, output, indent=2)
+            output.write("\n")
+        else:
+            write_csv(rows, output)
+    finally:
+        if args.output:
+            output.close()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -143,7 +143,7 @@ TOTAL_CHECKS=$((TOTAL_CHECKS + 1))
 echo -e "\n${YELLOW}7. Unit Tests${NC}"
 echo "-------------"
 
-check_file "$PROJECT_ROOT/Tests/Unit/BikeMovementTest.cpp" "Bike Movement Tests"
+check_file "$PROJECT_ROOT/Source/BikeAdventureTests/Unit/BikeMovementTests.cpp" "Bike Movement Tests"
 TOTAL_CHECKS=$((TOTAL_CHECKS + 1))
 [ $? -eq 0 ] && PASSED_CHECKS=$((PASSED_CHECKS + 1))
 